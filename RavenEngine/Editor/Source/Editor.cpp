@@ -23,6 +23,7 @@
 
 #include "Scene/Scene.h"
 #include "Scene/SceneManager.h"
+#include "Scene/SceneBoundsTree.h"
 #include "Scene/Component/Component.h"
 #include "Scene/Component/Transform.h"
 #include "Scene/Component/Light.h"
@@ -324,55 +325,58 @@ namespace Raven
 
 	void Editor::SelectObject(const Ray& ray)
 	{
-		/*auto& registry = GetModule<SceneManager>()->GetCurrentScene()->GetRegistry();
-		float closestEntityDist = std::numeric_limits<float>::infinity();
-
-		entt::entity currentClosestEntity = entt::null;
+		auto scene = GetModule<SceneManager>()->GetCurrentScene();
 
-		auto group = registry.group<Model>(entt::get<Transform>);
+		if (!scene)
+			return;
 
-		for (auto entity : group)
-		{
-			const auto& [model, trans] = group.get<Model, Transform>(entity);
+		auto& registry = scene->GetRegistry();
+		SceneBoundsTree* boundsTree = scene->GetBoundsTree();
+		boundsTree->Update(registry);
 
-			auto& meshes = model.GetMeshes();
+		float closestEntityDist = std::numeric_limits<float>::infinity();
+		entt::entity currentClosestEntity = entt::null;
 
-			for (auto mesh : meshes)
+		// Only test the entities whose bounds the ray hit.
+		boundsTree->QueryRay(ray.GetOrigin(), ray.GetDirection(), closestEntityDist, [&](entt::entity entity)
 			{
-				if (mesh->IsActive())
+				auto trans = registry.try_get<Transform>(entity);
+				PrimitiveComponent* prims[2] = {
+					registry.try_get<MeshComponent>(entity),
+					registry.try_get<SkinnedMeshComponent>(entity)
+				};
+
+				for (uint32_t i = 0; trans && i < 2; ++i)
 				{
-					auto& worldTransform = trans.GetWorldMatrix();
+					if (!prims[i])
+						continue;
+
+					MathUtils::BoundingBox bounds = prims[i]->GetLocalBounds();
+
+					if (!bounds.IsValid())
+						continue;
+
+					bounds = bounds.Transform(trans->GetWorldMatrix());
 
-					auto bbCopy = mesh->GetBoundingBox()->Transformed(worldTransform);
-					float dist = ray.HitDistance(bbCopy);
+					float dist = 0.0f;
 
-					if (dist < std::numeric_limits<float>::infinity())
+					if (!bounds.RayIntersection(ray.GetOrigin(), ray.GetDirection(), dist) || dist < 0.0f)
+						continue;
+
+					if (dist < closestEntityDist)
 					{
-						if (dist < closestEntityDist)
-						{
-							closestEntityDist = dist;
-							currentClosestEntity = entity;
-						}
+						closestEntityDist = dist;
+						currentClosestEntity = entity;
 					}
 				}
-			}
-		}
-
-		if (selectedNode != entt::null)
-		{
-			if (selectedNode == currentClosestEntity)
-			{
-				
-				auto& trans = registry.get<Transform>(selectedNode);
-				auto& model = registry.get<Model>(selectedNode);
-				auto bb = model.GetMeshes().front()->GetBoundingBox()->Transformed(trans.GetWorldMatrix());
 
-				FocusCamera(trans.GetWorldPosition(), (bb.max_ - bb.min_).Length());
-			}
+				return closestEntityDist;
+			});
 
-			selectedNode = currentClosestEntity;
-			return;
-		}*/
+		if (currentClosestEntity != entt::null)
+		{
+			SetSelected(currentClosestEntity);
+		}
 	}
 
 	void Editor::OpenFile(const std::string& filePath)
@@ -343,6 +343,12 @@ namespace MM
 
 				ImGui::PopID();
 			}
+
+			// GPU Memory of the mesh & its LODs.
+			ImGui::NextColumn();
+			ImGui::Text("GPU Size");
+			ImGui::NextColumn();
+			ImGui::Text("%.1f KB (%d LODs)", meshRsc->GetGPUSize() / 1024.0f, meshRsc->GetNumLODs());
 		}
 
 		ImGui::NextColumn();
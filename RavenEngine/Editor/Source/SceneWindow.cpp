@@ -21,6 +21,7 @@
 #include "SceneWindow.h"
 #include "ImGui/ImGuiHelpers.h"
 #include "Render/RenderModule.h"
+#include "Render/RenderObjects/RenderScene.h"
 #include "Render/RenderTarget.h"
 #include "Render/OpenGL/GLTexture.h"
 
@@ -340,6 +341,15 @@ namespace Raven
 			LOGW("TODO --- GizmosPopup");
 			ImGui::EndPopup();
 		}
+		ImGui::SameLine();
+
+		if (ImGui::Button("Stats " ICON_MDI_CHEVRON_DOWN))
+			ImGui::OpenPopup("StatsPopup");
+		if (ImGui::BeginPopup("StatsPopup"))
+		{
+			DrawRenderStats();
+			ImGui::EndPopup();
+		}
 
 		ImGui::PopStyleColor();
 		ImGui::Unindent();
@@ -348,6 +358,31 @@ namespace Raven
 
 
 
+	void SceneWindow::DrawRenderStats()
+	{
+		auto& editor = static_cast<Editor&>(Editor::Get());
+		const RenderSceneStats& stats = editor.GetModule<RenderModule>()->GetRenderScene()->GetStats();
+
+		ImGui::Text("Deferred Draws: %u", stats.deferredDraws.draws);
+		ImGui::Text("Shader/Material/Mesh Changes: %u/%u/%u", stats.deferredDraws.shaderChanges,
+			stats.deferredDraws.materialChanges, stats.deferredDraws.meshChanges);
+		ImGui::Text("Shadow Draws: %u", stats.shadowDraws.draws);
+		ImGui::Text("Shadow Cascades: %u", stats.shadowCascades);
+		ImGui::Text("Cluster Light Refs: %u", stats.clusterLightRefs);
+		ImGui::Text("Foliage Instances: %u (%u bytes uploaded)", stats.foliageInstances, stats.foliageUploadBytes);
+		ImGui::Separator();
+
+		// Visible primitives & triangles at each mesh LOD.
+		for (uint32_t i = 0; i < RENDER_STATS_MAX_LODS; ++i)
+		{
+			if (stats.lodPrimitives[i] == 0)
+				continue;
+
+			ImGui::Text("LOD_%u: %u primitives, %u triangles", i, stats.lodPrimitives[i], stats.lodTriangles[i]);
+		}
+	}
+
+
 	void SceneWindow::DrawGizmos(float width, float height, float xpos, float ypos, Scene* scene)
 	{
 		auto& editor = static_cast<Editor&>(Engine::Get());
@@ -38,6 +38,7 @@ namespace Raven
 		void DrawGizmos(float width, float height, float xpos, float ypos, Scene* scene);
 	private:
 		void DrawToolBar();
+		void DrawRenderStats();
 		uint32_t width;
 		uint32_t height;
 		bool showCamera = false;
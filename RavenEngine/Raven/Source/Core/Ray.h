@@ -52,6 +52,10 @@ namespace Raven
 
         glm::vec3 ClosestPoint(const Ray& ray) const;
 
+        inline const glm::vec3& GetOrigin() const { return origin; }
+
+        inline const glm::vec3& GetDirection() const { return direction; }
+
     private:
         glm::vec3 origin;
         glm::vec3 direction;
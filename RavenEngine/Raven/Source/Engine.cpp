@@ -154,6 +154,9 @@ void Engine::OnImGui()
 
 void Engine::OnUpdate(float dt)
 {
+	// Finish resources loaded in the background.
+	GetModule<ResourceManager>()->Update();
+
 	// Dispatch events
 	eventDispatcher.DispatchEvents();
 
@@ -0,0 +1,440 @@
+/*
+ * Developed by Raven Group at the University  of Leeds
+ * Copyright (C) 2021 Ammar Herzallah, Ben Husle, Thomas Moreno Cooper, Sulagna Sinha & Tian Zeng
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3 of the License.
+ *
+ * THIS PROGRAM IS DISTRIBUTED IN THE HOPE THAT IT WILL BE USEFUL,
+ * BUT WITHOUT ANY WARRANTY; WITHOUT EVEN THE IMPLIED WARRANTY OF
+ * MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE.  SEE THE
+ * GNU GENERAL PUBLIC LICENSE FOR MORE DETAILS.
+ */
+#include "DynamicAABBTree.h"
+
+
+#include "glm/common.hpp"
+
+
+
+
+namespace Raven {
+
+namespace MathUtils {
+
+
+
+
+// Half the surface area of a box, used as the insertion cost.
+static inline float BoxArea(const glm::vec3& min, const glm::vec3& max)
+{
+	glm::vec3 d = max - min;
+	return d.x * d.y + d.y * d.z + d.z * d.x;
+}
+
+
+// Return true if the box a contains box b.
+static inline bool BoxContains(const glm::vec3& aMin, const glm::vec3& aMax, const glm::vec3& bMin, const glm::vec3& bMax)
+{
+	return aMin.x <= bMin.x && aMin.y <= bMin.y && aMin.z <= bMin.z
+		&& aMax.x >= bMax.x && aMax.y >= bMax.y && aMax.z >= bMax.z;
+}
+
+
+
+
+DynamicAABBTree::DynamicAABBTree()
+	: root(NULL_NODE)
+	, freeList(NULL_NODE)
+	, numProxies(0)
+{
+
+}
+
+
+int32_t DynamicAABBTree::AllocateNode()
+{
+	// Pool is full?
+	if (freeList == NULL_NODE)
+	{
+		Node newNode;
+		newNode.parent = NULL_NODE;
+		newNode.height = -1;
+		nodes.push_back(newNode);
+		freeList = (int32_t)nodes.size() - 1;
+	}
+
+	int32_t nodeId = freeList;
+	Node& node = nodes[nodeId];
+	freeList = node.parent;
+
+	node.parent = NULL_NODE;
+	node.child1 = NULL_NODE;
+	node.child2 = NULL_NODE;
+	node.height = 0;
+	node.userData = 0;
+
+	return nodeId;
+}
+
+
+void DynamicAABBTree::FreeNode(int32_t nodeId)
+{
+	nodes[nodeId].parent = freeList;
+	nodes[nodeId].height = -1;
+	freeList = nodeId;
+}
+
+
+int32_t DynamicAABBTree::CreateProxy(const glm::vec3& min, const glm::vec3& max, uint32_t userData)
+{
+	int32_t proxyId = AllocateNode();
+	Node& node = nodes[proxyId];
+
+	// Fatten...
+	glm::vec3 margin = (max - min) * DYNAMIC_AABB_TREE_FAT_SCALE + glm::vec3(0.1f);
+	node.min = min - margin;
+	node.max = max + margin;
+	node.userData = userData;
+	node.height = 0;
+
+	InsertLeaf(proxyId);
+	++numProxies;
+
+	return proxyId;
+}
+
+
+void DynamicAABBTree::DestroyProxy(int32_t proxyId)
+{
+	RAVEN_ASSERT(nodes[proxyId].IsLeaf(), "DynamicAABBTree - Invalid Proxy.");
+
+	RemoveLeaf(proxyId);
+	FreeNode(proxyId);
+	--numProxies;
+}
+
+
+bool DynamicAABBTree::MoveProxy(int32_t proxyId, const glm::vec3& min, const glm::vec3& max)
+{
+	RAVEN_ASSERT(nodes[proxyId].IsLeaf(), "DynamicAABBTree - Invalid Proxy.");
+
+	// Still inside its fat box?
+	if (BoxContains(nodes[proxyId].min, nodes[proxyId].max, min, max))
+		return false;
+
+	RemoveLeaf(proxyId);
+
+	// Fatten...
+	glm::vec3 margin = (max - min) * DYNAMIC_AABB_TREE_FAT_SCALE + glm::vec3(0.1f);
+	nodes[proxyId].min = min - margin;
+	nodes[proxyId].max = max + margin;
+
+	InsertLeaf(proxyId);
+
+	return true;
+}
+
+
+void DynamicAABBTree::Clear()
+{
+	nodes.clear();
+	root = NULL_NODE;
+	freeList = NULL_NODE;
+	numProxies = 0;
+}
+
+
+void DynamicAABBTree::InsertLeaf(int32_t leaf)
+{
+	// First Node?
+	if (root == NULL_NODE)
+	{
+		root = leaf;
+		nodes[root].parent = NULL_NODE;
+		return;
+	}
+
+	const glm::vec3 leafMin = nodes[leaf].min;
+	const glm::vec3 leafMax = nodes[leaf].max;
+
+	// Find the best sibling using the surface area heuristic...
+	int32_t index = root;
+
+	while (!nodes[index].IsLeaf())
+	{
+		const Node& node = nodes[index];
+		int32_t child1 = node.child1;
+		int32_t child2 = node.child2;
+
+		float area = BoxArea(node.min, node.max);
+		float combinedArea = BoxArea(glm::min(node.min, leafMin), glm::max(node.max, leafMax));
+
+		// Cost of creating a new parent for this node and the new leaf.
+		float cost = 2.0f * combinedArea;
+
+		// Minimum cost of pushing the leaf further down the tree.
+		float inheritanceCost = 2.0f * (combinedArea - area);
+
+		// Cost of descending into each child.
+		float cost1, cost2;
+
+		{
+			const Node& c = nodes[child1];
+			float newArea = BoxArea(glm::min(c.min, leafMin), glm::max(c.max, leafMax));
+			cost1 = c.IsLeaf() ? newArea + inheritanceCost : (newArea - BoxArea(c.min, c.max)) + inheritanceCost;
+		}
+
+		{
+			const Node& c = nodes[child2];
+			float newArea = BoxArea(glm::min(c.min, leafMin), glm::max(c.max, leafMax));
+			cost2 = c.IsLeaf() ? newArea + inheritanceCost : (newArea - BoxArea(c.min, c.max)) + inheritanceCost;
+		}
+
+		// Cheaper to create the parent here?
+		if (cost < cost1 && cost < cost2)
+			break;
+
+		index = cost1 < cost2 ? child1 : child2;
+	}
+
+	int32_t sibling = index;
+
+	// Create a new parent for the sibling and the leaf...
+	int32_t oldParent = nodes[sibling].parent;
+	int32_t newParent = AllocateNode();
+	nodes[newParent].parent = oldParent;
+	nodes[newParent].min = glm::min(nodes[sibling].min, leafMin);
+	nodes[newParent].max = glm::max(nodes[sibling].max, leafMax);
+	nodes[newParent].height = nodes[sibling].height + 1;
+	nodes[newParent].child1 = sibling;
+	nodes[newParent].child2 = leaf;
+	nodes[sibling].parent = newParent;
+	nodes[leaf].parent = newParent;
+
+	if (oldParent != NULL_NODE)
+	{
+		if (nodes[oldParent].child1 == sibling)
+			nodes[oldParent].child1 = newParent;
+		else
+			nodes[oldParent].child2 = newParent;
+	}
+	else
+	{
+		root = newParent;
+	}
+
+	// Walk back up fixing heights and bounds.
+	Refit(nodes[leaf].parent);
+}
+
+
+void DynamicAABBTree::RemoveLeaf(int32_t leaf)
+{
+	// Last Node?
+	if (leaf == root)
+	{
+		root = NULL_NODE;
+		return;
+	}
+
+	int32_t parent = nodes[leaf].parent;
+	int32_t grandParent = nodes[parent].parent;
+	int32_t sibling = nodes[parent].child1 == leaf ? nodes[parent].child2 : nodes[parent].child1;
+
+	if (grandParent != NULL_NODE)
+	{
+		// Destroy parent and connect sibling to grandParent.
+		if (nodes[grandParent].child1 == parent)
+			nodes[grandParent].child1 = sibling;
+		else
+			nodes[grandParent].child2 = sibling;
+
+		nodes[sibling].parent = grandParent;
+		FreeNode(parent);
+
+		Refit(grandParent);
+	}
+	else
+	{
+		root = sibling;
+		nodes[sibling].parent = NULL_NODE;
+		FreeNode(parent);
+	}
+}
+
+
+void DynamicAABBTree::Refit(int32_t nodeId)
+{
+	int32_t index = nodeId;
+
+	while (index != NULL_NODE)
+	{
+		index = Balance(index);
+
+		Node& node = nodes[index];
+		const Node& c1 = nodes[node.child1];
+		const Node& c2 = nodes[node.child2];
+
+		node.height = 1 + glm::max(c1.height, c2.height);
+		node.min = glm::min(c1.min, c2.min);
+		node.max = glm::max(c1.max, c2.max);
+
+		index = node.parent;
+	}
+}
+
+
+int32_t DynamicAABBTree::Balance(int32_t iA)
+{
+	Node* A = &nodes[iA];
+
+	if (A->IsLeaf() || A->height < 2)
+		return iA;
+
+	int32_t iB = A->child1;
+	int32_t iC = A->child2;
+	Node* B = &nodes[iB];
+	Node* C = &nodes[iC];
+
+	int32_t balance = C->height - B->height;
+
+	// Rotate C up?
+	if (balance > 1)
+	{
+		int32_t iF = C->child1;
+		int32_t iG = C->child2;
+		Node* F = &nodes[iF];
+		Node* G = &nodes[iG];
+
+		// Swap A and C
+		C->child1 = iA;
+		C->parent = A->parent;
+		A->parent = iC;
+
+		// A's old parent should point to C
+		if (C->parent != NULL_NODE)
+		{
+			if (nodes[C->parent].child1 == iA)
+				nodes[C->parent].child1 = iC;
+			else
+				nodes[C->parent].child2 = iC;
+		}
+		else
+		{
+			root = iC;
+		}
+
+		// Rotate
+		if (F->height > G->height)
+		{
+			C->child2 = iF;
+			A->child2 = iG;
+			G->parent = iA;
+			A->min = glm::min(B->min, G->min);
+			A->max = glm::max(B->max, G->max);
+			C->min = glm::min(A->min, F->min);
+			C->max = glm::max(A->max, F->max);
+
+			A->height = 1 + glm::max(B->height, G->height);
+			C->height = 1 + glm::max(A->height, F->height);
+		}
+		else
+		{
+			C->child2 = iG;
+			A->child2 = iF;
+			F->parent = iA;
+			A->min = glm::min(B->min, F->min);
+			A->max = glm::max(B->max, F->max);
+			C->min = glm::min(A->min, G->min);
+			C->max = glm::max(A->max, G->max);
+
+			A->height = 1 + glm::max(B->height, F->height);
+			C->height = 1 + glm::max(A->height, G->height);
+		}
+
+		return iC;
+	}
+
+	// Rotate B up?
+	if (balance < -1)
+	{
+		int32_t iD = B->child1;
+		int32_t iE = B->child2;
+		Node* D = &nodes[iD];
+		Node* E = &nodes[iE];
+
+		// Swap A and B
+		B->child1 = iA;
+		B->parent = A->parent;
+		A->parent = iB;
+
+		// A's old parent should point to B
+		if (B->parent != NULL_NODE)
+		{
+			if (nodes[B->parent].child1 == iA)
+				nodes[B->parent].child1 = iB;
+			else
+				nodes[B->parent].child2 = iB;
+		}
+		else
+		{
+			root = iB;
+		}
+
+		// Rotate
+		if (D->height > E->height)
+		{
+			B->child2 = iD;
+			A->child1 = iE;
+			E->parent = iA;
+			A->min = glm::min(C->min, E->min);
+			A->max = glm::max(C->max, E->max);
+			B->min = glm::min(A->min, D->min);
+			B->max = glm::max(A->max, D->max);
+
+			A->height = 1 + glm::max(C->height, E->height);
+			B->height = 1 + glm::max(A->height, D->height);
+		}
+		else
+		{
+			B->child2 = iE;
+			A->child1 = iD;
+			D->parent = iA;
+			A->min = glm::min(C->min, D->min);
+			A->max = glm::max(C->max, D->max);
+			B->min = glm::min(A->min, E->min);
+			B->max = glm::max(A->max, E->max);
+
+			A->height = 1 + glm::max(C->height, D->height);
+			B->height = 1 + glm::max(A->height, E->height);
+		}
+
+		return iB;
+	}
+
+	return iA;
+}
+
+
+bool DynamicAABBTree::RayBox(const glm::vec3& org, const glm::vec3& invDir, float maxAlpha, const glm::vec3& min, const glm::vec3& max)
+{
+	glm::vec3 t0 = (min - org) * invDir;
+	glm::vec3 t1 = (max - org) * invDir;
+
+	glm::vec3 tmin = glm::min(t0, t1);
+	glm::vec3 tmax = glm::max(t0, t1);
+
+	float alphaMin = glm::max(glm::max(tmin.x, tmin.y), glm::max(tmin.z, 0.0f));
+	float alphaMax = glm::min(glm::min(tmax.x, tmax.y), glm::min(tmax.z, maxAlpha));
+
+	return alphaMin <= alphaMax;
+}
+
+
+
+
+} // End of namespace MathUtils.
+
+} // End of namespace Raven.
@@ -0,0 +1,278 @@
+/*
+ * Developed by Raven Group at the University  of Leeds
+ * Copyright (C) 2021 Ammar Herzallah, Ben Husle, Thomas Moreno Cooper, Sulagna Sinha & Tian Zeng
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3 of the License.
+ *
+ * THIS PROGRAM IS DISTRIBUTED IN THE HOPE THAT IT WILL BE USEFUL,
+ * BUT WITHOUT ANY WARRANTY; WITHOUT EVEN THE IMPLIED WARRANTY OF
+ * MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE.  SEE THE
+ * GNU GENERAL PUBLIC LICENSE FOR MORE DETAILS.
+ */
+#pragma once
+
+
+
+#include "Utilities/Core.h"
+#include "Math/Frustum.h"
+
+
+#include "glm/vec3.hpp"
+#include <vector>
+
+
+
+// The size of the fixed stack used while traversing the tree, the tree is balanced so it only grows on the heap
+// if it gets degenerate.
+#define DYNAMIC_AABB_TREE_STACK_SIZE 256
+
+// Fat margin added to leaves relative to their size, so small movements don't change the tree.
+#define DYNAMIC_AABB_TREE_FAT_SCALE 0.1f
+
+
+
+
+namespace Raven
+{
+	namespace MathUtils
+	{
+
+		// DynamicAABBTreeStack:
+		//		- The stack of nodes to visit while traversing the tree.
+		//		- Starts with a fixed array and only grows on the heap when it gets full.
+		//
+		class DynamicAABBTreeStack
+		{
+		public:
+			// Construct.
+			DynamicAABBTreeStack()
+				: data(fixed)
+				, count(0)
+				, capacity(DYNAMIC_AABB_TREE_STACK_SIZE)
+			{
+
+			}
+
+			// Not copyable, data may point to the fixed array.
+			DynamicAABBTreeStack(const DynamicAABBTreeStack&) = delete;
+			DynamicAABBTreeStack& operator=(const DynamicAABBTreeStack&) = delete;
+
+			// Return true if there are no more nodes to visit.
+			inline bool IsEmpty() const { return count == 0; }
+
+			// Push a node to visit.
+			inline void Push(int32_t node)
+			{
+				if (count == capacity)
+					Grow();
+
+				data[count++] = node;
+			}
+
+			// Pop the next node to visit.
+			inline int32_t Pop() { return data[--count]; }
+
+		private:
+			// Move the stack to the heap & double its capacity.
+			void Grow()
+			{
+				if (data == fixed)
+					heap.assign(fixed, fixed + count);
+
+				heap.resize(capacity * 2);
+				data = heap.data();
+				capacity = (int32_t)heap.size();
+			}
+
+		private:
+			// The fixed stack, used until it gets full.
+			int32_t fixed[DYNAMIC_AABB_TREE_STACK_SIZE];
+
+			// The heap stack, only used after the fixed one gets full.
+			std::vector<int32_t> heap;
+
+			// The current stack, either fixed or heap.
+			int32_t* data;
+
+			// The number of nodes in the stack.
+			int32_t count;
+
+			// The max number of nodes the current stack can hold.
+			int32_t capacity;
+		};
+
+
+
+		// DynamicAABBTree:
+		//		- Bounding volume hierarchy of axis aligned boxes that can be updated incrementally.
+		//		- Leaves store a fat box, moving a proxy inside its fat box doesn't change the tree.
+		//		- Balanced using tree rotations, so queries are logarithmic in the number of proxies.
+		//
+		class DynamicAABBTree
+		{
+			// Invalid node index.
+			static constexpr int32_t NULL_NODE = -1;
+
+			// A node in the tree.
+			struct Node
+			{
+				// The node bounds, fat bounds for leaves.
+				glm::vec3 min;
+				glm::vec3 max;
+
+				// The data of the proxy, only valid for leaves.
+				uint32_t userData;
+
+				// Parent while in the tree, next free node while in the free list.
+				int32_t parent;
+
+				// Children, leaves have no children.
+				int32_t child1;
+				int32_t child2;
+
+				// Height of the node, leaves are 0 and free nodes are -1.
+				int32_t height;
+
+				// Return true if this is a leaf node.
+				inline bool IsLeaf() const { return child1 == NULL_NODE; }
+			};
+
+		public:
+			// Construct.
+			DynamicAABBTree();
+
+			// Create a new proxy for the box.
+			// @return the proxy id used to move or remove the proxy.
+			int32_t CreateProxy(const glm::vec3& min, const glm::vec3& max, uint32_t userData);
+
+			// Remove a proxy from the tree.
+			void DestroyProxy(int32_t proxyId);
+
+			// Update the box of a proxy.
+			// @return true if the proxy left its fat box and was reinserted.
+			bool MoveProxy(int32_t proxyId, const glm::vec3& min, const glm::vec3& max);
+
+			// Return the user data of a proxy.
+			inline uint32_t GetUserData(int32_t proxyId) const { return nodes[proxyId].userData; }
+
+			// Return the fat box of a proxy, it contains the last box the proxy was moved to.
+			inline void GetFatBounds(int32_t proxyId, glm::vec3& outMin, glm::vec3& outMax) const
+			{
+				outMin = nodes[proxyId].min;
+				outMax = nodes[proxyId].max;
+			}
+
+			// Return the number of proxies in the tree.
+			inline uint32_t GetNumProxies() const { return numProxies; }
+
+			// Return the height of the tree.
+			inline int32_t GetHeight() const { return root == NULL_NODE ? 0 : nodes[root].height; }
+
+			// Remove all proxies.
+			void Clear();
+
+			// Call the callback with the user data of each proxy that intersect the frustum.
+			// @param is2D: test only the left, right, near and far planes, same as Frustum::IsInFrustum2D().
+			template<class Callback>
+			void QueryFrustum(const Frustum& frustum, bool is2D, Callback&& callback) const
+			{
+				if (root == NULL_NODE)
+					return;
+
+				DynamicAABBTreeStack stack;
+				stack.Push(root);
+
+				while (!stack.IsEmpty())
+				{
+					const Node& node = nodes[ stack.Pop() ];
+
+					bool isInside = is2D ? frustum.IsBoxInFrustum2D(node.min, node.max)
+						: frustum.IsBoxInFrustum(node.min, node.max);
+
+					if (!isInside)
+						continue;
+
+					if (node.IsLeaf())
+					{
+						callback(node.userData);
+						continue;
+					}
+
+					stack.Push(node.child1);
+					stack.Push(node.child2);
+				}
+			}
+
+			// Call the callback with the user data of each proxy that the ray hit, in no particular order.
+			// @param maxAlpha: the max ray parameter to test, rays are org + dir * alpha.
+			// @param callback: called as float(uint32_t userData), return the new max alpha to clip the ray with.
+			template<class Callback>
+			void QueryRay(const glm::vec3& org, const glm::vec3& dir, float maxAlpha, Callback&& callback) const
+			{
+				if (root == NULL_NODE)
+					return;
+
+				glm::vec3 invDir = 1.0f / dir;
+
+				DynamicAABBTreeStack stack;
+				stack.Push(root);
+
+				while (!stack.IsEmpty())
+				{
+					const Node& node = nodes[ stack.Pop() ];
+
+					if (!RayBox(org, invDir, maxAlpha, node.min, node.max))
+						continue;
+
+					if (node.IsLeaf())
+					{
+						maxAlpha = callback(node.userData);
+						continue;
+					}
+
+					stack.Push(node.child1);
+					stack.Push(node.child2);
+				}
+			}
+
+			// Ray vs box slab test.
+			static bool RayBox(const glm::vec3& org, const glm::vec3& invDir, float maxAlpha, const glm::vec3& min, const glm::vec3& max);
+
+		private:
+			// Allocate a node from the pool.
+			int32_t AllocateNode();
+
+			// Return a node to the pool.
+			void FreeNode(int32_t nodeId);
+
+			// Insert a leaf in the tree.
+			void InsertLeaf(int32_t leaf);
+
+			// Remove a leaf from the tree.
+			void RemoveLeaf(int32_t leaf);
+
+			// Perform a left or right rotation if node A is imbalanced.
+			// @return the new root index of the sub-tree.
+			int32_t Balance(int32_t iA);
+
+			// Refit the bounds & heights from the node up to the root.
+			void Refit(int32_t nodeId);
+
+		private:
+			// The nodes pool.
+			std::vector<Node> nodes;
+
+			// The root of the tree.
+			int32_t root;
+
+			// The head of the free list.
+			int32_t freeList;
+
+			// The number of proxies in the tree.
+			uint32_t numProxies;
+		};
+
+	}
+}
@@ -14,6 +14,11 @@
 #include "Frustum.h"
 
 
+#ifdef RAVEN_SSE
+#include <xmmintrin.h>
+#endif
+
+
 
 
 namespace Raven {
@@ -22,6 +27,15 @@ namespace MathUtils {
 
 
 
+// Left, Right, Near and Far.
+static const uint32_t PLANES_2D[4] = { 0, 1, 4, 5 };
+
+// All Planes.
+static const uint32_t PLANES_3D[6] = { 0, 1, 2, 3, 4, 5 };
+
+
+
+
 Frustum::Frustum()
 {
 
@@ -104,10 +118,10 @@ void Frustum::Normalize(uint32_t i)
 }
 
 
-bool Frustum::IsInFrustum2D(const glm::vec3& center, float radius)
+bool Frustum::IsInFrustum2D(const glm::vec3& center, float radius) const
 {
 	// Left, Right, Near and Far.
-	static uint32_t planesIndices[4] = { 0, 1, 4, 5 };
+	static const uint32_t planesIndices[4] = { 0, 1, 4, 5 };
 
 	// Test Planes...
 	for (uint32_t i = 0; i < 4; ++i)
@@ -120,7 +134,7 @@ bool Frustum::IsInFrustum2D(const glm::vec3& center, float radius)
 }
 
 
-bool Frustum::IsInFrustum(const glm::vec3& center, float radius)
+bool Frustum::IsInFrustum(const glm::vec3& center, float radius) const
 {
 	// Test Planes...
 	for (uint32_t i = 0; i < 6; ++i)
@@ -133,7 +147,7 @@ bool Frustum::IsInFrustum(const glm::vec3& center, float radius)
 }
 
 
-bool Frustum::TestPlane(uint32_t idx, const glm::vec3& center, float radius)
+bool Frustum::TestPlane(uint32_t idx, const glm::vec3& center, float radius) const
 {
 	glm::vec3 n = glm::vec3(planes[idx].x, planes[idx].y, planes[idx].z);
 
@@ -146,6 +160,192 @@ bool Frustum::TestPlane(uint32_t idx, const glm::vec3& center, float radius)
 }
 
 
+bool Frustum::IsBoxInFrustum2D(const glm::vec3& min, const glm::vec3& max) const
+{
+	// Left, Right, Near and Far.
+	static const uint32_t planesIndices[4] = { 0, 1, 4, 5 };
+
+	// Test Planes...
+	for (uint32_t i = 0; i < 4; ++i)
+	{
+		if (TestPlaneBox(planesIndices[i], min, max))
+			return false;
+	}
+
+	return true;
+}
+
+
+bool Frustum::IsBoxInFrustum(const glm::vec3& min, const glm::vec3& max) const
+{
+	// Test Planes...
+	for (uint32_t i = 0; i < 6; ++i)
+	{
+		if (TestPlaneBox(i, min, max))
+			return false;
+	}
+
+	return true;
+}
+
+
+bool Frustum::TestPlaneBox(uint32_t idx, const glm::vec3& min, const glm::vec3& max) const
+{
+	// The box corner that is furthest along the plane normal.
+	glm::vec3 p(
+		planes[idx].x >= 0.0f ? max.x : min.x,
+		planes[idx].y >= 0.0f ? max.y : min.y,
+		planes[idx].z >= 0.0f ? max.z : min.z
+	);
+
+	glm::vec3 n = glm::vec3(planes[idx].x, planes[idx].y, planes[idx].z);
+
+	float dr = glm::dot(n, p) + planes[idx].w;
+
+	if (-dr > SMALL_NUM)
+		return true;
+
+	return false;
+}
+
+
+uint32_t Frustum::IsInFrustum2DX4(const glm::vec3* centers, const float* radii) const
+{
+	return TestPlanesX4(PLANES_2D, 4, centers, radii);
+}
+
+
+uint32_t Frustum::IsInFrustumX4(const glm::vec3* centers, const float* radii) const
+{
+	return TestPlanesX4(PLANES_3D, 6, centers, radii);
+}
+
+
+uint32_t Frustum::IsBoxInFrustum2DX4(const glm::vec3* mins, const glm::vec3* maxs) const
+{
+	return TestPlanesBoxX4(PLANES_2D, 4, mins, maxs);
+}
+
+
+uint32_t Frustum::IsBoxInFrustumX4(const glm::vec3* mins, const glm::vec3* maxs) const
+{
+	return TestPlanesBoxX4(PLANES_3D, 6, mins, maxs);
+}
+
+
+#ifdef RAVEN_SSE
+
+// The sphere and box tests evaluate the plane equation in the same order as the scalar
+// path ((x + y) + z) + w, so the results are bitwise the same.
+
+// The scalar path compares against SMALL_NUM as a double, x < -SMALL_NUM is only the same as
+// x < -float(SMALL_NUM) for every float x if the float is rounded toward zero.
+static_assert((double)(float)SMALL_NUM <= SMALL_NUM, "Frustum - SIMD threshold differs from the scalar path.");
+
+uint32_t Frustum::TestPlanesX4(const uint32_t* indices, uint32_t count, const glm::vec3* centers, const float* radii) const
+{
+	// Transpose to SoA.
+	__m128 cx = _mm_setr_ps(centers[0].x, centers[1].x, centers[2].x, centers[3].x);
+	__m128 cy = _mm_setr_ps(centers[0].y, centers[1].y, centers[2].y, centers[3].y);
+	__m128 cz = _mm_setr_ps(centers[0].z, centers[1].z, centers[2].z, centers[3].z);
+	__m128 r = _mm_loadu_ps(radii);
+	__m128 limit = _mm_set1_ps(-(float)SMALL_NUM);
+
+	// Lanes outside any of the planes.
+	__m128 outside = _mm_setzero_ps();
+
+	for (uint32_t i = 0; i < count; ++i)
+	{
+		const glm::vec4& plane = planes[indices[i]];
+
+		__m128 dr = _mm_add_ps(
+			_mm_add_ps(_mm_mul_ps(_mm_set1_ps(plane.x), cx), _mm_mul_ps(_mm_set1_ps(plane.y), cy)),
+			_mm_mul_ps(_mm_set1_ps(plane.z), cz)
+		);
+
+		dr = _mm_add_ps(_mm_add_ps(dr, _mm_set1_ps(plane.w)), r);
+		outside = _mm_or_ps(outside, _mm_cmplt_ps(dr, limit));
+	}
+
+	return ~(uint32_t)_mm_movemask_ps(outside) & 0xF;
+}
+
+
+uint32_t Frustum::TestPlanesBoxX4(const uint32_t* indices, uint32_t count, const glm::vec3* mins, const glm::vec3* maxs) const
+{
+	// Transpose to SoA.
+	__m128 minX = _mm_setr_ps(mins[0].x, mins[1].x, mins[2].x, mins[3].x);
+	__m128 minY = _mm_setr_ps(mins[0].y, mins[1].y, mins[2].y, mins[3].y);
+	__m128 minZ = _mm_setr_ps(mins[0].z, mins[1].z, mins[2].z, mins[3].z);
+	__m128 maxX = _mm_setr_ps(maxs[0].x, maxs[1].x, maxs[2].x, maxs[3].x);
+	__m128 maxY = _mm_setr_ps(maxs[0].y, maxs[1].y, maxs[2].y, maxs[3].y);
+	__m128 maxZ = _mm_setr_ps(maxs[0].z, maxs[1].z, maxs[2].z, maxs[3].z);
+	__m128 limit = _mm_set1_ps(-(float)SMALL_NUM);
+
+	// Lanes outside any of the planes.
+	__m128 outside = _mm_setzero_ps();
+
+	for (uint32_t i = 0; i < count; ++i)
+	{
+		const glm::vec4& plane = planes[indices[i]];
+
+		// The box corner that is furthest along the plane normal, the sign is the same for all lanes.
+		__m128 px = plane.x >= 0.0f ? maxX : minX;
+		__m128 py = plane.y >= 0.0f ? maxY : minY;
+		__m128 pz = plane.z >= 0.0f ? maxZ : minZ;
+
+		__m128 dr = _mm_add_ps(
+			_mm_add_ps(_mm_mul_ps(_mm_set1_ps(plane.x), px), _mm_mul_ps(_mm_set1_ps(plane.y), py)),
+			_mm_mul_ps(_mm_set1_ps(plane.z), pz)
+		);
+
+		dr = _mm_add_ps(dr, _mm_set1_ps(plane.w));
+		outside = _mm_or_ps(outside, _mm_cmplt_ps(dr, limit));
+	}
+
+	return ~(uint32_t)_mm_movemask_ps(outside) & 0xF;
+}
+
+#else
+
+uint32_t Frustum::TestPlanesX4(const uint32_t* indices, uint32_t count, const glm::vec3* centers, const float* radii) const
+{
+	uint32_t mask = 0;
+
+	for (uint32_t l = 0; l < 4; ++l)
+	{
+		bool isInside = true;
+
+		for (uint32_t i = 0; i < count && isInside; ++i)
+			isInside = !TestPlane(indices[i], centers[l], radii[l]);
+
+		mask |= (uint32_t)isInside << l;
+	}
+
+	return mask;
+}
+
+
+uint32_t Frustum::TestPlanesBoxX4(const uint32_t* indices, uint32_t count, const glm::vec3* mins, const glm::vec3* maxs) const
+{
+	uint32_t mask = 0;
+
+	for (uint32_t l = 0; l < 4; ++l)
+	{
+		bool isInside = true;
+
+		for (uint32_t i = 0; i < count && isInside; ++i)
+			isInside = !TestPlaneBox(indices[i], mins[l], maxs[l]);
+
+		mask |= (uint32_t)isInside << l;
+	}
+
+	return mask;
+}
+
+#endif
+
+
 
 
 
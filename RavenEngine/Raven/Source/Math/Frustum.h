@@ -55,10 +55,32 @@ namespace Raven
 			}
 
 			// Test if a sphere inside or intersect the frustum, ignores the Y-Axis and perform the test in 2D.
-			bool IsInFrustum2D(const glm::vec3& center, float radius);
+			bool IsInFrustum2D(const glm::vec3& center, float radius) const;
 
 			// Test if a sphere inside or intersect the frustum.
-			bool IsInFrustum(const glm::vec3& center, float radius);
+			bool IsInFrustum(const glm::vec3& center, float radius) const;
+
+			// Test if an axis aligned box inside or intersect the frustum, ignores the Y-Axis and perform the test in 2D.
+			bool IsBoxInFrustum2D(const glm::vec3& min, const glm::vec3& max) const;
+
+			// Test if an axis aligned box inside or intersect the frustum.
+			bool IsBoxInFrustum(const glm::vec3& min, const glm::vec3& max) const;
+
+			// Test 4 spheres at once, same as IsInFrustum2D() for each sphere.
+			// @return bit mask where bit i is set if sphere i is inside or intersect the frustum.
+			uint32_t IsInFrustum2DX4(const glm::vec3* centers, const float* radii) const;
+
+			// Test 4 spheres at once, same as IsInFrustum() for each sphere.
+			// @return bit mask where bit i is set if sphere i is inside or intersect the frustum.
+			uint32_t IsInFrustumX4(const glm::vec3* centers, const float* radii) const;
+
+			// Test 4 boxes at once, same as IsBoxInFrustum2D() for each box.
+			// @return bit mask where bit i is set if box i is inside or intersect the frustum.
+			uint32_t IsBoxInFrustum2DX4(const glm::vec3* mins, const glm::vec3* maxs) const;
+
+			// Test 4 boxes at once, same as IsBoxInFrustum() for each box.
+			// @return bit mask where bit i is set if box i is inside or intersect the frustum.
+			uint32_t IsBoxInFrustumX4(const glm::vec3* mins, const glm::vec3* maxs) const;
 
 			// Extract Frustum Planes from view projection matrix.
 			void ExtractPlanes(const glm::mat4& mtx);
@@ -68,7 +90,16 @@ namespace Raven
 			void Normalize(uint32_t i);
 
 			// Test if the sphere intersect or on the positive half space of the plane.
-			bool TestPlane(uint32_t idx, const glm::vec3& center, float radius);
+			bool TestPlane(uint32_t idx, const glm::vec3& center, float radius) const;
+
+			// Test if the box intersect or on the positive half space of the plane.
+			bool TestPlaneBox(uint32_t idx, const glm::vec3& min, const glm::vec3& max) const;
+
+			// Test 4 spheres against the planes, uses SSE if RAVEN_SSE is defined.
+			uint32_t TestPlanesX4(const uint32_t* indices, uint32_t count, const glm::vec3* centers, const float* radii) const;
+
+			// Test 4 boxes against the planes, uses SSE if RAVEN_SSE is defined.
+			uint32_t TestPlanesBoxX4(const uint32_t* indices, uint32_t count, const glm::vec3* mins, const glm::vec3* maxs) const;
 
 		private:
 			// The frustum planes in ax+by+cz+d=0 form.
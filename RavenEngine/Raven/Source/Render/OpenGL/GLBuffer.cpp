@@ -33,6 +33,7 @@ GLBuffer::GLBuffer()
 	, size(0)
 	, type(EGLBufferType::None)
 	, usage(EGLBufferUsage::StaticDraw)
+	, mappedData(nullptr)
 {
 
 }
@@ -42,6 +43,13 @@ GLBuffer::~GLBuffer()
 {
 	if (id != 0)
 	{
+		if (mappedData)
+		{
+			glBindBuffer((GLENUM)type, id);
+			glUnmapBuffer((GLENUM)type);
+			glBindBuffer((GLENUM)type, 0);
+		}
+
 		glDeleteBuffers(1, &id);
 	}
 }
@@ -81,8 +89,31 @@ GLBuffer* GLBuffer::Create(EGLBufferType type, int size, const void* data, EGLBu
 }
 
 
+GLBuffer* GLBuffer::CreatePersistent(EGLBufferType type, int size)
+{
+	GLBuffer* buffer = new GLBuffer();
+	buffer->type = type;
+	buffer->usage = EGLBufferUsage::DynamicDraw;
+	buffer->size = size;
+
+	const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+
+	glGenBuffers(1, &buffer->id);
+	glBindBuffer((GLENUM)type, buffer->id);
+	glBufferStorage((GLENUM)type, size, nullptr, flags);
+	buffer->mappedData = (uint8_t*)glMapBufferRange((GLENUM)type, 0, size, flags);
+	glBindBuffer((GLENUM)type, 0);
+
+	RAVEN_ASSERT(buffer->mappedData != nullptr, "GLBuffer - Failed to map persistent buffer.");
+
+	return buffer;
+}
+
+
 void GLBuffer::UpdateData(int dataSize, const void* data)
 {
+	RAVEN_ASSERT(mappedData == nullptr, "GLBuffer - Can't reallocate a persistent buffer.");
+
 	size = dataSize;
 
 	glBindBuffer((GLENUM)type, id);
@@ -94,6 +125,7 @@ void GLBuffer::UpdateData(int dataSize, const void* data)
 void GLBuffer::UpdateSubData(int dataSize, int offset, const void* data)
 {
 	RAVEN_ASSERT((offset + dataSize) <= size, "GLBuffer Update - Invalid Size.");
+	RAVEN_ASSERT(mappedData == nullptr, "GLBuffer - Persistent buffers are updated through their mapped data.");
 
 	glBindBuffer((GLENUM)type, id);
 	glBufferSubData((GLENUM)type, offset, dataSize, data);
@@ -18,6 +18,8 @@
 
 #include "GLTypes.h"
 
+#include <cstdint>
+
 
 
 
@@ -45,6 +47,10 @@ namespace Raven
 		// Create a new GLBuffer with data. 
 		static GLBuffer* Create(EGLBufferType type, int size, const void* data, EGLBufferUsage usage);
 
+		// Create a new GLBuffer with immutable storage that stays mapped for writing while the buffer is alive.
+		// The mapping is coherent, writes are visible to the GPU without flushing.
+		static GLBuffer* CreatePersistent(EGLBufferType type, int size);
+
 		// Reallocate and update new data for the buffer.
 		void UpdateData(int dataSize, const void* data);
 
@@ -60,6 +66,9 @@ namespace Raven
 		// Return the current usage of the buffer.
 		inline EGLBufferUsage GetUsage() const { return usage; }
 
+		// Return the persistent mapped memory of the buffer, null if the buffer is not persistent.
+		inline uint8_t* GetMappedData() const { return mappedData; }
+
 		// Return the opengl id of the buffer.
 		inline GLUINT GetID() const { return id; }
 
@@ -87,6 +96,9 @@ namespace Raven
 
 		// OpenGL Object ID.
 		GLUINT id;
+
+		// The persistent mapped memory of the buffer.
+		uint8_t* mappedData;
 	};
 
 
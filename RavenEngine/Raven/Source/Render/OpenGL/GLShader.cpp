@@ -15,6 +15,7 @@
 
 
 #include "GLShader.h"
+#include "GLShaderCache.h"
 #include "Logger/Console.h"
 #include "Utilities/Core.h"
 
@@ -38,14 +39,26 @@ namespace Raven {
 
 
 
+// The ids of all uniform names used with GLShader::GetUniformID.
+static std::unordered_map<std::string, GLUniformID> uniformIDs;
+static std::vector<std::string> uniformNames;
+
+
+
+
 
 
 
 
 GLShader::GLShader()
 	: id(0)
+	, buildKey(0)
+	, buildProgram(0)
+	, isBuildPrepared(false)
+	, isBuildFromCache(false)
 {
-
+	for (int32_t i = 0; i < GLSHADER_NUM_STAGES; ++i)
+		buildStages[i] = 0;
 }
 
 
@@ -55,6 +68,15 @@ GLShader::~GLShader()
 	{
 		glDeleteProgram(id);
 	}
+
+	// Build still in progress?
+	for (int32_t i = 0; i < GLSHADER_NUM_STAGES; ++i)
+		GLSHADER_DELETE_VALID( buildStages[i] );
+
+	if (buildProgram != 0)
+	{
+		glDeleteProgram(buildProgram);
+	}
 }
 
 
@@ -165,108 +187,238 @@ EGLShaderStageBit GLShader::ToStageBit(EGLShaderStage stage)
 }
 
 
+// The stages of a program in build order.
+static const EGLShaderStage GLSHADER_STAGES[GLSHADER_NUM_STAGES] = { EGLShaderStage::Vertex,
+	EGLShaderStage::Fragment, EGLShaderStage::Geometry,
+	EGLShaderStage::TessControl, EGLShaderStage::TessEvaluation
+};
+
+
+
 bool GLShader::Build()
 {
-	int prevID = id;
+	if (!PrepareBuild())
+		return false;
 
-	// OpenGL Shader for each stag
-	GLUINT glshaders[5] = { 0 };
-	static const EGLShaderStage glshadersTypes[5] = { EGLShaderStage::Vertex, 
-	  EGLShaderStage::Fragment, EGLShaderStage::Geometry,
-	  EGLShaderStage::TessControl, EGLShaderStage::TessEvaluation
-	};
+	BeginBuild();
+	return FinishBuild();
+}
 
 
-	// Iterate over all stages and build the provided ones.
-	for (int32_t i = 0; i < 5; ++i)
+bool GLShader::PrepareBuild()
+{
+	isBuildPrepared = false;
+
+	// Load the sources of all provided stages.
+	for (int32_t i = 0; i < GLSHADER_NUM_STAGES; ++i)
 	{
+		buildSources[i].clear();
+
 		// No source for this stage?
-		if (!source.count(glshadersTypes[i]))
+		if (!source.count(GLSHADER_STAGES[i]))
 			continue;
 
-		glshaders[i] = BuildStage(glshadersTypes[i]);
+		LoadSource(GLSHADER_STAGES[i], buildSources[i]);
 
-		// Build Failed?
-		if (!glshaders[i])
+		// Failed to load source?
+		if (buildSources[i].empty())
 		{
-			// Delete created shaders objects...
-			for (int32_t pi = i - 1; pi >= 0; --pi)
-				GLSHADER_DELETE_VALID( glshaders[pi] );
-
+			LOGE("GLShader({0}) - Failed to load {1} source.", name.c_str(), ToString(GLSHADER_STAGES[i]).c_str());
 			return false;
 		}
 	}
 
+	// Program Binary Cache Key...
+	if (GLShaderCache::IsEnabled())
+	{
+		std::vector<std::string> sources(buildSources, buildSources + GLSHADER_NUM_STAGES);
+		buildKey = GLShaderCache::ComputeKey(sources);
+	}
+
+	isBuildPrepared = true;
+	return true;
+}
+
+
+void GLShader::BeginBuild()
+{
+	RAVEN_ASSERT(buildProgram == 0, "GLShader - BeginBuild() called twice.");
+
+	if (!isBuildPrepared)
+		return;
+
+	isBuildFromCache = false;
+
+	// Program Binary Cache...
+	if (GLShaderCache::IsEnabled() && LoadBinary(buildKey))
+	{
+		isBuildFromCache = true;
+		return;
+	}
+
+	// Compile all stages, the compile status is only checked in FinishBuild() so drivers
+	// that compile in parallel are not forced to wait.
+	for (int32_t i = 0; i < GLSHADER_NUM_STAGES; ++i)
+	{
+		if (buildSources[i].empty())
+			continue;
+
+		buildStages[i] = glCreateShader((GLENUM)GLSHADER_STAGES[i]);
+		const char* srcData = buildSources[i].data();
+		glShaderSource(buildStages[i], 1, &srcData, NULL);
+		glCompileShader(buildStages[i]);
+	}
+
 
 	// Program...
-	id = glCreateProgram();
+	buildProgram = glCreateProgram();
 
 	// Attach Valid Stages
-	for (GLUINT i = 0; i < 5; ++i)
-		GLSHADER_ATTACH_VALID(id, glshaders[i]);
+	for (int32_t i = 0; i < GLSHADER_NUM_STAGES; ++i)
+		GLSHADER_ATTACH_VALID(buildProgram, buildStages[i]);
 
-	glLinkProgram(id); // Link...
+	if (GLShaderCache::IsEnabled())
+		glProgramParameteri(buildProgram, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+
+	glLinkProgram(buildProgram); // Link...
+}
+
+
+bool GLShader::IsBuildComplete() const
+{
+	if (buildProgram == 0 || !(GLEW_KHR_parallel_shader_compile || GLEW_ARB_parallel_shader_compile))
+		return true;
+
+	int result = GL_TRUE;
+	glGetProgramiv(buildProgram, GL_COMPLETION_STATUS_KHR, &result);
+
+	return result == GL_TRUE;
+}
+
+
+bool GLShader::FinishBuild()
+{
+	if (!isBuildPrepared)
+		return false;
+
+	isBuildPrepared = false;
+
+	// Loaded from the cache in BeginBuild().
+	if (isBuildFromCache)
+		return true;
 
 	int result;
-	glGetProgramiv(id, GL_LINK_STATUS, &result);
+	glGetProgramiv(buildProgram, GL_LINK_STATUS, &result);
 
 	// Link Success?
 	if (result != GL_TRUE)
 	{
+		// Log Stage Errors...
+		for (int32_t i = 0; i < GLSHADER_NUM_STAGES; ++i)
+		{
+			if (buildStages[i] != 0)
+				LogStageErrors(GLSHADER_STAGES[i], buildStages[i]);
+		}
+
 		// Log Error...
 		int len = 0;
-		glGetProgramiv(id, GL_INFO_LOG_LENGTH, &len);
+		glGetProgramiv(buildProgram, GL_INFO_LOG_LENGTH, &len);
 		std::string log;
 		log.resize(len+1);
 
-		glGetProgramInfoLog(id, len, NULL, log.data());
+		glGetProgramInfoLog(buildProgram, len, NULL, log.data());
 		LOGE("GLShader({0}) - Failed To Link Program: \n{1}", name.c_str(), log.c_str());
 
-		glDeleteProgram(id);
-		id = prevID;
+		glDeleteProgram(buildProgram);
 	}
 	else
 	{
 		// Delete old program...
-		if (prevID != 0)
+		if (id != 0)
 		{
-			glDeleteProgram(prevID);
+			glDeleteProgram(id);
 		}
+
+		id = buildProgram;
+		ResolveUniformLocations();
+
+		if (GLShaderCache::IsEnabled())
+			SaveBinary(buildKey);
 	}
 
 	// Cleanup...
-	for (GLUINT i = 0; i < 5; ++i)
-		GLSHADER_DELETE_VALID( glshaders[i] );
+	for (int32_t i = 0; i < GLSHADER_NUM_STAGES; ++i)
+	{
+		GLSHADER_DELETE_VALID( buildStages[i] );
+		buildStages[i] = 0;
+	}
 
+	buildProgram = 0;
 	return result == GL_TRUE;
 }
 
 
-GLUINT GLShader::BuildStage(EGLShaderStage stage)
+bool GLShader::LoadBinary(uint64_t cacheKey)
 {
-	// 
-	std::string src;
-	LoadSource(stage, src);
+	uint32_t format = 0;
+	std::vector<uint8_t> binary;
+
+	if (!GLShaderCache::Load(cacheKey, format, binary))
+		return false;
+
+	GLUINT programID = glCreateProgram();
+	glProgramBinary(programID, format, binary.data(), (GLsizei)binary.size());
+
+	int result;
+	glGetProgramiv(programID, GL_LINK_STATUS, &result);
+
+	// The driver may reject binaries even with a matching key, e.g. after an update, build from source.
+	if (result != GL_TRUE)
+	{
+		glDeleteProgram(programID);
+		return false;
+	}
+
+	// Delete old program...
+	if (id != 0)
+	{
+		glDeleteProgram(id);
+	}
 
-	// Failed to load source?
-	if (src.empty())
+	id = programID;
+	ResolveUniformLocations();
+
+	return true;
+}
+
+
+void GLShader::SaveBinary(uint64_t cacheKey)
+{
+	int len = 0;
+	glGetProgramiv(id, GL_PROGRAM_BINARY_LENGTH, &len);
+
+	if (len <= 0)
+		return;
+
+	std::vector<uint8_t> binary(len);
+	GLENUM format = 0;
+	glGetProgramBinary(id, len, NULL, &format, binary.data());
+
+	if (!GLShaderCache::Save(cacheKey, format, binary))
 	{
-		LOGE("GLShader({0}) - Failed to load {1} source.", name.c_str(), ToString(stage).c_str());
-		return 0;
+		LOGW("GLShader({0}) - Failed to save program binary.", name.c_str());
 	}
+}
 
-	// Build...
-	int shaderID = glCreateShader((GLENUM)stage);
-	const char* srcData = src.data();
-	glShaderSource(shaderID, 1, &srcData, NULL);
-	glCompileShader(shaderID);
 
+void GLShader::LogStageErrors(EGLShaderStage stage, GLUINT shaderID)
+{
 	int val = 0;
 	glGetShaderiv(shaderID, GL_COMPILE_STATUS, &val);
 
 	// Success?
 	if (val == GL_TRUE)
-		return shaderID;
+		return;
 
 	// Log Error...
 	int len = 0;
@@ -276,9 +428,6 @@ GLUINT GLShader::BuildStage(EGLShaderStage stage)
 
 	glGetShaderInfoLog(shaderID, len, NULL, log.data());
 	LOGE("GLShader({0}) - Failed To Compile {1}: \n{2}", name.c_str(), ToString(stage).c_str(), log.c_str());
-
-	glDeleteShader(shaderID);
-	return 0;
 }
 
 
@@ -366,57 +515,175 @@ void GLShader::Use()
 }
 
 
+GLUniformID GLShader::GetUniformID(const std::string& name)
+{
+	auto iter = uniformIDs.find(name);
+
+	if (iter != uniformIDs.end())
+		return iter->second;
+
+	GLUniformID newID = (GLUniformID)uniformNames.size();
+	uniformIDs.emplace(name, newID);
+	uniformNames.push_back(name);
+
+	return newID;
+}
+
+
+int32_t GLShader::GetUniformLocation(const std::string& name) const
+{
+	auto iter = uniformLocations.find(name);
+	return iter != uniformLocations.end() ? iter->second : -1;
+}
+
+
+int32_t GLShader::GetUniformLocation(GLUniformID uniformID)
+{
+	// Resolve ids registered after the last resolve.
+	if (uniformID >= (GLUniformID)idLocations.size())
+	{
+		size_t first = idLocations.size();
+		idLocations.resize(uniformNames.size());
+
+		for (size_t i = first; i < idLocations.size(); ++i)
+			idLocations[i] = GetUniformLocation(uniformNames[i]);
+	}
+
+	return idLocations[uniformID];
+}
+
+
+void GLShader::ResolveUniformLocations()
+{
+	uniformLocations.clear();
+	idLocations.clear();
+
+	int numUniforms = 0;
+	int maxLength = 0;
+	glGetProgramiv(id, GL_ACTIVE_UNIFORMS, &numUniforms);
+	glGetProgramiv(id, GL_ACTIVE_UNIFORM_MAX_LENGTH, &maxLength);
+
+	std::vector<char> nameBuffer(maxLength + 1);
+
+	for (int i = 0; i < numUniforms; ++i)
+	{
+		GLsizei length = 0;
+		GLint size = 0;
+		GLenum type = 0;
+		glGetActiveUniform(id, i, (GLsizei)nameBuffer.size(), &length, &size, &type, nameBuffer.data());
+
+		std::string uniformName(nameBuffer.data(), length);
+		int loc = glGetUniformLocation(id, uniformName.c_str());
+
+		// Uniform block members have no location.
+		if (loc == -1)
+			continue;
+
+		uniformLocations[uniformName] = loc;
+
+		// Arrays are reported by their first element, add the array name and the rest of the elements.
+		if (uniformName.size() > 3 && uniformName.compare(uniformName.size() - 3, 3, "[0]") == 0)
+		{
+			std::string arrayName = uniformName.substr(0, uniformName.size() - 3);
+			uniformLocations[arrayName] = loc;
+
+			for (int e = 1; e < size; ++e)
+			{
+				std::string elemName = arrayName + "[" + std::to_string(e) + "]";
+				uniformLocations[elemName] = glGetUniformLocation(id, elemName.c_str());
+			}
+		}
+	}
+}
+
+
 void GLShader::SetUniform(const std::string& name, const float& value)
 {
-	int loc = glGetUniformLocation(id, name.c_str());
-	glUniform1f(loc, value);
+	glUniform1f(GetUniformLocation(name), value);
 }
 
 
 void GLShader::SetUniform(const std::string& name, const int& value)
 {
-	int loc = glGetUniformLocation(id, name.c_str());
-	glUniform1i(loc, value);
+	glUniform1i(GetUniformLocation(name), value);
 }
 
 
 void GLShader::SetUniform(const std::string& name, const glm::vec2& value)
 {
-	int loc = glGetUniformLocation(id, name.c_str());
-	glUniform2f(loc, value.x, value.y);
+	glUniform2f(GetUniformLocation(name), value.x, value.y);
 }
 
 
 void GLShader::SetUniform(const std::string& name, const glm::vec3& value)
 {
-	int loc = glGetUniformLocation(id, name.c_str());
-	glUniform3f(loc, value.x, value.y, value.z);
+	glUniform3f(GetUniformLocation(name), value.x, value.y, value.z);
 }
 
 
 void GLShader::SetUniform(const std::string& name, const glm::vec4& value)
 {
-	int loc = glGetUniformLocation(id, name.c_str());
-	glUniform4f(loc, value.x, value.y, value.z, value.w);
+	glUniform4f(GetUniformLocation(name), value.x, value.y, value.z, value.w);
 }
 
 
 void GLShader::SetUniform(const std::string& name, const glm::mat4& value)
 {
-	int loc = glGetUniformLocation(id, name.c_str());
-	glUniformMatrix4fv(loc, 1, GL_FALSE, glm::value_ptr(value));
+	glUniformMatrix4fv(GetUniformLocation(name), 1, GL_FALSE, glm::value_ptr(value));
 }
 
 
 void GLShader::SetUniform(const std::string& name, const glm::mat3& value)
 {
-	int loc = glGetUniformLocation(id, name.c_str());
+	int loc = GetUniformLocation(name);
 	RAVEN_ASSERT(loc != -1, "Invalid Unifrom Name.");
 
 	glUniformMatrix3fv(loc, 1, GL_FALSE, glm::value_ptr(value));
 }
 
 
+void GLShader::SetUniform(GLUniformID uniformID, const float& value)
+{
+	glUniform1f(GetUniformLocation(uniformID), value);
+}
+
+
+void GLShader::SetUniform(GLUniformID uniformID, const int& value)
+{
+	glUniform1i(GetUniformLocation(uniformID), value);
+}
+
+
+void GLShader::SetUniform(GLUniformID uniformID, const glm::vec2& value)
+{
+	glUniform2f(GetUniformLocation(uniformID), value.x, value.y);
+}
+
+
+void GLShader::SetUniform(GLUniformID uniformID, const glm::vec3& value)
+{
+	glUniform3f(GetUniformLocation(uniformID), value.x, value.y, value.z);
+}
+
+
+void GLShader::SetUniform(GLUniformID uniformID, const glm::vec4& value)
+{
+	glUniform4f(GetUniformLocation(uniformID), value.x, value.y, value.z, value.w);
+}
+
+
+void GLShader::SetUniform(GLUniformID uniformID, const glm::mat4& value)
+{
+	glUniformMatrix4fv(GetUniformLocation(uniformID), 1, GL_FALSE, glm::value_ptr(value));
+}
+
+
+void GLShader::SetUniform(GLUniformID uniformID, const glm::mat3& value)
+{
+	glUniformMatrix3fv(GetUniformLocation(uniformID), 1, GL_FALSE, glm::value_ptr(value));
+}
+
+
 void GLShader::BindUniformBlock(const std::string& blockName, int binding)
 {
 	int blockIdx = glGetUniformBlockIndex(id, blockName.c_str());
@@ -31,6 +31,13 @@
 #include <string>
 #include <vector>
 #include <set>
+#include <unordered_map>
+
+
+
+
+// The number of shader stages in a program.
+#define GLSHADER_NUM_STAGES 5
 
 
 
@@ -39,6 +46,10 @@
 
 namespace Raven
 {
+	// The id of a uniform name, shared by all shaders and valid even if a shader is rebuilt.
+	typedef int32_t GLUniformID;
+
+
 	// Code for a specific shader stage, could be code or file.
 	struct GLShaderCode
 	{
@@ -76,6 +87,9 @@ namespace Raven
 		// Return the program id of this shader.
 		inline GLUINT GetID() { return id; }
 
+		// Return the name of this shader.
+		inline const std::string& GetName() const { return name; }
+
 		// Create a GLShader.
 		static GLShader* Create(const std::string& name);
 
@@ -100,8 +114,24 @@ namespace Raven
 		void RemovePreprocessor(const std::string& def);
 
 		// Build Shader - OpenGL Program.
+		// Same as calling PrepareBuild(), BeginBuild() then FinishBuild().
 		bool Build();
 
+		// Load & assemble the sources of all stages, does not use OpenGL so it can run on a worker thread.
+		// @return false if a source failed to load.
+		bool PrepareBuild();
+
+		// Load the program from the binary cache or start compiling & linking the prepared sources.
+		void BeginBuild();
+
+		// Return true if the program started by BeginBuild() finished linking, always true if the
+		// driver doesn't support parallel shader compile.
+		bool IsBuildComplete() const;
+
+		// Finish the build started by BeginBuild(), this wait for the driver if the build is not complete.
+		// @return true if the program was built, the old program is kept if the build failed.
+		bool FinishBuild();
+
 		// Use this shader's program. Make it the current one.
 		void Use();
 
@@ -130,13 +160,40 @@ namespace Raven
 		void SetUniform(const std::string& name, const glm::mat4& value);
 		void SetUniform(const std::string& name, const glm::mat3& value);
 
+		// Set a Uniform value using its id, no string lookups.
+		// Note: This assume that this program is the current one.
+		void SetUniform(GLUniformID uniformID, const float& value);
+		void SetUniform(GLUniformID uniformID, const int& value);
+		void SetUniform(GLUniformID uniformID, const glm::vec2& value);
+		void SetUniform(GLUniformID uniformID, const glm::vec3& value);
+		void SetUniform(GLUniformID uniformID, const glm::vec4& value);
+		void SetUniform(GLUniformID uniformID, const glm::mat4& value);
+		void SetUniform(GLUniformID uniformID, const glm::mat3& value);
+
+		// Return the id of a uniform name, the same name always return the same id.
+		static GLUniformID GetUniformID(const std::string& name);
+
+		// Return the location of a uniform in this program, -1 if the program has no such active uniform.
+		int32_t GetUniformLocation(const std::string& name) const;
+		int32_t GetUniformLocation(GLUniformID uniformID);
+
 		// Bind Uniform buffer to this shader uniform block.
 		// Note: This assume that this program is the current one.
 		void BindUniformBlock(const std::string& blockName, int binding);
 
 	private:
-		// Build a shader stage
-		GLUINT BuildStage(EGLShaderStage stage);
+		// Log the compile errors of a shader stage.
+		void LogStageErrors(EGLShaderStage stage, GLUINT shaderID);
+
+		// Create the program from a binary in the shader cache.
+		// @return false if the binary was not found or rejected by the driver.
+		bool LoadBinary(uint64_t cacheKey);
+
+		// Save the linked program binary to the shader cache.
+		void SaveBinary(uint64_t cacheKey);
+
+		// Query the locations of all active uniforms after linking the program.
+		void ResolveUniformLocations();
 
 		// Load all the source of a shader stage.
 		bool LoadSource(EGLShaderStage stage, std::string& loadedSrc);
@@ -161,6 +218,28 @@ namespace Raven
 		// for example "#define COMPUTE_MATERIAL 0"
 		std::set<std::string> preprocessor;
 
+		// The assembled source of each stage, set by PrepareBuild().
+		std::string buildSources[GLSHADER_NUM_STAGES];
+
+		// The program binary cache key of the build sources.
+		uint64_t buildKey;
+
+		// The stages & program of the build in progress.
+		GLUINT buildStages[GLSHADER_NUM_STAGES];
+		GLUINT buildProgram;
+
+		// True if PrepareBuild() succeeded and the build was not finished.
+		bool isBuildPrepared;
+
+		// True if BeginBuild() loaded the program from the binary cache.
+		bool isBuildFromCache;
+
+		// The location of each active uniform name, resolved once after linking.
+		std::unordered_map<std::string, int32_t> uniformLocations;
+
+		// The location of each uniform id, resolved from the names on first use.
+		std::vector<int32_t> idLocations;
+
 	};
 
 }
@@ -0,0 +1,211 @@
+/*
+ * Developed by Raven Group at the University  of Leeds
+ * Copyright (C) 2021 Ammar Herzallah, Ben Husle, Thomas Moreno Cooper, Sulagna Sinha & Tian Zeng
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3 of the License.
+ *
+ * THIS PROGRAM IS DISTRIBUTED IN THE HOPE THAT IT WILL BE USEFUL,
+ * BUT WITHOUT ANY WARRANTY; WITHOUT EVEN THE IMPLIED WARRANTY OF
+ * MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE.  SEE THE
+ * GNU GENERAL PUBLIC LICENSE FOR MORE DETAILS.
+ */
+#include "GLShaderCache.h"
+#include "Logger/Console.h"
+#include "Utilities/Hash.h"
+
+
+#include <fstream>
+#include <filesystem>
+#include <cstdio>
+
+
+
+
+namespace Raven {
+
+
+
+
+// The first bytes of a program binary file.
+static constexpr uint32_t GLSHADER_CACHE_MAGIC = 0x42535652; // "RVSB"
+
+
+// The header of a program binary file.
+struct GLShaderCacheHeader
+{
+	uint32_t magic;
+	uint32_t version;
+	uint64_t key;
+	uint32_t format;
+	uint32_t size;
+	uint64_t checksum;
+};
+
+
+// The state of the cache.
+static bool cacheEnabled = false;
+static std::string cacheDirectory;
+static std::string cacheDriver;
+
+
+
+
+void GLShaderCache::Enable(const std::string& directory, const std::string& driver)
+{
+	std::error_code ec;
+	std::filesystem::create_directories(directory, ec);
+
+	if (ec)
+	{
+		LOGW("GLShaderCache - Failed to create the cache directory {0}, cache disabled.", directory.c_str());
+		cacheEnabled = false;
+		return;
+	}
+
+	cacheEnabled = true;
+	cacheDirectory = directory;
+	cacheDriver = driver;
+}
+
+
+void GLShaderCache::Disable()
+{
+	cacheEnabled = false;
+}
+
+
+bool GLShaderCache::IsEnabled()
+{
+	return cacheEnabled;
+}
+
+
+uint64_t GLShaderCache::ComputeKey(const std::vector<std::string>& sources)
+{
+	return ComputeKey(sources, cacheDriver);
+}
+
+
+uint64_t GLShaderCache::ComputeKey(const std::vector<std::string>& sources, const std::string& driver)
+{
+	uint64_t hash = HASH_OFFSET_BASIS;
+	uint32_t version = GLSHADER_CACHE_VERSION;
+	hash = HashBytes(hash, &version, sizeof(uint32_t));
+
+	// Hash the size before each string, so moving text between strings changes the key.
+	uint64_t size = driver.size();
+	hash = HashBytes(hash, &size, sizeof(uint64_t));
+	hash = HashBytes(hash, driver.data(), driver.size());
+
+	for (const auto& src : sources)
+	{
+		size = src.size();
+		hash = HashBytes(hash, &size, sizeof(uint64_t));
+		hash = HashBytes(hash, src.data(), src.size());
+	}
+
+	return hash;
+}
+
+
+bool GLShaderCache::Load(uint64_t key, uint32_t& outFormat, std::vector<uint8_t>& outBinary)
+{
+	if (!cacheEnabled)
+		return false;
+
+	return ReadFile(GetFilePath(cacheDirectory, key), key, outFormat, outBinary);
+}
+
+
+bool GLShaderCache::Save(uint64_t key, uint32_t format, const std::vector<uint8_t>& binary)
+{
+	if (!cacheEnabled)
+		return false;
+
+	return WriteFile(GetFilePath(cacheDirectory, key), key, format, binary);
+}
+
+
+std::string GLShaderCache::GetFilePath(const std::string& directory, uint64_t key)
+{
+	char name[32];
+	snprintf(name, sizeof(name), "%016llx.bin", (unsigned long long)key);
+
+	return directory + "/" + name;
+}
+
+
+bool GLShaderCache::WriteFile(const std::string& path, uint64_t key, uint32_t format, const std::vector<uint8_t>& binary)
+{
+	GLShaderCacheHeader header;
+	header.magic = GLSHADER_CACHE_MAGIC;
+	header.version = GLSHADER_CACHE_VERSION;
+	header.key = key;
+	header.format = format;
+	header.size = (uint32_t)binary.size();
+	header.checksum = HashBytes(HASH_OFFSET_BASIS, binary.data(), binary.size());
+
+	// Write to a temporary file first, so a failed write never leaves a truncated binary behind.
+	std::string tmpPath = path + ".tmp";
+
+	std::ofstream fs(tmpPath.c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+
+	if (!fs.is_open())
+		return false;
+
+	fs.write((const char*)&header, sizeof(GLShaderCacheHeader));
+	fs.write((const char*)binary.data(), binary.size());
+	fs.close();
+
+	std::error_code ec;
+
+	if (fs.good())
+		std::filesystem::rename(tmpPath, path, ec);
+
+	// Failed? don't leave the temporary file behind.
+	if (!fs.good() || ec)
+	{
+		std::filesystem::remove(tmpPath, ec);
+		return false;
+	}
+
+	return true;
+}
+
+
+bool GLShaderCache::ReadFile(const std::string& path, uint64_t key, uint32_t& outFormat, std::vector<uint8_t>& outBinary)
+{
+	std::ifstream fs(path.c_str(), std::ios::in | std::ios::binary);
+
+	if (!fs.is_open())
+		return false;
+
+	GLShaderCacheHeader header;
+	fs.read((char*)&header, sizeof(GLShaderCacheHeader));
+
+	// Invalid Header?
+	if (!fs.good() || header.magic != GLSHADER_CACHE_MAGIC || header.version != GLSHADER_CACHE_VERSION
+		|| header.key != key || header.size == 0)
+	{
+		return false;
+	}
+
+	outBinary.resize(header.size);
+	fs.read((char*)outBinary.data(), header.size);
+
+	// Truncated or Corrupted?
+	if ((size_t)fs.gcount() != header.size
+		|| HashBytes(HASH_OFFSET_BASIS, outBinary.data(), outBinary.size()) != header.checksum)
+	{
+		outBinary.clear();
+		return false;
+	}
+
+	outFormat = header.format;
+	return true;
+}
+
+
+} // End of namespace Raven.
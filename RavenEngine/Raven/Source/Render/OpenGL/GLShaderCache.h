@@ -0,0 +1,84 @@
+/*
+ * Developed by Raven Group at the University  of Leeds
+ * Copyright (C) 2021 Ammar Herzallah, Ben Husle, Thomas Moreno Cooper, Sulagna Sinha & Tian Zeng
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3 of the License.
+ *
+ * THIS PROGRAM IS DISTRIBUTED IN THE HOPE THAT IT WILL BE USEFUL,
+ * BUT WITHOUT ANY WARRANTY; WITHOUT EVEN THE IMPLIED WARRANTY OF
+ * MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE.  SEE THE
+ * GNU GENERAL PUBLIC LICENSE FOR MORE DETAILS.
+ */
+#pragma once
+
+
+
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+
+
+
+// The directory of the shader program binaries.
+#define GLSHADER_CACHE_DIRECTORY "cache/shaders"
+
+// The version of the binary file format, files with a different version are ignored.
+#define GLSHADER_CACHE_VERSION 1
+
+
+
+
+
+namespace Raven
+{
+
+
+	// GLShaderCache:
+	//		- On-disk cache of linked shader program binaries, keyed by a hash of the final sources of
+	//		  all stages (defines included) and the driver string, so any change to a shader or driver
+	//		  results in a new key.
+	//		- Only the key & file format are handled here, it does not use OpenGL.
+	//
+	class GLShaderCache
+	{
+	public:
+		// Enable the cache for this driver.
+		// @param directory: the directory of the binary files, created if it doesn't exist.
+		// @param driver: string that identify the driver, binaries are only valid for the driver that created them.
+		static void Enable(const std::string& directory, const std::string& driver);
+
+		// Disable the cache.
+		static void Disable();
+
+		// Return true if the cache is enabled.
+		static bool IsEnabled();
+
+		// Compute the cache key of shader sources for the current driver.
+		static uint64_t ComputeKey(const std::vector<std::string>& sources);
+
+		// Compute the cache key of shader sources for a driver.
+		static uint64_t ComputeKey(const std::vector<std::string>& sources, const std::string& driver);
+
+		// Load a program binary from the cache.
+		// @return false if the key is not in the cache or its file is invalid.
+		static bool Load(uint64_t key, uint32_t& outFormat, std::vector<uint8_t>& outBinary);
+
+		// Save a program binary to the cache.
+		static bool Save(uint64_t key, uint32_t format, const std::vector<uint8_t>& binary);
+
+		// Return the path of the file of a key in a directory.
+		static std::string GetFilePath(const std::string& directory, uint64_t key);
+
+		// Write a program binary file.
+		static bool WriteFile(const std::string& path, uint64_t key, uint32_t format, const std::vector<uint8_t>& binary);
+
+		// Read a program binary file, fail if the file doesn't match the key, version or its checksum.
+		static bool ReadFile(const std::string& path, uint64_t key, uint32_t& outFormat, std::vector<uint8_t>& outBinary);
+	};
+
+}
+
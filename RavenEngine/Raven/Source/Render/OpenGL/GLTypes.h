@@ -45,6 +45,7 @@ namespace Raven
 		Int = 0x1404,
 
 		Float = 0x1406,
+		HalfFloat = 0x140B,
 		Double = 0x140A
 	};
 
@@ -57,7 +58,9 @@ namespace Raven
 		None = 0x0500,
 		Array = 0x8892,
 		Element = 0x8893,
-		Uniform = 0x8A11
+		Uniform = 0x8A11,
+		DrawIndirect = 0x8F3F,
+		ShaderStorage = 0x90D2
 	};
 
 
@@ -64,7 +64,7 @@ void GLVertexArray::Build(const std::vector<GLVABuildAttribData>& data, const GL
 			vd.index,
 			vd.size,
 			(GLENUM)vd.type,
-			GL_FALSE,
+			vd.normalized ? GL_TRUE : GL_FALSE,
 			vd.stride,
 			(void*)(std::ptrdiff_t)vd.offset);
 
@@ -34,7 +34,7 @@ namespace Raven
 		GLVABuildAttribData(
 			const GLBuffer* inBuffer,
 			GLUINT inIndex, int inSize, EGLTypes inType,
-			int inStride, int inOffset, int inInstance = 0 )
+			int inStride, int inOffset, int inInstance = 0, bool inNormalized = false )
 			: buffer(inBuffer)
 			, index(inIndex)
 			, size(inSize)
@@ -42,6 +42,7 @@ namespace Raven
 			, stride(inStride)
 			, offset(inOffset)
 			, instance(inInstance)
+			, normalized(inNormalized)
 		{
 
 		}
@@ -67,6 +68,9 @@ namespace Raven
 
 		// Instancing 
 		int instance;
+
+		// If true integer data is normalized to [-1, 1] for signed types or [0, 1] for unsigned types.
+		bool normalized;
 	};
 
 
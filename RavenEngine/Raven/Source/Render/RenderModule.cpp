@@ -27,8 +27,10 @@
 #include "RenderTarget.h"
 #include "RenderPipeline.h"
 #include "RenderTexFilter.h"
+#include "RenderShaderCompiler.h"
 #include "Render/RenderResource/Shader/RenderRscShader.h"
 #include "Render/RenderResource/Shader/UniformBuffer.h"
+#include "Render/RenderResource/Shader/MaterialUniformBuffer.h"
 #include "Render/RenderResource/RenderRscTexture.h"
 #include "RenderObjects/RenderScene.h"
 #include "RenderObjects/RenderPass.h"
@@ -38,6 +40,7 @@
 
 #include "OpenGL/GLContext.h"
 #include "OpenGL/GLShader.h"
+#include "OpenGL/GLShaderCache.h"
 #include "OpenGL/GLFrameBuffer.h"
 #include "OpenGL/GLVertexArray.h"
 #include "OpenGL/GLRenderBuffer.h"
@@ -109,6 +112,26 @@ void RenderModule::Initialize()
 	// We are only using one context, so make it current.
 	context->MakeCurrent(); 
 
+	// Program binary cache, only if the driver supports at least one binary format.
+	GLint numBinaryFormats = 0;
+	glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &numBinaryFormats);
+
+	if (numBinaryFormats > 0)
+	{
+		std::string driver = std::string((const char*)glGetString(GL_VENDOR)) + "|"
+			+ (const char*)glGetString(GL_RENDERER) + "|"
+			+ (const char*)glGetString(GL_VERSION);
+
+		GLShaderCache::Enable(GLSHADER_CACHE_DIRECTORY, driver);
+	}
+
+	// Shader Compiler.
+	shaderCompiler = Ptr<RenderShaderCompiler>(new RenderShaderCompiler());
+	shaderCompiler->Initialize();
+
+	// Materials Paramters.
+	materialBuffer = Ptr<MaterialUniformBuffer>(MaterialUniformBuffer::Create(MATERIAL_UNIFORM_BUFFER_INITIAL_SIZE));
+
 	// Setup Render Debug.
 	rdebug->Setup();
 
@@ -159,6 +182,9 @@ void RenderModule::Initialize()
 
 void RenderModule::Destroy()
 {
+	// Finish all shader builds, their shaders may be destroyed after the module.
+	shaderCompiler->Flush();
+
 	// Destroy Debug Render.
 	rdebug->Destroy();
 	
@@ -196,6 +222,9 @@ void RenderModule::BeginRender(Scene* scene, const glm::ivec2& extent)
 	if (rtScene->IsDirty())
 		rtScene->Update();
 
+	// Finish the shaders that are done building.
+	shaderCompiler->Update();
+
 
 	// ~TESTING-------------------------------------------------------
 #if CAPTURE_SHOT != 0
@@ -221,6 +250,9 @@ void RenderModule::BeginRender(Scene* scene, const glm::ivec2& extent)
 
 	// Build Render Data form the scene...
 	rscene->Build(scene);
+
+	// Upload the materials paramters that changed while building.
+	materialBuffer->Update();
 }
 
 
@@ -367,6 +399,9 @@ void RenderModule::CreateDefaultMaterials()
 
 		defaultMaterials.meshInstance = mat;
 	}
+
+	// The default materials are the fallback of materials still being built, they must be ready.
+	shaderCompiler->Flush();
 }
 
 
@@ -38,6 +38,8 @@ namespace Raven
 	class Scene;
 	class RenderPipeline;
 	class RenderTexFilter;
+	class RenderShaderCompiler;
+	class MaterialUniformBuffer;
 	class RenderRscMaterial;
 	class Material;
 	class RenderRscTexture;
@@ -88,6 +90,9 @@ namespace Raven
 		// Return render debug.
 		inline RenderDebug* GetDebug() { return rdebug.get(); }
 
+		// Return the main render scene, used to set render settings & read the stats of the last frame.
+		inline RenderScene* GetRenderScene() { return rscene.get(); }
+
 		// Return the final render texture target of the scene.
 		RenderTarget* GetSceneRT() { return rtScene.get(); }
 
@@ -97,6 +102,12 @@ namespace Raven
 		//  Return default materails.
 		inline const RenderDefaultMaterials& GetDefaultMaterials() { return defaultMaterials; }
 
+		// Return the shader compiler, used to build material shaders in the background.
+		inline RenderShaderCompiler* GetShaderCompiler() { return shaderCompiler.get(); }
+
+		// Return the uniform buffer shared by all materials paramters.
+		inline const Ptr<MaterialUniformBuffer>& GetMaterialBuffer() { return materialBuffer; }
+
 	public:
 		// Update render.
 		void Update(float dt);
@@ -148,6 +159,12 @@ namespace Raven
 		// The Engine Render Texture Filter, used to filter textures.
 		Ptr<RenderTexFilter> rfilter;
 
+		// Build material shaders in the background.
+		Ptr<RenderShaderCompiler> shaderCompiler;
+
+		// The uniform buffer shared by all materials paramters.
+		Ptr<MaterialUniformBuffer> materialBuffer;
+
 		// if true will render to window with the exact size as the window.
 		bool isRTToWindow;
 
@@ -54,7 +54,8 @@ void RenderDebugPrimitive::SetDebugMesh(RenderRscDebugMesh* prim)
 
 void RenderDebugPrimitive::Draw(GLShader* shader, bool isShadow) const
 {
-	shader->SetUniform("color", color);
+	static const GLUniformID colorID = GLShader::GetUniformID("color");
+	shader->SetUniform(colorID, color);
 
 	mesh->GetArray()->Bind();
 	glDrawElements(GL_TRIANGLES, (GLsizei)mesh->GetNumIndices(), GL_UNSIGNED_INT, nullptr);
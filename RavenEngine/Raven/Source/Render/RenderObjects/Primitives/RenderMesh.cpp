@@ -52,7 +52,13 @@ RenderRscPrimitive* RenderMesh::GetRsc()
 void RenderMesh::Draw(GLShader* shader, bool isShadow) const
 {
 	mesh->GetArray()->Bind();
-	glDrawElements(GL_TRIANGLES, mesh->GetNumIndices(), GL_UNSIGNED_INT, nullptr);
+	glDrawElements(GL_TRIANGLES, mesh->GetNumIndices(), mesh->GetIndexType(), nullptr);
+}
+
+
+uint32_t RenderMesh::GetNumTriangles() const
+{
+	return (uint32_t)mesh->GetNumIndices() / 3;
 }
 
 
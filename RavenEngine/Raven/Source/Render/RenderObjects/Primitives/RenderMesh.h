@@ -45,6 +45,9 @@ namespace Raven
 		// Draw Mesh.
 		void Draw(GLShader* shader, bool isShadow) const override;
 
+		// Return the number of triangles in the mesh.
+		virtual uint32_t GetNumTriangles() const override;
+
 		// Return Expected Domain of this primitive.
 		inline virtual ERenderShaderDomain GetDomain() { return ERenderShaderDomain::Mesh; }
 
@@ -26,7 +26,10 @@ namespace Raven {
 
 RenderPrimitive::RenderPrimitive()
 	: material(nullptr)
+	, lights(nullptr)
+	, numLights(0)
 	, indexInScene(-1)
+	, transformOffset(-1)
 	, isSkinned(false)
 {
 
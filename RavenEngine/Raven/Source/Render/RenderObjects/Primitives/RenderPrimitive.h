@@ -71,11 +71,17 @@ namespace Raven
 		// Draw ths Primitive.
 		virtual void Draw(GLShader* shader, bool isShadow) const = 0;
 
-		// Add a light that is going to lit this primitive.
-		inline void AddLight(uint32_t lightIndex) { lights.push_back(lightIndex); }
+		// Return the number of triangles drawn by this primitive, used for statistics.
+		virtual uint32_t GetNumTriangles() const { return 0; }
+
+		// Set the lights that are going to lit this primitive, the indices are owned by the render scene frame arena.
+		inline void SetLights(const uint32_t* lightIndices, uint32_t count) { lights = lightIndices; numLights = count; }
 
 		// Return the lighst that are going to lit this primitive.
-		inline const std::vector<uint32_t>& GetLights() const { return lights; }
+		inline const uint32_t* GetLights() const { return lights; }
+
+		// Return the number of lights that are going to lit this primitive.
+		inline uint32_t GetNumLights() const { return numLights; }
 
 		// Render Shader Domain from the material set to this primitive.
 		ERenderShaderDomain GetMaterialDomain() const;
@@ -100,11 +106,17 @@ namespace Raven
 		glm::mat4 normalMatrix;
 
 		// Lights that lit that is used to lit this primitive.
-		std::vector<uint32_t> lights;
+		const uint32_t* lights;
+
+		// The number of lights in the lights list.
+		uint32_t numLights;
 
 		// Used by RenderScene, the index of this primitive in the render scene.
 		int32_t indexInScene;
 
+		// Used by RenderScene, the offset of this primitive transform in the frame transform buffer.
+		int32_t transformOffset;
+
 	protected:
 		// True if this is a skinned primitive.
 		bool isSkinned;
@@ -56,4 +56,10 @@ void RenderSkinnedMesh::Draw(GLShader* shader, bool isShadow) const
 }
 
 
+uint32_t RenderSkinnedMesh::GetNumTriangles() const
+{
+	return (uint32_t)mesh->GetNumIndices() / 3;
+}
+
+
 } // End of namespace Raven.
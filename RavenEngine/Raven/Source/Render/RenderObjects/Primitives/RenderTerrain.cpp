@@ -122,6 +122,7 @@ void RenderTerrain::Draw(GLShader* shader, bool isShadow) const
 
 RenderTerrainFoliage::RenderTerrainFoliage()
 	: instanceRsc(nullptr)
+	, shadowCascade(0)
 {
 
 }
@@ -146,16 +147,9 @@ RenderRscPrimitive* RenderTerrainFoliage::GetRsc()
 }
 
 
-void RenderTerrainFoliage::SetInstanceCount(int32_t inCount)
-{
-	count = inCount;
-}
-
-
 void RenderTerrainFoliage::Draw(GLShader* shader, bool isShadow) const
 {
-	instanceRsc->GetArray()->Bind();
-	glDrawElementsInstanced(GL_TRIANGLES, instanceRsc->GetNumIndices(), GL_UNSIGNED_INT, nullptr, count);
+	instanceRsc->DrawIndirect(isShadow ? GetShadowInstanceList(shadowCascade) : ERenderInstanceList::View);
 }
 
 
@@ -87,10 +87,10 @@ namespace Raven
 		// Set the terrain render resource to render.
 		void SetMeshRsc(RenderRscMeshInstance* rsc);
 
-		// Number of instance meshes to draw.
-		void SetInstanceCount(int32_t inCount);
+		// Set the shadow cascade this primitive is drawn into.
+		inline void SetShadowCascade(uint32_t cascade) { shadowCascade = cascade; }
 
-		// Draw the mesh instances.
+		// Draw the mesh instances, the view or shadow cascade instance ranges of the resource.
 		virtual void Draw(GLShader* shader, bool isShadow) const override;
 
 		// Return Expected Domain of this primitive.
@@ -100,8 +100,8 @@ namespace Raven
 		// Mesh Instance Resrouce.
 		RenderRscMeshInstance* instanceRsc;
 
-		// Number of instance to draw.
-		int32_t count;
+		// The shadow cascade this primitive is drawn into.
+		uint32_t shadowCascade;
 	};
 
 
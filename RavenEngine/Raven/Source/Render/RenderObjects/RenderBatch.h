@@ -18,14 +18,13 @@
 #include "Render/RenderResource/Shader/RenderRscShader.h"
 #include "Render/RenderResource/Shader/RenderRscMaterial.h"
 #include "Render/RenderObjects/Primitives/RenderPrimitive.h"
+#include "Render/RenderObjects/RenderRadixSort.h"
 
 
 
 
-#include <cstdlib>
+#include <cstring>
 #include <vector>
-#include <array>
-#include <unordered_map>
 
 
 
@@ -57,54 +56,88 @@ namespace Raven
 
 
 
+	// A single draw in a batch.
+	struct RenderBatchDraw
+	{
+		// The sort key, see MakeRenderBatchKey().
+		uint64_t key;
 
+		// The primitive to draw.
+		RenderPrimitive* primitive;
 
-	// --- -- --- -- --- -- --- -- --- -- --- -- --- -- --- -- --- -- --- -- --- -- --- -- --- -- 
+		// The shader to draw with.
+		RenderRscShader* shader;
 
+		// The material to draw with.
+		RenderRscMaterial* material;
+	};
 
 
 
+	// The number of draws & state changes made while drawing batches.
+	struct RenderBatchStats
+	{
+		// The number of draw calls.
+		uint32_t draws;
 
+		// The number of times a different shader was bound.
+		uint32_t shaderChanges;
 
+		// The number of times a different material was bound.
+		uint32_t materialChanges;
 
-	// RenderBatch<Deferred>
-	//		- Store primitive for deferred rendering pass.
-	//		- sort objects based material & shader.
-	//
-	template<>
-	class RenderBatch<ERenderBatchType::Deferred>
-	{
-		// Invlaid Index for shader & materail batches.
-		const uint32_t INVALID_BATCH_INDEX = (uint32_t)-1;
+		// The number of times a draw used a different mesh than the previous draw.
+		uint32_t meshChanges;
 
-		// Represent a shader in this batch.
-		struct ShaderBatch
+		// Reset all stats.
+		inline void Reset()
 		{
-			// The index in the batch list.
-			uint32_t index;
+			draws = 0;
+			shaderChanges = 0;
+			materialChanges = 0;
+			meshChanges = 0;
+		}
+	};
 
-			// The shader.
-			RenderRscShader* shader;
 
-			// List of materials that is part of this shader.
-			std::vector<uint32_t> materials;
-		};
 
+	// Make the sort key of a draw, from the most significant bits:
+	//		- pass (4 bits): two-sided draws after the others so face culling changes once.
+	//		- shader (12 bits), material (16 bits), mesh (16 bits): the sort ids of the draw resources.
+	//		- depth (16 bits): the high bits of the squared view distance, positive floats sort as integers.
+	inline uint64_t MakeRenderBatchKey(const RenderRscShader* shader, const RenderRscMaterial* material,
+		const RenderRscPrimitive* mesh, float viewDist2)
+	{
+		uint32_t depthBits;
+		std::memcpy(&depthBits, &viewDist2, sizeof(float));
 
-		// Represent a material in this batch.
-		struct MaterialBatch
-		{
-			// The index in the batch list.
-			uint32_t index;
+		return ((uint64_t)(shader->IsTwoSided() ? 1 : 0) << 60)
+			| ((uint64_t)(shader->sortId & ((1u << RENDER_SORT_ID_SHADER_BITS) - 1)) << 48)
+			| ((uint64_t)(material->sortId & ((1u << RENDER_SORT_ID_MATERIAL_BITS) - 1)) << 32)
+			| ((uint64_t)(mesh->sortId & ((1u << RENDER_SORT_ID_MESH_BITS) - 1)) << 16)
+			| (uint64_t)(depthBits >> 16);
+	}
 
-			// The material.
-			RenderRscMaterial* material;
 
-			// List of primitives that use this material.
-			std::vector<uint32_t> primitives;
-		};
 
 
+
+
+	// --- -- --- -- --- -- --- -- --- -- --- -- --- -- --- -- --- -- --- -- --- -- --- -- --- -- 
+
+
+
+
+
+
+
+	// RenderBatch<Deferred>
+	//		- Store primitive for deferred rendering pass.
+	//		- sort draws by their key, pass then shader, material, mesh & front to back depth.
+	//
+	template<>
+	class RenderBatch<ERenderBatchType::Deferred>
+	{
 	public:
 		// Construct.
 		inline RenderBatch()
@@ -115,102 +148,39 @@ namespace Raven
 		// Rest/Clear the batch.
 		inline void Reset()
 		{
-			// Clear Index.
-			for (auto& elem : shaders)
-				elem.shader->renderBatchIndex = INVALID_BATCH_INDEX;
-
-			// Clear Index.
-			for (auto& elem : materials)
-				elem.material->renderBatchIndex = INVALID_BATCH_INDEX;
-
-			shaders.clear();
-			materials.clear();
-			primitives.clear();
+			draws.clear();
 		}
 
 		// Add new primitive to the batch to be drawn.
-		inline void Add(RenderPrimitive* prim)
+		// @param viewDist2: the squared distance of the primitive from the view.
+		inline void Add(RenderPrimitive* prim, float viewDist2)
 		{
-			// Add to the list.
-			uint32_t primIndex = primitives.size();
-			primitives.push_back(prim);
-
-			// Add to the material batch.
-			MaterialBatch* matBatch = FindOrCreateMaterail(prim->GetMaterial());
-			matBatch->primitives.push_back(primIndex);
+			RenderBatchDraw draw;
+			draw.primitive = prim;
+			draw.material = prim->GetMaterial();
+			draw.shader = draw.material->GetShaderRsc();
+			draw.key = MakeRenderBatchKey(draw.shader, draw.material, prim->GetRsc(), viewDist2);
+			draws.push_back(draw);
 		}
 
-		// Return the number of shaders batches to render.
-		inline uint32_t GetNumShaders() const { return shaders.size(); }
-
-		// Return a shader batch to render.
-		inline const ShaderBatch& GetShaderBatch(uint32_t index) const { return shaders[index]; }
-
-		// Return a material batch to render.
-		inline const MaterialBatch& GetMaterialBatch(uint32_t index) const { return materials[index]; }
-
-		// Return all primitives in this entire batch.
-		inline const std::vector<RenderPrimitive*>& GetPrimitives() const { return primitives; }
-
-		// Return true if the batch has no primitives to draw.
-		bool IsEmpty() { return primitives.empty(); }
-
-	private:
-		// Find if there is a batch created for the shader, if not create a new one.
-		inline ShaderBatch* FindOrCreateShader(RenderRscShader* shader)
+		// Sort the draws by their keys.
+		inline void Sort()
 		{
-			// Exist?
-			if (shader->renderBatchIndex != INVALID_BATCH_INDEX)
-			{
-				return &shaders[shader->renderBatchIndex];
-			}
-
-			// New...
-			ShaderBatch newShaderBatch;
-			newShaderBatch.index = shaders.size();
-			newShaderBatch.shader = shader;
-			shaders.push_back(newShaderBatch);
-
-			// Map...
-			shader->renderBatchIndex = newShaderBatch.index;
-
-			return &shaders[newShaderBatch.index];
+			RenderRadixSort(draws, scratch);
 		}
 
-		// Find if there is a batch created for the material, if not create a new one.
-		inline MaterialBatch* FindOrCreateMaterail(RenderRscMaterial* mat)
-		{
-			// Exist?
-			if (mat->renderBatchIndex != INVALID_BATCH_INDEX)
-			{
-				return &materials[mat->renderBatchIndex];
-			}
-
-			// New...
-			MaterialBatch newMatBatch;
-			newMatBatch.index = materials.size();
-			newMatBatch.material = mat;
-			materials.push_back(newMatBatch);
-	
-			// Add to shader batch.
-			ShaderBatch* shaderBatch = FindOrCreateShader(mat->GetShaderRsc());
-			shaderBatch->materials.push_back(newMatBatch.index);
+		// Return all the draws in this batch, sorted after calling Sort().
+		inline const std::vector<RenderBatchDraw>& GetDraws() const { return draws; }
 
-			// Map...
-			mat->renderBatchIndex = newMatBatch.index;
-
-			return &materials[newMatBatch.index];
-		}
+		// Return true if the batch has no primitives to draw.
+		bool IsEmpty() { return draws.empty(); }
 
 	private:
-		// The shaders the primitives materials are part of.
-		std::vector<ShaderBatch> shaders;
-
-		// The materials the primitives are using.
-		std::vector<MaterialBatch> materials;
+		// The draws of this batch.
+		std::vector<RenderBatchDraw> draws;
 
-		// The primitives this batch is drawing.
-		std::vector<RenderPrimitive*> primitives;
+		// Scratch memory used for sorting.
+		std::vector<RenderBatchDraw> scratch;
 	};
 
 
@@ -221,9 +191,9 @@ namespace Raven
 
 
 
-	// RenderBatch<Deferred>
+	// RenderBatch<Translucent>
 	//		- Store primitive for translucent rendering pass.
-	//		- sort objects based distance from view.
+	//		- sort objects based distance from view, back to front.
 	//
 	template<>
 	class RenderBatch<ERenderBatchType::Translucent>
@@ -231,11 +201,11 @@ namespace Raven
 		// Primtive in this batch.
 		struct PrimitiveElem
 		{
+			// The sort key, the inverted bits of the squared distance from the view so far primitives come first.
+			uint32_t key;
+
 			// The primitive to render.
 			RenderPrimitive* primitive;
-
-			// Distance from the view.
-			float distance;
 		};
 
 	public:
@@ -252,24 +222,23 @@ namespace Raven
 		}
 
 		// Add new primitive to the batch to be drawn.
+		// @param distance: the squared distance of the primitive from the view.
 		inline void Add(RenderPrimitive* prim, float distance)
 		{
+			// Positive floats sort as integers.
+			uint32_t distanceBits;
+			std::memcpy(&distanceBits, &distance, sizeof(float));
+
 			PrimitiveElem elem;
+			elem.key = ~distanceBits;
 			elem.primitive = prim;
-			elem.distance = distance;
 			primitives.push_back(elem);
 		}
 
 		// Sort render primitives based on their distance from the view.
 		inline void Sort()
 		{
-			// Quicksort...
-			std::qsort(
-				primitives.data(), 
-				primitives.size(),
-				sizeof(PrimitiveElem),
-				&RenderBatch<ERenderBatchType::Translucent>::ComparePrimitiveElem
-			);
+			RenderRadixSort(primitives, scratch);
 		}
 
 		// Return true if the batch has no primitives to draw.
@@ -278,21 +247,12 @@ namespace Raven
 		// Return all primitives in this batch.
 		inline const std::vector<PrimitiveElem>& GetPrimitives() const { return primitives; }
 
-	private:
-		// Compare two primitive element based on distance.
-		inline static int ComparePrimitiveElem(const void* p1, const void* p2)
-		{
-			const auto* e1 = static_cast<const PrimitiveElem*>(p1);
-			const auto* e2 = static_cast<const PrimitiveElem*>(p2);
-
-			return e1->distance > e2->distance ? -1 : 1;
-		}
-
-
 	private:
 		// The primitives this batch is drawing.
 		std::vector<PrimitiveElem> primitives;
 
+		// Scratch memory used for sorting.
+		std::vector<PrimitiveElem> scratch;
 	};
 
 
@@ -301,211 +261,90 @@ namespace Raven
 
 
 
-	// RenderBatch<Default>
-	//		- Store primitive for shadow map rendering, if the primitive have custom shadow shader
-	//      store in a shader batch.
+	// RenderBatch<Shadow>
+	//		- Store primitive for shadow map rendering, primitives that have no custom shadow shader
+	//		  are drawn with the default material of their domain.
+	//		- sort draws by their key, pass then shader, material & mesh.
 	// 
 	template<>
 	class RenderBatch<ERenderBatchType::Shadow>
 	{
-	public:
-		// Represent a shader in this batch.
-		struct ShaderBatch
-		{
-			// The index in the batch list.
-			uint32_t index;
-
-			// The shader.
-			RenderRscShader* shader;
-
-			// List of materials that is part of this shader.
-			std::vector<uint32_t> materials;
-
-			// The domain of the shadow shader, used to identify default shader types.
-			ERenderShaderDomain domain;
-		};
-
-
-		// Represent a material in this batch.
-		struct MaterialBatch
-		{
-			// The index in the batch list.
-			uint32_t index;
-
-			// The material.
-			RenderRscMaterial* material;
-
-			// List of primitives that use this material.
-			std::vector<uint32_t> primitives;
-		};
-
-
 	public:
 		// Construct.
 		inline RenderBatch()
 		{
-			// Default shader from primitives that has no custom shader for shadows.
-			SetupDefaultBatches();
-
+			defaultMaterials[0] = nullptr;
+			defaultMaterials[1] = nullptr;
+			defaultMaterials[2] = nullptr;
 		}
 
 		// Rest/Clear the batch.
 		inline void Reset()
 		{
-			matMap.clear();
-			shaderMap.clear();
-			primitives.clear();
-			shaders.resize(3);
-			materials.resize(3);
+			draws.clear();
+		}
 
-			for (size_t i = 0; i < 3; ++i)
-			{
-				materials[i].primitives.clear();
-			}
+		// Set the default materials used to draw the primitives of each domain without a custom shadow shader.
+		inline void SetDefaultMaterials(RenderRscMaterial* mesh, RenderRscMaterial* skinned, RenderRscMaterial* terrain)
+		{
+			defaultMaterials[0] = mesh;
+			defaultMaterials[1] = skinned;
+			defaultMaterials[2] = terrain;
 		}
 
 		// Add new primitive to the batch to be drawn.
 		inline void Add(RenderPrimitive* prim, bool isDefault)
 		{
-			// Add to the list.
-			uint32_t primIndex = primitives.size();
-			primitives.push_back(prim);
+			RenderRscMaterial* material = prim->GetMaterial();
 
 			// Use default shader shaders?
-			if (!prim->GetMaterial()->GetShadowShaderRsc() || isDefault)
+			if (!material->GetShadowShaderRsc() || isDefault)
 			{
 				switch (prim->GetDomain())
 				{
 				case Raven::ERenderShaderDomain::Mesh:
-					materials[0].primitives.push_back(primIndex);
+					material = defaultMaterials[0];
 					break;
 				case Raven::ERenderShaderDomain::Skinned:
-					materials[1].primitives.push_back(primIndex);
+					material = defaultMaterials[1];
 					break;
 				case Raven::ERenderShaderDomain::Terrain:
-					materials[2].primitives.push_back(primIndex);
+					material = defaultMaterials[2];
 					break;
+				default:
+					return;
 				}
 			}
-			else
-			{
-				// Add to the material batch.
-				MaterialBatch* matBatch = FindOrCreateMaterail(prim->GetMaterial());
-				matBatch->primitives.push_back(primIndex);
-			}
-		}
-
-		// Return the number of shaders batches to render.
-		inline uint32_t GetNumShaders() const { return shaders.size(); }
-
-		// Return a shader batch to render.
-		inline const ShaderBatch& GetShaderBatch(uint32_t index) const { return shaders[index]; }
-
-		// Return a material batch to render.
-		inline const MaterialBatch& GetMaterialBatch(uint32_t index) const { return materials[index]; }
-
-		// Return all primitives in this entire batch.
-		inline const std::vector<RenderPrimitive*>& GetPrimitives() const { return primitives; }
 
-		// Return true if the batch has no primitives to draw.
-		inline bool IsEmpty() { return primitives.empty(); }
-
-		// Set deafult materail and its shader.
-		inline void SetDefaultShader(uint32_t index, RenderRscShader* defaultShader, RenderRscMaterial* defaultMaterial)
-		{
-			shaders[index].shader = defaultShader;
-			materials[index].material = defaultMaterial;
-		}
-
-	private:
-		// Default shader from primitives that has no custom shader for shadows.
-		inline void SetupDefaultBatches()
-		{
-			materials.resize(3);
-			shaders.resize(3);
-
-			ERenderShaderDomain domains[3] = {
-				ERenderShaderDomain::Mesh,
-				ERenderShaderDomain::Skinned,
-				ERenderShaderDomain::Terrain
-			};
-
-
-			for (size_t i = 0; i < 3; ++i)
-			{
-				shaders[i].index = i;
-				shaders[i].materials.push_back(i);
-				shaders[i].shader = nullptr;
-				shaders[i].domain = domains[i];
-
-				materials[i].index = i;
-				materials[i].material = nullptr;
-			}
+			RenderBatchDraw draw;
+			draw.primitive = prim;
+			draw.material = material;
+			draw.shader = material->GetShadowShaderRsc();
+			draw.key = MakeRenderBatchKey(draw.shader, draw.material, prim->GetRsc(), 0.0f);
+			draws.push_back(draw);
 		}
 
-
-		// Find if there is a batch created for the shader, if not create a new one.
-		inline ShaderBatch* FindOrCreateShader(RenderRscShader* shader)
+		// Sort the draws by their keys.
+		inline void Sort()
 		{
-			// Exist?
-			if (shaderMap.count(shader))
-			{
-				return &shaders[ shaderMap[shader] ];
-			}
-
-			// New...
-			ShaderBatch newShaderBatch;
-			newShaderBatch.index = shaders.size();
-			newShaderBatch.shader = shader;
-			shaders.push_back(newShaderBatch);
-
-			// Map...
-			shaderMap[shader] = newShaderBatch.index;
-
-			return &shaders[newShaderBatch.index];
+			RenderRadixSort(draws, scratch);
 		}
 
-		// Find if there is a batch created for the material, if not create a new one.
-		inline MaterialBatch* FindOrCreateMaterail(RenderRscMaterial* mat)
-		{
-			// Exist?
-			if (matMap.count(mat))
-			{
-				return &materials[ matMap[mat] ];
-			}
-
-			// New...
-			MaterialBatch newMatBatch;
-			newMatBatch.index = materials.size();
-			newMatBatch.material = mat;
-			materials.push_back(newMatBatch);
-
-			// Add to custom shader batch.
-			ShaderBatch* shaderBatch = FindOrCreateShader(mat->GetShadowShaderRsc());
-			shaderBatch->materials.push_back(newMatBatch.index);
-
-			// Map...
-			matMap[mat] = newMatBatch.index;
-
-			return &materials[newMatBatch.index];
-		}
+		// Return all the draws in this batch, sorted after calling Sort().
+		inline const std::vector<RenderBatchDraw>& GetDraws() const { return draws; }
 
+		// Return true if the batch has no primitives to draw.
+		inline bool IsEmpty() { return draws.empty(); }
 
 	private:
-		// Map materials to their index in the materials batches list.
-		std::unordered_map<RenderRscMaterial*, uint32_t> matMap;
-
-		// Map shader to their index in the shaders batches list.
-		std::unordered_map<RenderRscShader*, uint32_t> shaderMap;
+		// The default materials of the mesh, skinned & terrain domains.
+		RenderRscMaterial* defaultMaterials[3];
 
-		// The shaders the primitives materials are part of.
-		std::vector<ShaderBatch> shaders;
+		// The draws of this batch.
+		std::vector<RenderBatchDraw> draws;
 
-		// The materials the primitives are using.
-		std::vector<MaterialBatch> materials;
-
-		// The primitives this batch is drawing.
-		std::vector<RenderPrimitive*> primitives;
+		// Scratch memory used for sorting.
+		std::vector<RenderBatchDraw> scratch;
 	};
 
 
@@ -0,0 +1,114 @@
+/*
+ * Developed by Raven Group at the University  of Leeds
+ * Copyright (C) 2021 Ammar Herzallah, Ben Husle, Thomas Moreno Cooper, Sulagna Sinha & Tian Zeng
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3 of the License.
+ *
+ * THIS PROGRAM IS DISTRIBUTED IN THE HOPE THAT IT WILL BE USEFUL,
+ * BUT WITHOUT ANY WARRANTY; WITHOUT EVEN THE IMPLIED WARRANTY OF
+ * MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE.  SEE THE
+ * GNU GENERAL PUBLIC LICENSE FOR MORE DETAILS.
+ */
+#include "RenderFrameArena.h"
+
+
+#include <algorithm>
+#include <cstdlib>
+
+
+
+
+namespace Raven {
+
+
+
+RenderFrameArena::RenderFrameArena(size_t inBlockSize)
+	: current(0)
+	, blockSize(inBlockSize)
+	, usedSize(0)
+	, frameHeapAllocations(0)
+	, totalHeapAllocations(0)
+{
+
+}
+
+
+RenderFrameArena::~RenderFrameArena()
+{
+	for (auto& block : blocks)
+		free(block.data);
+}
+
+
+void* RenderFrameArena::Allocate(size_t size, size_t alignment)
+{
+	// Find a block that fits the allocation, starting from the current one...
+	for (;;)
+	{
+		if (current < blocks.size())
+		{
+			Block& block = blocks[current];
+
+			// Align the address not the offset.
+			uintptr_t base = reinterpret_cast<uintptr_t>(block.data);
+			uintptr_t addr = (base + block.offset + alignment - 1) & ~(uintptr_t)(alignment - 1);
+			size_t offset = (size_t)(addr - base);
+
+			if (offset + size <= block.size)
+			{
+				usedSize += (offset - block.offset) + size;
+				block.offset = offset + size;
+				return block.data + offset;
+			}
+
+			// Doesn't fit, try the next one.
+			++current;
+			continue;
+		}
+
+		// No more blocks, we have to grow.
+		NewBlock(size + alignment);
+	}
+}
+
+
+void RenderFrameArena::NewBlock(size_t minSize)
+{
+	Block newBlock;
+	newBlock.size = std::max(blockSize, minSize);
+	newBlock.data = static_cast<uint8_t*>( malloc(newBlock.size) );
+	newBlock.offset = 0;
+	RAVEN_ASSERT(newBlock.data, "RenderFrameArena - Failed to allocate a new block.");
+
+	blocks.push_back(newBlock);
+	++frameHeapAllocations;
+	++totalHeapAllocations;
+}
+
+
+void RenderFrameArena::Reset()
+{
+	for (auto& block : blocks)
+		block.offset = 0;
+
+	current = 0;
+	usedSize = 0;
+	frameHeapAllocations = 0;
+}
+
+
+size_t RenderFrameArena::GetCapacity() const
+{
+	size_t capacity = 0;
+
+	for (const auto& block : blocks)
+		capacity += block.size;
+
+	return capacity;
+}
+
+
+
+} // End of namespace Raven.
@@ -0,0 +1,126 @@
+/*
+ * Developed by Raven Group at the University  of Leeds
+ * Copyright (C) 2021 Ammar Herzallah, Ben Husle, Thomas Moreno Cooper, Sulagna Sinha & Tian Zeng
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3 of the License.
+ *
+ * THIS PROGRAM IS DISTRIBUTED IN THE HOPE THAT IT WILL BE USEFUL,
+ * BUT WITHOUT ANY WARRANTY; WITHOUT EVEN THE IMPLIED WARRANTY OF
+ * MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE.  SEE THE
+ * GNU GENERAL PUBLIC LICENSE FOR MORE DETAILS.
+ */
+#pragma once
+
+
+
+#include "Utilities/Core.h"
+
+
+#include <vector>
+#include <new>
+#include <utility>
+#include <type_traits>
+
+
+
+// The default size of a single arena memory block.
+#define RENDER_FRAME_ARENA_BLOCK_SIZE (1024 * 1024)
+
+
+
+
+namespace Raven
+{
+
+	// RenderFrameArena:
+	//		- Linear allocator for render data that only lives for a single frame.
+	//		- Memory blocks are kept between frames, Reset() only rewinds them, so once the arena
+	//		  has grown to fit a frame it stops allocating from the heap.
+	//		- The arena never calls destructors, the owner is responsible for destroying its objects.
+	//
+	class RenderFrameArena
+	{
+		NOCOPYABLE(RenderFrameArena);
+
+		// A single memory block of the arena.
+		struct Block
+		{
+			// The block memory.
+			uint8_t* data;
+
+			// The size of the block in bytes.
+			size_t size;
+
+			// The current allocation offset in the block.
+			size_t offset;
+		};
+
+	public:
+		// Construct.
+		// @param inBlockSize: the size of each block allocated by the arena.
+		RenderFrameArena(size_t inBlockSize = RENDER_FRAME_ARENA_BLOCK_SIZE);
+
+		// Destruct.
+		~RenderFrameArena();
+
+		// Allocate aligned memory from the arena.
+		void* Allocate(size_t size, size_t alignment);
+
+		// Allocate and construct a new object in the arena.
+		template<class T, typename...Args>
+		inline T* New(Args&&... args)
+		{
+			void* mem = Allocate(sizeof(T), alignof(T));
+			return new (mem) T(std::forward<Args>(args)...);
+		}
+
+		// Allocate an uninitialized array in the arena, only used for trivial types.
+		template<class T>
+		inline T* NewArray(size_t count)
+		{
+			static_assert(std::is_trivially_destructible<T>::value, "Arena arrays must be trivially destructible.");
+			return static_cast<T*>( Allocate(sizeof(T) * count, alignof(T)) );
+		}
+
+		// Rewind all the blocks, invalidating every allocation made since the last reset.
+		void Reset();
+
+		// Return the number of heap allocations made by the arena since the last reset.
+		inline uint32_t GetFrameHeapAllocations() const { return frameHeapAllocations; }
+
+		// Return the total number of heap allocations made by the arena.
+		inline uint32_t GetTotalHeapAllocations() const { return totalHeapAllocations; }
+
+		// Return the number of bytes used since the last reset.
+		inline size_t GetUsedSize() const { return usedSize; }
+
+		// Return the total size of all blocks allocated by the arena.
+		size_t GetCapacity() const;
+
+	private:
+		// Allocate a new block that can hold at least the size.
+		void NewBlock(size_t minSize);
+
+	private:
+		// The memory blocks of the arena.
+		std::vector<Block> blocks;
+
+		// The current block we allocate from.
+		uint32_t current;
+
+		// The size of each new block.
+		size_t blockSize;
+
+		// The number of bytes used since the last reset.
+		size_t usedSize;
+
+		// Number of heap allocations since the last reset.
+		uint32_t frameHeapAllocations;
+
+		// Total number of heap allocations.
+		uint32_t totalHeapAllocations;
+	};
+
+}
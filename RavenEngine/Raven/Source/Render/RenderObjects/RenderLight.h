@@ -26,6 +26,17 @@ namespace Raven
 	class RenderPrimitive;
 
 
+
+	// The types of render lights, matches the light types in Lighting.glsl.
+	enum class ERenderLightType : int32_t
+	{
+		Invalid = 0,
+		Directional = 1,
+		Spot = 2,
+		Point = 3
+	};
+
+
 	// RenderLight:
 	//		- 
 	class RenderLight
@@ -52,6 +63,9 @@ namespace Raven
 		// Return the type of the light.
 		inline int32_t GetType() const { return type; }
 
+		// Set the type of the light, lights collected from the scene have their type set by RenderScene.
+		inline void SetType(ERenderLightType inType) { type = (int32_t)inType; }
+
 	public:
 		// General Light Data.
 		float radius;
@@ -0,0 +1,221 @@
+/*
+ * Developed by Raven Group at the University  of Leeds
+ * Copyright (C) 2021 Ammar Herzallah, Ben Husle, Thomas Moreno Cooper, Sulagna Sinha & Tian Zeng
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3 of the License.
+ *
+ * THIS PROGRAM IS DISTRIBUTED IN THE HOPE THAT IT WILL BE USEFUL,
+ * BUT WITHOUT ANY WARRANTY; WITHOUT EVEN THE IMPLIED WARRANTY OF
+ * MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE.  SEE THE
+ * GNU GENERAL PUBLIC LICENSE FOR MORE DETAILS.
+ */
+#include "RenderLightClusters.h"
+#include "RenderLight.h"
+
+
+#include "glm/common.hpp"
+#include "glm/exponential.hpp"
+
+
+
+
+namespace Raven {
+
+
+
+
+RenderLightClusters::RenderLightClusters()
+	: near(-1.0f)
+	, far(-1.0f)
+	, sliceScale(0.0f)
+	, tanHalfFov(1.0f)
+{
+	cells.resize(GetNumClusters());
+}
+
+
+void RenderLightClusters::ComputeSlices(float inNear, float inFar)
+{
+	if (near == inNear && far == inFar)
+		return;
+
+	near = inNear;
+	far = inFar;
+	sliceScale = (float)RENDER_LIGHT_CLUSTER_Z / glm::log(far / near);
+
+	for (int32_t i = 0; i <= RENDER_LIGHT_CLUSTER_Z; ++i)
+	{
+		sliceDepths[i] = near * glm::pow(far / near, (float)i / (float)RENDER_LIGHT_CLUSTER_Z);
+	}
+}
+
+
+int32_t RenderLightClusters::GetSlice(float depth) const
+{
+	int32_t slice = (int32_t)(glm::log(glm::max(depth, near) / near) * sliceScale);
+	return glm::clamp(slice, 0, RENDER_LIGHT_CLUSTER_Z - 1);
+}
+
+
+uint32_t RenderLightClusters::GetClusterIndex(const glm::vec2& ndc, float depth) const
+{
+	glm::vec2 uv = glm::clamp(ndc * 0.5f + 0.5f, 0.0f, 0.9999f);
+	uint32_t tx = (uint32_t)(uv.x * RENDER_LIGHT_CLUSTER_X);
+	uint32_t ty = (uint32_t)(uv.y * RENDER_LIGHT_CLUSTER_Y);
+	uint32_t tz = (uint32_t)GetSlice(depth);
+
+	return tx + (ty + tz * RENDER_LIGHT_CLUSTER_Y) * RENDER_LIGHT_CLUSTER_X;
+}
+
+
+void RenderLightClusters::Build(const std::vector<RenderLight*>& inLights, const glm::mat4& view, const glm::mat4& projection,
+	float inNear, float inFar)
+{
+	ComputeSlices(inNear, inFar);
+	tanHalfFov = glm::vec2(1.0f / projection[0][0], 1.0f / projection[1][1]);
+
+	lights.resize(inLights.size());
+	refs.clear();
+
+	for (uint32_t i = 0; i < (uint32_t)inLights.size(); ++i)
+	{
+		const RenderLight* light = inLights[i];
+
+		RenderLightClusterLight& data = lights[i];
+		data.dir = glm::vec4(light->dir, 0.0f);
+		data.pos = glm::vec4(light->postion, 0.0f);
+		data.power = light->colorAndPower;
+		data.data = glm::vec4((float)light->GetType(), light->innerAngle, light->outerAngle, light->radius);
+
+		switch ((ERenderLightType)light->GetType())
+		{
+		// Directional lights affect all clusters.
+		case ERenderLightType::Directional:
+			for (uint32_t c = 0; c < GetNumClusters(); ++c)
+				refs.push_back(glm::uvec2(c, i));
+
+			break;
+
+		// Spot & Point lights, spot lights are bound by the sphere of their radius.
+		case ERenderLightType::Spot:
+		case ERenderLightType::Point:
+		{
+			glm::vec3 center = view * glm::vec4(light->postion, 1.0f);
+			center.z = -center.z; // View Depth.
+			AddLight(i, center, light->radius);
+		}
+			break;
+
+		default:
+			break;
+		}
+	}
+
+
+	// Count the lights of each cluster...
+	for (auto& cell : cells)
+		cell = glm::uvec2(0);
+
+	for (const auto& ref : refs)
+		++cells[ref.x].y;
+
+	// Offset of each cluster into the indices list...
+	uint32_t offset = 0;
+
+	for (auto& cell : cells)
+	{
+		cell.x = offset;
+		offset += cell.y;
+		cell.y = 0;
+	}
+
+	// Fill the indices, stay in the same order as the lights.
+	indices.resize(refs.size());
+
+	for (const auto& ref : refs)
+	{
+		glm::uvec2& cell = cells[ref.x];
+		indices[cell.x + cell.y] = ref.y;
+		++cell.y;
+	}
+}
+
+
+void RenderLightClusters::AddLight(uint32_t lightIndex, const glm::vec3& center, float radius)
+{
+	// Depth range of the light in the view.
+	float minDepth = glm::max(center.z - radius, near);
+	float maxDepth = glm::min(center.z + radius, far);
+
+	if (minDepth > maxDepth)
+		return;
+
+	// Conservative screen bounds of the light box between its min & max depth.
+	glm::vec2 minNDC(1.0f);
+	glm::vec2 maxNDC(-1.0f);
+
+	for (int32_t i = 0; i < 4; ++i)
+	{
+		float depth = (i & 1) ? maxDepth : minDepth;
+		float side = (i & 2) ? radius : -radius;
+		glm::vec2 ndc = (glm::vec2(center) + side) / (depth * tanHalfFov);
+
+		minNDC = glm::min(minNDC, ndc);
+		maxNDC = glm::max(maxNDC, ndc);
+	}
+
+	if (minNDC.x > 1.0f || minNDC.y > 1.0f || maxNDC.x < -1.0f || maxNDC.y < -1.0f)
+		return;
+
+	const glm::ivec2 tileCount(RENDER_LIGHT_CLUSTER_X, RENDER_LIGHT_CLUSTER_Y);
+	glm::ivec2 minTile = glm::clamp(glm::ivec2(glm::floor((minNDC * 0.5f + 0.5f) * glm::vec2(tileCount))), glm::ivec2(0), tileCount - 1);
+	glm::ivec2 maxTile = glm::clamp(glm::ivec2(glm::floor((maxNDC * 0.5f + 0.5f) * glm::vec2(tileCount))), glm::ivec2(0), tileCount - 1);
+	int32_t minSlice = GetSlice(minDepth);
+	int32_t maxSlice = GetSlice(maxDepth);
+
+	const glm::vec2 tileSize = 2.0f / glm::vec2(tileCount);
+	const float radius2 = radius * radius;
+
+	for (int32_t z = minSlice; z <= maxSlice; ++z)
+	{
+		float depth0 = sliceDepths[z];
+		float depth1 = sliceDepths[z + 1];
+		float dz = glm::max(glm::max(depth0 - center.z, center.z - depth1), 0.0f);
+
+		for (int32_t y = minTile.y; y <= maxTile.y; ++y)
+		{
+			// The view space bounds of the cluster along y, the tile widen with depth.
+			float ndc0 = -1.0f + y * tileSize.y;
+			float ndc1 = ndc0 + tileSize.y;
+			float minY = glm::min(ndc0 * depth0, ndc0 * depth1) * tanHalfFov.y;
+			float maxY = glm::max(ndc1 * depth0, ndc1 * depth1) * tanHalfFov.y;
+			float dy = glm::max(glm::max(minY - center.y, center.y - maxY), 0.0f);
+
+			float dyz2 = dy * dy + dz * dz;
+
+			if (dyz2 > radius2)
+				continue;
+
+			for (int32_t x = minTile.x; x <= maxTile.x; ++x)
+			{
+				float ndc0 = -1.0f + x * tileSize.x;
+				float ndc1 = ndc0 + tileSize.x;
+				float minX = glm::min(ndc0 * depth0, ndc0 * depth1) * tanHalfFov.x;
+				float maxX = glm::max(ndc1 * depth0, ndc1 * depth1) * tanHalfFov.x;
+				float dx = glm::max(glm::max(minX - center.x, center.x - maxX), 0.0f);
+
+				// Sphere & cluster box intersection.
+				if (dx * dx + dyz2 > radius2)
+					continue;
+
+				uint32_t cluster = x + (y + z * RENDER_LIGHT_CLUSTER_Y) * RENDER_LIGHT_CLUSTER_X;
+				refs.push_back(glm::uvec2(cluster, lightIndex));
+			}
+		}
+	}
+}
+
+
+} // End of namespace Raven.
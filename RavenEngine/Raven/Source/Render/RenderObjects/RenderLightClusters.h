@@ -0,0 +1,145 @@
+/*
+ * Developed by Raven Group at the University  of Leeds
+ * Copyright (C) 2021 Ammar Herzallah, Ben Husle, Thomas Moreno Cooper, Sulagna Sinha & Tian Zeng
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3 of the License.
+ *
+ * THIS PROGRAM IS DISTRIBUTED IN THE HOPE THAT IT WILL BE USEFUL,
+ * BUT WITHOUT ANY WARRANTY; WITHOUT EVEN THE IMPLIED WARRANTY OF
+ * MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE.  SEE THE
+ * GNU GENERAL PUBLIC LICENSE FOR MORE DETAILS.
+ */
+#pragma once
+
+
+
+#include "Utilities/Core.h"
+
+#include "glm/vec2.hpp"
+#include "glm/vec4.hpp"
+#include "glm/mat4x4.hpp"
+
+
+#include <vector>
+
+
+
+// The number of clusters along the screen width, height and view depth.
+#define RENDER_LIGHT_CLUSTER_X 16
+#define RENDER_LIGHT_CLUSTER_Y 9
+#define RENDER_LIGHT_CLUSTER_Z 24
+
+// The storage buffer bindings of the clusters data in the lighting shader.
+#define RENDER_LIGHT_CLUSTER_LIGHTS_BINDING 0
+#define RENDER_LIGHT_CLUSTER_CELLS_BINDING 1
+#define RENDER_LIGHT_CLUSTER_INDICES_BINDING 2
+
+
+
+
+namespace Raven
+{
+	class RenderLight;
+
+
+
+	// The data of a single light as stored in the lights storage buffer, matches the layout used by Lighting.glsl.
+	struct RenderLightClusterLight
+	{
+		// Direction (XYZ).
+		glm::vec4 dir;
+
+		// Position (XYZ).
+		glm::vec4 pos;
+
+		// Light Color(RGB), Power(A).
+		glm::vec4 power;
+
+		// Type(X), Inner Angle(Y), Outter Angle(Z), Radius(W).
+		glm::vec4 data;
+	};
+
+
+
+	// RenderLightClusters:
+	//		- Assign lights to the clusters (froxels) of the view frustum, the screen is split into tiles
+	//		  and the view depth into exponential slices between the near and far planes.
+	//		- Each cluster store the offset & count of its lights in a single list of light indices, so
+	//		  the lighting pass only evaluate the lights that overlap the cluster of each pixel.
+	//		- Built on the CPU without any GPU resources, the render pipeline upload the result.
+	//
+	class RenderLightClusters
+	{
+	public:
+		// Construct.
+		RenderLightClusters();
+
+		// Build the clusters of the lights.
+		// @param inLights: the lights to assign, point & spot lights are bound by their radius.
+		// @param view: the view matrix.
+		// @param projection: the perspective projection matrix.
+		// @param inNear/inFar: the near & far clipping planes of the projection.
+		void Build(const std::vector<RenderLight*>& inLights, const glm::mat4& view, const glm::mat4& projection,
+			float inNear, float inFar);
+
+		// Return the index of the cluster that contains a point.
+		// @param ndc: the xy normalized device coordinates of the point [-1, 1].
+		// @param depth: the view depth of the point.
+		uint32_t GetClusterIndex(const glm::vec2& ndc, float depth) const;
+
+		// Return the lights data, in the same order as the lights used in Build().
+		inline const std::vector<RenderLightClusterLight>& GetLights() const { return lights; }
+
+		// Return the offset(X) & count(Y) of the light indices of each cluster.
+		inline const std::vector<glm::uvec2>& GetCells() const { return cells; }
+
+		// Return the light indices of all the clusters.
+		inline const std::vector<uint32_t>& GetIndices() const { return indices; }
+
+		// Return the number of clusters.
+		static constexpr uint32_t GetNumClusters()
+		{
+			return RENDER_LIGHT_CLUSTER_X * RENDER_LIGHT_CLUSTER_Y * RENDER_LIGHT_CLUSTER_Z;
+		}
+
+	private:
+		// Compute the slice depths, only if the near & far planes changed.
+		void ComputeSlices(float inNear, float inFar);
+
+		// Return the depth slice of a view depth.
+		int32_t GetSlice(float depth) const;
+
+		// Add a light to all clusters between the min & max tiles and slices that overlap its sphere.
+		void AddLight(uint32_t lightIndex, const glm::vec3& center, float radius);
+
+	private:
+		// The data of all the lights.
+		std::vector<RenderLightClusterLight> lights;
+
+		// The offset & count of each cluster into the indices list.
+		std::vector<glm::uvec2> cells;
+
+		// The light indices of all the clusters.
+		std::vector<uint32_t> indices;
+
+		// Cluster(X) & Light(Y) pairs collected while building, kept between frames to reuse its memory.
+		std::vector<glm::uvec2> refs;
+
+		// The view depth of each slice plane.
+		float sliceDepths[RENDER_LIGHT_CLUSTER_Z + 1];
+
+		// The near & far planes the slices were computed with.
+		float near;
+		float far;
+
+		// Scale applied to the log of the depth to get its slice.
+		float sliceScale;
+
+		// The tangents of the half field of view, horizontal(X) & vertical(Y).
+		glm::vec2 tanHalfFov;
+	};
+
+}
+
@@ -0,0 +1,219 @@
+/*
+ * Developed by Raven Group at the University  of Leeds
+ * Copyright (C) 2021 Ammar Herzallah, Ben Husle, Thomas Moreno Cooper, Sulagna Sinha & Tian Zeng
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3 of the License.
+ *
+ * THIS PROGRAM IS DISTRIBUTED IN THE HOPE THAT IT WILL BE USEFUL,
+ * BUT WITHOUT ANY WARRANTY; WITHOUT EVEN THE IMPLIED WARRANTY OF
+ * MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE.  SEE THE
+ * GNU GENERAL PUBLIC LICENSE FOR MORE DETAILS.
+ */
+#include "RenderLightGrid.h"
+#include "RenderLight.h"
+
+
+#include "glm/common.hpp"
+
+
+
+
+namespace Raven {
+
+
+
+
+RenderLightGrid::RenderLightGrid()
+	: lights(nullptr)
+	, stamp(0)
+{
+	bucketOffsets.resize(RENDER_LIGHT_GRID_BUCKETS + 1, 0);
+}
+
+
+glm::ivec3 RenderLightGrid::GetCell(const glm::vec3& p)
+{
+	// Clamp before converting, a float out of the int range is undefined.
+	glm::vec3 cell = glm::clamp(glm::floor(p / RENDER_LIGHT_GRID_CELL_SIZE),
+		glm::vec3(-RENDER_LIGHT_GRID_MAX_COORD), glm::vec3(RENDER_LIGHT_GRID_MAX_COORD));
+
+	return glm::ivec3(cell);
+}
+
+
+bool RenderLightGrid::IsLargeRange(const glm::ivec3& minCell, const glm::ivec3& maxCell)
+{
+	// With clamped cells each axis count is at most 2^20 + 1, their product only fits an int64.
+	glm::ivec3 numCells = maxCell - minCell + 1;
+	return (int64_t)numCells.x * (int64_t)numCells.y * (int64_t)numCells.z > RENDER_LIGHT_GRID_MAX_CELLS;
+}
+
+
+uint32_t RenderLightGrid::GetBucket(const glm::ivec3& cell)
+{
+	uint32_t hash = ((uint32_t)cell.x * 73856093u) ^ ((uint32_t)cell.y * 19349663u) ^ ((uint32_t)cell.z * 83492791u);
+	return hash & (RENDER_LIGHT_GRID_BUCKETS - 1);
+}
+
+
+void RenderLightGrid::Build(const std::vector<RenderLight*>& inLights)
+{
+	lights = &inLights;
+	refs.clear();
+	largeLights.clear();
+	localLights.clear();
+
+	if (stamps.size() < inLights.size())
+		stamps.resize(inLights.size(), 0);
+
+	for (uint32_t i = 0; i < (uint32_t)inLights.size(); ++i)
+	{
+		const RenderLight* light = inLights[i];
+
+		// Only Spot & Point lights.
+		if (light->GetType() != (int32_t)ERenderLightType::Spot && light->GetType() != (int32_t)ERenderLightType::Point)
+			continue;
+
+		localLights.push_back(i);
+
+		glm::ivec3 minCell = GetCell(light->postion - light->radius);
+		glm::ivec3 maxCell = GetCell(light->postion + light->radius);
+
+		if (IsLargeRange(minCell, maxCell))
+		{
+			largeLights.push_back(i);
+			continue;
+		}
+
+		for (int32_t z = minCell.z; z <= maxCell.z; ++z)
+		{
+			for (int32_t y = minCell.y; y <= maxCell.y; ++y)
+			{
+				for (int32_t x = minCell.x; x <= maxCell.x; ++x)
+				{
+					refs.push_back(glm::uvec2(GetBucket(glm::ivec3(x, y, z)), i));
+				}
+			}
+		}
+	}
+
+
+	// Count the lights of each bucket, then offset of each bucket...
+	for (auto& offset : bucketOffsets)
+		offset = 0;
+
+	for (const auto& ref : refs)
+		++bucketOffsets[ref.x + 1];
+
+	for (uint32_t i = 0; i < RENDER_LIGHT_GRID_BUCKETS; ++i)
+		bucketOffsets[i + 1] += bucketOffsets[i];
+
+	// Fill the indices, each offset advance to the end of its bucket, then shifted back to the start.
+	indices.resize(refs.size());
+
+	for (const auto& ref : refs)
+	{
+		indices[bucketOffsets[ref.x]] = ref.y;
+		++bucketOffsets[ref.x];
+	}
+
+	for (uint32_t i = RENDER_LIGHT_GRID_BUCKETS; i > 0; --i)
+		bucketOffsets[i] = bucketOffsets[i - 1];
+
+	bucketOffsets[0] = 0;
+}
+
+
+uint32_t RenderLightGrid::Gather(const glm::vec3& center, float radius, uint32_t* outLights, uint32_t maxLights)
+{
+	if (!lights || maxLights == 0)
+		return 0;
+
+	if (scores.size() < maxLights)
+		scores.resize(maxLights);
+
+	++stamp;
+	uint32_t count = 0;
+
+	glm::ivec3 minCell = GetCell(center - radius);
+	glm::ivec3 maxCell = GetCell(center + radius);
+
+	// Large queries test all the lights.
+	if (IsLargeRange(minCell, maxCell))
+	{
+		for (uint32_t lightIndex : localLights)
+			GatherLight(lightIndex, center, radius, outLights, maxLights, count);
+
+		return count;
+	}
+
+
+	for (int32_t z = minCell.z; z <= maxCell.z; ++z)
+	{
+		for (int32_t y = minCell.y; y <= maxCell.y; ++y)
+		{
+			for (int32_t x = minCell.x; x <= maxCell.x; ++x)
+			{
+				uint32_t bucket = GetBucket(glm::ivec3(x, y, z));
+
+				for (uint32_t i = bucketOffsets[bucket]; i < bucketOffsets[bucket + 1]; ++i)
+					GatherLight(indices[i], center, radius, outLights, maxLights, count);
+			}
+		}
+	}
+
+	for (uint32_t lightIndex : largeLights)
+		GatherLight(lightIndex, center, radius, outLights, maxLights, count);
+
+	return count;
+}
+
+
+void RenderLightGrid::GatherLight(uint32_t lightIndex, const glm::vec3& center, float radius, uint32_t* outLights,
+	uint32_t maxLights, uint32_t& count)
+{
+	// Already tested in this gather?
+	if (stamps[lightIndex] == stamp)
+		return;
+
+	stamps[lightIndex] = stamp;
+
+	const RenderLight* light = (*lights)[lightIndex];
+	glm::vec3 v = center - light->postion;
+	float d2 = v.x * v.x + v.y * v.y + v.z * v.z;
+	float r = radius + light->radius;
+
+	// No intersection?
+	if (d2 > r * r)
+		return;
+
+	// Closer lights relative to their radius contribute more.
+	float score = d2 / (light->radius * light->radius);
+
+	if (count == maxLights)
+	{
+		// Less important than all the gathered lights?
+		if (score >= scores[count - 1])
+			return;
+
+		--count;
+	}
+
+	// Insert sorted by score.
+	uint32_t i = count;
+
+	for (; i > 0 && scores[i - 1] > score; --i)
+	{
+		scores[i] = scores[i - 1];
+		outLights[i] = outLights[i - 1];
+	}
+
+	scores[i] = score;
+	outLights[i] = lightIndex;
+	++count;
+}
+
+
+} // End of namespace Raven.
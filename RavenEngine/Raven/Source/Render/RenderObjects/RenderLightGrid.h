@@ -0,0 +1,114 @@
+/*
+ * Developed by Raven Group at the University  of Leeds
+ * Copyright (C) 2021 Ammar Herzallah, Ben Husle, Thomas Moreno Cooper, Sulagna Sinha & Tian Zeng
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3 of the License.
+ *
+ * THIS PROGRAM IS DISTRIBUTED IN THE HOPE THAT IT WILL BE USEFUL,
+ * BUT WITHOUT ANY WARRANTY; WITHOUT EVEN THE IMPLIED WARRANTY OF
+ * MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE.  SEE THE
+ * GNU GENERAL PUBLIC LICENSE FOR MORE DETAILS.
+ */
+#pragma once
+
+
+
+#include "Utilities/Core.h"
+
+#include "glm/vec2.hpp"
+#include "glm/vec3.hpp"
+
+
+#include <vector>
+
+
+
+// The size of a single grid cell in world units.
+#define RENDER_LIGHT_GRID_CELL_SIZE 16.0f
+
+// The number of hash buckets of the grid, must be a power of two.
+#define RENDER_LIGHT_GRID_BUCKETS 1024
+
+// Lights & queries that overlap more cells than this are not stored/searched in the grid.
+#define RENDER_LIGHT_GRID_MAX_CELLS 64
+
+// Cells coordinates are clamped to this range, so far away or huge lights don't overflow the cell math.
+#define RENDER_LIGHT_GRID_MAX_COORD (1 << 19)
+
+
+
+
+namespace Raven
+{
+	class RenderLight;
+
+
+
+	// RenderLightGrid:
+	//		- Spatial hash of the point & spot lights in world space, used to find the lights that
+	//		  intersect an object without testing every light in the scene.
+	//		- The lights of each bucket are stored in a single list of light indices, all the memory
+	//		  is kept between frames so building and querying stops allocating once it fits a frame.
+	//
+	class RenderLightGrid
+	{
+	public:
+		// Construct.
+		RenderLightGrid();
+
+		// Build the grid of the lights, the lights list must stay alive while querying the grid.
+		void Build(const std::vector<RenderLight*>& inLights);
+
+		// Gather the lights that intersect a sphere, if more lights are found only the closest relative
+		// to their radius are kept.
+		// @param outLights: array of at least maxLights to write the light indices into.
+		// @return the number of lights written.
+		uint32_t Gather(const glm::vec3& center, float radius, uint32_t* outLights, uint32_t maxLights);
+
+	private:
+		// Return the cell that contains a point.
+		static glm::ivec3 GetCell(const glm::vec3& p);
+
+		// Return true if the cells between min & max are more than RENDER_LIGHT_GRID_MAX_CELLS.
+		static bool IsLargeRange(const glm::ivec3& minCell, const glm::ivec3& maxCell);
+
+		// Return the hash bucket of a cell.
+		static uint32_t GetBucket(const glm::ivec3& cell);
+
+		// Test a light against the sphere of the current gather and keep it if it is important enough.
+		void GatherLight(uint32_t lightIndex, const glm::vec3& center, float radius, uint32_t* outLights,
+			uint32_t maxLights, uint32_t& count);
+
+	private:
+		// The lights the grid was built with.
+		const std::vector<RenderLight*>* lights;
+
+		// The offset of each bucket into the indices list, the last is the size of the list.
+		std::vector<uint32_t> bucketOffsets;
+
+		// The light indices of all buckets.
+		std::vector<uint32_t> indices;
+
+		// Bucket(X) & Light(Y) pairs collected while building.
+		std::vector<glm::uvec2> refs;
+
+		// Lights that overlap too many cells, tested by all gathers.
+		std::vector<uint32_t> largeLights;
+
+		// All the point & spot lights, tested by gathers that overlap too many cells.
+		std::vector<uint32_t> localLights;
+
+		// The gather stamp of each light, a light found in multiple buckets is tested once.
+		std::vector<uint32_t> stamps;
+
+		// The stamp of the current gather.
+		uint32_t stamp;
+
+		// The importance of each gathered light, lower is more important.
+		std::vector<float> scores;
+	};
+
+}
+
@@ -17,6 +17,8 @@
 #include "Primitives/RenderMesh.h"
 #include "Primitives/RenderSkinnedMesh.h"
 
+#include "ResourceManager/Resources/Mesh.h"
+
 
 
 
@@ -28,6 +30,9 @@ RenderPrimitiveCollector::RenderPrimitiveCollector(RenderScene* sceneOwner)
 	: owner(sceneOwner)
 	, worldMatrix(nullptr)
 	, normalMatrix(nullptr)
+	, viewDist(-1.0f)
+	, lodBias(1.0f)
+	, lodLevel(0)
 {
 
 }
@@ -37,6 +42,34 @@ void RenderPrimitiveCollector::Reset()
 {
 	primitive.clear();
 	viewDist = -1.0f;
+	lodLevel = 0;
+}
+
+
+uint32_t RenderPrimitiveCollector::SelectLOD(const Mesh* mesh, uint32_t currentLevel)
+{
+	const uint32_t numLODs = mesh->GetNumLODs();
+	const float dist = viewDist * lodBias;
+
+	// No view distance or LODs?
+	if (viewDist < 0.0f || numLODs == 1)
+	{
+		lodLevel = 0;
+		return lodLevel;
+	}
+
+	uint32_t level = glm::min(currentLevel, numLODs - 1);
+
+	// Lower details, only after passing the next LOD distance by the hysteresis band.
+	while (level + 1 < numLODs && dist > mesh->GetMeshLOD(level + 1).distance * (1.0f + RENDER_LOD_HYSTERESIS))
+		++level;
+
+	// Higher details, only after getting closer than the current LOD distance by the hysteresis band.
+	while (level > 0 && dist < mesh->GetMeshLOD(level).distance * (1.0f - RENDER_LOD_HYSTERESIS))
+		--level;
+
+	lodLevel = level;
+	return lodLevel;
 }
 
 
@@ -23,8 +23,15 @@
 
 
 
+// The fraction of an LOD distance used as a dead band around it, to avoid popping between two LODs.
+#define RENDER_LOD_HYSTERESIS 0.1f
+
+
+
+
 namespace Raven
 {
+	class Mesh;
 	class RenderScene;
 	class RenderPrimitive;
 	class RenderMesh;
@@ -52,6 +59,19 @@ namespace Raven
 		// Return the view distance to the primitive.
 		inline float GetViewDistance() { return viewDist; }
 
+		// Set the view distance to the primitive, negative if unknown.
+		inline void SetViewDistance(float dist) { viewDist = dist; }
+
+		// Set the scale applied to the view distance while selecting LODs.
+		inline void SetLODBias(float bias) { lodBias = bias; }
+
+		// Return the scale applied to the view distance while selecting LODs.
+		inline float GetLODBias() const { return lodBias; }
+
+		// Select the mesh LOD for the current view distance scaled by the LOD bias.
+		// @param currentLevel: the LOD selected last frame, only changed if the distance leaves its hysteresis band.
+		uint32_t SelectLOD(const Mesh* mesh, uint32_t currentLevel);
+
 	private:
 		// Clear all collected primitives form the collector.
 		void Reset();
@@ -78,6 +98,12 @@ namespace Raven
 
 		// The distance from the view to the primitive, can be used for LODs.
 		float viewDist;
+
+		// Scale applied to the view distance while selecting LODs, values greater than 1 select lower details sooner.
+		float lodBias;
+
+		// The LOD selected for the current primitives.
+		uint32_t lodLevel;
 	};
 
 }
@@ -0,0 +1,119 @@
+/*
+ * Developed by Raven Group at the University  of Leeds
+ * Copyright (C) 2021 Ammar Herzallah, Ben Husle, Thomas Moreno Cooper, Sulagna Sinha & Tian Zeng
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3 of the License.
+ *
+ * THIS PROGRAM IS DISTRIBUTED IN THE HOPE THAT IT WILL BE USEFUL,
+ * BUT WITHOUT ANY WARRANTY; WITHOUT EVEN THE IMPLIED WARRANTY OF
+ * MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE.  SEE THE
+ * GNU GENERAL PUBLIC LICENSE FOR MORE DETAILS.
+ */
+#pragma once
+
+
+
+#include "Utilities/Core.h"
+
+
+#include <vector>
+#include <utility>
+
+
+
+// Below this number of elements the radix sort fallback to an in-place insertion sort.
+#define RENDER_RADIX_SORT_MIN_ELEMENTS 64
+
+
+
+
+namespace Raven
+{
+
+	// Sort elements by their unsigned integer member "key" using an LSD radix sort on 8-bit digits.
+	//		- The histograms of all digits are built in a single pass over the elements, and digits that
+	//		  are the same for all keys are skipped, so constant high bits cost nothing.
+	//		- Stable, linear in the number of elements.
+	//		- The scratch vector only grows, reusing it between frames makes the sort non-allocating.
+	// @param elems: the elements to sort, sorted in place.
+	// @param scratch: temporary storage, resized to the number of elements.
+	template<class T>
+	inline void RenderRadixSort(std::vector<T>& elems, std::vector<T>& scratch)
+	{
+		typedef decltype(T::key) KeyType;
+		constexpr uint32_t NUM_DIGITS = sizeof(KeyType);
+
+		const size_t count = elems.size();
+
+		// Small lists are faster with an insertion sort, stable & doesn't allocate.
+		if (count < RENDER_RADIX_SORT_MIN_ELEMENTS)
+		{
+			for (size_t i = 1; i < count; ++i)
+			{
+				T elem = elems[i];
+				size_t j = i;
+
+				for (; j > 0 && elem.key < elems[j - 1].key; --j)
+					elems[j] = elems[j - 1];
+
+				elems[j] = elem;
+			}
+
+			return;
+		}
+
+		scratch.resize(count);
+
+		// Histograms of all digits.
+		uint32_t histograms[NUM_DIGITS][256] = {};
+
+		for (size_t i = 0; i < count; ++i)
+		{
+			KeyType key = elems[i].key;
+
+			for (uint32_t d = 0; d < NUM_DIGITS; ++d)
+				++histograms[d][(key >> (d * 8)) & 0xFF];
+		}
+
+
+		T* src = elems.data();
+		T* dst = scratch.data();
+
+		for (uint32_t d = 0; d < NUM_DIGITS; ++d)
+		{
+			uint32_t* histogram = histograms[d];
+			const uint32_t shift = d * 8;
+
+			// All the keys have the same digit?
+			if (histogram[(src[0].key >> shift) & 0xFF] == count)
+				continue;
+
+			// Offset of each digit value.
+			uint32_t offset = 0;
+
+			for (uint32_t b = 0; b < 256; ++b)
+			{
+				uint32_t n = histogram[b];
+				histogram[b] = offset;
+				offset += n;
+			}
+
+			// Scatter...
+			for (size_t i = 0; i < count; ++i)
+			{
+				dst[histogram[(src[i].key >> shift) & 0xFF]++] = src[i];
+			}
+
+			std::swap(src, dst);
+		}
+
+		// The result ended in the scratch vector?
+		if (src != elems.data())
+		{
+			std::swap(elems, scratch);
+		}
+	}
+
+}
@@ -33,6 +33,7 @@
 #include "Render/RenderResource/Shader/RenderRscShader.h" 
 #include "Render/RenderResource/Shader/RenderRscMaterial.h"
 #include "Render/RenderResource/Shader/UniformBuffer.h"
+#include "Render/RenderResource/Shader/UniformRingBuffer.h"
 #include "Render/OpenGL/GLBuffer.h"
 #include "Render/OpenGL/GLShader.h"
 
@@ -45,6 +46,7 @@
 
 #include "Core/Camera.h"
 #include "Scene/Scene.h"
+#include "Scene/SceneBoundsTree.h"
 #include "Scene/Component/Transform.h"
 #include "Scene/Component/Light.h"
 #include "Scene/Component/MeshComponent.h"
@@ -87,7 +89,22 @@ struct TransformBoneVertexData
 	glm::mat4 modelMatrix;
 	glm::mat4 normalMatrix;
 	glm::mat4 bones[RENDER_SKINNED_MAX_BONES];
-} trBoneData;
+};
+
+
+
+// Add an instance to a list of instance ranges, extends the last range if the instance follows it.
+inline void AddInstanceRange(std::vector<glm::uvec2>& ranges, uint32_t instance)
+{
+	if (!ranges.empty() && ranges.back().x + ranges.back().y == instance)
+	{
+		ranges.back().y++;
+	}
+	else
+	{
+		ranges.emplace_back(instance, 1u);
+	}
+}
 
 
 
@@ -108,6 +125,24 @@ void RenderSceneEnvironment::Reset()
 
 
 
+void RenderSceneStats::Reset()
+{
+	for (uint32_t i = 0; i < RENDER_STATS_MAX_LODS; ++i)
+	{
+		lodTriangles[i] = 0;
+		lodPrimitives[i] = 0;
+	}
+
+	foliageInstances = 0;
+	foliageUploadBytes = 0;
+	shadowCascades = 0;
+	clusterLightRefs = 0;
+	deferredDraws.Reset();
+	shadowDraws.Reset();
+}
+
+
+
 
 
 // --- -- --- -- --- -- --- -- --- -- --- -- --- -- --- -- --- -- --- -- --- -- --- -- 
@@ -122,8 +157,10 @@ RenderScene::RenderScene()
 	, frustum(glm::mat4(1.0f))
 	, isGrid(true)
 	, fov(false)
+	, collector(this)
+	, gatherStamp(0)
 {
-
+	stats.Reset();
 }
 
 
@@ -137,10 +174,10 @@ void RenderScene::Setup()
 {
 	// Transfrom Vertex Uniform 
 	transformUniform = Ptr<UniformBuffer>( UniformBuffer::Create(RenderShaderInput::TransformBlock, false) );
-	transformBoneUniform = Ptr<UniformBuffer>( UniformBuffer::Create(RenderShaderInput::TransformBoneBlock, false));
+	transformRing = Ptr<UniformRingBuffer>( UniformRingBuffer::Create(RENDER_SCENE_TRANSFORM_FRAME_SIZE) );
 
-	RAVEN_ASSERT(transformUniform->GetDescription().size == sizeof(TransformVertexData), "Invalid Size.");
-	RAVEN_ASSERT(transformBoneUniform->GetDescription().size == sizeof(TransformBoneVertexData), "Invalid Size.");
+	RAVEN_ASSERT(RenderShaderInput::TransformBlock.size == sizeof(TransformVertexData), "Invalid Size.");
+	RAVEN_ASSERT(RenderShaderInput::TransformBoneBlock.size == sizeof(TransformBoneVertexData), "Invalid Size.");
 
 	// Default Textures...
 	defaultTextures.resize(3);
@@ -156,7 +193,14 @@ void RenderScene::Setup()
 
 	// Sun Shadow Cascade..
 	environment.sunShadow = Ptr<RenderShadowCascade>(new RenderShadowCascade());
-	environment.sunShadow->SetupCascade(RENDER_MAX_SHADOW_CASCADE, glm::ivec2(1024, 1024));
+
+	// Near cascades get more texels, about the same memory as 4 cascades of 1024x1024.
+	environment.sunShadow->SetupCascade({
+		glm::ivec2(1536, 1536),
+		glm::ivec2(1024, 1024),
+		glm::ivec2(768, 768),
+		glm::ivec2(512, 512)
+	});
 
 	// Reset the environment to default.
 	environment.Reset();
@@ -165,9 +209,26 @@ void RenderScene::Setup()
 
 void RenderScene::Build(Scene* scene)
 {
+	// Stats of this frame.
+	stats.Reset();
+
+	// The default materials of primitives without custom shadow shaders.
+	const auto& defaultMaterials = Engine::GetModule<RenderModule>()->GetDefaultMaterials();
+
+	for (uint32_t i = 0; i < environment.sunShadow->GetNumCascade(); ++i)
+	{
+		environment.sunShadow->GetCascade(i).shadowBatch.SetDefaultMaterials(
+			defaultMaterials.mesh->GetRenderRsc(),
+			defaultMaterials.skinned->GetRenderRsc(),
+			defaultMaterials.terrain->GetRenderRsc());
+	}
+
 	// View & Projection.
 	CollectSceneView(scene);
 
+	// Bounds of the entities that changed since the last frame, before the cascades decide to use their cache.
+	UpdateSceneBounds(scene);
+
 	// Lights.
 	CollectSceneLights(scene);
 
@@ -177,8 +238,17 @@ void RenderScene::Build(Scene* scene)
 	// Traverse the scene to collected render primitives.
 	TraverseScene(scene);
 
-	// ...
+	// Sort all batches by their draw keys...
+	deferredBatch.Sort();
 	translucentBatch.Sort();
+
+	for (uint32_t i = 0; i < environment.sunShadow->GetNumCascade(); ++i)
+	{
+		environment.sunShadow->GetCascade(i).shadowBatch.Sort();
+	}
+
+	// Transforms of all collected primitives.
+	UploadTransforms();
 }
 
 
@@ -209,73 +279,39 @@ void RenderScene::TraverseScene(Scene* scene)
 	// Default Materials.
 	const auto& defaultMaterials = Engine::GetModule<RenderModule>()->GetDefaultMaterials();
 
-	// Primitives Collector.
-	RenderPrimitiveCollector collector(this);
-
 	// Get All models in the scene
-	std::vector<ScenePrimitiveData> outPrimitiveComponents;
-	GatherScenePrimitives(scene, outPrimitiveComponents);
+	scenePrimitives.clear();
+	GatherScenePrimitives(scene, scenePrimitives);
 
+	// Frustum & Shadow culling...
+	culler.Cull(scenePrimitives, viewPos, frustum, environment.isSun ? environment.sunShadow.get() : nullptr);
 
-	// Iterate over all Models in the scene.
-	for (auto& scenePrim : outPrimitiveComponents)
+
+	// Iterate over all visible Models in the scene.
+	for (const auto& cullData : culler.GetVisible())
 	{
 		// Primitive Component - Entity Data
+		const ScenePrimitiveData& scenePrim = scenePrimitives[cullData.index];
 		PrimitiveComponent* primComp = scenePrim.comp;
-		Transform* trComp = scenePrim.tr;
-
-		// Compute World Bounds.
-		MathUtils::BoundingBox bounds = primComp->GetLocalBounds().Transform(trComp->GetWorldMatrix());
-
-		// distance to view.
-		glm::vec3 v = (viewPos - bounds.GetCenter());
-		float viewDist2 = v.x * v.x + v.y * v.y + v.z * v.z;
-
-
-		// Clipping based on distance...
-		if (primComp->GetClipDistance() > 0.0)
-		{
-			float clipDist2 = primComp->GetClipDistance();
-			clipDist2 = clipDist2 * clipDist2;
-
-			if (viewDist2 > clipDist2)
-			{
-				// Don't Draw Component...
-				continue;
-			}
-		}
-		
-		
-
-
-		float radius;
-		glm::vec3 center;
-		bounds.GetSphere(center, radius);
-
-		// View Culling...
-		bool isViewCulled = !frustum.IsInFrustum2D(center, radius);
-
-		// Shadow Culling...
-		std::vector<uint32_t> shadowCascadeIndices;
-
-		if (primComp->IsCastShadow() && environment.isSun)
-		{
-			environment.sunShadow->IsInShadow(center, radius, shadowCascadeIndices);
-		}
-
-		// Test if its in scene view frustum?
-		if (isViewCulled && shadowCascadeIndices.empty())
-		{
-			// Don't Draw Component...
-			continue;
-		}
 
+		const glm::vec3& center = cullData.center;
+		float radius = cullData.radius;
+		bool isViewCulled = cullData.isViewCulled;
 
 		// Collect Render Render Primitives...
 		collector.Reset();
-		collector.SetTransform(&trComp->GetWorldMatrix(), &trComp->GetWorldMatrix());
+		collector.SetTransform(scenePrim.worldMatrix, scenePrim.worldMatrix);
+		collector.SetViewDistance(glm::sqrt(cullData.viewDist2));
 		primComp->CollectRenderPrimitives(collector);
 
+		// LOD Stats.
+		uint32_t statsLOD = glm::min(collector.lodLevel, (uint32_t)RENDER_STATS_MAX_LODS - 1);
+
+		// Lights are gathered once for all translucent primitives of the component.
+		const uint32_t* primLights = nullptr;
+		uint32_t numPrimLights = 0;
+		bool isLightsGathered = false;
+
 		// Create a RenderPrimitive for each model, and add it to the correct batch.
 		for (uint32_t i = 0; i < collector.primitive.size(); ++i)
 		{
@@ -285,8 +321,8 @@ void RenderScene::TraverseScene(Scene* scene)
 			// Validate Material.
 			if (rprim->GetMaterial())
 			{
-				// Domain Missmatch?
-				if (rprim->GetMaterialDomain() != rprim->GetDomain())
+				// Domain Missmatch or still building its shaders?
+				if (rprim->GetMaterialDomain() != rprim->GetDomain() || !rprim->GetMaterial()->IsReady())
 				{
 					rprim->SetMaterial(nullptr);
 				}
@@ -307,28 +343,35 @@ void RenderScene::TraverseScene(Scene* scene)
 				if (rprim->GetShaderType() == ERenderShaderType::Translucent)
 				{
 					// Gather lights that affect this translucent primitive.
-					std::vector<RenderLight*> litPrim;
-					GatherLights(center, radius, litPrim);
+					if (!isLightsGathered)
+					{
+						uint32_t* lightIndices = frameArena.NewArray<uint32_t>(RENDER_PASS_FORWARD_MAX_LIGHTS);
+						numPrimLights = lightGrid.Gather(center, radius, lightIndices, RENDER_PASS_FORWARD_MAX_LIGHTS);
+						primLights = lightIndices;
+						isLightsGathered = true;
+					}
 
-					for (const auto& lit : litPrim)
-						rprim->AddLight(lit->indexInScene);
+					rprim->SetLights(primLights, numPrimLights);
 
 
 					// TRANSLUCENT BATCH.
-					translucentBatch.Add(rprim, viewDist2);
+					translucentBatch.Add(rprim, cullData.viewDist2);
 				}
 				else
 				{
 					// DEFERRED BATCH.
-					deferredBatch.Add(rprim);
+					deferredBatch.Add(rprim, cullData.viewDist2);
 				}
+
+				stats.lodTriangles[statsLOD] += rprim->GetNumTriangles();
+				stats.lodPrimitives[statsLOD]++;
 			}
 
 
-			if (!shadowCascadeIndices.empty() && rprim->IsCastShadow())
+			if (cullData.shadowMask != 0 && rprim->IsCastShadow())
 			{
 				// Add to shadow scene.
-				environment.sunShadow->AddPrimitive(rprim, isDefaultMat, shadowCascadeIndices);
+				environment.sunShadow->AddPrimitive(rprim, isDefaultMat, cullData.shadowMask);
 			}
 
 		}
@@ -370,6 +413,19 @@ void RenderScene::CollectSceneView(Scene* scene)
 }
 
 
+void RenderScene::UpdateSceneBounds(Scene* scene)
+{
+	SceneBoundsTree* boundsTree = scene->GetBoundsTree();
+	boundsTree->Update(scene->GetRegistry());
+
+	// A moved caster changes the shadow where it was & where it is now.
+	for (const auto& bounds : boundsTree->GetChangedBounds())
+	{
+		environment.sunShadow->Invalidate(bounds.GetMin(), bounds.GetMax());
+	}
+}
+
+
 void RenderScene::CollectSceneLights(Scene* scene)
 {
 	// Collect sun lights from global settings...
@@ -381,7 +437,9 @@ void RenderScene::CollectSceneLights(Scene* scene)
 		environment.sunPower = scene->GetGlobalSettings().sunPower;
 		environment.sunColor = scene->GetGlobalSettings().sunColor;
 
-		// Shadow Cascade...
+		// Shadow Cascade, scenes with a terrain are viewed from farther distances...
+		bool isTerrain = !scene->GetRegistry().view<TerrainComponent>().empty();
+		environment.sunShadow->SetLastCascadeRange(isTerrain ? RENDER_SHADOW_TERRAIN_DISTANCE : RENDER_SHADOW_DISTANCE);
 		environment.sunShadow->ComputeCascade(environment.sunDir, fov, aspect, near, far, viewMatrixInverse);
 
 	}
@@ -437,6 +495,10 @@ void RenderScene::CollectSceneLights(Scene* scene)
 
 	}
 
+	// Assign the collected lights to the view clusters & the world grid.
+	lightClusters.Build(rlights, view, projection, near, far);
+	lightGrid.Build(rlights);
+	stats.clusterLightRefs = (uint32_t)lightClusters.GetIndices().size();
 }
 
 
@@ -462,12 +524,8 @@ void RenderScene::CollectTerrain(Scene* scene)
 	float binRadius;
 	glm::vec3 binCenter;
 
-	std::vector< std::pair<bool, bool> > drawnBins; // first:scene, second:shadow]
-	drawnBins.resize(bins.size(), std::make_pair(false, false));
-
-
-	// Set last cascade distance for terrain scenes.
-	environment.sunShadow->SetLastCascadeRange(450);
+	std::vector< std::pair<bool, uint32_t> >& drawnBins = terrainDrawnBins;
+	drawnBins.assign(bins.size(), std::make_pair(false, 0u));
 
 
 	for (uint32_t i = 0; i < bins.size(); ++i)
@@ -478,13 +536,13 @@ void RenderScene::CollectTerrain(Scene* scene)
 		bool isViewCulled = !frustum.IsInFrustum2D(binCenter, binRadius);
 
 		// Shadow Culling...
-		std::vector<uint32_t> shadowCascadeIndices;
+		uint32_t shadowMask = 0;
 
 		if (environment.isSun)
-			environment.sunShadow->IsInShadow(binCenter, binRadius, shadowCascadeIndices);
+			shadowMask = environment.sunShadow->IsInShadow(binCenter, binRadius);
 
 		// Clip?
-		if (isViewCulled && shadowCascadeIndices.empty())
+		if (isViewCulled && shadowMask == 0)
 			continue;
 
 		// Render Terrain Object...
@@ -493,8 +551,8 @@ void RenderScene::CollectTerrain(Scene* scene)
 		renderTerrain->SetWorldMatrix(glm::mat4(1.0f));
 		renderTerrain->SetBin(i);
 
-		// Default Terrain Material.
-		if (terrain->GetMaterial())
+		// Default Terrain Material, also used while the terrain material is building its shaders.
+		if (terrain->GetMaterial() && terrain->GetMaterial()->GetRenderRsc()->IsReady())
 		{
 			renderTerrain->SetMaterial(terrain->GetMaterial()->GetRenderRsc());
 		}
@@ -506,14 +564,16 @@ void RenderScene::CollectTerrain(Scene* scene)
 		// Add the terrain to the deferred batch.
 		if (!isViewCulled)
 		{
-			deferredBatch.Add(renderTerrain);
+			glm::vec3 v = (viewPos - binCenter);
+			deferredBatch.Add(renderTerrain, v.x * v.x + v.y * v.y + v.z * v.z);
 			drawnBins[i].first = true;
 		}
 
 		// Add terrain to shadow rendering.
-		if (!shadowCascadeIndices.empty())
+		if (shadowMask != 0)
 		{
-			environment.sunShadow->AddPrimitive(renderTerrain, true, shadowCascadeIndices);
+			environment.sunShadow->AddPrimitive(renderTerrain, true, shadowMask);
+			drawnBins[i].second = shadowMask;
 		}
 
 
@@ -521,94 +581,160 @@ void RenderScene::CollectTerrain(Scene* scene)
 	}
 
 
-	// For each foliage layer build instance transformation for drawn instances only.
-	const auto& foliageLayers = *(terrain->GetRenderRsc()->GetFoliageLayer());
-	std::vector< std::vector<glm::mat4> > layersInstanceTransforms;
-	layersInstanceTransforms.resize( foliageLayers.size() );
+	// Foliage instances are static in their layer instance buffer sorted by bin, each frame only the ranges
+	// of visible instances are computed and their draw commands are uploaded only if they changed.
+	auto& foliageLayers = *(terrain->GetRenderRsc()->GetFoliageLayer());
+	const RenderShadowCascade* sunShadow = environment.sunShadow.get();
+	std::vector<glm::uvec2>& viewRanges = foliageViewRanges;
+	std::vector<glm::uvec2>* shadowRanges = foliageShadowRanges;
 
 
-	// Iterate on drawn bins only and determine what foliage to draw...
-	for (size_t i = 0; i < drawnBins.size(); ++i)
+	// Iterate on layers...
+	for (size_t li = 0; li < foliageLayers.size(); ++li)
 	{
-		// Not Drawn?
-		if (!drawnBins[i].first && !drawnBins[i].second)
+		auto& layer = foliageLayers[li];
+		const auto& meshInstances = layer.GetMeshInstances();
+		const auto& meshMaterials = layer.GetMaterials();
+
+		// Nothing to draw.
+		if (meshInstances.empty())
 			continue;
 
-		const auto& bin = bins[i];
+		// Upload the layer instances if changed.
+		layer.UpdateInstanceBuffer(bins.size());
+
+		const glm::vec3* centers = layer.GetCullCenters();
+		const float* radii = layer.GetCullRadii();
+		float layerClipDistance = layer.GetClipDistanceForTesting();
+		bool isLayerShadow = environment.isSun && layer.IsCastShadow();
+		uint32_t numViewInstances = 0;
 
-		// distance to bin.
-		glm::vec3 v = (viewPos - bin.bounds.GetCenter());
-		float viewDist2 = v.x * v.x + v.y * v.y + v.z * v.z;
+		viewRanges.clear();
 
-		// Iterate on instances inside this bin...
-		for (const auto& foliageInstance : bin.foliage)
+		for (uint32_t ic = 0; ic < RENDER_MAX_SHADOW_CASCADE; ++ic)
+			shadowRanges[ic].clear();
+
+		// Iterate on drawn bins only and determine what foliage to draw...
+		for (size_t i = 0; i < drawnBins.size(); ++i)
 		{
-			const auto& instanceLayer = foliageLayers[foliageInstance.layer];
-			const auto& instance = instanceLayer.GetInstance(foliageInstance.index);
-			float layerClipDistance = instanceLayer.GetClipDistanceForTesting();
+			bool isBinView = drawnBins[i].first;
+			uint32_t binShadowMask = isLayerShadow ? drawnBins[i].second : 0;
+
+			// Not Drawn?
+			if (!isBinView && binShadowMask == 0)
+				continue;
 
-			// distance to view.
-			glm::vec3 v = (viewPos - instance.center);
-			float viewDist2 = v.x * v.x + v.y * v.y + v.z * v.z;
+			const glm::uvec2& range = layer.GetBinRange(i);
 
-			if (viewDist2 > layerClipDistance)
-			{
-				// Don't Draw instance...
+			if (range.y == 0)
 				continue;
-			}
 
-			layersInstanceTransforms[foliageInstance.layer].push_back(instance.transform);
-		}
-	}
+			// The entire bin is beyond the clip distance?
+			bins[i].bounds.GetSphere(binCenter, binRadius);
+			float binDist = glm::max(glm::length(viewPos - binCenter) - binRadius, 0.0f);
 
+			if (binDist * binDist > layerClipDistance)
+				continue;
 
-	// Iterate on layers...
-	for (size_t li = 0; li < layersInstanceTransforms.size(); ++li)
-	{
-		const auto& layerTr = layersInstanceTransforms[li];
+			uint32_t end = range.x + range.y;
 
-		// Nothing to draw.
-		if (layerTr.empty())
-			continue;
+			// Iterate on instances inside this bin 4 at a time...
+			for (uint32_t s = range.x; s < end; s += 4)
+			{
+				uint32_t count = glm::min(end - s, 4u);
 
-		const auto& layer = foliageLayers[li];
-		const auto& meshInstances = layer.GetMeshInstances();
-		const auto& meshMaterials = layer.GetMaterials();
+				// distance to view.
+				uint32_t distMask = 0;
 
-		// Update transforms of all drawn instances...
-		if (!meshInstances.empty())
-		{
-			meshInstances[0]->UpdateTransforms(layerTr);
+				for (uint32_t j = 0; j < count; ++j)
+				{
+					glm::vec3 v = (viewPos - centers[s + j]);
+					float viewDist2 = v.x * v.x + v.y * v.y + v.z * v.z;
+					distMask |= viewDist2 > layerClipDistance ? 0 : (1u << j);
+				}
+
+				// Don't Draw instances...
+				if (distMask == 0)
+					continue;
+
+				uint32_t viewMask = isBinView ? (frustum.IsInFrustumX4(&centers[s], &radii[s]) & distMask) : 0;
+				uint32_t shadowMasks[4] = { 0, 0, 0, 0 };
+
+				// Cull against each shadow cascade volume.
+				if (binShadowMask != 0)
+				{
+					sunShadow->IsInShadowX4(&centers[s], &radii[s], shadowMasks);
+				}
+
+				for (uint32_t j = 0; j < count; ++j)
+				{
+					if (viewMask & (1u << j))
+					{
+						AddInstanceRange(viewRanges, s + j);
+						++numViewInstances;
+					}
+
+					// Not in clip distance?
+					if ((distMask & (1u << j)) == 0)
+						continue;
+
+					for (uint32_t ic = 0; ic < sunShadow->GetNumCascade(); ++ic)
+					{
+						if (shadowMasks[j] & (1u << ic))
+							AddInstanceRange(shadowRanges[ic], s + j);
+					}
+				}
+			}
 		}
-		
-		// Create a RenderPrimitive for each instance
+
+		stats.foliageInstances += numViewInstances;
+
+		// Create a RenderPrimitive for each instance in the view & in each shadow cascade...
 		for (size_t i = 0; i < meshInstances.size(); ++i)
 		{
-			// Render Foliage...
-			RenderTerrainFoliage* renderFoliage = NewPrimitive<RenderTerrainFoliage>();
-			renderFoliage->SetMeshRsc( meshInstances[i].get() );
-			renderFoliage->SetInstanceCount(layerTr.size());
-
 			// Update material if dirty.
 			if (meshMaterials[i]->IsDirty())
 			{
 				meshMaterials[i]->UpdateRenderResource();
 			}
 
-			renderFoliage->SetMaterial( meshMaterials[i]->GetRenderRsc() );
-			deferredBatch.Add(renderFoliage);
+			// Use the default material while the mesh material is building its shaders.
+			RenderRscMaterial* foliageMaterial = meshMaterials[i]->GetRenderRsc();
 
-#if RENDER_MAX_SHADOW_CASCADE == 4
-			std::vector<uint32_t> tmp = { 0, 1, 2 , 3 };
-			environment.sunShadow->AddPrimitive(renderFoliage, false, tmp);
-#else
-			std::vector<uint32_t> tmp = { 0 };
-			environment.sunShadow->AddPrimitive(renderFoliage, false, tmp);
-#endif
+			if (!foliageMaterial->IsReady())
+				foliageMaterial = defaultMaterials.meshInstance->GetRenderRsc();
 
-		}
+			stats.foliageUploadBytes += meshInstances[i]->UpdateDrawRanges(ERenderInstanceList::View, viewRanges);
+
+			if (!viewRanges.empty())
+			{
+				RenderTerrainFoliage* renderFoliage = NewPrimitive<RenderTerrainFoliage>();
+				renderFoliage->SetMeshRsc( meshInstances[i].get() );
+				renderFoliage->SetMaterial( foliageMaterial );
+				deferredBatch.Add(renderFoliage, 0.0f);
+			}
 
+			if (!isLayerShadow)
+				continue;
+
+			for (uint32_t ic = 0; ic < sunShadow->GetNumCascade(); ++ic)
+			{
+				// Cached cascade, keep its last ranges.
+				if (!sunShadow->GetCascade(ic).isUpdate)
+					continue;
 
+				stats.foliageUploadBytes += meshInstances[i]->UpdateDrawRanges(GetShadowInstanceList(ic), shadowRanges[ic]);
+
+				if (shadowRanges[ic].empty())
+					continue;
+
+				RenderTerrainFoliage* renderFoliage = NewPrimitive<RenderTerrainFoliage>();
+				renderFoliage->SetMeshRsc( meshInstances[i].get() );
+				renderFoliage->SetMaterial( foliageMaterial );
+				renderFoliage->SetShadowCascade(ic);
+				environment.sunShadow->AddPrimitive(renderFoliage, false, 1u << ic);
+			}
+		}
 	}
 
 
@@ -622,17 +748,21 @@ void RenderScene::Clear()
 	translucentBatch.Reset();
 
 
-	// Delete Dynamic Render Primitives created while building render scene...
+	// Destroy Dynamic Render Primitives created while building render scene...
 	for (auto& prim : rprimitives)
-		delete prim;
+		prim->~RenderPrimitive();
 
-	// Delete Render Lights created while building render scene...
+	// Destroy Render Lights created while building render scene...
 	for (auto& light : rlights)
-		delete light;
+		light->~RenderLight();
 
 	//...
 	rprimitives.clear();
 	rlights.clear();
+	frameArena.Reset();
+
+	// Fence the transforms of this frame, all its draws are issued.
+	transformRing->EndFrame();
 	environment.Reset();
 	near = 0.0f;
 	far = 0.0f;
@@ -641,94 +771,77 @@ void RenderScene::Clear()
 
 void RenderScene::DrawDeferred()
 {
-	// ...
-	bool isCullFace = true;
+	DrawBatch(deferredBatch.GetDraws(), false, stats.deferredDraws);
 
-	// Bind Transform Uniform Buffer.
-	transformUniform->BindBase();
-	transformBoneUniform->BindBase();
+	// End Drawing...
+	glBindVertexArray(0);
 
+}
 
-	// All The Batch Primitives.
-	const auto& primitives = deferredBatch.GetPrimitives();
 
-	// First: iterate on shaders...
-	for (uint32_t is = 0; is < deferredBatch.GetNumShaders(); ++is)
+void RenderScene::DrawBatch(const std::vector<RenderBatchDraw>& draws, bool isShadow, RenderBatchStats& outStats)
+{
+	RenderRscShader* lastShader = nullptr;
+	RenderRscMaterial* lastMaterial = nullptr;
+	RenderRscPrimitive* lastMesh = nullptr;
+	GLShader* shader = nullptr;
+	bool isCullFace = glIsEnabled(GL_CULL_FACE) == GL_TRUE;
+
+	// Draws are sorted by shader then material, bind each only when it changes...
+	for (const auto& draw : draws)
 	{
-		const auto& shaderBatch = deferredBatch.GetShaderBatch(is);
-
-		// Two-Sided?
-		if (shaderBatch.shader->IsTwoSided())
-		{
-			if (isCullFace)
-			{
-				glDisable(GL_CULL_FACE);
-				isCullFace = false;
-			}
-		}
-		else 
+		// The Shader
+		if (draw.shader != lastShader)
 		{
-			if (!isCullFace)
+			lastShader = draw.shader;
+			lastMaterial = nullptr;
+			++outStats.shaderChanges;
+
+			// Two-Sided?
+			if (draw.shader->IsTwoSided() == isCullFace)
 			{
-				glEnable(GL_CULL_FACE);
-				isCullFace = true;
+				isCullFace = !isCullFace;
+
+				if (isCullFace)
+					glEnable(GL_CULL_FACE);
+				else
+					glDisable(GL_CULL_FACE);
 			}
-		}
 
-		// The Shader
-		GLShader* shader = shaderBatch.shader->GetShader();
-		shader->Use();
+			shader = draw.shader->GetShader();
+			shader->Use();
+		}
 
-		// Second: iterate on materails...
-		for (uint32_t im = 0; im < shaderBatch.materials.size(); ++im)
+		// The Material
+		if (draw.material != lastMaterial)
 		{
-			const auto& materialBatch = deferredBatch.GetMaterialBatch(shaderBatch.materials[im]);
+			lastMaterial = draw.material;
+			++outStats.materialChanges;
 
-			// The Material
-			RenderRscMaterial* material = materialBatch.material;
-			material->MakeTexturesActive(defaultTextures);
+			draw.material->MakeTexturesActive(defaultTextures);
 
-			if (material->HasMaterialData())
+			if (draw.material->HasMaterialData())
 			{
-				material->GetUniformBuffer()->BindBase();
-				material->UpdateUniformBuffer();
+				draw.material->BindUniformBuffer();
 			}
+		}
 
+		// The Mesh
+		RenderRscPrimitive* mesh = draw.primitive->GetRsc();
 
-			// Finally: Draw Primitives...
-			for (uint32_t ip = 0; ip < materialBatch.primitives.size(); ++ip)
-			{
-				RenderPrimitive* prim = primitives[materialBatch.primitives[ip]];
-
-				// Transform.
-				if (prim->isSkinned)
-				{
-					auto skinned = static_cast<RenderSkinnedMesh*>(prim);
-
-					// Model & Normal & Bones.
-					trBoneData.modelMatrix = prim->GetWorldMatrix();
-					trBoneData.normalMatrix = prim->GetWorldMatrix();
-					memcpy(&trBoneData.bones, skinned->GetBones()->data(), sizeof(glm::mat4) * skinned->GetBones()->size());
-					transformBoneUniform->UpdateData(sizeof(TransformBoneVertexData), 0, (void*)(&trBoneData));
-				}
-				else
-				{
-					// Model & Normal.
-					trData.modelMatrix = prim->GetWorldMatrix();
-					trData.normalMatrix = prim->GetWorldMatrix();
-					transformUniform->UpdateData(sizeof(TransformVertexData), 0, &trData);
-				}
-
-
-				// Draw...
-				prim->Draw(shader, false);
-			}
+		if (mesh != lastMesh)
+		{
+			lastMesh = mesh;
+			++outStats.meshChanges;
 		}
-	}
 
-	// End Drawing...
-	glBindVertexArray(0);
+		// Transform.
+		BindTransform(draw.primitive);
 
+		// Draw...
+		draw.primitive->Draw(shader, isShadow);
+		++outStats.draws;
+	}
 }
 
 
@@ -769,10 +882,6 @@ void RenderScene::DrawDebug()
 
 void RenderScene::DrawTranslucent(UniformBuffer* lightUB)
 {
-	// Bind Transform Uniform Buffer.
-	transformUniform->BindBase();
-	transformBoneUniform->BindBase();
-
 	// All The Batch Primitives.
 	const auto& primitives = translucentBatch.GetPrimitives();
 
@@ -789,8 +898,7 @@ void RenderScene::DrawTranslucent(UniformBuffer* lightUB)
 
 		if (material->HasMaterialData())
 		{
-			material->GetUniformBuffer()->BindBase();
-			material->UpdateUniformBuffer();
+			material->BindUniformBuffer();
 		}
 
 		// The Shader.
@@ -798,23 +906,7 @@ void RenderScene::DrawTranslucent(UniformBuffer* lightUB)
 		shader->Use();
 
 		// Transform.
-		if (prim.primitive->isSkinned)
-		{
-			auto skinned = static_cast<RenderSkinnedMesh*>(prim.primitive);
-
-			// Model & Normal & Bones.
-			trBoneData.modelMatrix = prim.primitive->GetWorldMatrix();
-			trBoneData.normalMatrix = prim.primitive->GetWorldMatrix();
-			memcpy(&trBoneData.bones, skinned->GetBones()->data(), sizeof(glm::mat4) * skinned->GetBones()->size());
-			transformBoneUniform->UpdateData(sizeof(TransformBoneVertexData), 0, (void*)(&trBoneData));
-		}
-		else
-		{
-			// Model & Normal.
-			trData.modelMatrix = prim.primitive->GetWorldMatrix();
-			trData.normalMatrix = prim.primitive->GetWorldMatrix();
-			transformUniform->UpdateData(sizeof(TransformVertexData), 0, &trData);
-		}
+		BindTransform(prim.primitive);
 
 		// Draw...
 		prim.primitive->Draw(shader, false);
@@ -825,231 +917,196 @@ void RenderScene::DrawTranslucent(UniformBuffer* lightUB)
 
 void RenderScene::UpdateLights_FORWARD(UniformBuffer* lightUB, RenderPrimitive* prim)
 {
-	static std::vector<glm::vec4> lightPos(RENDER_PASS_FORWARD_MAX_LIGHTS);
-	static std::vector<glm::vec4> lightDir(RENDER_PASS_FORWARD_MAX_LIGHTS);
-	static std::vector<glm::vec4> lightPower(RENDER_PASS_FORWARD_MAX_LIGHTS);
-	static std::vector<glm::vec4> lightData(RENDER_PASS_FORWARD_MAX_LIGHTS);
+	struct LightingBlock
+	{
+		glm::vec4 lightDir[RENDER_PASS_FORWARD_MAX_LIGHTS];
+		glm::vec4 lightPos[RENDER_PASS_FORWARD_MAX_LIGHTS];
+		glm::vec4 lightPower[RENDER_PASS_FORWARD_MAX_LIGHTS];
+		glm::vec4 lightData[RENDER_PASS_FORWARD_MAX_LIGHTS];
+	} lightingData;
 
-	const auto& lit = prim->GetLights();
+	const uint32_t* lit = prim->GetLights();
+	uint32_t numLit = prim->GetNumLights();
 
-	for (int32_t i = 0; i < RENDER_PASS_FORWARD_MAX_LIGHTS; ++i)
+	for (uint32_t i = 0; i < RENDER_PASS_FORWARD_MAX_LIGHTS; ++i)
 	{
-		if (i >= lit.size())
+		if (i >= numLit)
 		{
-			lightData[i].r = 0.0f; // No Light.
+			lightingData.lightData[i] = glm::vec4(0.0f); // No Light.
 			continue;
 		}
 
 		const auto& light = rlights[ lit[i] ];
-		lightPos[i] = glm::vec4(light->postion, 0.0f);
-		lightDir[i] = glm::vec4(light->dir, 0.0f);
-		lightData[i].r = light->GetType();
-		lightData[i].g = light->innerAngle;
-		lightData[i].b = light->outerAngle;
-		lightData[i].a = light->radius;
-		lightPower[i] = light->colorAndPower;
+		lightingData.lightPos[i] = glm::vec4(light->postion, 0.0f);
+		lightingData.lightDir[i] = glm::vec4(light->dir, 0.0f);
+		lightingData.lightData[i].r = light->GetType();
+		lightingData.lightData[i].g = light->innerAngle;
+		lightingData.lightData[i].b = light->outerAngle;
+		lightingData.lightData[i].a = light->radius;
+		lightingData.lightPower[i] = light->colorAndPower;
 	}
 
-
-
-	lightUB->SetDataValues(0, lightDir);
-	lightUB->SetDataValues(1, lightPos);
-	lightUB->SetDataValues(2, lightPower);
-	lightUB->SetDataValues(3, lightData);
-	lightUB->Update();
+	lightUB->UpdateData(sizeof(LightingBlock), 0, &lightingData);
 }
 
 
-void RenderScene::GatherLights(const glm::vec3& center, float radius, std::vector<RenderLight*>& outLights)
+void RenderScene::GatherScenePrimitives(Scene* scene, std::vector<ScenePrimitiveData>& outPrimitivesComp)
 {
-	float r2 = radius * radius;
-
-	for (uint32_t il = 0; il < rlights.size(); ++il)
-	{
-		// Invalid or Directional?
-		if (rlights[il]->type <= 1)
-			continue;
+	entt::registry& registry = scene->GetRegistry();
+	SceneBoundsTree* boundsTree = scene->GetBoundsTree();
 
-		glm::vec3 v = (center - rlights[il]->postion);
-		float d2 = v.x * v.x + v.y * v.y + v.z * v.z;
+	// The tree was refitted by UpdateSceneBounds() this frame.
+	++gatherStamp;
 
-		float lr2 = rlights[il]->radius;
-		lr2 = lr2 * lr2;
+	// Add the primitive components of an entity, entities overlapping multiple frustums are only added once.
+	auto addEntity = [&](entt::entity entity)
+	{
+		uint32_t index = entt::to_integral(entity) & entt::entt_traits<entt::entity>::entity_mask;
 
+		if (index >= gatherStamps.size())
+			gatherStamps.resize(index + 1, 0);
 
-		// No intersection?
-		if ((d2 - lr2) > r2)
-			continue;
+		if (gatherStamps[index] == gatherStamp)
+			return;
 
-		outLights.push_back(rlights[il]);
-	}
+		gatherStamps[index] = gatherStamp;
 
-}
+		Transform* trans = registry.try_get<Transform>(entity);
 
+		if (!trans)
+			return;
 
-void RenderScene::GatherScenePrimitives(Scene* scene, std::vector<ScenePrimitiveData>& outPrimitivesComp)
-{
-	// Iterate over all MeshComponent in the scene.
-	{
-		auto meshPrimitives = scene->GetRegistry().group<MeshComponent>(entt::get<Transform>);
+		PrimitiveComponent* prims[2] = {
+			registry.try_get<MeshComponent>(entity),
+			registry.try_get<SkinnedMeshComponent>(entity)
+		};
 
-		for (auto entity : meshPrimitives)
+		for (uint32_t i = 0; i < 2; ++i)
 		{
-			auto& [mesh, trans] = meshPrimitives.get<MeshComponent, Transform>(entity);
+			if (!prims[i])
+				continue;
 
 			ScenePrimitiveData scenePrim;
-			scenePrim.comp = &mesh;
-			scenePrim.tr = &trans;
+			scenePrim.comp = prims[i];
+			scenePrim.tr = trans;
+			scenePrim.worldMatrix = &trans->GetWorldMatrix();
+			scenePrim.localBounds = &prims[i]->GetLocalBounds();
+			scenePrim.clipDistance = prims[i]->GetClipDistance();
+			scenePrim.isCastShadow = prims[i]->IsCastShadow();
 			outPrimitivesComp.push_back(scenePrim);
 		}
-	}
+	};
+
 
+	// Primitives in the view...
+	boundsTree->QueryFrustum(frustum, true, addEntity);
 
-	// Iterate over all SkinnedMeshComponent in the scene.
+	// Primitives that may cast shadow in one of the cascades...
+	if (environment.isSun)
 	{
-		auto skinnedPrimitives = scene->GetRegistry().group<SkinnedMeshComponent>(entt::get<Transform>);
+		const RenderShadowCascade* sunShadow = environment.sunShadow.get();
 
-		for (auto entity : skinnedPrimitives)
+		for (uint32_t ic = 0; ic < sunShadow->GetNumCascade(); ++ic)
 		{
-			auto& [skinned, trans] = skinnedPrimitives.get<SkinnedMeshComponent, Transform>(entity);
+			// Cached cascade, no casters needed.
+			if (!sunShadow->GetCascade(ic).isUpdate)
+				continue;
 
-			ScenePrimitiveData scenePrim;
-			scenePrim.comp = &skinned;
-			scenePrim.tr = &trans;
-			outPrimitivesComp.push_back(scenePrim);
+			boundsTree->QueryFrustum(sunShadow->GetCascade(ic).frustum, false, addEntity);
 		}
 	}
 
 }
 
 
-void RenderScene::DrawShadow(UniformBuffer* shadowUB)
+void RenderScene::UploadTransforms()
 {
-	// ...
-	bool isCullFace = true;
-
-	// Default Materials.
-	const auto& defaultMaterials = Engine::GetModule<RenderModule>()->GetDefaultMaterials();
-
-
-	// Bind Transform Uniform Buffer.
-	shadowUB->BindBase();
-	transformUniform->BindBase();
-	transformBoneUniform->BindBase();
-
-	// Shadow Cascade...
-	RenderShadowCascade* shadow = GetEnvironment().sunShadow.get();
+	const int32_t trSize = transformRing->GetAlignedSize(sizeof(TransformVertexData));
+	const int32_t boneSize = transformRing->GetAlignedSize(sizeof(TransformBoneVertexData));
 
+	int32_t requiredSize = 0;
 
-	for (uint32_t i = 0; i < shadow->GetNumCascade(); ++i)
+	for (auto prim : rprimitives)
 	{
-		ShadowCascadeData& cascade = shadow->GetCascade(i);
-		glm::ivec2 shadowSize = cascade.shadowPass->GetSize();
+		requiredSize += prim->isSkinned ? boneSize : trSize;
+	}
 
-		// Begin...
-		cascade.shadowPass->Begin(glm::ivec4(0, 0, shadowSize.x, shadowSize.y), true);
+	transformRing->BeginFrame(requiredSize);
 
-		// Shadow Transform...
-		shadowUB->SetDataValue(0, cascade.viewProj);
-		shadowUB->Update();
 
-		// All The Batch Primitives.
-		auto& shadowBatch = cascade.shadowBatch;
-		const auto& primitives = shadowBatch.GetPrimitives();
+	// Write each primitive transform once, draws only bind its range.
+	for (auto prim : rprimitives)
+	{
+		if (prim->isSkinned)
+		{
+			auto skinned = static_cast<RenderSkinnedMesh*>(prim);
+			uint32_t numBones = glm::min((uint32_t)skinned->GetBones()->size(), (uint32_t)RENDER_SKINNED_MAX_BONES);
 
+			prim->transformOffset = transformRing->Allocate(sizeof(TransformBoneVertexData));
+			auto trBoneData = reinterpret_cast<TransformBoneVertexData*>(transformRing->GetData(prim->transformOffset));
 
-		// First: iterate on shaders...
-		for (uint32_t is = 0; is < shadowBatch.GetNumShaders(); ++is)
+			// Model & Normal & Bones.
+			trBoneData->modelMatrix = prim->GetWorldMatrix();
+			trBoneData->normalMatrix = prim->GetWorldMatrix();
+			memcpy(&trBoneData->bones, skinned->GetBones()->data(), sizeof(glm::mat4) * numBones);
+		}
+		else
 		{
-			const auto& shaderBatch = shadowBatch.GetShaderBatch(is);
+			prim->transformOffset = transformRing->Allocate(sizeof(TransformVertexData));
+			auto trData = reinterpret_cast<TransformVertexData*>(transformRing->GetData(prim->transformOffset));
 
-			// Default Shadow Shader not assigned?
-			if (!shaderBatch.shader)
-			{
-				switch (shaderBatch.domain)
-				{
-				case Raven::ERenderShaderDomain::Mesh:
-					shadowBatch.SetDefaultShader(is, defaultMaterials.mesh->GetRenderRsc()->GetShadowShaderRsc(), defaultMaterials.mesh->GetRenderRsc());
-					break;
-				case Raven::ERenderShaderDomain::Skinned:
-					shadowBatch.SetDefaultShader(is, defaultMaterials.skinned->GetRenderRsc()->GetShadowShaderRsc(), defaultMaterials.skinned->GetRenderRsc());
-					break;
-				case Raven::ERenderShaderDomain::Terrain:
-					shadowBatch.SetDefaultShader(is, defaultMaterials.terrain->GetRenderRsc()->GetShadowShaderRsc(), defaultMaterials.terrain->GetRenderRsc());
-					break;
-				}
-			}
+			// Model & Normal.
+			trData->modelMatrix = prim->GetWorldMatrix();
+			trData->normalMatrix = prim->GetWorldMatrix();
+		}
+	}
+}
 
 
-			// Two-Sided?
-			if (shaderBatch.shader->IsTwoSided())
-			{
-				if (isCullFace)
-				{
-					glDisable(GL_CULL_FACE);
-					isCullFace = false;
-				}
-			}
-			else
-			{
-				if (!isCullFace)
-				{
-					glEnable(GL_CULL_FACE);
-					isCullFace = true;
-				}
-			}
+void RenderScene::BindTransform(RenderPrimitive* prim)
+{
+	RAVEN_ASSERT(prim->transformOffset != -1, "RenderScene - Primitive transform was not uploaded.");
 
-			// The Shader
-			GLShader* shader = shaderBatch.shader->GetShader();
-			shader->Use();
+	if (prim->isSkinned)
+	{
+		transformRing->BindRange(RenderShaderInput::TransformBoneBlock.binding, prim->transformOffset, sizeof(TransformBoneVertexData));
+	}
+	else
+	{
+		transformRing->BindRange(RenderShaderInput::TransformBlock.binding, prim->transformOffset, sizeof(TransformVertexData));
+	}
+}
 
-			// Second: iterate on materails...
-			for (uint32_t im = 0; im < shaderBatch.materials.size(); ++im)
-			{
-				const auto& materialBatch = shadowBatch.GetMaterialBatch(shaderBatch.materials[im]);
 
-				// The Material
-				RenderRscMaterial* material = materialBatch.material;
-				material->MakeTexturesActive(defaultTextures);
+void RenderScene::DrawShadow(UniformBuffer* shadowUB)
+{
+	// Bind Shadow Uniform Buffer.
+	shadowUB->BindBase();
 
-				if (material->HasMaterialData())
-				{
-					material->GetUniformBuffer()->BindBase();
-					material->UpdateUniformBuffer();
-				}
+	// Shadow Cascade...
+	RenderShadowCascade* shadow = GetEnvironment().sunShadow.get();
 
 
-				// Finally: Draw Primitives...
-				for (uint32_t ip = 0; ip < materialBatch.primitives.size(); ++ip)
-				{
-					RenderPrimitive* prim = primitives[materialBatch.primitives[ip]];
+	for (uint32_t i = 0; i < shadow->GetNumCascade(); ++i)
+	{
+		ShadowCascadeData& cascade = shadow->GetCascade(i);
+		glm::ivec2 shadowSize = cascade.shadowPass->GetSize();
 
-					// Transform.
-					if (prim->isSkinned)
-					{
-						auto skinned = static_cast<RenderSkinnedMesh*>(prim);
+		// Cached cascade, keep its last shadow map.
+		if (!cascade.isUpdate)
+			continue;
 
-						// Model & Normal & Bones.
-						trBoneData.modelMatrix = prim->GetWorldMatrix();
-						trBoneData.normalMatrix = prim->GetWorldMatrix();
-						memcpy(&trBoneData.bones, skinned->GetBones()->data(), sizeof(glm::mat4) * skinned->GetBones()->size());
-						transformBoneUniform->UpdateData(sizeof(TransformBoneVertexData), 0, (void*)(&trBoneData));
-					}
-					else
-					{
-						// Model & Normal.
-						trData.modelMatrix = prim->GetWorldMatrix();
-						trData.normalMatrix = prim->GetWorldMatrix();
-						transformUniform->UpdateData(sizeof(TransformVertexData), 0, &trData);
-					}
+		++stats.shadowCascades;
 
+		// Begin...
+		cascade.shadowPass->Begin(glm::ivec4(0, 0, shadowSize.x, shadowSize.y), true);
 
-					// Draw...
-					prim->Draw(shader, true);
-				}
-			}
-		}
-		
+		// Shadow Transform...
+		shadowUB->SetDataValue(0, cascade.viewProj);
+		shadowUB->Update();
+
+		// Draw...
+		DrawBatch(cascade.shadowBatch.GetDraws(), true, stats.shadowDraws);
 	}
 
 	glBindVertexArray(0);
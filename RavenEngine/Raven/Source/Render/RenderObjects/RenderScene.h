@@ -19,6 +19,12 @@
 #include "Utilities/Core.h"
 #include "Math/Frustum.h"
 #include "RenderBatch.h"
+#include "RenderFrameArena.h"
+#include "RenderLightClusters.h"
+#include "RenderLightGrid.h"
+#include "RenderPrimitiveCollector.h"
+#include "RenderSceneCuller.h"
+#include "Render/RenderResource/Shader/RenderShaderInput.h"
 
 
 #include "glm/matrix.hpp"
@@ -28,6 +34,13 @@
 #define CAPTURE_SHOT 0
 
 
+// The initial size of the per-frame transform buffer, grows if a frame needs more.
+#define RENDER_SCENE_TRANSFORM_FRAME_SIZE (1024 * 1024)
+
+// The max number of mesh LODs tracked by the scene stats, higher levels are added to the last one.
+#define RENDER_STATS_MAX_LODS 8
+
+
 
 
 namespace Raven
@@ -37,8 +50,8 @@ namespace Raven
 	class PrimitiveComponent;
 	class RenderLight;
 	class UniformBuffer;
+	class UniformRingBuffer;
 	class RenderShadowCascade;
-	class RenderPrimitiveCollector;
 	class ITexture;
 
 
@@ -75,14 +88,35 @@ namespace Raven
 
 
 
-	// Holds data of an entity with a primitive component.
-	struct ScenePrimitiveData
+	// Statistics of the last built scene.
+	struct RenderSceneStats
 	{
-		// The Primitive Transform.
-		Transform* tr;
+		// The number of visible triangles drawn at each mesh LOD level.
+		uint32_t lodTriangles[RENDER_STATS_MAX_LODS];
+
+		// The number of visible primitives drawn at each mesh LOD level.
+		uint32_t lodPrimitives[RENDER_STATS_MAX_LODS];
+
+		// The number of foliage instances visible in the view.
+		uint32_t foliageInstances;
+
+		// The number of bytes uploaded for drawing foliage, zero if the foliage didn't change since the last frame.
+		uint32_t foliageUploadBytes;
+
+		// The number of shadow cascades rendered this frame, cached cascades are not counted.
+		uint32_t shadowCascades;
+
+		// The number of lights assigned to all clusters of the view.
+		uint32_t clusterLightRefs;
 
-		// The Primitive Component.
-		PrimitiveComponent* comp;
+		// The draws & state changes of the deferred pass.
+		RenderBatchStats deferredDraws;
+
+		// The draws & state changes of the shadow pass, for all cascades.
+		RenderBatchStats shadowDraws;
+
+		// Reset All Stats.
+		void Reset();
 	};
 
 
@@ -158,14 +192,32 @@ namespace Raven
 
 		// Return the light in the scene.
 		inline const std::vector<RenderLight*>& GetLights() { return rlights; }
+
+		// Return the lights assigned to the clusters of the view.
+		inline const RenderLightClusters& GetLightClusters() const { return lightClusters; }
 		
 		// Return true if the scene want to draw the 2D grid.
 		inline bool IsGrid() { return isGrid; }
 
+		// Return the arena used to allocate the render data of the current frame.
+		inline const RenderFrameArena& GetFrameArena() const { return frameArena; }
+
+		// Return the stats of the last built scene.
+		inline const RenderSceneStats& GetStats() const { return stats; }
+
+		// Set the bias applied to the view distance when selecting mesh LODs, higher values switch to lower LODs earlier.
+		inline void SetLODBias(float bias) { collector.SetLODBias(bias); }
+
+		// Return the mesh LOD selection bias.
+		inline float GetLODBias() const { return collector.GetLODBias(); }
+
 	private:
 		// Collect view & projection from the scene.
 		void CollectSceneView(Scene* scene);
 
+		// Refit the scene bounds tree & invalidate the cached shadow cascades that the changed bounds intersect.
+		void UpdateSceneBounds(Scene* scene);
+
 		// Collect lights from the scene.
 		void CollectSceneLights(Scene* scene);
 
@@ -175,18 +227,25 @@ namespace Raven
 		// Traverse the scene and collect primitives that needs to be rendered.
 		void TraverseScene(Scene* scene);
 
-		// Gather all lights that intesect with the bounding sphere.
-		void GatherLights(const glm::vec3& center, float radius, std::vector<RenderLight*>& outLights);
+		// Write the transforms of all the frame primitives to the transform ring buffer, once for each primitive.
+		void UploadTransforms();
+
+		// Bind the transform of the primitive from the transform ring buffer.
+		void BindTransform(RenderPrimitive* prim);
+
+		// Draw a sorted list of batch draws, binding shaders & materials only when they change.
+		// @param isShadow: if true draw with the shadow shaders.
+		void DrawBatch(const std::vector<RenderBatchDraw>& draws, bool isShadow, RenderBatchStats& outStats);
+
 
-		// Gather all Primitive Components from scene.
+		// Gather the Primitive Components that may be visible in the view or the shadow cascades using the scene bounds tree.
 		void GatherScenePrimitives(Scene* scene, std::vector<ScenePrimitiveData>& outPrimitivesComp);
 
 		// Create New Primitive to render.
 		template<class PrimitiveType>
 		PrimitiveType* NewPrimitive()
 		{
-			// TODO: Memeory management for dynamic primitives.
-			PrimitiveType* prim = new PrimitiveType();
+			PrimitiveType* prim = frameArena.New<PrimitiveType>();
 			prim->indexInScene = rprimitives.size();
 			rprimitives.push_back(prim);
 
@@ -197,8 +256,7 @@ namespace Raven
 		template<class LightType>
 		inline LightType* NewLight()
 		{
-			// TODO: Memeory management for lights.
-			LightType* light = new LightType();
+			LightType* light = frameArena.New<LightType>();
 			light->indexInScene = rlights.size();
 			rlights.push_back(light);
 
@@ -254,12 +312,45 @@ namespace Raven
 		// Scene Enviornment Data.
 		RenderSceneEnvironment environment;
 
+		// The lights of the view assigned to clusters, built in RenderScene::CollectSceneLights().
+		RenderLightClusters lightClusters;
+
+		// Spatial grid of the lights, used to gather the lights of forward primitives.
+		RenderLightGrid lightGrid;
+
+		// Arena for allocating dynamic primitives, lights and their lists, reset every frame in Clear().
+		RenderFrameArena frameArena;
+
 		// Dynamic Primitives Container.
 		std::vector<RenderPrimitive*> rprimitives;
 
-		// Transform Uniform Buffers.
+		// Collector used while traversing the scene.
+		RenderPrimitiveCollector collector;
+
+		// Primitive components gathered from the scene, kept between frames to reuse its memory.
+		std::vector<ScenePrimitiveData> scenePrimitives;
+
+		// The gather stamp of each entity index, used to gather entities found by multiple frustum queries once.
+		std::vector<uint32_t> gatherStamps;
+
+		// The stamp of the current gather.
+		uint32_t gatherStamp;
+
+		// Culls the gathered scene primitives in parallel chunks.
+		RenderSceneCuller culler;
+
+		// The terrain bins drawn this frame, first: drawn in the view, second: mask of shadow cascades.
+		std::vector< std::pair<bool, uint32_t> > terrainDrawnBins;
+
+		// The instance ranges of the foliage layer being collected, in the view & in each shadow cascade.
+		std::vector<glm::uvec2> foliageViewRanges;
+		std::vector<glm::uvec2> foliageShadowRanges[RENDER_MAX_SHADOW_CASCADE];
+
+		// Transform Uniform Buffer, only used by debug primitives.
 		Ptr<UniformBuffer> transformUniform;
-		Ptr<UniformBuffer> transformBoneUniform;
+
+		// Transforms & Bones of all the frame primitives, written once after culling.
+		Ptr<UniformRingBuffer> transformRing;
 
 		// Lights in the scene.
 		std::vector<RenderLight*> rlights;
@@ -273,6 +364,9 @@ namespace Raven
 		// Default textures assigned to materials.
 		std::vector< Ptr<ITexture> > defaultTextures;
 
+		// The stats of the last built scene.
+		RenderSceneStats stats;
+
 	};
 
 
@@ -0,0 +1,144 @@
+/*
+ * Developed by Raven Group at the University  of Leeds
+ * Copyright (C) 2021 Ammar Herzallah, Ben Husle, Thomas Moreno Cooper, Sulagna Sinha & Tian Zeng
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3 of the License.
+ *
+ * THIS PROGRAM IS DISTRIBUTED IN THE HOPE THAT IT WILL BE USEFUL,
+ * BUT WITHOUT ANY WARRANTY; WITHOUT EVEN THE IMPLIED WARRANTY OF
+ * MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE.  SEE THE
+ * GNU GENERAL PUBLIC LICENSE FOR MORE DETAILS.
+ */
+#include "RenderSceneCuller.h"
+#include "RenderShadow.h"
+
+
+
+
+namespace Raven {
+
+
+
+void RenderSceneCuller::Cull(const std::vector<ScenePrimitiveData>& primitives, const glm::vec3& viewPos,
+	const MathUtils::Frustum& frustum, const RenderShadowCascade* sunShadow)
+{
+	// OpenMP loops need a signed index, all the counts are signed to match it.
+	const int32_t numPrimitives = (int32_t)primitives.size();
+	const int32_t numChunks = (numPrimitives + RENDER_SCENE_CULL_CHUNK_SIZE - 1) / RENDER_SCENE_CULL_CHUNK_SIZE;
+
+	if ((int32_t)chunks.size() < numChunks)
+		chunks.resize(numChunks);
+
+	const bool isSunShadow = sunShadow != nullptr;
+
+
+	// Each chunk is culled by a single job that only write to its own visible list.
+#pragma omp parallel for schedule(dynamic, 1) if(numChunks > 1)
+	for (int32_t ic = 0; ic < numChunks; ++ic)
+	{
+		std::vector<ScenePrimitiveCullData>& chunk = chunks[ic];
+		chunk.clear();
+
+		const int32_t begin = ic * RENDER_SCENE_CULL_CHUNK_SIZE;
+		const int32_t end = glm::min(begin + RENDER_SCENE_CULL_CHUNK_SIZE, numPrimitives);
+
+		for (int32_t i = begin; i < end; ++i)
+		{
+			const ScenePrimitiveData& scenePrim = primitives[i];
+
+			// Compute World Bounds.
+			MathUtils::BoundingBox bounds = scenePrim.localBounds->Transform(*scenePrim.worldMatrix);
+
+			// distance to view.
+			glm::vec3 v = (viewPos - bounds.GetCenter());
+			float viewDist2 = v.x * v.x + v.y * v.y + v.z * v.z;
+
+			// Clipping based on distance...
+			if (scenePrim.clipDistance > 0.0f)
+			{
+				float clipDist2 = scenePrim.clipDistance;
+				clipDist2 = clipDist2 * clipDist2;
+
+				if (viewDist2 > clipDist2)
+				{
+					// Don't Draw Component...
+					continue;
+				}
+			}
+
+			ScenePrimitiveCullData data;
+			data.index = i;
+			data.viewDist2 = viewDist2;
+			data.isViewCulled = false;
+			bounds.GetSphere(data.center, data.radius);
+
+			// Shadow mask is only a flag until the batch test, non-zero if the primitive may cast shadow.
+			data.shadowMask = scenePrim.isCastShadow && isSunShadow ? 1u : 0u;
+
+			chunk.push_back(data);
+		}
+
+
+		// View & Shadow Culling, 4 primitives at a time...
+		const uint32_t numCandidates = (uint32_t)chunk.size();
+		uint32_t numVisible = 0;
+
+		for (uint32_t ib = 0; ib < numCandidates; ib += 4)
+		{
+			const uint32_t count = glm::min(4u, numCandidates - ib);
+
+			// The last batch repeats its last primitive to fill the lanes.
+			glm::vec3 centers[4];
+			float radii[4];
+
+			for (uint32_t l = 0; l < 4; ++l)
+			{
+				const ScenePrimitiveCullData& data = chunk[ib + glm::min(l, count - 1)];
+				centers[l] = data.center;
+				radii[l] = data.radius;
+			}
+
+			uint32_t viewMask = frustum.IsInFrustum2DX4(centers, radii);
+			uint32_t shadowMasks[4] = { 0, 0, 0, 0 };
+
+			if (isSunShadow)
+			{
+				sunShadow->IsInShadowX4(centers, radii, shadowMasks);
+			}
+
+			for (uint32_t l = 0; l < count; ++l)
+			{
+				ScenePrimitiveCullData data = chunk[ib + l];
+				data.isViewCulled = ((viewMask >> l) & 1u) == 0;
+				data.shadowMask = data.shadowMask != 0 ? shadowMasks[l] : 0;
+
+				// Test if its in scene view frustum?
+				if (data.isViewCulled && data.shadowMask == 0)
+				{
+					// Don't Draw Component...
+					continue;
+				}
+
+				// Compact in place, never overwrite a candidate that wasn't tested yet.
+				chunk[numVisible++] = data;
+			}
+		}
+
+		chunk.resize(numVisible);
+	}
+
+
+	// Merge in chunk order, so the result is the same regardless of the jobs scheduling.
+	visible.clear();
+
+	for (int32_t ic = 0; ic < numChunks; ++ic)
+	{
+		visible.insert(visible.end(), chunks[ic].begin(), chunks[ic].end());
+	}
+}
+
+
+
+} // End of namespace Raven.
@@ -0,0 +1,112 @@
+/*
+ * Developed by Raven Group at the University  of Leeds
+ * Copyright (C) 2021 Ammar Herzallah, Ben Husle, Thomas Moreno Cooper, Sulagna Sinha & Tian Zeng
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3 of the License.
+ *
+ * THIS PROGRAM IS DISTRIBUTED IN THE HOPE THAT IT WILL BE USEFUL,
+ * BUT WITHOUT ANY WARRANTY; WITHOUT EVEN THE IMPLIED WARRANTY OF
+ * MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE.  SEE THE
+ * GNU GENERAL PUBLIC LICENSE FOR MORE DETAILS.
+ */
+#pragma once
+
+
+
+
+#include "Utilities/Core.h"
+#include "Math/Frustum.h"
+#include "Math/BoundingBox.h"
+
+
+#include "glm/matrix.hpp"
+#include <vector>
+
+
+
+// The number of scene primitives culled by a single job while traversing the scene.
+#define RENDER_SCENE_CULL_CHUNK_SIZE 512
+
+
+
+
+namespace Raven
+{
+	class Transform;
+	class PrimitiveComponent;
+	class RenderShadowCascade;
+
+
+
+
+	// Holds data of an entity with a primitive component.
+	struct ScenePrimitiveData
+	{
+		// The Primitive Transform.
+		Transform* tr;
+
+		// The Primitive Component.
+		PrimitiveComponent* comp;
+
+		// The Primitive World Matrix, resolved while gathering so culling jobs only read it.
+		const glm::mat4* worldMatrix;
+
+		// The Primitive local bounds, clip distance & cast shadow flag, resolved while gathering.
+		const MathUtils::BoundingBox* localBounds;
+		float clipDistance;
+		bool isCastShadow;
+	};
+
+
+
+
+	// Culling results of a visible scene primitive.
+	struct ScenePrimitiveCullData
+	{
+		// The index of the primitive in the gathered scene primitives.
+		uint32_t index;
+
+		// The world bounding sphere.
+		glm::vec3 center;
+		float radius;
+
+		// The squared distance to the view.
+		float viewDist2;
+
+		// True if the primitive is outside the view frustum and only drawn for shadows.
+		bool isViewCulled;
+
+		// Mask of shadow cascades that the primitive intersect.
+		uint32_t shadowMask;
+	};
+
+
+
+
+	// RenderSceneCuller:
+	//		- cull the gathered scene primitives against the view & the sun shadow cascades in parallel chunks.
+	//		- only reads the gathered data, so it runs on the CPU without a render context.
+	//
+	class RenderSceneCuller
+	{
+	public:
+		// Cull the primitives, the visible ones are merged in chunk order so the result is the same
+		// regardless of the jobs scheduling.
+		// @param sunShadow: the sun shadow cascades, null if there is no sun.
+		void Cull(const std::vector<ScenePrimitiveData>& primitives, const glm::vec3& viewPos,
+			const MathUtils::Frustum& frustum, const RenderShadowCascade* sunShadow);
+
+		// Return the primitives that survived the last culling.
+		inline const std::vector<ScenePrimitiveCullData>& GetVisible() const { return visible; }
+
+	private:
+		// Visible primitives of each culling chunk, kept between frames to reuse their memory.
+		std::vector< std::vector<ScenePrimitiveCullData> > chunks;
+
+		// The primitives that survived culling.
+		std::vector<ScenePrimitiveCullData> visible;
+	};
+
+}
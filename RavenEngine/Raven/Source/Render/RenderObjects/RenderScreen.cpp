@@ -93,7 +93,8 @@ RenderScreen* RenderScreen::Create()
 
 void RenderScreen::Draw(GLShader* shader)
 {
-	shader->SetUniform("inRTSize", rtSize);
+	static const GLUniformID inRTSizeID = GLShader::GetUniformID("inRTSize");
+	shader->SetUniform(inRTSizeID, rtSize);
 	vxArray->Bind();
 	glDrawArrays(GL_TRIANGLES, 0, 3);
 }
@@ -15,6 +15,7 @@
 #include "RenderPass.h"
 
 #include "Render/OpenGL/GLTexture.h"
+#include "Render/RenderResource/Shader/RenderShaderInput.h"
 
 #include "glm/matrix.hpp"
 #include "glm/gtx/transform.hpp"
@@ -32,12 +33,25 @@
 
 
 
+// The sun direction change that invalidate the cached cascades, cosine of the angle between the two directions.
+#define RENDER_SHADOW_LIGHT_CHANGE_COS 0.99999f
+
+
+
+
 namespace Raven {
 
 
 
 
 RenderShadowCascade::RenderShadowCascade()
+	: lightDir(0.0f)
+	, updateMask(0)
+	, frameCounter(0)
+	, splitLambda(RENDER_SHADOW_SPLIT_LAMBDA)
+	, lastSplitLambda(RENDER_SHADOW_SPLIT_LAMBDA)
+	, splitNear(-1.0f)
+	, shadowDistance(RENDER_SHADOW_DISTANCE)
 {
 
 }
@@ -58,63 +72,154 @@ void RenderShadowCascade::Reset()
 }
 
 
-void RenderShadowCascade::SetupCascade(uint32_t numCascade, const glm::ivec2& shadowSize)
+void RenderShadowCascade::SetupCascade(const std::vector<glm::ivec2>& shadowSizes)
 {
 	RAVEN_ASSERT(cascade.empty(), "");
-	cascade.resize(numCascade);
+	RAVEN_ASSERT(shadowSizes.size() <= RENDER_MAX_SHADOW_CASCADE, "RenderShadowCascade - Too many cascades.");
+	cascade.resize(shadowSizes.size());
 
-	for (auto& data : cascade)
+	for (uint32_t i = 0; i < cascade.size(); ++i)
 	{
-		// Shadow Mpa...
-		data.shadowMap = Ptr<GLTexture>(GLTexture::Create2D(
-			EGLFormat::Depth32,
-			shadowSize.x, shadowSize.y,
-			EGLFilter::Linear,
-			EGLWrap::ClampToBorder
-		));
-
-
-		data.shadowMap->Bind();
-		data.shadowMap->BorderColor(1.0f, 1.0f, 1.0f, 1.0f);
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_COMPARE_MODE, GL_COMPARE_REF_TO_TEXTURE);
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_COMPARE_FUNC, GL_LEQUAL);
-		data.shadowMap->Unbind();
-
-
-		// Shadow Pass...
-		data.shadowPass = Ptr<RenderPass>(new RenderPass());
-		data.shadowPass->SetDepthTexture(data.shadowMap, false);
-		data.shadowPass->SetSize(shadowSize);
-		data.shadowPass->Build();
+		ShadowCascadeData& data = cascade[i];
+
+		// The first two cascades are updated every frame, the interval doubles for each farther cascade.
+		data.updateInterval = i < 2 ? 1 : (1u << (i - 1));
+		data.isUpdate = true;
+		data.isValid = false;
+
+		CreateShadowMap(i, shadowSizes[i]);
 	}
 	
-	// Ranges...
-	cascadeRanges.resize(numCascade + 1);
-	cascadeRanges[1] = 7.0f; // Start Range
+	// Ranges, computed from the split lambda when computing the cascades.
+	cascadeRanges.resize(cascade.size() + 1, 0.0f);
+	splitNear = -1.0f;
+}
+
+
+void RenderShadowCascade::CreateShadowMap(uint32_t index, const glm::ivec2& shadowSize)
+{
+	ShadowCascadeData& data = cascade[index];
+
+	// Shadow Mpa...
+	data.shadowMap = Ptr<GLTexture>(GLTexture::Create2D(
+		EGLFormat::Depth32,
+		shadowSize.x, shadowSize.y,
+		EGLFilter::Linear,
+		EGLWrap::ClampToBorder
+	));
+
+
+	data.shadowMap->Bind();
+	data.shadowMap->BorderColor(1.0f, 1.0f, 1.0f, 1.0f);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_COMPARE_MODE, GL_COMPARE_REF_TO_TEXTURE);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_COMPARE_FUNC, GL_LEQUAL);
+	data.shadowMap->Unbind();
+
+
+	// Shadow Pass...
+	data.shadowPass = Ptr<RenderPass>(new RenderPass());
+	data.shadowPass->SetDepthTexture(data.shadowMap, false);
+	data.shadowPass->SetSize(shadowSize);
+	data.shadowPass->Build();
+}
+
+
+void RenderShadowCascade::SetCascadeResolution(uint32_t index, const glm::ivec2& shadowSize)
+{
+	if (cascade[index].shadowPass->GetSize() == shadowSize)
+		return;
 
-	for (uint32_t i = 2; i < cascadeRanges.size(); ++i)
+	CreateShadowMap(index, shadowSize);
+	cascade[index].isValid = false;
+}
+
+
+void RenderShadowCascade::SetLastCascadeRange(float distance)
+{
+	shadowDistance = distance; // End Range
+}
+
+
+void RenderShadowCascade::SetSplitLambda(float lambda)
+{
+	splitLambda = glm::clamp(lambda, 0.0f, 1.0f);
+}
+
+
+void RenderShadowCascade::ComputeSplits(float n)
+{
+	// Nothing changed?
+	if (n == splitNear && splitLambda == lastSplitLambda && shadowDistance == cascadeRanges.back())
+		return;
+
+	splitNear = n;
+	lastSplitLambda = splitLambda;
+
+	float f = shadowDistance;
+	float logNear = glm::max(n, 0.01f);
+	float numCascade = (float)cascade.size();
+	cascadeRanges.front() = n;
+	cascadeRanges.back() = f;
+
+	// Blend between logarithmic and uniform splits.
+	for (uint32_t i = 1; i < cascade.size(); ++i)
 	{
-		cascadeRanges[i] = cascadeRanges[i-1] * 2.2f;
+		float t = (float)i / numCascade;
+		float logSplit = logNear * glm::pow(f / logNear, t);
+		float uniformSplit = n + (f - n) * t;
+		cascadeRanges[i] = glm::mix(uniformSplit, logSplit, splitLambda);
 	}
 
-	cascadeRanges.back() *= 1.5;
+	// The ranges changed, all cached cascades are invalid.
+	Invalidate();
+}
+
 
+void RenderShadowCascade::SetCascadeUpdateInterval(uint32_t index, uint32_t interval)
+{
+	cascade[index].updateInterval = glm::max(interval, 1u);
 }
 
 
-void RenderShadowCascade::SetLastCascadeRange(float distance)
+void RenderShadowCascade::Invalidate()
 {
-	cascadeRanges.back() = distance; // End Range
+	for (auto& c : cascade)
+	{
+		c.isValid = false;
+	}
 }
 
 
-void RenderShadowCascade::ComputeCascade(const glm::vec3& lightDir, float fov, float a, float n, float f, glm::mat4 viewInv)
+void RenderShadowCascade::Invalidate(const glm::vec3& min, const glm::vec3& max)
+{
+	for (auto& c : cascade)
+	{
+		// The frustum of a valid cascade is the one its cached shadow map was rendered with.
+		if (c.isValid && c.frustum.IsBoxInFrustum(min, max))
+			c.isValid = false;
+	}
+}
+
+
+void RenderShadowCascade::ComputeCascade(const glm::vec3& inLightDir, float fov, float a, float n, float f, glm::mat4 viewInv)
 {
 	RAVEN_ASSERT(!cascade.empty(), "");
 	
 
 	fov = glm::radians(fov);
-	cascadeRanges.front() = n;
+	ComputeSplits(n);
+
+	// A change in the sun direction invalidate all the cached cascades.
+	bool isLightChanged = glm::dot(lightDir, inLightDir) < RENDER_SHADOW_LIGHT_CHANGE_COS;
+	lightDir = inLightDir;
+
+	++frameCounter;
+	updateMask = 0;
+
+
+	// The light space rotation, the same for all cascades and independent of the view so it doesn't shimmer.
+	glm::vec3 lightUp = glm::abs(lightDir.y) > 0.99f ? glm::vec3(0.0f, 0.0f, 1.0f) : glm::vec3(0.0f, 1.0f, 0.0f);
+	glm::mat4 lightView = glm::lookAt(glm::vec3(0.0f), lightDir, lightUp);
 
 
 	for (int32_t i = 0; i < cascade.size(); ++i)
@@ -146,46 +251,56 @@ void RenderShadowCascade::ComputeCascade(const glm::vec3& lightDir, float fov, f
 		};
 
 
-		MathUtils::BoundingBox bounds;
-		bounds.Add(viewInv * frustumCorners[0]);
-		bounds.Add(viewInv * frustumCorners[1]);
-		bounds.Add(viewInv * frustumCorners[2]);
-		bounds.Add(viewInv * frustumCorners[3]);
-		bounds.Add(viewInv * frustumCorners[4]);
-		bounds.Add(viewInv * frustumCorners[5]);
-		bounds.Add(viewInv * frustumCorners[6]);
-		bounds.Add(viewInv * frustumCorners[7]);
+		glm::vec3 corners[8];
+		glm::vec3 center(0.0f);
+		bool isCovered = cascade[i].isValid;
+
+		for (uint32_t ic = 0; ic < 8; ++ic)
+		{
+			corners[ic] = glm::vec3(viewInv * frustumCorners[ic]);
+			center += corners[ic] * 0.125f;
+
+			// The cached cascade must still contain the view slice.
+			isCovered = isCovered && cascade[i].frustum.IsInFrustum(corners[ic], 0.0f);
+		}
 
-		glm::vec3 wext = bounds.GetExtent();
-		glm::vec3 wcenter = bounds.GetCenter();
 
+		// Use the cached cascade?
+		cascade[i].isUpdate = !isCovered || isLightChanged
+			|| (frameCounter + (uint32_t)i) % cascade[i].updateInterval == 0;
 
-		glm::mat4 lightView = glm::lookAt(
-			glm::vec3(0.0f) + wcenter,
-			lightDir + wcenter,
-			glm::vec3(0.0f, 1.0f, 0.0f));
+		if (!cascade[i].isUpdate)
+			continue;
 
+		cascade[i].isValid = true;
+		updateMask |= 1u << i;
 
-		MathUtils::BoundingBox lightbounds;
-		lightbounds.Add(lightView * glm::vec4(wcenter + glm::vec3(-wext.x, -wext.y, -wext.z), 1.0f));
-		lightbounds.Add(lightView * glm::vec4(wcenter + glm::vec3( wext.x, -wext.y, -wext.z), 1.0f));
-		lightbounds.Add(lightView * glm::vec4(wcenter + glm::vec3( wext.x,  wext.y, -wext.z), 1.0f));
-		lightbounds.Add(lightView * glm::vec4(wcenter + glm::vec3(-wext.x,  wext.y, -wext.z), 1.0f));
-		lightbounds.Add(lightView * glm::vec4(wcenter + glm::vec3(-wext.x, -wext.y,  wext.z), 1.0f));
-		lightbounds.Add(lightView * glm::vec4(wcenter + glm::vec3( wext.x, -wext.y,  wext.z), 1.0f));
-		lightbounds.Add(lightView * glm::vec4(wcenter + glm::vec3( wext.x,  wext.y,  wext.z), 1.0f));
-		lightbounds.Add(lightView * glm::vec4(wcenter + glm::vec3(-wext.x,  wext.y,  wext.z), 1.0f));
 
-		glm::vec3 ext = lightbounds.GetExtent() * 1.2f;
-		
+		// Bounding sphere of the view slice, its size doesn't change with the view rotation,
+		// rounded up so floating point errors don't change the texel size.
+		float radius = 0.0f;
+
+		for (uint32_t ic = 0; ic < 8; ++ic)
+			radius = glm::max(radius, glm::length(corners[ic] - center));
+
+		radius = glm::ceil(radius * 16.0f) / 16.0f;
+
+
+		// Snap the center to the shadow map texels in light space, so static shadows don't move with the view.
+		glm::vec2 shadowSize = glm::vec2(cascade[i].shadowPass->GetSize());
+		glm::vec2 texelSize = glm::vec2(2.0f * radius) / shadowSize;
+		glm::vec3 lightCenter = glm::vec3(lightView * glm::vec4(center, 1.0f));
+		lightCenter.x = glm::floor(lightCenter.x / texelSize.x) * texelSize.x;
+		lightCenter.y = glm::floor(lightCenter.y / texelSize.y) * texelSize.y;
+
 
 		glm::mat4 lightProjection = glm::ortho(
-			-ext.x,
-			 ext.x,
-			-ext.y,
-			 ext.y,
-			-ext.z - lightFar * 0.8f,
-			 ext.z + lightFar * 0.2f
+			lightCenter.x - radius,
+			lightCenter.x + radius,
+			lightCenter.y - radius,
+			lightCenter.y + radius,
+			-lightCenter.z - radius - lightFar * 0.8f,
+			-lightCenter.z + radius + lightFar * 0.2f
 		);
 
 
@@ -197,23 +312,46 @@ void RenderShadowCascade::ComputeCascade(const glm::vec3& lightDir, float fov, f
 }
 
 
-void RenderShadowCascade::IsInShadow(const glm::vec3& center, float radius, std::vector<uint32_t>& outIndices)
+uint32_t RenderShadowCascade::IsInShadow(const glm::vec3& center, float radius) const
 {
-	outIndices.reserve(RENDER_MAX_SHADOW_CASCADE);
+	uint32_t mask = 0;
 
 	for (int32_t ic = 0; ic < cascade.size(); ++ic)
 	{
+		if (!cascade[ic].isUpdate)
+			continue;
+
 		if (cascade[ic].frustum.IsInFrustum(center, radius))
-			outIndices.push_back(ic);
+			mask |= 1u << ic;
+	}
+
+	return mask;
+}
+
+
+void RenderShadowCascade::IsInShadowX4(const glm::vec3* centers, const float* radii, uint32_t* outMasks) const
+{
+	outMasks[0] = outMasks[1] = outMasks[2] = outMasks[3] = 0;
+
+	for (int32_t ic = 0; ic < cascade.size(); ++ic)
+	{
+		if (!cascade[ic].isUpdate)
+			continue;
+
+		uint32_t inside = cascade[ic].frustum.IsInFrustumX4(centers, radii);
+
+		for (uint32_t l = 0; l < 4; ++l)
+			outMasks[l] |= ((inside >> l) & 1u) << ic;
 	}
 }
 
 
-void RenderShadowCascade::AddPrimitive(RenderPrimitive* primitive, bool isDefualtShader, std::vector<uint32_t>& shadowCascadeIndices)
+void RenderShadowCascade::AddPrimitive(RenderPrimitive* primitive, bool isDefualtShader, uint32_t cascadeMask)
 {
-	for (auto index : shadowCascadeIndices)
+	for (int32_t ic = 0; ic < cascade.size(); ++ic)
 	{
-		cascade[index].shadowBatch.Add(primitive, isDefualtShader);
+		if (cascadeMask & updateMask & (1u << ic))
+			cascade[ic].shadowBatch.Add(primitive, isDefualtShader);
 	}
 }
 
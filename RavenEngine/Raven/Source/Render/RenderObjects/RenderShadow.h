@@ -30,6 +30,19 @@
 
 
 
+
+// The default split lambda, blend the cascades splits between uniform (0.0) and logarithmic (1.0).
+#define RENDER_SHADOW_SPLIT_LAMBDA 0.9f
+
+// The default distance covered by the cascades.
+#define RENDER_SHADOW_DISTANCE 112.0f
+
+// The distance covered by the cascades in scenes with a terrain.
+#define RENDER_SHADOW_TERRAIN_DISTANCE 450.0f
+
+
+
+
 namespace Raven
 {
 	class GLTexture;
@@ -56,12 +69,23 @@ namespace Raven
 
 		// The shadow render pass for drawing into the shadow map.
 		Ptr<RenderPass> shadowPass;
+
+		// The shadow map is rendered at most once every updateInterval frames, unless invalidated.
+		uint32_t updateInterval;
+
+		// True if the shadow map is rendered this frame, otherwise the last rendered map & matrix are reused.
+		bool isUpdate;
+
+		// True if the shadow map was rendered at least once since it was invalidated.
+		bool isValid;
 	};
 
 
 
 	// RenderShadowCascaded:
 	//		- Shadow for sun directional light with cascading.
+	//		- Cascades can be cached, a cached cascade keeps its last shadow map and is only rendered when
+	//		  its update interval elapse, the sun direction change, or the view leave the cached volume.
 	class RenderShadowCascade
 	{
 	public:
@@ -75,13 +99,16 @@ namespace Raven
 		void Reset();
 
 		// Build cascade data.
-		// @param numCascade: number of cascade to build.
-		// @param shadowSize: the size of the shadow map.
-		void SetupCascade(uint32_t numCascade, const glm::ivec2& shadowSize);
+		// @param shadowSizes: the size of the shadow map of each cascade, one cascade is built for each size.
+		void SetupCascade(const std::vector<glm::ivec2>& shadowSizes);
 
-		// Compute the cascade data for a directional light.
-		// @param lightDir: the light direction that cast this shadow.
-		void ComputeCascade(const glm::vec3& lightDir, float fov, float a, float n, float f, glm::mat4 viewInv);
+		// Change the shadow map size of a cascade.
+		void SetCascadeResolution(uint32_t index, const glm::ivec2& shadowSize);
+
+		// Compute the cascade data for a directional light, each cascade is fitted to the bounding sphere of
+		// its view slice and snapped to its shadow map texels so shadows don't shimmer when the view moves.
+		// @param inLightDir: the light direction that cast this shadow.
+		void ComputeCascade(const glm::vec3& inLightDir, float fov, float a, float n, float f, glm::mat4 viewInv);
 
 
 		// Return a cascade at index.
@@ -91,18 +118,49 @@ namespace Raven
 		// Return the number of cascades.
 		inline uint32_t GetNumCascade() const { return cascade.size(); }
 
-		// Test if a sphere is inside the shaodw cascade furstum.
-		void IsInShadow(const glm::vec3& center, float radius, std::vector<uint32_t>& outIndices);
+		// Set the number of frames between updates of a cascade, 1 to update every frame.
+		void SetCascadeUpdateInterval(uint32_t index, uint32_t interval);
+
+		// Force all the cascades to update the next frame, for example when the casters in the scene changed.
+		void Invalidate();
+
+		// Force the cached cascades that intersect a box to update the next frame, for example the old & new bounds of a moved caster.
+		void Invalidate(const glm::vec3& min, const glm::vec3& max);
+
+		// Return a mask with a bit set for each cascade rendered this frame.
+		inline uint32_t GetUpdateCascadeMask() const { return updateMask; }
+
+		// Test if a sphere is inside the shaodw cascade furstums, return a mask with a bit set for each cascade it intersect,
+		// only cascades rendered this frame are tested.
+		uint32_t IsInShadow(const glm::vec3& center, float radius) const;
+
+		// Test 4 spheres at once, same as IsInShadow() for each sphere.
+		void IsInShadowX4(const glm::vec3* centers, const float* radii, uint32_t* outMasks) const;
 
 		// Add primitive to the cascade shadow scene.
-		void AddPrimitive(RenderPrimitive* primitive, bool isDefualtShader, std::vector<uint32_t>& shadowCascadeIndices);
+		// @param cascadeMask: a bit for each cascade to add the primitive to, as returned by IsInShadow().
+		void AddPrimitive(RenderPrimitive* primitive, bool isDefualtShader, uint32_t cascadeMask);
+
+		// Return a mask with all the cascades bits set.
+		inline uint32_t GetAllCascadeMask() const { return (1u << cascade.size()) - 1u; }
 
 		// Return cascade ranges.
 		inline const auto& GetCascadeRanges() const { return cascadeRanges; }
 
-		//
+		// Set the distance covered by the cascades, the end of the last cascade.
 		void SetLastCascadeRange(float distance);
 
+		// Set/Get the lambda used to split the cascades, 0.0 for uniform splits & 1.0 for logarithmic splits.
+		void SetSplitLambda(float lambda);
+		inline float GetSplitLambda() const { return splitLambda; }
+
+	private:
+		// Create the shadow map & pass of a cascade.
+		void CreateShadowMap(uint32_t index, const glm::ivec2& shadowSize);
+
+		// Compute the cascade ranges if the near, lambda or distance changed.
+		void ComputeSplits(float n);
+
 	private:
 		// Cascades.
 		std::vector<ShadowCascadeData> cascade;
@@ -113,6 +171,22 @@ namespace Raven
 		// Clip Distance for cascade shadow furstums.
 		std::vector<float> cascadeRanges;
 
+		// A bit set for each cascade rendered this frame.
+		uint32_t updateMask;
+
+		// Incremented every time the cascades are computed, used to stagger cascades updates.
+		uint32_t frameCounter;
+
+		// The lambda used to split the cascades.
+		float splitLambda;
+
+		// The lambda, near & distance the current cascade ranges were computed with.
+		float lastSplitLambda;
+		float splitNear;
+
+		// The distance covered by the cascades.
+		float shadowDistance;
+
 	};
 
 
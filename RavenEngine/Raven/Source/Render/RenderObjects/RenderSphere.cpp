@@ -174,7 +174,8 @@ void RenderSphere::SetProj(const glm::mat4& mtx)
 void RenderSphere::Draw(GLShader* shader)
 {
 	glm::mat4 viewProj = proj * view;
-	shader->SetUniform("inViewProjMatrix", viewProj);
+	static const GLUniformID inViewProjMatrixID = GLShader::GetUniformID("inViewProjMatrix");
+	shader->SetUniform(inViewProjMatrixID, viewProj);
 
 	vxArray->Bind();
 	glDrawElements(GL_TRIANGLES, numIndices, GL_UNSIGNED_INT, nullptr);
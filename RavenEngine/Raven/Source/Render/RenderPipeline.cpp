@@ -17,6 +17,7 @@
 #include "RenderTarget.h"
 #include "RenderObjects/RenderScene.h"
 #include "RenderObjects/RenderLight.h"
+#include "RenderObjects/RenderLightClusters.h"
 #include "RenderObjects/RenderScreen.h"
 #include "RenderObjects/RenderSphere.h"
 #include "RenderObjects/RenderPass.h"
@@ -26,6 +27,7 @@
 #include "RenderResource/Shader/RenderRscShader.h"
 
 #include "OpenGL/GLTexture.h"
+#include "OpenGL/GLBuffer.h"
 #include "OpenGL/GLShader.h"
 #include "OpenGL/GLFrameBuffer.h"
 
@@ -75,7 +77,9 @@ void RenderPipeline::Initialize()
 
 	// Uniforms...
 	uniforms.common = Ptr<UniformBuffer>( UniformBuffer::Create(RenderShaderInput::CommonBlock, true) );
-	uniforms.light_DEFERRED = Ptr<UniformBuffer>( UniformBuffer::Create(RenderShaderInput::LightingBlock_DEFERRED, true) );
+	uniforms.clusterLights = Ptr<GLBuffer>( GLBuffer::Create(EGLBufferType::ShaderStorage, sizeof(RenderLightClusterLight), EGLBufferUsage::DynamicDraw) );
+	uniforms.clusterCells = Ptr<GLBuffer>( GLBuffer::Create(EGLBufferType::ShaderStorage, RenderLightClusters::GetNumClusters() * sizeof(glm::uvec2), EGLBufferUsage::DynamicDraw) );
+	uniforms.clusterIndices = Ptr<GLBuffer>( GLBuffer::Create(EGLBufferType::ShaderStorage, sizeof(uint32_t), EGLBufferUsage::DynamicDraw) );
 	uniforms.light_FORWARD = Ptr<UniformBuffer>(UniformBuffer::Create(RenderShaderInput::LightingBlock_FORWARD, true));
 	uniforms.shadow = Ptr<UniformBuffer>( UniformBuffer::Create(RenderShaderInput::ShadowBlock, true) );
 	uniforms.lightShadow = Ptr<UniformBuffer>( UniformBuffer::Create(RenderShaderInput::LightShadowBlock, true) );
@@ -90,7 +94,9 @@ void RenderPipeline::Initialize()
 void RenderPipeline::Destroy()
 {
 	uniforms.common.reset();
-	uniforms.light_DEFERRED.reset();
+	uniforms.clusterLights.reset();
+	uniforms.clusterCells.reset();
+	uniforms.clusterIndices.reset();
 	uniforms.light_FORWARD.reset();
 	uniforms.shadow.reset();
 	uniforms.lightShadow.reset();
@@ -244,7 +250,9 @@ void RenderPipeline::Render()
 		// ...
 		UpdateLights_DEFERRED();
 		UpdateShadows();
-		uniforms.light_DEFERRED->BindBase();
+		uniforms.clusterLights->BindBase(RENDER_LIGHT_CLUSTER_LIGHTS_BINDING);
+		uniforms.clusterCells->BindBase(RENDER_LIGHT_CLUSTER_CELLS_BINDING);
+		uniforms.clusterIndices->BindBase(RENDER_LIGHT_CLUSTER_INDICES_BINDING);
 		uniforms.lightShadow->BindBase();
 
 		
@@ -583,7 +591,13 @@ void RenderPipeline::SetupShaders()
 		shaderDomainData.AddImport(EGLShaderStageBit::FragmentBit, "shaders/CommonLight.glsl");
 		shaderDomainData.AddImport(EGLShaderStageBit::FragmentBit, "shaders/CommonShadow.glsl");
 		shaderDomainData.AddImport(EGLShaderStageBit::FragmentBit, "shaders/Lighting.glsl");
-		shaderDomainData.AddPreprocessor("#define MAX_LIGHTS " + std::to_string(RENDER_PASS_DEFERRED_MAX_LIGHTS));
+		shaderDomainData.AddPreprocessor("#define LIGHT_CLUSTERS 1");
+		shaderDomainData.AddPreprocessor("#define LIGHT_CLUSTER_X " + std::to_string(RENDER_LIGHT_CLUSTER_X) + "u");
+		shaderDomainData.AddPreprocessor("#define LIGHT_CLUSTER_Y " + std::to_string(RENDER_LIGHT_CLUSTER_Y) + "u");
+		shaderDomainData.AddPreprocessor("#define LIGHT_CLUSTER_Z " + std::to_string(RENDER_LIGHT_CLUSTER_Z) + "u");
+		shaderDomainData.AddPreprocessor("#define LIGHT_CLUSTER_LIGHTS_BINDING " + std::to_string(RENDER_LIGHT_CLUSTER_LIGHTS_BINDING));
+		shaderDomainData.AddPreprocessor("#define LIGHT_CLUSTER_CELLS_BINDING " + std::to_string(RENDER_LIGHT_CLUSTER_CELLS_BINDING));
+		shaderDomainData.AddPreprocessor("#define LIGHT_CLUSTER_INDICES_BINDING " + std::to_string(RENDER_LIGHT_CLUSTER_INDICES_BINDING));
 		shaderDomainData.AddPreprocessor("#define SCALE_UV_WITH_TARGET 1");
 		shaderDomainData.AddPreprocessor("#define MAX_SHADOW_CASCADE " + std::to_string(RENDER_MAX_SHADOW_CASCADE));
 
@@ -595,7 +609,6 @@ void RenderPipeline::SetupShaders()
 
 		lightingShader = Ptr<RenderRscShader>( RenderRscShader::CreateCustom(shaderDomainData, shaderData) );
 		lightingShader->GetInput().AddBlockInput(RenderShaderInput::CommonBlock);
-		lightingShader->GetInput().AddBlockInput(RenderShaderInput::LightingBlock_DEFERRED);
 		lightingShader->GetInput().AddBlockInput(RenderShaderInput::LightShadowBlock);
 		lightingShader->GetInput().AddSamplerInput("inAlbedo");
 		lightingShader->GetInput().AddSamplerInput("inNormal");
@@ -799,39 +812,31 @@ void RenderPipeline::SetupSky()
 }
 
 
-void RenderPipeline::UpdateLights_DEFERRED()
+// Upload data to a storage buffer, the buffer is reallocated only when it needs to grow.
+static void UpdateStorageBuffer(GLBuffer* buffer, int dataSize, const void* data)
 {
-	static std::vector<glm::vec4> lightPos(RENDER_PASS_DEFERRED_MAX_LIGHTS);
-	static std::vector<glm::vec4> lightDir(RENDER_PASS_DEFERRED_MAX_LIGHTS);
-	static std::vector<glm::vec4> lightPower(RENDER_PASS_DEFERRED_MAX_LIGHTS);
-	static std::vector<glm::vec4> lightData(RENDER_PASS_DEFERRED_MAX_LIGHTS);
-
+	if (dataSize == 0)
+		return;
 
-	for (int32_t i = 0; i < RENDER_PASS_DEFERRED_MAX_LIGHTS; ++i)
+	if (dataSize > buffer->GetSize())
 	{
-		if (i >= rscene->GetLights().size())
-		{
-			lightData[i].r = 0.0f; // No Light.
-			continue;
-		}
-		
-		const auto& light =  rscene->GetLights()[i];
-		lightPos[i] = glm::vec4(light->postion, 0.0f);
-		lightDir[i] = glm::vec4(light->dir, 0.0f);
-		lightData[i].r = light->GetType();
-		lightData[i].g = light->innerAngle;
-		lightData[i].b = light->outerAngle;
-		lightData[i].a = light->radius;
-		lightPower[i] = light->colorAndPower;
+		buffer->UpdateData(glm::max(dataSize, buffer->GetSize() * 2), nullptr);
 	}
 
+	buffer->UpdateSubData(dataSize, 0, data);
+}
 
 
-	uniforms.light_DEFERRED->SetDataValues(0, lightDir);
-	uniforms.light_DEFERRED->SetDataValues(1, lightPos);
-	uniforms.light_DEFERRED->SetDataValues(2, lightPower);
-	uniforms.light_DEFERRED->SetDataValues(3, lightData);
-	uniforms.light_DEFERRED->Update();
+void RenderPipeline::UpdateLights_DEFERRED()
+{
+	const RenderLightClusters& clusters = rscene->GetLightClusters();
+	const auto& lights = clusters.GetLights();
+	const auto& cells = clusters.GetCells();
+	const auto& indices = clusters.GetIndices();
+
+	UpdateStorageBuffer(uniforms.clusterLights.get(), (int)(lights.size() * sizeof(RenderLightClusterLight)), lights.data());
+	UpdateStorageBuffer(uniforms.clusterCells.get(), (int)(cells.size() * sizeof(glm::uvec2)), cells.data());
+	UpdateStorageBuffer(uniforms.clusterIndices.get(), (int)(indices.size() * sizeof(uint32_t)), indices.data());
 }
 
 
@@ -35,6 +35,7 @@ namespace Raven
 	class RenderGrid;
 	class RenderRscShader;
 	class UniformBuffer;
+	class GLBuffer;
 	class GLTexture;
 	class GLShader;
 	class RenderTexFilter;
@@ -49,8 +50,10 @@ namespace Raven
 		// Common Uniform Buffer - used by all shaders.
 		Ptr<UniformBuffer> common;
 
-		// Light framebuffer used for deferred lighting data.
-		Ptr<UniformBuffer> light_DEFERRED;
+		// Storage buffers of the clustered deferred lighting, the lights, the cluster cells & their light indices.
+		Ptr<GLBuffer> clusterLights;
+		Ptr<GLBuffer> clusterCells;
+		Ptr<GLBuffer> clusterIndices;
 
 		// Light framebuffer used for forward lighting data.
 		Ptr<UniformBuffer> light_FORWARD;
@@ -115,7 +118,7 @@ namespace Raven
 		// Resize all render passes.
 		void Resize(const glm::ivec2& newSize);
 
-		// Update Light Unifrom Buffer for deferred lighting.
+		// Update the light cluster storage buffers for deferred lighting.
 		void UpdateLights_DEFERRED();
 		
 		// Update Shadows Unifrom Buffer..
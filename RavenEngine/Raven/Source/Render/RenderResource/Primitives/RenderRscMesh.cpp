@@ -17,6 +17,12 @@
 
 #include "Render/OpenGL/GLVertexArray.h"
 #include "Render/OpenGL/GLBuffer.h"
+#include "GL/glew.h"
+
+
+#include "glm/common.hpp"
+#include "glm/packing.hpp"
+#include <cstring>
 
 
 
@@ -25,12 +31,54 @@ namespace Raven {
 
 
 
+// Octahedral encoding of a unit vector, mapping the octahedron faces to the [-1, 1] square.
+static glm::vec2 EncodeOctahedral(const glm::vec3& v)
+{
+	float sum = glm::abs(v.x) + glm::abs(v.y) + glm::abs(v.z);
+
+	if (sum <= 0.0f)
+		return glm::vec2(0.0f);
+
+	glm::vec3 n = v / sum;
+	glm::vec2 e(n.x, n.y);
+
+	// Fold the lower hemisphere over the diagonals.
+	if (n.z < 0.0f)
+	{
+		e.x = (1.0f - glm::abs(n.y)) * (n.x >= 0.0f ? 1.0f : -1.0f);
+		e.y = (1.0f - glm::abs(n.x)) * (n.y >= 0.0f ? 1.0f : -1.0f);
+	}
+
+	return e;
+}
+
+
+// Return the vertex attribute or zero if the attribute is missing.
+template<class T>
+static inline T GetAttribute(const std::vector<T>& data, size_t index)
+{
+	return index < data.size() ? data[index] : T(0.0f);
+}
+
+
+// Write a value at an offset in the vertex data.
+template<class T>
+static inline void WriteAttribute(uint8_t* vertex, int32_t offset, const T& value)
+{
+	memcpy(vertex + offset, &value, sizeof(T));
+}
+
+
+
+
 RenderRscMesh::RenderRscMesh()
 	: vxarray(nullptr)
-	, positionBuffer(nullptr)
-	, normalBuffer(nullptr)
-	, texCoordBuffer(nullptr)
+	, vertexBuffer(nullptr)
 	, indexBuffer(nullptr)
+	, numIndices(0)
+	, indexType(EGLTypes::UnsignedInt)
+	, vertexBytes(0)
+	, indexBytes(0)
 {
 
 }
@@ -39,9 +87,7 @@ RenderRscMesh::RenderRscMesh()
 RenderRscMesh::~RenderRscMesh()
 {
 	delete vxarray;
-	delete positionBuffer;
-	delete normalBuffer;
-	delete texCoordBuffer;
+	delete vertexBuffer;
 	delete indexBuffer;
 }
 
@@ -50,90 +96,179 @@ void RenderRscMesh::Load(const std::vector<glm::vec3>& positions,
 	const std::vector<glm::vec3>& normals, const std::vector<glm::vec3>& tangents,
 	const std::vector<glm::vec2>& texCoord, const std::vector<unsigned int>& indices)
 {
-	// Create/Update Position Buffer.
-	positionBuffer = GLBuffer::Create(
-		EGLBufferType::Array, 
-		(int)(positions.size() * sizeof(glm::vec3)),
-		positions.data(),
-		EGLBufferUsage::StaticDraw
-	);
+	const size_t numVertices = positions.size();
 
-	// Create/Update Normal Buffer.
-	normalBuffer = GLBuffer::Create(
-		EGLBufferType::Array,
-		(int)(normals.size() * sizeof(glm::vec3)),
-		normals.data(),
-		EGLBufferUsage::StaticDraw
-	);
+#if RENDER_MESH_COMPACT_VERTEX
+	// Half float texture coordinates only if they keep their precision.
+	bool isHalfUV = true;
 
-	// Create/Update Tangent Buffer.
-	tangentBuffer = GLBuffer::Create(
-		EGLBufferType::Array,
-		(int)(tangents.size() * sizeof(glm::vec3)),
-		tangents.data(),
-		EGLBufferUsage::StaticDraw
-	);
+	for (const auto& uv : texCoord)
+	{
+		if (glm::abs(uv.x) > RENDER_MESH_HALF_UV_RANGE || glm::abs(uv.y) > RENDER_MESH_HALF_UV_RANGE)
+		{
+			isHalfUV = false;
+			break;
+		}
+	}
 
-	// Create/Update TexCoordinate Buffer.
-	texCoordBuffer = GLBuffer::Create(
+	// Layout: Position(float3), Normal(snorm16x2), Tangent(snorm16x2), TexCoord(half2 or float2).
+	const int32_t posOffset = 0;
+	const int32_t normalOffset = posOffset + sizeof(glm::vec3);
+	const int32_t tangentOffset = normalOffset + sizeof(uint32_t);
+	const int32_t texCoordOffset = tangentOffset + sizeof(uint32_t);
+	const int32_t stride = texCoordOffset + (isHalfUV ? sizeof(uint32_t) : sizeof(glm::vec2));
+
+#else
+	// Layout: Position(float3), Normal(float3), Tangent(float3), TexCoord(float2).
+	const int32_t posOffset = 0;
+	const int32_t normalOffset = posOffset + sizeof(glm::vec3);
+	const int32_t tangentOffset = normalOffset + sizeof(glm::vec3);
+	const int32_t texCoordOffset = tangentOffset + sizeof(glm::vec3);
+	const int32_t stride = texCoordOffset + sizeof(glm::vec2);
+
+#endif
+
+
+	// Interleave the vertex data...
+	std::vector<uint8_t> vertexData(numVertices * stride);
+
+	for (size_t i = 0; i < numVertices; ++i)
+	{
+		uint8_t* vertex = &vertexData[i * stride];
+		WriteAttribute(vertex, posOffset, positions[i]);
+
+#if RENDER_MESH_COMPACT_VERTEX
+		WriteAttribute(vertex, normalOffset, glm::packSnorm2x16(EncodeOctahedral(GetAttribute(normals, i))));
+		WriteAttribute(vertex, tangentOffset, glm::packSnorm2x16(EncodeOctahedral(GetAttribute(tangents, i))));
+
+		if (isHalfUV)
+			WriteAttribute(vertex, texCoordOffset, glm::packHalf2x16(GetAttribute(texCoord, i)));
+		else
+			WriteAttribute(vertex, texCoordOffset, GetAttribute(texCoord, i));
+#else
+		WriteAttribute(vertex, normalOffset, GetAttribute(normals, i));
+		WriteAttribute(vertex, tangentOffset, GetAttribute(tangents, i));
+		WriteAttribute(vertex, texCoordOffset, GetAttribute(texCoord, i));
+#endif
+	}
+
+	// Create Vertex Buffer.
+	vertexBytes = (uint32_t)vertexData.size();
+	vertexBuffer = GLBuffer::Create(
 		EGLBufferType::Array,
-		(int)(texCoord.size() * sizeof(glm::vec2)),
-		texCoord.data(),
+		(int)vertexBytes,
+		vertexData.data(),
 		EGLBufferUsage::StaticDraw
 	);
 
-	// Create/Update Index Buffer.
+
+	// Create Index Buffer, 16-bit indices if possible.
 	numIndices = indices.size();
-	indexBuffer = GLBuffer::Create(
-		EGLBufferType::Element,
-		(int)(indices.size() * sizeof(unsigned int)),
-		indices.data(),
-		EGLBufferUsage::StaticDraw
-	);
+
+	if (numVertices < 65536)
+	{
+		std::vector<uint16_t> indices16(indices.begin(), indices.end());
+
+		indexType = EGLTypes::UnsignedShort;
+		indexBytes = (uint32_t)(indices16.size() * sizeof(uint16_t));
+		indexBuffer = GLBuffer::Create(
+			EGLBufferType::Element,
+			(int)indexBytes,
+			indices16.data(),
+			EGLBufferUsage::StaticDraw
+		);
+	}
+	else
+	{
+		indexType = EGLTypes::UnsignedInt;
+		indexBytes = (uint32_t)(indices.size() * sizeof(unsigned int));
+		indexBuffer = GLBuffer::Create(
+			EGLBufferType::Element,
+			(int)indexBytes,
+			indices.data(),
+			EGLBufferUsage::StaticDraw
+		);
+	}
 
 
 
 	// Build Vertex Input Description...
-	std::vector<GLVABuildAttribData> attributes{
+	attributes = {
 			// Attribute 0 - Positions
 			GLVABuildAttribData(
-				positionBuffer,    // Buffer
+				vertexBuffer,      // Buffer
 				0,                 // Index
 				3,                 // Type-Size
 				EGLTypes::Float,   // Type
-				sizeof(glm::vec3), // Stride
-				0                  // offset
+				stride,            // Stride
+				posOffset          // offset
 			),
 
+#if RENDER_MESH_COMPACT_VERTEX
+			// Attribute 1 - Normals, Octahedral.
+			GLVABuildAttribData(
+				vertexBuffer,      // Buffer
+				1,                 // Index
+				2,                 // Type-Size
+				EGLTypes::Short,   // Type
+				stride,            // Stride
+				normalOffset,      // offset
+				0,                 // Instance
+				true               // Normalized
+			),
+
+			// Attribute 2 - Tangents, Octahedral.
+			GLVABuildAttribData(
+				vertexBuffer,      // Buffer
+				2,                 // Index
+				2,                 // Type-Size
+				EGLTypes::Short,   // Type
+				stride,            // Stride
+				tangentOffset,     // offset
+				0,                 // Instance
+				true               // Normalized
+			),
+
+			// Attribute 3 - TexCoords
+			GLVABuildAttribData(
+				vertexBuffer,      // Buffer
+				3,                 // Index
+				2,                 // Type-Size
+				isHalfUV ? EGLTypes::HalfFloat : EGLTypes::Float, // Type
+				stride,            // Stride
+				texCoordOffset     // offset
+			)
+#else
 			// Attribute 1 - Normals
 			GLVABuildAttribData(
-				normalBuffer,      // Buffer
+				vertexBuffer,      // Buffer
 				1,                 // Index
 				3,                 // Type-Size
 				EGLTypes::Float,   // Type
-				sizeof(glm::vec3), // Stride
-				0                  // offset
+				stride,            // Stride
+				normalOffset       // offset
 			),
 
 			// Attribute 2 - Tangents
 			GLVABuildAttribData(
-				tangentBuffer,     // Buffer
+				vertexBuffer,      // Buffer
 				2,                 // Index
 				3,                 // Type-Size
 				EGLTypes::Float,   // Type
-				sizeof(glm::vec3), // Stride
-				0                  // offset
+				stride,            // Stride
+				tangentOffset      // offset
 			),
 
 			// Attribute 3 - TexCoords
 			GLVABuildAttribData(
-				texCoordBuffer,		 // Buffer
+				vertexBuffer,      // Buffer
 				3,                 // Index
 				2,                 // Type-Size
 				EGLTypes::Float,   // Type
-				sizeof(glm::vec2), // Stride
-				0                  // offset
+				stride,            // Stride
+				texCoordOffset     // offset
 			)
+#endif
 	};
 
 
@@ -321,6 +456,8 @@ RenderRscMeshInstance::RenderRscMeshInstance()
 	, instanceTransform(nullptr)
 	, instanceBufferOwner(false)
 {
+	for (int32_t i = 0; i < (int32_t)ERenderInstanceList::Count; ++i)
+		drawCommands[i] = nullptr;
 
 }
 
@@ -332,6 +469,9 @@ RenderRscMeshInstance::~RenderRscMeshInstance()
 		delete instanceTransform;
 	}
 
+	for (int32_t i = 0; i < (int32_t)ERenderInstanceList::Count; ++i)
+		delete drawCommands[i];
+
 	delete vxarray;
 }
 
@@ -359,48 +499,10 @@ void RenderRscMeshInstance::Load(GLBuffer* instanceBuffer, int32_t iniSize, Rend
 
 
 
-	// Build Vertex Input Description...
-	std::vector<GLVABuildAttribData> attributes{
-		// Attribute 0 - Positions
-		GLVABuildAttribData(
-			mesh->positionBuffer,   // Buffer
-			0,                      // Index
-			3,                      // Type-Size
-			EGLTypes::Float,        // Type
-			sizeof(glm::vec3),      // Stride
-			0                       // offset
-		),
-
-		// Attribute 1 - Normals
-		GLVABuildAttribData(
-			mesh->normalBuffer,   // Buffer
-			1,                    // Index
-			3,                    // Type-Size
-			EGLTypes::Float,      // Type
-			sizeof(glm::vec3),    // Stride
-			0                     // offset
-		),
-
-		// Attribute 2 - Tangents
-		GLVABuildAttribData(
-			mesh->tangentBuffer,  // Buffer
-			2,                    // Index
-			3,                    // Type-Size
-			EGLTypes::Float,      // Type
-			sizeof(glm::vec3),    // Stride
-			0                     // offset
-		),
-
-		// Attribute 3 - TexCoords
-		GLVABuildAttribData(
-			mesh->texCoordBuffer,	 // Buffer
-			3,                     // Index
-			2,                     // Type-Size
-			EGLTypes::Float,       // Type
-			sizeof(glm::vec2),     // Stride
-			0                      // offset
-		),
+	// Build Vertex Input Description, the mesh attributes followed by the instance transform...
+	std::vector<GLVABuildAttribData> attributes = mesh->attributes;
 
+	attributes.insert(attributes.end(), {
 		// -- -- -- -- -- -- -- -- -- -- --
 		// Attribute 4,5,6,7 - Instance Transform
 		GLVABuildAttribData(
@@ -439,7 +541,7 @@ void RenderRscMeshInstance::Load(GLBuffer* instanceBuffer, int32_t iniSize, Rend
 			3 * sizeof(glm::vec4),        // offset
 			1                             // Instance
 		)
-	};
+	});
 
 
 
@@ -464,5 +566,64 @@ void RenderRscMeshInstance::UpdateTransforms(const std::vector<glm::mat4>& trans
 }
 
 
+int32_t RenderRscMeshInstance::UpdateDrawRanges(ERenderInstanceList list, const std::vector<glm::uvec2>& ranges)
+{
+	int32_t listIndex = (int32_t)list;
+
+	// Same ranges as the last upload?
+	if (drawCommands[listIndex] && ranges == drawRanges[listIndex])
+		return 0;
+
+	drawRanges[listIndex] = ranges;
+
+	if (ranges.empty())
+		return 0;
+
+	// Build the commands in the reused scratch memory.
+	std::vector<DrawElementsIndirectCommand>& commands = commandsScratch;
+	commands.resize(ranges.size());
+
+	for (size_t i = 0; i < ranges.size(); ++i)
+	{
+		commands[i].count = mesh->GetNumIndices();
+		commands[i].instanceCount = ranges[i].y;
+		commands[i].firstIndex = 0;
+		commands[i].baseVertex = 0;
+		commands[i].baseInstance = ranges[i].x;
+	}
+
+	int32_t newSize = (int32_t)(commands.size() * sizeof(DrawElementsIndirectCommand));
+
+	if (!drawCommands[listIndex])
+	{
+		drawCommands[listIndex] = GLBuffer::Create(EGLBufferType::DrawIndirect, newSize, &commands[0], EGLBufferUsage::DynamicDraw);
+	}
+	else if (newSize <= drawCommands[listIndex]->GetSize())
+	{
+		drawCommands[listIndex]->UpdateSubData(newSize, 0, &commands[0]);
+	}
+	else
+	{
+		drawCommands[listIndex]->UpdateData(newSize, &commands[0]);
+	}
+
+	return newSize;
+}
+
+
+void RenderRscMeshInstance::DrawIndirect(ERenderInstanceList list)
+{
+	int32_t listIndex = (int32_t)list;
+
+	if (drawRanges[listIndex].empty())
+		return;
+
+	vxarray->Bind();
+	drawCommands[listIndex]->Bind();
+	glMultiDrawElementsIndirect(GL_TRIANGLES, mesh->GetIndexType(), nullptr, (GLsizei)drawRanges[listIndex].size(), 0);
+	drawCommands[listIndex]->Unbind();
+}
+
+
 
 } // End of namespace Raven.
@@ -18,6 +18,8 @@
 
 
 #include "RenderRscPrimitive.h"
+#include "Render/OpenGL/GLVertexArray.h"
+#include "Render/RenderResource/Shader/RenderShaderInput.h"
 
 #include "glm/vec3.hpp"
 #include "glm/vec2.hpp"
@@ -28,6 +30,16 @@
 
 
 
+// If 1 meshes use a compact interleaved vertex, octahedral normals & tangents and half float
+// texture coordinates, otherwise the interleaved vertex is all floats.
+#define RENDER_MESH_COMPACT_VERTEX 1
+
+// Texture coordinates are stored as half floats only if they are all in [-range, range], otherwise as floats.
+// Half floats have 10 mantissa bits, in [-1, 1] their step is at most 1/2048 so a 1024 texture keeps sub-texel precision.
+#define RENDER_MESH_HALF_UV_RANGE 1.0f
+
+
+
 
 namespace Raven
 {
@@ -35,6 +47,8 @@ namespace Raven
 	class GLBuffer;
 
 	// RenderRscMesh:
+	//		- Mesh vertices interleaved in a single vertex buffer, see RENDER_MESH_COMPACT_VERTEX for its format.
+	//		- 16-bit indices are used if the mesh has less than 65536 vertices.
 	//
 	class RenderRscMesh : public RenderRscPrimitive
 	{
@@ -59,28 +73,42 @@ namespace Raven
 		// Return the number of indices in the mesh.
 		inline int32_t GetNumIndices() const { return numIndices; }
 
+		// Return the type of the indices to draw with.
+		inline GLENUM GetIndexType() const { return (GLENUM)indexType; }
 
-	protected:
-		// The OpenGL Vertex Array of the mesh, defines mesh vertex input.
-		GLVertexArray* vxarray;
+		// Return the size of the vertex & index buffers on the GPU in bytes.
+		inline uint32_t GetGPUSize() const { return vertexBytes + indexBytes; }
 
-		// OpenGL Buffer for Mesh Positions.
-		GLBuffer* positionBuffer;
+		// Return the size of the vertex buffer on the GPU in bytes.
+		inline uint32_t GetVertexBytes() const { return vertexBytes; }
 
-		// OpenGL Buffer for Mesh Normals.
-		GLBuffer* normalBuffer;
+		// Return the size of the index buffer on the GPU in bytes.
+		inline uint32_t GetIndexBytes() const { return indexBytes; }
 
-		// OpenGL Buffer for Mesh Normals.
-		GLBuffer* tangentBuffer;
+	protected:
+		// The OpenGL Vertex Array of the mesh, defines mesh vertex input.
+		GLVertexArray* vxarray;
 
-		// OpenGL Buffer for Mesh Texture Coordinate.
-		GLBuffer* texCoordBuffer;
+		// OpenGL Buffer for the interleaved mesh vertices.
+		GLBuffer* vertexBuffer;
 
 		// OpenGL Buffer for Mesh Indices.
 		GLBuffer* indexBuffer;
 
+		// The vertex attributes in the vertex buffer, also used by mesh instances.
+		std::vector<GLVABuildAttribData> attributes;
+
 		// Number of indices in the index buffer.
 		int32_t numIndices;
+
+		// The type of the indices, unsigned short or unsigned int.
+		EGLTypes indexType;
+
+		// The size of the vertex buffer in bytes.
+		uint32_t vertexBytes;
+
+		// The size of the index buffer in bytes.
+		uint32_t indexBytes;
 	};
 
 
@@ -138,10 +166,42 @@ namespace Raven
 	};
 
 
+	// The lists of instance ranges a mesh instance is drawn with.
+	enum class ERenderInstanceList
+	{
+		// Instances visible in the view.
+		View = 0,
+
+		// Instances drawn into the first shadow cascade, followed by a list for each other cascade.
+		Shadow = 1,
+
+		// Number of lists.
+		Count = 1 + RENDER_MAX_SHADOW_CASCADE
+	};
+
+
+	// Return the instances list of a shadow cascade.
+	inline ERenderInstanceList GetShadowInstanceList(uint32_t cascade)
+	{
+		return (ERenderInstanceList)((int32_t)ERenderInstanceList::Shadow + (int32_t)cascade);
+	}
+
+
+
 	// RenderRscMeshInstance:
 	//
 	class RenderRscMeshInstance : public RenderRscPrimitive
 	{
+		// The layout of the indirect draw command expected by glMultiDrawElementsIndirect.
+		struct DrawElementsIndirectCommand
+		{
+			uint32_t count;
+			uint32_t instanceCount;
+			uint32_t firstIndex;
+			int32_t baseVertex;
+			uint32_t baseInstance;
+		};
+
 	public:
 		// Construct.
 		RenderRscMeshInstance();
@@ -161,9 +221,20 @@ namespace Raven
 		// Update the instances with a list of transforms.
 		void UpdateTransforms(const std::vector<glm::mat4>& transforms);
 
+		// Update the ranges of instances to draw for a list, each range is (first instance, count),
+		// the draw commands are only uploaded if the ranges changed since the last update.
+		// @return the number of bytes uploaded.
+		int32_t UpdateDrawRanges(ERenderInstanceList list, const std::vector<glm::uvec2>& ranges);
+
+		// Draw all the instance ranges of a list with a single multi-draw indirect call.
+		void DrawIndirect(ERenderInstanceList list);
+
 		// Return the number of indices in the mesh.
 		inline int32_t GetNumIndices() const { return mesh->GetNumIndices(); }
 
+		// Return the type of the indices to draw with.
+		inline GLENUM GetIndexType() const { return mesh->GetIndexType(); }
+
 	private:
 		// The mesh we are instancing.
 		RenderRscMesh* mesh;
@@ -176,6 +247,15 @@ namespace Raven
 
 		// Onwer of the instance buffer.
 		bool instanceBufferOwner;
+
+		// OpenGL Indirect Buffer, the draw commands of each list.
+		GLBuffer* drawCommands[(int32_t)ERenderInstanceList::Count];
+
+		// The ranges of the last draw commands uploaded for each list.
+		std::vector<glm::uvec2> drawRanges[(int32_t)ERenderInstanceList::Count];
+
+		// Scratch memory for building draw commands, kept to avoid allocating when the ranges change.
+		std::vector<DrawElementsIndirectCommand> commandsScratch;
 	};
 
 }
@@ -15,6 +15,10 @@
 
 
 #include "Render/RenderResource/IRenderResource.h"
+#include "Render/RenderResource/RenderSortIdAllocator.h"
+
+
+#include <cstdint>
 
 
 
@@ -27,9 +31,30 @@ namespace Raven
 	class RenderRscPrimitive : public IRenderResource
 	{
 	public:
+		// Construct.
+		RenderRscPrimitive()
+			: sortId(GetSortIdAllocator().Allocate())
+		{
+
+		}
+
 		// Destruct. 
-		virtual ~RenderRscPrimitive() { }
+		virtual ~RenderRscPrimitive()
+		{
+			GetSortIdAllocator().Free(sortId);
+		}
+
+	private:
+		// Return the allocator of the primitive resources sort ids.
+		static inline RenderSortIdAllocator& GetSortIdAllocator()
+		{
+			static RenderSortIdAllocator allocator(RENDER_SORT_ID_MESH_BITS);
+			return allocator;
+		}
 
+	public:
+		// Render Batch Use Only, compact unique id used to build the draw sort keys.
+		uint32_t sortId;
 	};
 
 
@@ -87,8 +87,8 @@ namespace Raven
 		inline UniformBuffer* GetBinUB() { return binUniform.get(); }
 
 		// Set/Get terrain foliage layers.
-		inline const std::vector<TerrainFoliageLayer>* GetFoliageLayer() const { return foliageLayers; }
-		inline void SetFoliageLayers(const std::vector<TerrainFoliageLayer>* layers) { foliageLayers = layers; }
+		inline std::vector<TerrainFoliageLayer>* GetFoliageLayer() const { return foliageLayers; }
+		inline void SetFoliageLayers(std::vector<TerrainFoliageLayer>* layers) { foliageLayers = layers; }
 		 
 	private:
 		// Generate Terrain Mesh for a single ben.
@@ -132,7 +132,7 @@ namespace Raven
 		const std::vector<TerrainBin>* bins;
 
 		// Terrain foliage layers.
-		const std::vector<TerrainFoliageLayer>* foliageLayers;
+		std::vector<TerrainFoliageLayer>* foliageLayers;
 	};
 
 
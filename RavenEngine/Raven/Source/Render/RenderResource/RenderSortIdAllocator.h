@@ -0,0 +1,102 @@
+/*
+ * Developed by Raven Group at the University  of Leeds
+ * Copyright (C) 2021 Ammar Herzallah, Ben Husle, Thomas Moreno Cooper, Sulagna Sinha & Tian Zeng
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3 of the License.
+ *
+ * THIS PROGRAM IS DISTRIBUTED IN THE HOPE THAT IT WILL BE USEFUL,
+ * BUT WITHOUT ANY WARRANTY; WITHOUT EVEN THE IMPLIED WARRANTY OF
+ * MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE.  SEE THE
+ * GNU GENERAL PUBLIC LICENSE FOR MORE DETAILS.
+ */
+#pragma once
+
+
+#include "Utilities/Core.h"
+
+
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+
+
+// The number of bits of each resource sort id in the draw sort key, @see MakeRenderBatchKey().
+#define RENDER_SORT_ID_SHADER_BITS 12
+#define RENDER_SORT_ID_MATERIAL_BITS 16
+#define RENDER_SORT_ID_MESH_BITS 16
+
+
+
+
+namespace Raven
+{
+
+	// RenderSortIdAllocator:
+	//		- Allocate the sort ids of one type of render resource, the ids of destroyed resources are recycled
+	//		  so the ids stay compact and fit their field in the draw sort key.
+	//		- Thread safe, resources may be created by the loading threads.
+	//
+	class RenderSortIdAllocator
+	{
+	public:
+		// Construct.
+		// @param inNumBits: the number of bits of the ids in the draw sort key.
+		RenderSortIdAllocator(uint32_t inNumBits)
+			: numBits(inNumBits)
+			, nextId(0)
+		{
+
+		}
+
+		// Allocate a sort id, the id of a destroyed resource if any.
+		inline uint32_t Allocate()
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			uint32_t id;
+
+			if (!freeIds.empty())
+			{
+				id = freeIds.back();
+				freeIds.pop_back();
+			}
+			else
+			{
+				id = nextId++;
+			}
+
+			RAVEN_ASSERT(id < (1u << numBits), "RenderSortIdAllocator - Too many resources, the sort id doesn't fit its key field.");
+			return id;
+		}
+
+		// Free the sort id of a destroyed resource to be reused.
+		inline void Free(uint32_t id)
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			freeIds.push_back(id);
+		}
+
+		// Return the number of ids in use.
+		inline uint32_t GetNumUsed()
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			return nextId - (uint32_t)freeIds.size();
+		}
+
+	private:
+		// The number of bits of the ids in the draw sort key.
+		uint32_t numBits;
+
+		// The next id to allocate if there is no free id.
+		uint32_t nextId;
+
+		// The ids of destroyed resources.
+		std::vector<uint32_t> freeIds;
+
+		// Guard the ids.
+		std::mutex mutex;
+	};
+
+}
@@ -0,0 +1,167 @@
+/*
+ * Developed by Raven Group at the University  of Leeds
+ * Copyright (C) 2021 Ammar Herzallah, Ben Husle, Thomas Moreno Cooper, Sulagna Sinha & Tian Zeng
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3 of the License.
+ *
+ * THIS PROGRAM IS DISTRIBUTED IN THE HOPE THAT IT WILL BE USEFUL,
+ * BUT WITHOUT ANY WARRANTY; WITHOUT EVEN THE IMPLIED WARRANTY OF
+ * MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE.  SEE THE
+ * GNU GENERAL PUBLIC LICENSE FOR MORE DETAILS.
+ */
+#include "MaterialUniformBuffer.h"
+#include "Render/OpenGL/GLBuffer.h"
+
+
+#include "GL/glew.h"
+#include "glm/common.hpp"
+
+#include <algorithm>
+
+
+
+
+namespace Raven {
+
+
+MaterialUniformBuffer::MaterialUniformBuffer()
+	: buffer(nullptr)
+	, usedSize(0)
+	, alignment(256)
+	, isResized(false)
+	, lastUploadSize(0)
+{
+
+}
+
+
+MaterialUniformBuffer::~MaterialUniformBuffer()
+{
+	delete buffer;
+}
+
+
+MaterialUniformBuffer* MaterialUniformBuffer::Create(int32_t initialSize)
+{
+	MaterialUniformBuffer* newBuffer = new MaterialUniformBuffer();
+
+	GLint offsetAlignment = 0;
+	glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &offsetAlignment);
+
+	if (offsetAlignment > 0)
+		newBuffer->alignment = offsetAlignment;
+
+	newBuffer->data.resize(newBuffer->GetAlignedSize(initialSize), 0);
+	newBuffer->buffer = GLBuffer::Create(EGLBufferType::Uniform, (int)newBuffer->data.size(), EGLBufferUsage::DynamicDraw);
+
+	return newBuffer;
+}
+
+
+int32_t MaterialUniformBuffer::Allocate(int32_t blockSize)
+{
+	int32_t alignedSize = GetAlignedSize(blockSize);
+
+	// Reuse a freed slot that fits...
+	for (size_t i = 0; i < freeSlots.size(); ++i)
+	{
+		int32_t slot = freeSlots[i];
+
+		if (slots[slot].size >= alignedSize)
+		{
+			freeSlots[i] = freeSlots.back();
+			freeSlots.pop_back();
+			return slot;
+		}
+	}
+
+	// New slot at the end of the buffer.
+	Slot newSlot;
+	newSlot.offset = usedSize;
+	newSlot.size = alignedSize;
+	usedSize += alignedSize;
+
+	// Grow to fit the new slot.
+	if (usedSize > (int32_t)data.size())
+	{
+		data.resize(glm::max(usedSize, (int32_t)data.size() * 2), 0);
+		isResized = true;
+	}
+
+	slots.push_back(newSlot);
+	return (int32_t)slots.size() - 1;
+}
+
+
+void MaterialUniformBuffer::Free(int32_t slot)
+{
+	RAVEN_ASSERT(slot >= 0 && slot < (int32_t)slots.size(), "MaterialUniformBuffer - Invalid slot.");
+	freeSlots.push_back(slot);
+}
+
+
+void MaterialUniformBuffer::MarkDirty(int32_t slot, int32_t offset, int32_t size)
+{
+	// The whole buffer is going to be uploaded anyway.
+	if (isResized)
+		return;
+
+	int32_t begin = slots[slot].offset + offset;
+	dirtyRanges.emplace_back(begin, begin + size);
+}
+
+
+void MaterialUniformBuffer::Update()
+{
+	lastUploadSize = 0;
+
+	// Recreate the buffer with all the data.
+	if (isResized)
+	{
+		delete buffer;
+		buffer = GLBuffer::Create(EGLBufferType::Uniform, (int)data.size(), data.data(), EGLBufferUsage::DynamicDraw);
+
+		lastUploadSize = (int32_t)data.size();
+		isResized = false;
+		dirtyRanges.clear();
+		return;
+	}
+
+	if (dirtyRanges.empty())
+		return;
+
+	// Merge overlapping & adjacent ranges, materials allocated together are usually updated together.
+	std::sort(dirtyRanges.begin(), dirtyRanges.end());
+
+	buffer->Bind();
+	std::pair<int32_t, int32_t> range = dirtyRanges[0];
+
+	for (size_t i = 1; i <= dirtyRanges.size(); ++i)
+	{
+		if (i < dirtyRanges.size() && dirtyRanges[i].first <= range.second)
+		{
+			range.second = glm::max(range.second, dirtyRanges[i].second);
+			continue;
+		}
+
+		buffer->UpdateSubData(range.second - range.first, range.first, data.data() + range.first);
+		lastUploadSize += range.second - range.first;
+
+		if (i < dirtyRanges.size())
+			range = dirtyRanges[i];
+	}
+
+	dirtyRanges.clear();
+}
+
+
+void MaterialUniformBuffer::BindSlot(int32_t binding, int32_t slot)
+{
+	const Slot& s = slots[slot];
+	buffer->BindRange(binding, s.offset, s.size);
+}
+
+
+} // End of namespace Raven.
@@ -0,0 +1,129 @@
+/*
+ * Developed by Raven Group at the University  of Leeds
+ * Copyright (C) 2021 Ammar Herzallah, Ben Husle, Thomas Moreno Cooper, Sulagna Sinha & Tian Zeng
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3 of the License.
+ *
+ * THIS PROGRAM IS DISTRIBUTED IN THE HOPE THAT IT WILL BE USEFUL,
+ * BUT WITHOUT ANY WARRANTY; WITHOUT EVEN THE IMPLIED WARRANTY OF
+ * MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE.  SEE THE
+ * GNU GENERAL PUBLIC LICENSE FOR MORE DETAILS.
+ */
+#pragma once
+
+
+
+
+
+#include "Utilities/Core.h"
+#include "Render/OpenGL/GLTypes.h"
+
+
+#include <vector>
+
+
+
+
+
+
+
+// The initial size of the material uniform buffer.
+#define MATERIAL_UNIFORM_BUFFER_INITIAL_SIZE (64 * 1024)
+
+
+
+
+namespace Raven
+{
+	class GLBuffer;
+
+
+	// MaterialUniformBuffer:
+	//		- A single uniform buffer shared by all materials, each material has a slot holding its paramters block.
+	//		- A draw select its material by binding the range of its slot, no buffer update between draws.
+	//		- Materials write their paramters to a cpu copy of the buffer and mark the changed bytes dirty,
+	//		  Update() then upload only the dirty ranges once per frame.
+	//
+	class MaterialUniformBuffer
+	{
+		NOCOPYABLE(MaterialUniformBuffer);
+
+		// Construct.
+		MaterialUniformBuffer();
+
+	public:
+		// Destruct.
+		~MaterialUniformBuffer();
+
+		// Create a material uniform buffer.
+		static MaterialUniformBuffer* Create(int32_t initialSize);
+
+		// Allocate a slot for a material paramters block.
+		// @return the index of the new slot.
+		int32_t Allocate(int32_t blockSize);
+
+		// Free a slot, the slot can be reused by another allocation.
+		void Free(int32_t slot);
+
+		// Return the cpu data of a slot, changes must be marked with MarkDirty().
+		inline uint8_t* GetData(int32_t slot) { return data.data() + slots[slot].offset; }
+
+		// Mark a range of a slot to be uploaded on the next Update().
+		void MarkDirty(int32_t slot, int32_t offset, int32_t size);
+
+		// Upload all dirty ranges to the uniform buffer.
+		void Update();
+
+		// Bind the range of a slot to the uniform block binding.
+		void BindSlot(int32_t binding, int32_t slot);
+
+		// Return the number of bytes uploaded by the last Update().
+		inline int32_t GetLastUploadSize() const { return lastUploadSize; }
+
+	private:
+		// Return size aligned to the uniform buffer offset alignment.
+		inline int32_t GetAlignedSize(int32_t size) const { return (size + alignment - 1) / alignment * alignment; }
+
+	private:
+		// A range of the buffer used by a single material.
+		struct Slot
+		{
+			// The offset of the slot from the start of the buffer.
+			int32_t offset;
+
+			// The aligned size of the slot.
+			int32_t size;
+		};
+
+		// OpenGL Uniform Buffer.
+		GLBuffer* buffer;
+
+		// The cpu copy of the buffer.
+		std::vector<uint8_t> data;
+
+		// All the allocated slots.
+		std::vector<Slot> slots;
+
+		// The freed slots to be reused.
+		std::vector<int32_t> freeSlots;
+
+		// The ranges to upload on the next update, pairs of begin & end offsets.
+		std::vector< std::pair<int32_t, int32_t> > dirtyRanges;
+
+		// The size used by all the slots.
+		int32_t usedSize;
+
+		// The required offset alignment of uniform block ranges.
+		int32_t alignment;
+
+		// True if the cpu copy grew and the uniform buffer has to be recreated.
+		bool isResized;
+
+		// The number of bytes uploaded by the last update.
+		int32_t lastUploadSize;
+	};
+
+}
+
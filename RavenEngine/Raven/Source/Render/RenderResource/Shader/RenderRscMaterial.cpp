@@ -13,17 +13,22 @@
  */
 #include "RenderRscMaterial.h"
 #include "RenderRscShader.h"
-#include "UniformBuffer.h"
+#include "MaterialUniformBuffer.h"
 
 #include "Render/RenderResource/RenderRscTexture.h"
+#include "Render/RenderResource/RenderSortIdAllocator.h"
 #include "Render/OpenGL/GLTexture.h"
+#include "Render/RenderModule.h"
 
 #include "ResourceManager/Resources/Material.h"
 #include "ResourceManager/Resources/Texture2D.h"
 
+#include "Engine.h"
+
 
 
 #include "glm/gtc/type_ptr.hpp"
+#include "glm/common.hpp"
 
 
 
@@ -33,14 +38,25 @@ namespace Raven {
 
 
 
+// Allocate the sort ids of the materials.
+static RenderSortIdAllocator& GetSortIdAllocator()
+{
+	static RenderSortIdAllocator allocator(RENDER_SORT_ID_MATERIAL_BITS);
+	return allocator;
+}
+
+
+
 RenderRscMaterial::RenderRscMaterial(RenderRscShader* inShader)
 	: shader(inShader)
-	, materialBuffer(nullptr)
+	, shadowShader(nullptr)
 	, blockIndex(-1)
-	, ubo(nullptr)
-	, renderBatchIndex((uint32_t)-1)
+	, uniformBuffer(Engine::GetModule<RenderModule>()->GetMaterialBuffer())
+	, slot(-1)
+	, binding(-1)
+	, isFullFill(true)
+	, sortId(GetSortIdAllocator().Allocate())
 	, samplersStartIndex(-1)
-	, shadowShader(nullptr)
 {
 
 }
@@ -48,7 +64,10 @@ RenderRscMaterial::RenderRscMaterial(RenderRscShader* inShader)
 
 RenderRscMaterial::~RenderRscMaterial()
 {
-	delete materialBuffer;
+	if (slot != -1)
+		uniformBuffer->Free(slot);
+
+	GetSortIdAllocator().Free(sortId);
 }
 
 
@@ -64,6 +83,12 @@ void RenderRscMaterial::ReloadShader(RenderRscShader* inShader)
 }
 
 
+bool RenderRscMaterial::IsReady() const
+{
+	return shader && shader->IsReady() && (!shadowShader || shadowShader->IsReady());
+}
+
+
 void RenderRscMaterial::LoadInputBlock(const std::string& inBlockName, int32_t inSamplersStartIndex)
 {
 	RAVEN_ASSERT(shader != nullptr, "Updating Render Material with invalid shader.");
@@ -71,11 +96,20 @@ void RenderRscMaterial::LoadInputBlock(const std::string& inBlockName, int32_t i
 	// Find Block
 	blockIndex = shader->GetInput().GetBlockInputIndex(inBlockName);
 
-	// Delete materail buffer that match the old block.
-	if (materialBuffer)
+	// Free the slot that match the old block.
+	if (slot != -1)
 	{
-		delete materialBuffer;
-		materialBuffer = nullptr;
+		uniformBuffer->Free(slot);
+		slot = -1;
+	}
+
+	// Allocate a slot for the new block.
+	if (blockIndex != -1)
+	{
+		const auto& blockInput = shader->GetInput().GetBlockInput(blockIndex);
+		slot = uniformBuffer->Allocate(blockInput.size);
+		binding = blockInput.binding;
+		isFullFill = true;
 	}
 
 
@@ -94,6 +128,7 @@ void RenderRscMaterial::LoadInputBlock(const std::string& inBlockName, int32_t i
 void RenderRscMaterial::ClearMapping()
 {
 	matInputMap.clear();
+	isFullFill = true;
 
 	for (auto& tex : matInputTexturesMap)
 	{
@@ -171,56 +206,73 @@ void RenderRscMaterial::MapParamter(const std::string& name, const glm::vec4* co
 void RenderRscMaterial::FillBuffer()
 {
 	// No Input Block?
-	if (blockIndex == -1)
+	if (blockIndex == -1 || slot == -1)
 		return;
 
 	const auto& blockInput = shader->GetInput().GetBlockInput(blockIndex);
+	uint8_t* materialBuffer = uniformBuffer->GetData(slot);
 
-	// Invalid?
-	if (!materialBuffer)
+	// New slot or mapping, write everything.
+	if (isFullFill)
 	{
-		// Allocate...
-		materialBuffer = new uint8_t[ blockInput.size ];
-	}
+		isFullFill = false;
 
-	// Missing Paramters?
-	if (matInputMap.size() != blockInput.inputs.size())
-	{
-		// Set them to default.
-		for (const auto& input : blockInput.inputs)
+		// Missing Paramters?
+		if (matInputMap.size() != blockInput.inputs.size())
 		{
-			if (input.first.inputType == EShaderInputType::Float)
-			{
-				float def = input.first.flag == ESInputDefaultFlag::Black ? 0.0f : 1.0f;
-				memcpy(materialBuffer + input.second, &def, sizeof(float));
-			}
-			else
+			// Set them to default.
+			for (const auto& input : blockInput.inputs)
 			{
-				glm::vec4 color = input.first.flag == ESInputDefaultFlag::Black ? glm::vec4(0.0f) : glm::vec4(1.0f);
-				memcpy(materialBuffer + input.second, glm::value_ptr(color), sizeof(glm::vec4));
+				if (input.first.inputType == EShaderInputType::Float)
+				{
+					float def = input.first.flag == ESInputDefaultFlag::Black ? 0.0f : 1.0f;
+					memcpy(materialBuffer + input.second, &def, sizeof(float));
+				}
+				else
+				{
+					glm::vec4 color = input.first.flag == ESInputDefaultFlag::Black ? glm::vec4(0.0f) : glm::vec4(1.0f);
+					memcpy(materialBuffer + input.second, glm::value_ptr(color), sizeof(glm::vec4));
+				}
 			}
 		}
+
+		// Fill the buffer with materail data.
+		for (const auto& inputParam : matInputMap)
+		{
+			memcpy(materialBuffer + inputParam.offset, inputParam.data, inputParam.size);
+		}
+
+		uniformBuffer->MarkDirty(slot, 0, blockInput.size);
+		return;
 	}
 
-	// Fill the buffer with materail data.
+	// Only write the paramters that changed, and mark the range covering them dirty.
+	int32_t dirtyBegin = blockInput.size;
+	int32_t dirtyEnd = 0;
+
 	for (const auto& inputParam : matInputMap)
 	{
-		memcpy(materialBuffer + inputParam.offset, inputParam.data, inputParam.size);
+		uint8_t* dst = materialBuffer + inputParam.offset;
+
+		if (memcmp(dst, inputParam.data, inputParam.size) == 0)
+			continue;
+
+		memcpy(dst, inputParam.data, inputParam.size);
+		dirtyBegin = glm::min(dirtyBegin, inputParam.offset);
+		dirtyEnd = glm::max(dirtyEnd, inputParam.offset + inputParam.size);
 	}
 
+	if (dirtyBegin < dirtyEnd)
+	{
+		uniformBuffer->MarkDirty(slot, dirtyBegin, dirtyEnd - dirtyBegin);
+	}
 }
 
 
-void RenderRscMaterial::UpdateUniformBuffer()
+void RenderRscMaterial::BindUniformBuffer()
 {
-	// No Input Block? No Unifrom Buffer?
-	if (blockIndex == -1 && ubo == nullptr)
-		return;
-
-	const auto& blockInput = shader->GetInput().GetBlockInput(blockIndex);
-
-	// Update the unifrom buffer with the material data.
-	ubo->UpdateData(blockInput.size, 0, materialBuffer);
+	RAVEN_ASSERT(binding != -1, "RenderRscMaterial - Invalid binding.");
+	uniformBuffer->BindSlot(binding, slot);
 }
 
 
@@ -234,7 +286,8 @@ void RenderRscMaterial::MakeTexturesActive(const std::vector< Ptr<ITexture> >& d
 		auto inputTex = matInputTexturesMap[i];
 		int32_t samplerIndex = i + samplersStartIndex;
 
-		if (inputTex)
+		// Mapped and not loading in the background?
+		if (inputTex && *inputTex)
 		{
 			RenderRscTexture* rtex = (*inputTex)->GetRenderRsc();
 			rtex->GetTexture()->Active(samplerIndex);
@@ -30,12 +30,14 @@ namespace Raven
 	class RenderRscShader;
 	class ITexture;
 	class Material;
-	class UniformBuffer;
+	class MaterialUniformBuffer;
 
 
 	// RenderRscMaterial:
 	//			- Mangae the mapping between materail and the shader. maps all the paramters
 	//				of the material to their shader input.
+	//			- The paramters block is stored in a slot of the shared material uniform buffer,
+	//				only the paramters that changed are marked dirty for upload.
 	class RenderRscMaterial : public IRenderResource
 	{
 	public:
@@ -54,11 +56,14 @@ namespace Raven
 		// Set the custom shader of this material.
 		inline void SetShadowShader(RenderRscShader* shader) { shadowShader = shader; }
 
+		// Return true if the shader and the shadow shader of this material finished building.
+		bool IsReady() const;
+
 		// Reload shader resrouce and its paramters mapping.
 		void ReloadShader(RenderRscShader* inShader);
 
 		// Return true if this resouce has a materail data.
-		inline bool HasMaterialData() { return blockIndex != -1 && materialBuffer != nullptr; }
+		inline bool HasMaterialData() { return blockIndex != -1 && slot != -1; }
 
 		// Find/Load input block from shader to map our materail paramters to.
 		void LoadInputBlock(const std::string& inBlockName, int32_t inSamplersStartIndex);
@@ -71,20 +76,14 @@ namespace Raven
 		void MapParamter(const std::string& name, const float* scalar);
 		void MapParamter(const std::string& name, const glm::vec4* color);
 
-		// Fill the material buffer with our paramters values.
+		// Fill the material slot with our paramters values, only the changed values are marked dirty.
 		void FillBuffer();
 
 		// Return textures.
 		const std::vector<Ptr<ITexture>*>& GetTextures() { return matInputTexturesMap; }
 
-		// Set the unfirom buffer to update.
-		inline void SetUniformBuffer(UniformBuffer* inUBO) { ubo = inUBO; }
-
-		// Return the unfirom buffer this material update.
-		inline UniformBuffer* GetUniformBuffer() {  return ubo; }
-
-		// Update the uniform buffer with the materail data.
-		void UpdateUniformBuffer();
+		// Bind the material slot of the shared material uniform buffer.
+		void BindUniformBuffer();
 
 		// Make Material Textures the current active ones.
 		void MakeTexturesActive(const std::vector< Ptr<ITexture> >& defaultTextures);
@@ -99,8 +98,17 @@ namespace Raven
 		// The index of the input block in shader.
 		int32_t blockIndex;
 
-		// Buffer used to update the material unfirom buffer.
-		uint8_t* materialBuffer;
+		// The uniform buffer shared by all materials.
+		Ptr<MaterialUniformBuffer> uniformBuffer;
+
+		// The slot of the material paramters block in the shared uniform buffer, -1 if no block.
+		int32_t slot;
+
+		// The binding of the material paramters block.
+		int32_t binding;
+
+		// If true the next FillBuffer() write all the paramters & defaults, set when the slot or the mapping change.
+		bool isFullFill;
 
 		// Materail Input Mapping of a paramter
 		struct MaterialInputMap
@@ -117,12 +125,9 @@ namespace Raven
 		// Material Input Texture Paramters mapped to their shader input index.
 		std::vector< Ptr<ITexture>* > matInputTexturesMap;
 
-		// The unfirom buffer this material update.
-		UniformBuffer* ubo;
-
 	public:
-		// Render Batch Use Only, index set by the render batch to performs fast mapping during batching.
-		mutable uint32_t renderBatchIndex;
+		// Render Batch Use Only, compact unique id used to build the draw sort keys.
+		uint32_t sortId;
 
 		// The material samplers start index in the shader.
 		int32_t samplersStartIndex;
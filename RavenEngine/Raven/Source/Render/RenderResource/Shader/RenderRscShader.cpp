@@ -15,6 +15,11 @@
 #include "Utilities/Core.h"
 
 #include "Render/OpenGL/GLShader.h"
+#include "Render/RenderResource/Primitives/RenderRscMesh.h"
+#include "Render/RenderResource/RenderSortIdAllocator.h"
+#include "Render/RenderModule.h"
+#include "Render/RenderShaderCompiler.h"
+#include "Engine.h"
 
 
 
@@ -42,12 +47,26 @@ namespace Raven {
 
 
 
+// Allocate the sort ids of the shaders.
+static RenderSortIdAllocator& GetSortIdAllocator()
+{
+	static RenderSortIdAllocator allocator(RENDER_SORT_ID_SHADER_BITS);
+	return allocator;
+}
+
+
+
 RenderRscShader::RenderRscShader()
 	: domain(ERenderShaderDomain::Custom)
 	, type(ERenderShaderType::Opaque)
-	, renderBatchIndex((uint32_t)-1)
 	, isShadow(false)
 	, isTwoSidedShader(false)
+	, isReady(false)
+	, isBuilding(false)
+	, isFailed(false)
+	, isPendingBlockInputs(false)
+	, isPendingSamplers(false)
+	, sortId(GetSortIdAllocator().Allocate())
 {
 
 }
@@ -55,11 +74,50 @@ RenderRscShader::RenderRscShader()
 
 RenderRscShader::~RenderRscShader()
 {
+	// Still being built?
+	if (isBuilding)
+	{
+		Engine::GetModule<RenderModule>()->GetShaderCompiler()->Cancel(this);
+	}
 
+	GetSortIdAllocator().Free(sortId);
 }
 
 
 RenderRscShader* RenderRscShader::Create(ERenderShaderDomain domain, const RenderRscShaderCreateData& data)
+{
+	RenderRscShader* rsc = CreateUnbuilt(domain, data);
+
+	// Build OpenGL Shader/Program.
+	rsc->shader->Build();
+
+	// Success?
+	if (rsc->shader->IsValid())
+	{
+		rsc->isReady = true;
+		rsc->shader->Use();
+		return rsc;
+	}
+
+	// Failed...
+	delete rsc;
+	return nullptr;
+}
+
+
+RenderRscShader* RenderRscShader::CreateAsync(ERenderShaderDomain domain, const RenderRscShaderCreateData& data)
+{
+	RenderRscShader* rsc = CreateUnbuilt(domain, data);
+
+	// Build OpenGL Shader/Program in the background.
+	rsc->isBuilding = true;
+	Engine::GetModule<RenderModule>()->GetShaderCompiler()->Submit(rsc);
+
+	return rsc;
+}
+
+
+RenderRscShader* RenderRscShader::CreateUnbuilt(ERenderShaderDomain domain, const RenderRscShaderCreateData& data)
 {
 	RenderRscShader* rsc = new RenderRscShader();
 	rsc->domain = domain;
@@ -93,19 +151,7 @@ RenderRscShader* RenderRscShader::Create(ERenderShaderDomain domain, const Rende
 			data.materialFunction.first, data.materialFunction.second);
 	}
 
-	// Build OpenGL Shader/Program.
-	rsc->shader->Build();
-
-	// Success?
-	if (rsc->shader->IsValid())
-	{
-		rsc->shader->Use();
-		return rsc;
-	}
-
-	// Failed...
-	delete rsc;
-	return nullptr;
+	return rsc;
 }
 
 
@@ -151,6 +197,7 @@ RenderRscShader* RenderRscShader::CreateCustom(const RenderRscShaderDomainCreate
 	// Success?
 	if (rsc->shader->IsValid())
 	{
+		rsc->isReady = true;
 		rsc->shader->Use();
 		return rsc;
 	}
@@ -181,6 +228,9 @@ void RenderRscShader::SetupShaderForDomain()
 		{
 			shader->AddPreprocessor("#define RENDER_SHADER_MESH_INSTANCE 1");
 		}
+
+		// Vertex Format...
+		shader->AddPreprocessor("#define RENDER_MESH_COMPACT_VERTEX " + std::to_string(RENDER_MESH_COMPACT_VERTEX));
 		
 		// Main Source...
 		shader->SetSourceFile(EGLShaderStage::Vertex, "shaders/MeshVert.glsl");
@@ -321,6 +371,13 @@ void RenderRscShader::SetupShaderForType()
 
 void RenderRscShader::BindBlockInputs()
 {
+	// Bind once the build is finished.
+	if (!isReady)
+	{
+		isPendingBlockInputs = true;
+		return;
+	}
+
 	for (uint32_t i = 0; i < input.GetNumBlocks(); ++i)
 	{
 		const auto& block = input.GetBlockInput(i);
@@ -331,6 +388,13 @@ void RenderRscShader::BindBlockInputs()
 
 void RenderRscShader::BindSamplers()
 {
+	// Bind once the build is finished.
+	if (!isReady)
+	{
+		isPendingSamplers = true;
+		return;
+	}
+
 	shader->Use();
 
 	for (uint32_t i = 0; i < input.GetNumSamplers(); ++i)
@@ -341,11 +405,47 @@ void RenderRscShader::BindSamplers()
 }
 
 
-bool RenderRscShader::IsTwoSided()
+bool RenderRscShader::IsTwoSided() const
 {
 	return type == ERenderShaderType::MaskedFoliage || isTwoSidedShader;
 }
 
 
+void RenderRscShader::OnBuildFinished(bool isSuccess)
+{
+	isBuilding = false;
+
+	// Failed, the shader is never ready and its users keep using their fallback.
+	if (!isSuccess || !shader->IsValid())
+	{
+		LOGE("RenderRscShader - Failed to build shader {0}.", shader->GetName());
+		isFailed = true;
+
+		if (onBuildFinished)
+			onBuildFinished(false);
+
+		return;
+	}
+
+	isReady = true;
+	shader->Use();
+
+	if (isPendingBlockInputs)
+	{
+		isPendingBlockInputs = false;
+		BindBlockInputs();
+	}
+
+	if (isPendingSamplers)
+	{
+		isPendingSamplers = false;
+		BindSamplers();
+	}
+
+	if (onBuildFinished)
+		onBuildFinished(true);
+}
+
+
 
 } // End of namespace Raven.
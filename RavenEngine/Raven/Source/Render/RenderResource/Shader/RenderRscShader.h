@@ -24,6 +24,7 @@
 
 
 #include <memory>
+#include <functional>
 #include <string>
 #include <vector>
 #include <map>
@@ -173,6 +174,8 @@ namespace Raven
 	//
 	class RenderRscShader : public IRenderResource
 	{
+		friend class RenderShaderCompiler;
+
 		// Private Construct, use Create Function.
 		RenderRscShader();
 
@@ -183,6 +186,10 @@ namespace Raven
 		// Creat a shader with one of the pre-defined domains.
 		static RenderRscShader* Create(ERenderShaderDomain domain, const RenderRscShaderCreateData& data);
 
+		// Creat a shader with one of the pre-defined domains and build it in the background, 
+		// the shader can't be used until IsReady() return true. @see RenderShaderCompiler.
+		static RenderRscShader* CreateAsync(ERenderShaderDomain domain, const RenderRscShaderCreateData& data);
+
 		// Creat a shader with a custom domain.
 		static RenderRscShader* CreateCustom(const RenderRscShaderDomainCreateData& domain, const RenderRscShaderCreateData& data);
 
@@ -206,9 +213,24 @@ namespace Raven
 		void BindSamplers();
 
 		// Is this shader render two sided without face culling.
-		bool IsTwoSided();
+		bool IsTwoSided() const;
+
+		// Return true if the shader finished building successfully and can be used for rendering.
+		inline bool IsReady() const { return isReady; }
+
+		// Return true if the shader finished building and failed to compile or link, it is never ready.
+		inline bool IsFailed() const { return isFailed; }
+
+		// Set a function called when the build started by CreateAsync() is finished, with true if it succeeded.
+		inline void SetBuildFinishedCallback(const std::function<void(bool)>& callback) { onBuildFinished = callback; }
 
 	private:
+		// Create a shader with one of the pre-defined domains without building it.
+		static RenderRscShader* CreateUnbuilt(ERenderShaderDomain domain, const RenderRscShaderCreateData& data);
+
+		// Called by the shader compiler when the build started by CreateAsync() is finished.
+		void OnBuildFinished(bool isSuccess);
+
 		// Setup the shader for the current domain.
 		void SetupShaderForDomain();
 
@@ -234,9 +256,25 @@ namespace Raven
 		// Is this shader render twosided fron/back without face culling.
 		bool isTwoSidedShader;
 
+		// True if the shader is built and can be used.
+		bool isReady;
+
+		// True if the shader is still being built by the shader compiler.
+		bool isBuilding;
+
+		// True if the build finished and failed.
+		bool isFailed;
+
+		// Called when the build started by CreateAsync() is finished.
+		std::function<void(bool)> onBuildFinished;
+
+		// True if BindBlockInputs()/BindSamplers() were called while building, applied once the build is finished.
+		bool isPendingBlockInputs;
+		bool isPendingSamplers;
+
 	public:
-		// Render Batch Use Only, index set by the render batch to performs fast mapping during batching.
-		mutable uint32_t renderBatchIndex;
+		// Render Batch Use Only, compact unique id used to build the draw sort keys.
+		uint32_t sortId;
 	};
 
 }
@@ -46,7 +46,6 @@ namespace Raven {
 RSInputBlockDescription RenderShaderInput::CommonBlock = RSInputBlockDescription::MakeCommonBlock();
 RSInputBlockDescription RenderShaderInput::TransformBlock = RSInputBlockDescription::MakeTransformBlock();
 RSInputBlockDescription RenderShaderInput::TransformBoneBlock = RSInputBlockDescription::MakeTransformBoneBlock();
-RSInputBlockDescription RenderShaderInput::LightingBlock_DEFERRED = RSInputBlockDescription::MakeLightingBlock_DEFERRED();
 RSInputBlockDescription RenderShaderInput::LightingBlock_FORWARD = RSInputBlockDescription::MakeLightingBlock_FORWARD();
 RSInputBlockDescription RenderShaderInput::TerrainBinBlock = RSInputBlockDescription::MakeTerrainBinBlock();
 RSInputBlockDescription RenderShaderInput::ShadowBlock = RSInputBlockDescription::MakeShadowBlock();
@@ -230,21 +229,6 @@ RSInputBlockDescription RSInputBlockDescription::MakeLightingBlock_FORWARD()
 }
 
 
-RSInputBlockDescription RSInputBlockDescription::MakeLightingBlock_DEFERRED()
-{
-	RSInputBlockDescription inputblock;
-	inputblock.binding = LIGHTING_BLOCK_BINDING;
-	inputblock.BeginUniformBlock("LightingBlock");
-	inputblock.AddInputArray(EShaderInputType::Vec4, "lightDir", RENDER_PASS_DEFERRED_MAX_LIGHTS);
-	inputblock.AddInputArray(EShaderInputType::Vec4, "lightPos", RENDER_PASS_DEFERRED_MAX_LIGHTS);
-	inputblock.AddInputArray(EShaderInputType::Vec4, "lightPower", RENDER_PASS_DEFERRED_MAX_LIGHTS);
-	inputblock.AddInputArray(EShaderInputType::Vec4, "lightData", RENDER_PASS_DEFERRED_MAX_LIGHTS);
-	inputblock.EndUniformBlock();
-
-	return inputblock;
-}
-
-
 RSInputBlockDescription RSInputBlockDescription::MakeTerrainBinBlock()
 {
 	RSInputBlockDescription inputblock;
@@ -26,7 +26,6 @@
 
 
 
-#define RENDER_PASS_DEFERRED_MAX_LIGHTS 32
 #define RENDER_PASS_FORWARD_MAX_LIGHTS 4
 #define RENDER_SKINNED_MAX_BONES 82
 #define RENDER_MAX_SHADOW_CASCADE 4
@@ -216,7 +215,6 @@ namespace Raven
 		static RSInputBlockDescription MakeCommonBlock();
 		static RSInputBlockDescription MakeTransformBlock();
 		static RSInputBlockDescription MakeTransformBoneBlock();
-		static RSInputBlockDescription MakeLightingBlock_DEFERRED();
 		static RSInputBlockDescription MakeLightingBlock_FORWARD();
 		static RSInputBlockDescription MakeTerrainBinBlock();
 		static RSInputBlockDescription MakeShadowBlock();
@@ -289,7 +287,6 @@ namespace Raven
 		static RSInputBlockDescription CommonBlock;
 		static RSInputBlockDescription TransformBlock;
 		static RSInputBlockDescription TransformBoneBlock;
-		static RSInputBlockDescription LightingBlock_DEFERRED;
 		static RSInputBlockDescription LightingBlock_FORWARD;
 		static RSInputBlockDescription TerrainBinBlock;
 		static RSInputBlockDescription ShadowBlock;
@@ -0,0 +1,154 @@
+/*
+ * Developed by Raven Group at the University  of Leeds
+ * Copyright (C) 2021 Ammar Herzallah, Ben Husle, Thomas Moreno Cooper, Sulagna Sinha & Tian Zeng
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3 of the License.
+ *
+ * THIS PROGRAM IS DISTRIBUTED IN THE HOPE THAT IT WILL BE USEFUL,
+ * BUT WITHOUT ANY WARRANTY; WITHOUT EVEN THE IMPLIED WARRANTY OF
+ * MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE.  SEE THE
+ * GNU GENERAL PUBLIC LICENSE FOR MORE DETAILS.
+ */
+#include "UniformRingBuffer.h"
+#include "Render/OpenGL/GLBuffer.h"
+
+
+#include "GL/glew.h"
+#include "glm/common.hpp"
+
+
+
+
+namespace Raven {
+
+
+UniformRingBuffer::UniformRingBuffer()
+	: buffer(nullptr)
+	, alignment(256)
+	, frameSize(0)
+	, frameIndex(0)
+	, frameOffset(0)
+	, isInFrame(false)
+{
+	for (uint32_t i = 0; i < UNIFORM_RING_BUFFER_FRAMES; ++i)
+		fences[i] = nullptr;
+}
+
+
+UniformRingBuffer::~UniformRingBuffer()
+{
+	for (uint32_t i = 0; i < UNIFORM_RING_BUFFER_FRAMES; ++i)
+	{
+		if (fences[i])
+			glDeleteSync((GLsync)fences[i]);
+	}
+
+	delete buffer;
+}
+
+
+UniformRingBuffer* UniformRingBuffer::Create(int32_t frameSize)
+{
+	UniformRingBuffer* newRingBuffer = new UniformRingBuffer();
+
+	GLint offsetAlignment = 0;
+	glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &offsetAlignment);
+
+	if (offsetAlignment > 0)
+		newRingBuffer->alignment = offsetAlignment;
+
+	newRingBuffer->Resize(frameSize);
+
+	return newRingBuffer;
+}
+
+
+void UniformRingBuffer::Resize(int32_t newFrameSize)
+{
+	// Make sure the GPU is done with all regions.
+	for (uint32_t i = 0; i < UNIFORM_RING_BUFFER_FRAMES; ++i)
+		WaitFrame(i);
+
+	delete buffer;
+
+	frameSize = GetAlignedSize(newFrameSize);
+	buffer = GLBuffer::CreatePersistent(EGLBufferType::Uniform, frameSize * UNIFORM_RING_BUFFER_FRAMES);
+}
+
+
+void UniformRingBuffer::WaitFrame(uint32_t index)
+{
+	if (!fences[index])
+		return;
+
+	GLsync sync = (GLsync)fences[index];
+	GLenum result = glClientWaitSync(sync, GL_SYNC_FLUSH_COMMANDS_BIT, 0);
+
+	// Still in use, wait for it...
+	while (result == GL_TIMEOUT_EXPIRED)
+	{
+		result = glClientWaitSync(sync, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000);
+	}
+
+	glDeleteSync(sync);
+	fences[index] = nullptr;
+}
+
+
+void UniformRingBuffer::BeginFrame(int32_t requiredSize)
+{
+	RAVEN_ASSERT(!isInFrame, "UniformRingBuffer - BeginFrame() called twice.");
+
+	// Grow to fit the new frame.
+	if (requiredSize > frameSize)
+	{
+		Resize(glm::max(requiredSize, frameSize * 2));
+	}
+
+	frameIndex = (frameIndex + 1) % UNIFORM_RING_BUFFER_FRAMES;
+	frameOffset = 0;
+	isInFrame = true;
+
+	WaitFrame(frameIndex);
+}
+
+
+void UniformRingBuffer::EndFrame()
+{
+	if (!isInFrame)
+		return;
+
+	fences[frameIndex] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+	isInFrame = false;
+}
+
+
+int32_t UniformRingBuffer::Allocate(int32_t size)
+{
+	RAVEN_ASSERT(isInFrame, "UniformRingBuffer - Allocate() called outside a frame.");
+
+	int32_t alignedSize = GetAlignedSize(size);
+	RAVEN_ASSERT(frameOffset + alignedSize <= frameSize, "UniformRingBuffer - Frame overflow, invalid required size.");
+
+	int32_t offset = frameIndex * frameSize + frameOffset;
+	frameOffset += alignedSize;
+
+	return offset;
+}
+
+
+uint8_t* UniformRingBuffer::GetData(int32_t offset)
+{
+	return buffer->GetMappedData() + offset;
+}
+
+
+void UniformRingBuffer::BindRange(int32_t binding, int32_t offset, int32_t size)
+{
+	buffer->BindRange(binding, offset, size);
+}
+
+
+} // End of namespace Raven.
@@ -0,0 +1,115 @@
+/*
+ * Developed by Raven Group at the University  of Leeds
+ * Copyright (C) 2021 Ammar Herzallah, Ben Husle, Thomas Moreno Cooper, Sulagna Sinha & Tian Zeng
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3 of the License.
+ *
+ * THIS PROGRAM IS DISTRIBUTED IN THE HOPE THAT IT WILL BE USEFUL,
+ * BUT WITHOUT ANY WARRANTY; WITHOUT EVEN THE IMPLIED WARRANTY OF
+ * MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE.  SEE THE
+ * GNU GENERAL PUBLIC LICENSE FOR MORE DETAILS.
+ */
+#pragma once
+
+
+
+
+
+#include "Utilities/Core.h"
+#include "Render/OpenGL/GLTypes.h"
+
+
+
+
+
+
+
+// The number of frames the ring buffer can hold before waiting for the GPU.
+#define UNIFORM_RING_BUFFER_FRAMES 3
+
+
+
+
+namespace Raven
+{
+	class GLBuffer;
+
+
+	// UniformRingBuffer:
+	//		- Persistent mapped uniform buffer split into a region for each frame in flight.
+	//		- The data of a frame is written once to the mapped memory and uniform blocks
+	//		  are bound to ranges of it, which avoid a buffer update for each draw.
+	//		- Each region is fenced at the end of its frame, and only reused after the GPU is done reading it.
+	//
+	class UniformRingBuffer
+	{
+		// Construct.
+		UniformRingBuffer();
+
+	public:
+		// Destruct.
+		~UniformRingBuffer();
+
+		// Create a ring buffer.
+		// @param frameSize: the initial size of a single frame region, the buffer grows if a frame needs more.
+		static UniformRingBuffer* Create(int32_t frameSize);
+
+		// Begin a new frame, wait if the GPU is still reading the region of the new frame.
+		// @param requiredSize: the total size going to be allocated this frame, use GetAlignedSize() for each allocation.
+		void BeginFrame(int32_t requiredSize);
+
+		// End the current frame, must be called after all the draws that read the frame data are issued.
+		void EndFrame();
+
+		// Allocate a block in the current frame.
+		// @return the offset of the block in the buffer.
+		int32_t Allocate(int32_t size);
+
+		// Return the mapped memory at offset for writing.
+		uint8_t* GetData(int32_t offset);
+
+		// Bind a range of the buffer to a uniform block binding index.
+		void BindRange(int32_t binding, int32_t offset, int32_t size);
+
+		// Return the size rounded up to the uniform buffer offset alignment.
+		inline int32_t GetAlignedSize(int32_t size) const { return (size + alignment - 1) / alignment * alignment; }
+
+		// Return the size of a frame region.
+		inline int32_t GetFrameSize() const { return frameSize; }
+
+		// Return true if we are between BeginFrame() and EndFrame().
+		inline bool IsInFrame() const { return isInFrame; }
+
+	private:
+		// Wait for the GPU to finish reading a frame region.
+		void WaitFrame(uint32_t index);
+
+		// Recreate the buffer with a new frame size.
+		void Resize(int32_t newFrameSize);
+
+	private:
+		// OpenGL Uniform Buffer.
+		GLBuffer* buffer;
+
+		// The uniform buffer offset alignment required by the device.
+		int32_t alignment;
+
+		// The size of a single frame region.
+		int32_t frameSize;
+
+		// The current frame region.
+		uint32_t frameIndex;
+
+		// The current allocation offset in the frame region.
+		int32_t frameOffset;
+
+		// Fence (GLsync) of each frame region, null if the region is not used by the GPU.
+		void* fences[UNIFORM_RING_BUFFER_FRAMES];
+
+		// True if we are between BeginFrame() and EndFrame().
+		bool isInFrame;
+	};
+
+}
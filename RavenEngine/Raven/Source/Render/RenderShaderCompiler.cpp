@@ -0,0 +1,250 @@
+/*
+ * Developed by Raven Group at the University  of Leeds
+ * Copyright (C) 2021 Ammar Herzallah, Ben Husle, Thomas Moreno Cooper, Sulagna Sinha & Tian Zeng
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3 of the License.
+ *
+ * THIS PROGRAM IS DISTRIBUTED IN THE HOPE THAT IT WILL BE USEFUL,
+ * BUT WITHOUT ANY WARRANTY; WITHOUT EVEN THE IMPLIED WARRANTY OF
+ * MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE.  SEE THE
+ * GNU GENERAL PUBLIC LICENSE FOR MORE DETAILS.
+ */
+#include "RenderShaderCompiler.h"
+#include "RenderResource/Shader/RenderRscShader.h"
+#include "OpenGL/GLShader.h"
+
+
+#include "GL/glew.h"
+
+#include <algorithm>
+
+
+
+
+namespace Raven {
+
+
+
+
+RenderShaderCompiler::RenderShaderCompiler()
+	: isParallel(false)
+	, isStopping(false)
+{
+
+}
+
+
+RenderShaderCompiler::~RenderShaderCompiler()
+{
+	RAVEN_ASSERT(jobs.empty(), "RenderShaderCompiler - Destroyed with pending shaders.");
+
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		isStopping = true;
+	}
+
+	condition.notify_all();
+
+	for (auto& worker : workers)
+	{
+		worker.join();
+	}
+
+	for (auto job : jobs)
+	{
+		delete job;
+	}
+}
+
+
+void RenderShaderCompiler::Initialize()
+{
+	// Let the driver use as many threads as it wants.
+	if (GLEW_KHR_parallel_shader_compile)
+	{
+		glMaxShaderCompilerThreadsKHR(0xFFFFFFFF);
+		isParallel = true;
+	}
+	else if (GLEW_ARB_parallel_shader_compile)
+	{
+		glMaxShaderCompilerThreadsARB(0xFFFFFFFF);
+		isParallel = true;
+	}
+
+	// Sources preparation, leave a core for the main thread.
+	uint32_t numWorkers = std::thread::hardware_concurrency();
+	numWorkers = std::max(1u, std::min(numWorkers > 1 ? numWorkers - 1 : 1u, (uint32_t)RENDER_SHADER_COMPILER_MAX_WORKERS));
+
+	for (uint32_t i = 0; i < numWorkers; ++i)
+	{
+		workers.emplace_back(&RenderShaderCompiler::WorkerMain, this);
+	}
+}
+
+
+void RenderShaderCompiler::Submit(RenderRscShader* shader)
+{
+	Job* newJob = new Job();
+	newJob->shader = shader;
+	newJob->prepare = EPrepareState::Queued;
+	newJob->isCompiling = false;
+
+	jobs.push_back(newJob);
+
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		queue.push_back(newJob);
+	}
+
+	condition.notify_one();
+}
+
+
+void RenderShaderCompiler::Cancel(RenderRscShader* shader)
+{
+	auto iter = std::find_if(jobs.begin(), jobs.end(), [shader](const Job* job) { return job->shader == shader; });
+
+	if (iter == jobs.end())
+		return;
+
+	Job* job = *iter;
+
+	// The worker thread may still be using the shader.
+	{
+		std::unique_lock<std::mutex> lock(mutex);
+		auto queueIter = std::find(queue.begin(), queue.end(), job);
+
+		if (queueIter != queue.end())
+			queue.erase(queueIter);
+		else
+			prepared.wait(lock, [job]() { return job->prepare != EPrepareState::Running; });
+	}
+
+	jobs.erase(iter);
+	delete job;
+}
+
+
+void RenderShaderCompiler::Update()
+{
+	auto iter = std::remove_if(jobs.begin(), jobs.end(), [this](Job* job)
+		{
+			if (!UpdateJob(job, false))
+				return false;
+
+			delete job;
+			return true;
+		});
+
+	jobs.erase(iter, jobs.end());
+}
+
+
+void RenderShaderCompiler::Flush()
+{
+	// Start compiling all the shaders first, so the driver compile them in parallel.
+	for (auto job : jobs)
+	{
+		if (job->isCompiling)
+			continue;
+
+		if (GetPrepareState(job, true) == EPrepareState::Succeeded)
+		{
+			job->shader->GetShader()->BeginBuild();
+			job->isCompiling = true;
+		}
+	}
+
+	for (auto job : jobs)
+	{
+		UpdateJob(job, true);
+		delete job;
+	}
+
+	jobs.clear();
+}
+
+
+bool RenderShaderCompiler::UpdateJob(Job* job, bool isWait)
+{
+	GLShader* glshader = job->shader->GetShader();
+
+	// Sources not ready yet?
+	if (!job->isCompiling)
+	{
+		EPrepareState state = GetPrepareState(job, isWait);
+
+		if (state == EPrepareState::Queued || state == EPrepareState::Running)
+			return false;
+
+		// Failed to load the sources.
+		if (state == EPrepareState::Failed)
+		{
+			job->shader->OnBuildFinished(false);
+			return true;
+		}
+
+		job->isCompiling = true;
+		glshader->BeginBuild();
+	}
+
+	// Without parallel compile the driver would block anyway.
+	if (!isWait && isParallel && !glshader->IsBuildComplete())
+		return false;
+
+	job->shader->OnBuildFinished( glshader->FinishBuild() );
+	return true;
+}
+
+
+RenderShaderCompiler::EPrepareState RenderShaderCompiler::GetPrepareState(Job* job, bool isWait)
+{
+	std::unique_lock<std::mutex> lock(mutex);
+
+	if (isWait)
+	{
+		prepared.wait(lock, [job]()
+			{
+				return job->prepare == EPrepareState::Succeeded || job->prepare == EPrepareState::Failed;
+			});
+	}
+
+	return job->prepare;
+}
+
+
+void RenderShaderCompiler::WorkerMain()
+{
+	while (true)
+	{
+		Job* job = nullptr;
+
+		// Wait for a job...
+		{
+			std::unique_lock<std::mutex> lock(mutex);
+			condition.wait(lock, [this]() { return isStopping || !queue.empty(); });
+
+			if (isStopping)
+				return;
+
+			job = queue.front();
+			queue.pop_front();
+			job->prepare = EPrepareState::Running;
+		}
+
+		bool isPrepared = job->shader->GetShader()->PrepareBuild();
+
+		// Done...
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			job->prepare = isPrepared ? EPrepareState::Succeeded : EPrepareState::Failed;
+		}
+
+		prepared.notify_all();
+	}
+}
+
+
+} // End of namespace Raven.
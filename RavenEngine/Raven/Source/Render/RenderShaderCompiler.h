@@ -0,0 +1,140 @@
+/*
+ * Developed by Raven Group at the University  of Leeds
+ * Copyright (C) 2021 Ammar Herzallah, Ben Husle, Thomas Moreno Cooper, Sulagna Sinha & Tian Zeng
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3 of the License.
+ *
+ * THIS PROGRAM IS DISTRIBUTED IN THE HOPE THAT IT WILL BE USEFUL,
+ * BUT WITHOUT ANY WARRANTY; WITHOUT EVEN THE IMPLIED WARRANTY OF
+ * MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE.  SEE THE
+ * GNU GENERAL PUBLIC LICENSE FOR MORE DETAILS.
+ */
+#pragma once
+
+
+
+#include "Utilities/Core.h"
+
+
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+
+
+// The maximum number of worker threads preparing shader sources.
+#define RENDER_SHADER_COMPILER_MAX_WORKERS 2
+
+
+
+
+namespace Raven
+{
+	class RenderRscShader;
+
+
+
+	// RenderShaderCompiler:
+	//		- Build shaders without blocking the main thread, the sources of each shader are loaded
+	//		  and assembled on a small pool of worker threads, then compiled by the driver on the main thread.
+	//		- With GL_KHR_parallel_shader_compile the driver compile & link on its own threads, and
+	//		  Update() only finish the shaders that are done, otherwise it finish them as soon as
+	//		  their sources are ready.
+	//		- Shaders are not ready until their build is finished, @see RenderRscShader::IsReady().
+	//
+	class RenderShaderCompiler
+	{
+		NOCOPYABLE(RenderShaderCompiler);
+
+		// The state of the sources preparation of a job.
+		enum class EPrepareState
+		{
+			Queued,
+			Running,
+			Succeeded,
+			Failed
+		};
+
+		// A shader being built.
+		struct Job
+		{
+			// The shader to build.
+			RenderRscShader* shader;
+
+			// The sources preparation state, guarded by the mutex.
+			EPrepareState prepare;
+
+			// True if the driver started compiling the shader.
+			bool isCompiling;
+		};
+
+	public:
+		// Construct.
+		RenderShaderCompiler();
+
+		// Destruct.
+		~RenderShaderCompiler();
+
+		// Setup the driver parallel compile & start the worker threads, called once the OpenGL context is current.
+		void Initialize();
+
+		// Start building a shader, the shader must not be deleted without calling Cancel().
+		void Submit(RenderRscShader* shader);
+
+		// Remove a shader from the compiler, waits for the worker thread if its sources are being prepared.
+		void Cancel(RenderRscShader* shader);
+
+		// Advance the builds without waiting for the driver, called every frame on the main thread.
+		void Update();
+
+		// Finish all the builds, waits for the worker threads & the driver.
+		void Flush();
+
+		// Return the number of shaders still being built.
+		inline uint32_t GetNumPending() const { return (uint32_t)jobs.size(); }
+
+		// Return true if the driver compile shaders in parallel.
+		inline bool IsParallel() const { return isParallel; }
+
+	private:
+		// Advance a single job, return true if the job is finished.
+		bool UpdateJob(Job* job, bool isWait);
+
+		// Return the sources preparation state of a job, if isWait it waits until the preparation is done.
+		EPrepareState GetPrepareState(Job* job, bool isWait);
+
+		// The worker thread loop.
+		void WorkerMain();
+
+	private:
+		// The shaders being built, only used by the main thread.
+		std::vector<Job*> jobs;
+
+		// True if the driver compile shaders in parallel.
+		bool isParallel;
+
+		// Guard the queue & the jobs prepare state.
+		std::mutex mutex;
+
+		// Jobs waiting for a worker.
+		std::deque<Job*> queue;
+
+		// Notify the workers when a job is queued or when stopping.
+		std::condition_variable condition;
+
+		// Notify the main thread when a job preparation is done.
+		std::condition_variable prepared;
+
+		// The worker threads.
+		std::vector<std::thread> workers;
+
+		// True if the workers should exit.
+		bool isStopping;
+	};
+
+}
+
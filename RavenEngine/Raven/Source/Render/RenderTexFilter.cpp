@@ -265,10 +265,12 @@ void RenderTexFilter::FilterSpecularIBL(RenderRscTexture* inEnvTexture, RenderRs
 
 	//
 
+	static const GLUniformID inRoughnessID = GLShader::GetUniformID("inRoughness");
+
 	for (int32_t mip = 0; mip < NUM_IBL_SPEC_MIPS; ++mip)
 	{
 		float roughness = (float)mip / (float)(NUM_IBL_SPEC_MIPS - 1);
-		shader->SetUniform("inRoughness", roughness);
+		shader->SetUniform(inRoughnessID, roughness);
 
 		glm::ivec2 mipSize(size.x >> mip, size.y >> mip);
 		glm::ivec4 viewport(0, 0, mipSize.x, mipSize.y);
@@ -359,10 +361,12 @@ void RenderTexFilter::FilterSky(RenderRscShader* skyShader, RenderPass* skyPass,
 	shader->Use();
 	glm::ivec2 size(skyEnv->GetWidth(), skyEnv->GetHeight());
 
+	static const GLUniformID inRoughnessID = GLShader::GetUniformID("inRoughness");
+
 	for (int32_t mip = 0; mip < NUM_IBL_SPEC_MIPS; ++mip)
 	{
 		float roughness = (float)mip / (float)(NUM_IBL_SPEC_MIPS - 1);
-		shader->SetUniform("inRoughness", roughness);
+		shader->SetUniform(inRoughnessID, roughness);
 
 		if (mip > 3)
 		{
@@ -15,6 +15,18 @@
 #include "FileSystem.h"
 #include <sys/stat.h>
 #include <fstream>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <Windows.h>
+#else
+#include <sys/mman.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
 namespace Raven 
 {
 
@@ -38,4 +50,111 @@ namespace Raven
 	}
 
 
+	MappedFile::MappedFile()
+		: data(nullptr)
+		, size(0)
+		, fileHandle(nullptr)
+		, mappingHandle(nullptr)
+	{
+
+	}
+
+
+	MappedFile::~MappedFile()
+	{
+		Close();
+	}
+
+
+	bool MappedFile::Open(const std::string& path)
+	{
+		Close();
+
+#ifdef _WIN32
+		HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL,
+			OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+
+		if (file == INVALID_HANDLE_VALUE)
+			return false;
+
+		LARGE_INTEGER fileSize;
+
+		if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart == 0)
+		{
+			CloseHandle(file);
+			return false;
+		}
+
+		HANDLE mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+
+		if (!mapping)
+		{
+			CloseHandle(file);
+			return false;
+		}
+
+		void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+
+		if (!view)
+		{
+			CloseHandle(mapping);
+			CloseHandle(file);
+			return false;
+		}
+
+		fileHandle = file;
+		mappingHandle = mapping;
+		size = (size_t)fileSize.QuadPart;
+		data = (const uint8_t*)view;
+#else
+		int fd = open(path.c_str(), O_RDONLY);
+
+		if (fd == -1)
+			return false;
+
+		struct stat fileStat;
+
+		if (fstat(fd, &fileStat) != 0 || fileStat.st_size == 0)
+		{
+			close(fd);
+			return false;
+		}
+
+		void* view = mmap(nullptr, (size_t)fileStat.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+		close(fd);
+
+		if (view == MAP_FAILED)
+			return false;
+
+		// The whole file is going to be read once.
+		madvise(view, (size_t)fileStat.st_size, MADV_SEQUENTIAL);
+
+		size = (size_t)fileStat.st_size;
+		data = (const uint8_t*)view;
+#endif
+
+		return true;
+	}
+
+
+	void MappedFile::Close()
+	{
+		if (!data)
+			return;
+
+#ifdef _WIN32
+		UnmapViewOfFile(data);
+		CloseHandle((HANDLE)mappingHandle);
+		CloseHandle((HANDLE)fileHandle);
+#else
+		munmap((void*)data, size);
+#endif
+
+		data = nullptr;
+		size = 0;
+		fileHandle = nullptr;
+		mappingHandle = nullptr;
+	}
+
+
 };
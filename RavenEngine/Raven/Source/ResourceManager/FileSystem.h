@@ -22,4 +22,47 @@ namespace Raven
 	public:
 		static std::unique_ptr<uint8_t[]> ReadFile(const std::string& path,int64_t & size);
 	};
+
+
+	// MappedFile:
+	//		- Read only memory mapping of a whole file, the file pages are only read when accessed.
+	class MappedFile
+	{
+	public:
+		// Construct.
+		MappedFile();
+
+		// Destruct, unmap the file if open.
+		~MappedFile();
+
+		// No copy.
+		MappedFile(const MappedFile&) = delete;
+		MappedFile& operator=(const MappedFile&) = delete;
+
+		// Map a file, return false if the file can't be opened or mapped.
+		bool Open(const std::string& path);
+
+		// Unmap the file.
+		void Close();
+
+		// Return true if a file is mapped.
+		inline bool IsOpen() const { return data != nullptr; }
+
+		// Return the mapped memory.
+		inline const uint8_t* GetData() const { return data; }
+
+		// Return the size of the file in bytes.
+		inline size_t GetSize() const { return size; }
+
+	private:
+		// The mapped memory.
+		const uint8_t* data;
+
+		// The size of the file.
+		size_t size;
+
+		// The platform handles of the file & mapping.
+		void* fileHandle;
+		void* mappingHandle;
+	};
 };
\ No newline at end of file
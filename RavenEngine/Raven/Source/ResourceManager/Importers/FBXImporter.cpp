@@ -17,6 +17,8 @@
 #include "ResourceManager/Resources/Mesh.h"
 #include "ResourceManager/Resources/SkinnedMesh.h"
 #include "ResourceManager/MeshFactory.h"
+#include "ResourceManager/MeshSimplifier.h"
+#include "ResourceManager/MeshOptimizer.h"
 
 #include "Animation/Skeleton.h"
 #include "Animation/Animation.h"
@@ -412,6 +414,11 @@ Mesh* FbxLoader::ImportMesh()
 		if (section->positions.empty())
 			continue;
 
+		// Weld & Optimize...
+		MeshOptimizerStats stats = MeshOptimizer::Optimize(section.get());
+		LOGI("FBXImporter - Section {0}: vertices {1} -> {2}, ACMR {3:.3f} -> {4:.3f}.",
+			i, stats.numVerticesBefore, stats.numVerticesAfter, stats.acmrBefore, stats.acmrAfter);
+
 		// Generate Tangents...
 		section->tangents.resize(section->normals.size());
 		Raven::ComputeTangents(section->tangents.data(), section->indices.size(), section->indices.data(),
@@ -442,6 +449,11 @@ SkinnedMesh* FbxLoader::ImportSkinnedMesh()
 		if (section->positions.empty())
 			continue;
 
+		// Weld & Optimize...
+		MeshOptimizerStats stats = MeshOptimizer::Optimize(section.get());
+		LOGI("FBXImporter - Section {0}: vertices {1} -> {2}, ACMR {3:.3f} -> {4:.3f}.",
+			i, stats.numVerticesBefore, stats.numVerticesAfter, stats.acmrBefore, stats.acmrAfter);
+
 		// Generate Tangents...
 		section->tangents.resize(section->normals.size());
 		Raven::ComputeTangents(section->tangents.data(), section->indices.size(), section->indices.data(),
@@ -683,6 +695,9 @@ bool FBXImporter::Import(const std::string& path, std::vector< Ptr<IResource> >&
 			Ptr<Mesh> mesh(fbx.ImportMesh());
 			mesh->SetName("MESH_" + name);
 
+			// Generate LODs...
+			MeshSimplifier::GenerateLODs(mesh.get(), settings.lod);
+
 			resources.push_back(mesh);
 		}
 	}
@@ -15,6 +15,7 @@
 
 #include "Utilities/Core.h"
 #include "ResourceManager/Importers/Importer.h"
+#include "ResourceManager/MeshSimplifier.h"
 
 #include "glm/vec3.hpp"
 #include "glm/vec2.hpp"
@@ -150,6 +151,9 @@ namespace Raven
 		// Import only the mesh even if there is animation and a skeleton.
 		bool importMeshOnly;
 
+		// The LOD levels to generate for imported meshes.
+		MeshLODSettings lod;
+
 		// Construct.
 		FBXImporterSettings()
 			: skeleton(nullptr)
@@ -16,6 +16,8 @@
 
 #include "ResourceManager/Resources/Mesh.h"
 #include "ResourceManager/MeshFactory.h"
+#include "ResourceManager/MeshSimplifier.h"
+#include "ResourceManager/MeshOptimizer.h"
 
 
 
@@ -56,6 +58,10 @@ bool OBJImporter::Import(const std::string& path, std::vector< Ptr<IResource> >&
   }
 
   resources.emplace_back(newRsc);
+
+  // Reset Settings.
+  settings = OBJImporterSettings();
+
 	return true;
 }
 
@@ -124,6 +130,11 @@ IResource* OBJImporter::LoadOBJ(const std::string& path)
     }
 
 
+    // Weld & Optimize...
+    MeshOptimizerStats stats = MeshOptimizer::Optimize(meshSection.get());
+    LOGI("OBJImporter - Section {0}: vertices {1} -> {2}, ACMR {3:.3f} -> {4:.3f}.",
+      shape.name, stats.numVerticesBefore, stats.numVerticesAfter, stats.acmrBefore, stats.acmrAfter);
+
     // Generate Tangents...
     meshSection->tangents.resize(meshSection->normals.size());
     Raven::ComputeTangents(meshSection->tangents.data(), meshSection->indices.size(), meshSection->indices.data(),
@@ -132,6 +143,9 @@ IResource* OBJImporter::LoadOBJ(const std::string& path)
     mesh->AddMeshSection(meshSection);
   }
 
+  // Generate LODs...
+  MeshSimplifier::GenerateLODs(mesh, settings.lod);
+
 
   //
   mesh->SetName( "MESH_" + StringUtils::GetFileNameWithoutExtension(path) );
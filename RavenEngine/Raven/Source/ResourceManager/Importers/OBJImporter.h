@@ -15,11 +15,18 @@
 
 
 #include "ResourceManager/Importers/Importer.h"
+#include "ResourceManager/MeshSimplifier.h"
 
 
 
 namespace Raven
 {
+	struct OBJImporterSettings
+	{
+		// The LOD levels to generate for imported meshes.
+		MeshLODSettings lod;
+	};
+
 
 	// OBJImporter:
 	//    - import obj into a mesh resource.
@@ -41,5 +48,9 @@ namespace Raven
 	private:
 		// Load a mesh resource from an obj file.
 		IResource* LoadOBJ(const std::string& path);
+
+	public:
+		// Next import settings will be reset after importing.
+		OBJImporterSettings settings;
 	};
 }
\ No newline at end of file
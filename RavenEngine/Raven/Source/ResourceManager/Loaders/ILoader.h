@@ -20,6 +20,9 @@
 
 
 #include "Utilities/Core.h"
+#include "Utilities/MemoryStreamBuf.h"
+#include "Utilities/Serialization.h"
+#include "ResourceManager/FileSystem.h"
 #include "ResourceManager/RavenVersion.h"
 #include "ResourceManager/Resources/IResource.h"
 
@@ -74,16 +77,47 @@ namespace Raven
 
 	public:
 		// Create an input archive
-		RavenInputArchive(const std::string& file)
+		// @param isMapped: if true the file is memory mapped, bulk data is copied or decompressed straight from the mapping.
+		RavenInputArchive(const std::string& file, bool isMapped = false)
+			: memoryBuf(nullptr, 0)
+			, memoryStream(&memoryBuf)
+			, isMemory(false)
+			, codec(ECompressionCodec::Zlib)
 		{
-			fileStream.open(file, std::ios::in | std::ios::binary);
-			archive = new cereal::BinaryInputArchive(fileStream);
+			if (isMapped && mappedFile.Open(file))
+			{
+				memoryBuf.Reset(mappedFile.GetData(), mappedFile.GetSize());
+				isMemory = true;
+				archive = new cereal::BinaryInputArchive(memoryStream);
+				RavenMemoryStreamBuf::Attach(archive, &memoryBuf);
+			}
+			else
+			{
+				fileStream.open(file, std::ios::in | std::ios::binary);
+				archive = new cereal::BinaryInputArchive(fileStream);
+			}
+		}
+
+		// Create an input archive that reads a file already loaded in memory.
+		RavenInputArchive(const uint8_t* data, size_t size)
+			: memoryBuf(data, size)
+			, memoryStream(&memoryBuf)
+			, isMemory(true)
+			, codec(ECompressionCodec::Zlib)
+		{
+			archive = new cereal::BinaryInputArchive(memoryStream);
+			RavenMemoryStreamBuf::Attach(archive, &memoryBuf);
 		}
 
 
 		// Destructor.
 		~RavenInputArchive()
 		{
+			if (isMemory)
+			{
+				RavenMemoryStreamBuf::Detach(archive);
+			}
+
 			if (fileStream.is_open())
 			{
 				fileStream.close();
@@ -93,13 +127,17 @@ namespace Raven
 		}
 
 		// Return true if the archive stream is valid.
-		inline bool IsValid() { return fileStream.is_open(); }
+		inline bool IsValid() { return isMemory || fileStream.is_open(); }
+
+		// Return true if the archive reads from a memory mapped file.
+		inline bool IsMapped() const { return mappedFile.IsOpen(); }
 
 		// Archive
 		template<class T>
 		inline void ArchiveLoad(T& obj)
 		{
 			ILoader::SetLoadVersion(obj, version);
+			CompressionCodecScope codecScope(codec);
 			(*archive)(obj);
 		}
 
@@ -111,10 +149,23 @@ namespace Raven
 		// The file stream.
 		std::ifstream fileStream;
 
+		// The memory stream, used if the archive reads from memory.
+		RavenMemoryStreamBuf memoryBuf;
+		std::istream memoryStream;
+
+		// True if the archive reads from memory.
+		bool isMemory;
+
+		// The mapped file, if the archive reads from a memory mapped file.
+		MappedFile mappedFile;
+
 
 	public:
 		// The version of the loaded file
 		uint32_t version;
+
+		// The codec of the compressed data in the loaded file.
+		ECompressionCodec codec;
 	};
 
 
@@ -129,6 +180,7 @@ namespace Raven
 	public:
 		// Create an output rchive
 		RavenOutputArchive(const std::string& file)
+			: codec(ECompressionCodec::Zlib)
 		{
 			fileStream.open(file, std::ios::out | std::ios::binary);
 			archive = new cereal::BinaryOutputArchive(fileStream);
@@ -153,6 +205,7 @@ namespace Raven
 		template<class T>
 		inline void ArchiveSave(T& obj)
 		{
+			CompressionCodecScope codecScope(codec);
 			(*archive)(obj);
 		}
 
@@ -163,6 +216,10 @@ namespace Raven
 		// The file stream.
 		std::ofstream fileStream;
 
+	public:
+		// The codec used to compress data in the saved file.
+		ECompressionCodec codec;
+
 	};
 
 
@@ -181,11 +238,15 @@ namespace Raven
 		// The type of the Resource, converted from EResourceType.
 		int32_t type;
 
+		// The codec of the compressed data in the Resource.
+		ECompressionCodec codec;
+
 	public:
 		// Construct.
 		ResourceHeaderInfo()
 			: type(-1)
 			, version(RAVEN_VERSION)
+			, codec(ECompressionCodec::Zlib)
 		{
 
 		}
@@ -195,8 +256,21 @@ namespace Raven
 		{
 			version = RAVEN_VERSION;
 			type = static_cast<uint32_t>(rsc->GetType());
+			codec = ECompressionCodec::Zlib;
+		}
+
+		// Construct from a header loaded before, @see ResourceCatalog.
+		ResourceHeaderInfo(int32_t inType, uint32_t inVersion)
+			: type(inType)
+			, version(inVersion)
+			, codec(ECompressionCodec::Zlib)
+		{
+
 		}
 
+		// Return the raw type value, -1 if invalid.
+		inline int32_t GetRawType() const { return type; }
+
 		// Save Raven file header.
 		template<typename Archive>
 		void save(Archive& archive) const
@@ -210,6 +284,9 @@ namespace Raven
 				version,
 				type
 			);
+
+			uint8_t codecValue = static_cast<uint8_t>(codec);
+			archive(codecValue);
 		}
 
 		// Load Raven file header.
@@ -232,10 +309,21 @@ namespace Raven
 				version,
 				type
 			);
+
+			// Files before codecs were added are compressed with zlib.
+			uint8_t codecValue = static_cast<uint8_t>(ECompressionCodec::Zlib);
+
+			if (version >= 10003)
+			{
+				archive(codecValue);
+			}
+
+			codec = static_cast<ECompressionCodec>(codecValue);
 		}
 
 		// Getters...
 		inline uint32_t GetVersion() const { return version; }
+		inline ECompressionCodec GetCodec() const { return codec; }
 		inline EResourceType GetType() const { return static_cast<EResourceType>(type); }
 
 		// Return true if valid header.
@@ -295,6 +383,17 @@ namespace Raven
 		// Load Resource from archive.
 		virtual IResource* LoadResource(const ResourceHeaderInfo& info, RavenInputArchive& archive) = 0;
 
+		// Load the header then the Resource from archive.
+		// @return the loaded resource, or null if the header is invalid.
+		IResource* LoadArchive(RavenInputArchive& archive, ResourceHeaderInfo& outInfo);
+
+		// Return true if a Resource of this type can be loaded on a worker thread, which requires
+		// the Resource to not load other resources or use the render module while loading.
+		virtual bool IsThreadSafe(EResourceType rscType) const { return false; }
+
+		// Return the codec used to compress the data of a Resource type when saved.
+		virtual ECompressionCodec GetCodec(EResourceType rscType) const { return ECompressionCodec::ZlibChunked; }
+
 		// Save Resource into archive.
 		virtual void SaveResource(RavenOutputArchive& archive, IResource* Resource) = 0;
 
@@ -302,7 +401,8 @@ namespace Raven
 		static ResourceHeaderInfo LoadHeader(RavenInputArchive& archive);
 
 		// Save the header at the start of the file and return the offset.
-		static ResourceHeaderInfo SaveHeader(RavenOutputArchive& archive, IResource* rsc);
+		// @param codec: the codec used to compress the Resource data that follow the header.
+		static ResourceHeaderInfo SaveHeader(RavenOutputArchive& archive, IResource* rsc, ECompressionCodec codec);
 
 		// List all resources that supported by this loader.
 		virtual void ListResourceTypes(std::vector<EResourceType>& outRscTypes) = 0;
@@ -47,5 +47,8 @@ namespace Raven
 		// List all resources that supported by this loader.
 		virtual void ListResourceTypes(std::vector<EResourceType>& outRscTypes) override;
 
+		// Textures are self-contained, only their render resources need the main thread.
+		virtual bool IsThreadSafe(EResourceType rscType) const override { return rscType == RT_Texture2D; }
+
 	};
 }
\ No newline at end of file
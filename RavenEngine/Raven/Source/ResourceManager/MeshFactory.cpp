@@ -874,6 +874,12 @@ EBasicShape::Type EBasicShape::GetPrimativeName(const std::string& name)
 void ComputeTangents(glm::vec3* out, uint32_t indices_count, uint32_t* indices,
 	const glm::vec3* vertices, const glm::vec3* normals, const glm::vec2* uvs)
 {
+	// Shared vertices accumulate the tangents of all their triangles.
+	for (uint32_t i = 0; i < indices_count; ++i)
+	{
+		out[ indices[i] ] = glm::vec3(0.0f);
+	}
+
 	for (int i = 0; i < indices_count; i += 3)
 	{
 		const glm::vec3 v0 = vertices[ indices[i + 0] ];
@@ -894,14 +900,30 @@ void ComputeTangents(glm::vec3* out, uint32_t indices_count, uint32_t* indices,
 		tangent.y = (dv20.y * duv10.y - dv10.y * duv20.y) * dir;
 		tangent.z = (dv20.z * duv10.y - dv10.z * duv20.y) * dir;
 
-		const float l = 1 / sqrtf(float(tangent.x * tangent.x + tangent.y * tangent.y + tangent.z * tangent.z));
-		tangent.x *= l;
-		tangent.y *= l;
-		tangent.z *= l;
+		const float len2 = tangent.x * tangent.x + tangent.y * tangent.y + tangent.z * tangent.z;
+
+		// Degenerate uvs?
+		if (len2 <= 0.0f)
+			continue;
+
+		tangent *= 1 / sqrtf(len2);
+
+		out[ indices[i + 0] ] += tangent;
+		out[ indices[i + 1] ] += tangent;
+		out[ indices[i + 2] ] += tangent;
+	}
+
+	// Normalize & make orthogonal to the normal.
+	for (uint32_t i = 0; i < indices_count; ++i)
+	{
+		glm::vec3& tangent = out[ indices[i] ];
+		const glm::vec3& normal = normals[ indices[i] ];
+
+		glm::vec3 t = tangent - normal * glm::dot(normal, tangent);
+		float len = glm::length(t);
 
-		out[ indices[i] + 0 ] = tangent;
-		out[ indices[i] + 1 ] = tangent;
-		out[ indices[i] + 2 ] = tangent;
+		if (len > 0.0f)
+			tangent = t / len;
 	}
 }
 
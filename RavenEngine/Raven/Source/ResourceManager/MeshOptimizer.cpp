@@ -0,0 +1,552 @@
+/*
+ * Developed by Raven Group at the University  of Leeds
+ * Copyright (C) 2021 Ammar Herzallah, Ben Husle, Thomas Moreno Cooper, Sulagna Sinha & Tian Zeng
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3 of the License.
+ *
+ * THIS PROGRAM IS DISTRIBUTED IN THE HOPE THAT IT WILL BE USEFUL,
+ * BUT WITHOUT ANY WARRANTY; WITHOUT EVEN THE IMPLIED WARRANTY OF
+ * MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE.  SEE THE
+ * GNU GENERAL PUBLIC LICENSE FOR MORE DETAILS.
+ */
+#include "MeshOptimizer.h"
+
+#include "ResourceManager/Resources/Mesh.h"
+#include "ResourceManager/Resources/SkinnedMesh.h"
+#include "Utilities/Hash.h"
+
+
+#include <glm/glm.hpp>
+#include <unordered_map>
+#include <algorithm>
+#include <cstring>
+
+
+
+// The size of the LRU cache modeled by the Forsyth optimization.
+#define FORSYTH_CACHE_SIZE 32
+
+// Forsyth score constants.
+#define FORSYTH_CACHE_DECAY_POWER 1.5f
+#define FORSYTH_LAST_TRI_SCORE 0.75f
+#define FORSYTH_VALENCE_BOOST_SCALE 2.0f
+#define FORSYTH_VALENCE_BOOST_POWER 0.5f
+
+
+
+
+namespace Raven {
+
+
+
+// Raw view of a vertex attribute, used to weld vertices of any section type.
+struct VertexStream
+{
+	// The attribute data.
+	const uint8_t* data;
+
+	// The size of a single vertex attribute.
+	uint32_t stride;
+};
+
+
+// Add a vertex attribute to the streams, only if it exist for all vertices.
+template<class T>
+static void AddStream(std::vector<VertexStream>& streams, const std::vector<T>& data, size_t numVertices)
+{
+	if (numVertices == 0 || data.size() != numVertices)
+		return;
+
+	streams.push_back({ reinterpret_cast<const uint8_t*>(data.data()), (uint32_t)sizeof(T) });
+}
+
+
+// Move the vertex attribute to its new index, removed vertices has a remap of UINT32_MAX.
+template<class T>
+static void RemapVector(std::vector<T>& data, const std::vector<uint32_t>& remap, uint32_t newCount)
+{
+	if (data.size() != remap.size())
+		return;
+
+	std::vector<T> newData(newCount);
+
+	for (uint32_t i = 0; i < (uint32_t)remap.size(); ++i)
+	{
+		if (remap[i] != UINT32_MAX)
+			newData[remap[i]] = data[i];
+	}
+
+	data.swap(newData);
+}
+
+
+static void GatherStreams(const MeshSection* section, std::vector<VertexStream>& streams)
+{
+	size_t numVertices = section->positions.size();
+	AddStream(streams, section->positions, numVertices);
+	AddStream(streams, section->normals, numVertices);
+	AddStream(streams, section->tangents, numVertices);
+	AddStream(streams, section->texCoords, numVertices);
+}
+
+
+static void GatherStreams(const SkinnedMeshSection* section, std::vector<VertexStream>& streams)
+{
+	size_t numVertices = section->positions.size();
+	AddStream(streams, section->positions, numVertices);
+	AddStream(streams, section->normals, numVertices);
+	AddStream(streams, section->tangents, numVertices);
+	AddStream(streams, section->texCoords, numVertices);
+	AddStream(streams, section->blendIndices, numVertices);
+	AddStream(streams, section->blendWeights, numVertices);
+}
+
+
+static void RemapSection(MeshSection* section, const std::vector<uint32_t>& remap, uint32_t newCount)
+{
+	RemapVector(section->normals, remap, newCount);
+	RemapVector(section->tangents, remap, newCount);
+	RemapVector(section->texCoords, remap, newCount);
+	RemapVector(section->positions, remap, newCount);
+}
+
+
+static void RemapSection(SkinnedMeshSection* section, const std::vector<uint32_t>& remap, uint32_t newCount)
+{
+	RemapVector(section->normals, remap, newCount);
+	RemapVector(section->tangents, remap, newCount);
+	RemapVector(section->texCoords, remap, newCount);
+	RemapVector(section->blendIndices, remap, newCount);
+	RemapVector(section->blendWeights, remap, newCount);
+	RemapVector(section->positions, remap, newCount);
+}
+
+
+// Weld vertices with the same data in all streams.
+// @return the number of unique vertices.
+static uint32_t WeldVertices(const std::vector<VertexStream>& streams, uint32_t numVertices, std::vector<uint32_t>& outRemap)
+{
+	// FNV-1a hash of all the vertex attributes.
+	auto hashVertex = [&](uint32_t v)
+	{
+		uint64_t hash = HASH_OFFSET_BASIS;
+
+		for (const auto& stream : streams)
+		{
+			hash = HashBytes(hash, stream.data + (size_t)v * stream.stride, stream.stride);
+		}
+
+		return (size_t)hash;
+	};
+
+	auto isEqual = [&](uint32_t a, uint32_t b)
+	{
+		for (const auto& stream : streams)
+		{
+			if (memcmp(stream.data + (size_t)a * stream.stride, stream.data + (size_t)b * stream.stride, stream.stride) != 0)
+				return false;
+		}
+
+		return true;
+	};
+
+	std::unordered_map<uint32_t, uint32_t, decltype(hashVertex), decltype(isEqual)> vertexMap(numVertices, hashVertex, isEqual);
+	outRemap.resize(numVertices);
+	uint32_t numUnique = 0;
+
+	for (uint32_t v = 0; v < numVertices; ++v)
+	{
+		auto iter = vertexMap.emplace(v, numUnique);
+
+		if (iter.second)
+			++numUnique;
+
+		outRemap[v] = iter.first->second;
+	}
+
+	return numUnique;
+}
+
+
+// Forsyth score of a vertex from its position in the cache and the number of triangles not yet added.
+static float ForsythVertexScore(int32_t cachePos, uint32_t numActiveTris)
+{
+	// No triangles left, never pick it again.
+	if (numActiveTris == 0)
+		return -1.0f;
+
+	float score = 0.0f;
+
+	if (cachePos >= 0)
+	{
+		// The vertices of the last triangle have a fixed score, so triangles don't favour any of its edges.
+		if (cachePos < 3)
+		{
+			score = FORSYTH_LAST_TRI_SCORE;
+		}
+		else
+		{
+			float scaler = 1.0f / (FORSYTH_CACHE_SIZE - 3);
+			score = glm::pow(1.0f - (float)(cachePos - 3) * scaler, FORSYTH_CACHE_DECAY_POWER);
+		}
+	}
+
+	// Boost vertices with few triangles left, to finish them and avoid leaving lone triangles.
+	score += FORSYTH_VALENCE_BOOST_SCALE * glm::pow((float)numActiveTris, -FORSYTH_VALENCE_BOOST_POWER);
+
+	return score;
+}
+
+
+// Reorder triangles to reuse the post-transform vertex cache, using Tom Forsyth linear-speed optimization.
+static void OptimizeVertexCache(std::vector<uint32_t>& indices, uint32_t numVertices)
+{
+	const uint32_t numTris = (uint32_t)indices.size() / 3;
+
+	if (numTris == 0)
+		return;
+
+	// Vertex to triangles adjacency, the active triangles of each vertex are kept first.
+	std::vector<uint32_t> numActiveTris(numVertices, 0);
+	std::vector<uint32_t> adjOffsets(numVertices + 1, 0);
+	std::vector<uint32_t> adjTris(numTris * 3);
+
+	for (uint32_t i = 0; i < numTris * 3; ++i)
+		numActiveTris[indices[i]]++;
+
+	for (uint32_t v = 0; v < numVertices; ++v)
+		adjOffsets[v + 1] = adjOffsets[v] + numActiveTris[v];
+
+	{
+		std::vector<uint32_t> adjCount(numVertices, 0);
+
+		for (uint32_t i = 0; i < numTris * 3; ++i)
+		{
+			uint32_t v = indices[i];
+			adjTris[adjOffsets[v] + adjCount[v]++] = i / 3;
+		}
+	}
+
+	// Initial scores.
+	std::vector<int32_t> cachePos(numVertices, -1);
+	std::vector<float> vertexScores(numVertices);
+	std::vector<float> triScores(numTris);
+	std::vector<bool> isAdded(numTris, false);
+
+	for (uint32_t v = 0; v < numVertices; ++v)
+		vertexScores[v] = ForsythVertexScore(-1, numActiveTris[v]);
+
+	int32_t bestTri = -1;
+	float bestScore = -1.0f;
+
+	for (uint32_t t = 0; t < numTris; ++t)
+	{
+		triScores[t] = vertexScores[indices[t * 3 + 0]] + vertexScores[indices[t * 3 + 1]] + vertexScores[indices[t * 3 + 2]];
+
+		if (triScores[t] > bestScore)
+		{
+			bestScore = triScores[t];
+			bestTri = (int32_t)t;
+		}
+	}
+
+
+	std::vector<uint32_t> newIndices;
+	newIndices.reserve(indices.size());
+
+	std::vector<uint32_t> cache, newCache;
+	cache.reserve(FORSYTH_CACHE_SIZE + 3);
+	newCache.reserve(FORSYTH_CACHE_SIZE + 3);
+
+	// Used when no triangle in the cache is left, to continue from the next triangle in the input order.
+	uint32_t nextTri = 0;
+
+	for (uint32_t added = 0; added < numTris; ++added)
+	{
+		if (bestTri == -1)
+		{
+			while (isAdded[nextTri])
+				++nextTri;
+
+			bestTri = (int32_t)nextTri;
+		}
+
+		const uint32_t* tri = &indices[bestTri * 3];
+		isAdded[bestTri] = true;
+
+		// Add the triangle & remove it from the active triangles of its vertices.
+		for (uint32_t k = 0; k < 3; ++k)
+		{
+			uint32_t v = tri[k];
+			newIndices.push_back(v);
+
+			uint32_t* vtris = &adjTris[adjOffsets[v]];
+			uint32_t& count = numActiveTris[v];
+
+			for (uint32_t i = 0; i < count; ++i)
+			{
+				if (vtris[i] == (uint32_t)bestTri)
+				{
+					std::swap(vtris[i], vtris[count - 1]);
+					--count;
+					break;
+				}
+			}
+		}
+
+		// Move the triangle vertices to the front of the cache.
+		newCache.clear();
+		newCache.push_back(tri[0]);
+		newCache.push_back(tri[1]);
+		newCache.push_back(tri[2]);
+
+		for (uint32_t v : cache)
+		{
+			if (v != tri[0] && v != tri[1] && v != tri[2])
+				newCache.push_back(v);
+		}
+
+		// Update the scores of the cache vertices, including the ones pushed out of it.
+		for (uint32_t i = 0; i < (uint32_t)newCache.size(); ++i)
+		{
+			uint32_t v = newCache[i];
+			cachePos[v] = i < FORSYTH_CACHE_SIZE ? (int32_t)i : -1;
+			vertexScores[v] = ForsythVertexScore(cachePos[v], numActiveTris[v]);
+		}
+
+		// Update the scores of their triangles & pick the next best one.
+		bestTri = -1;
+		bestScore = -1.0f;
+
+		for (uint32_t v : newCache)
+		{
+			const uint32_t* vtris = &adjTris[adjOffsets[v]];
+
+			for (uint32_t i = 0; i < numActiveTris[v]; ++i)
+			{
+				uint32_t t = vtris[i];
+				float score = vertexScores[indices[t * 3 + 0]] + vertexScores[indices[t * 3 + 1]] + vertexScores[indices[t * 3 + 2]];
+				triScores[t] = score;
+
+				if (score > bestScore || (score == bestScore && (int32_t)t < bestTri))
+				{
+					bestScore = score;
+					bestTri = (int32_t)t;
+				}
+			}
+		}
+
+		if (newCache.size() > FORSYTH_CACHE_SIZE)
+			newCache.resize(FORSYTH_CACHE_SIZE);
+
+		cache.swap(newCache);
+	}
+
+	indices.swap(newIndices);
+}
+
+
+// Reorder clusters of triangles so clusters facing outward are drawn first and occlude the rest.
+static void OptimizeOverdraw(std::vector<uint32_t>& indices, const std::vector<glm::vec3>& positions)
+{
+	const uint32_t numTris = (uint32_t)indices.size() / 3;
+	const uint32_t numVertices = (uint32_t)positions.size();
+
+	if (numTris == 0)
+		return;
+
+	// Split into clusters where the vertex cache restart, triangles that miss all their vertices,
+	// reordering at these points doesn't change the cache efficiency much.
+	std::vector<uint32_t> clusters;
+	std::vector<uint32_t> cacheTime(numVertices, 0);
+	uint32_t time = MESH_OPTIMIZER_ACMR_CACHE_SIZE + 1;
+
+	for (uint32_t t = 0; t < numTris; ++t)
+	{
+		uint32_t numMisses = 0;
+
+		for (uint32_t k = 0; k < 3; ++k)
+		{
+			uint32_t v = indices[t * 3 + k];
+
+			if (time - cacheTime[v] > MESH_OPTIMIZER_ACMR_CACHE_SIZE)
+			{
+				cacheTime[v] = time++;
+				++numMisses;
+			}
+		}
+
+		if (t == 0 || numMisses == 3)
+			clusters.push_back(t);
+	}
+
+	if (clusters.size() < 2)
+		return;
+
+	clusters.push_back(numTris);
+	const uint32_t numClusters = (uint32_t)clusters.size() - 1;
+
+
+	// The area weighted center & normal of each cluster.
+	std::vector<glm::vec3> clusterCenters(numClusters);
+	std::vector<glm::vec3> clusterNormals(numClusters);
+	glm::vec3 meshCenter(0.0f);
+	float meshArea = 0.0f;
+
+	for (uint32_t c = 0; c < numClusters; ++c)
+	{
+		glm::vec3 center(0.0f);
+		glm::vec3 normal(0.0f);
+		float area = 0.0f;
+
+		for (uint32_t t = clusters[c]; t < clusters[c + 1]; ++t)
+		{
+			const glm::vec3& p0 = positions[indices[t * 3 + 0]];
+			const glm::vec3& p1 = positions[indices[t * 3 + 1]];
+			const glm::vec3& p2 = positions[indices[t * 3 + 2]];
+
+			glm::vec3 n = glm::cross(p1 - p0, p2 - p0);
+			float triArea = glm::length(n);
+
+			center += (p0 + p1 + p2) * (triArea / 3.0f);
+			normal += n;
+			area += triArea;
+		}
+
+		meshCenter += center;
+		meshArea += area;
+
+		clusterCenters[c] = area > 0.0f ? center / area : positions[indices[clusters[c] * 3]];
+		clusterNormals[c] = normal;
+	}
+
+	if (meshArea > 0.0f)
+		meshCenter /= meshArea;
+
+
+	// Sort clusters by how much they face away from the mesh center.
+	std::vector<float> sortKeys(numClusters);
+	std::vector<uint32_t> order(numClusters);
+
+	for (uint32_t c = 0; c < numClusters; ++c)
+	{
+		float len = glm::length(clusterNormals[c]);
+		sortKeys[c] = len > 0.0f ? glm::dot(clusterCenters[c] - meshCenter, clusterNormals[c] / len) : 0.0f;
+		order[c] = c;
+	}
+
+	std::stable_sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b) { return sortKeys[a] > sortKeys[b]; });
+
+
+	std::vector<uint32_t> newIndices;
+	newIndices.reserve(indices.size());
+
+	for (uint32_t c : order)
+	{
+		newIndices.insert(newIndices.end(), indices.begin() + clusters[c] * 3, indices.begin() + clusters[c + 1] * 3);
+	}
+
+	indices.swap(newIndices);
+}
+
+
+template<class TSection>
+static MeshOptimizerStats OptimizeSection(TSection* section)
+{
+	MeshOptimizerStats stats;
+	stats.numVerticesBefore = (uint32_t)section->positions.size();
+	stats.acmrBefore = MeshOptimizer::ComputeACMR(section->indices, stats.numVerticesBefore);
+
+	// Weld...
+	std::vector<VertexStream> streams;
+	GatherStreams(section, streams);
+
+	std::vector<uint32_t> remap;
+	uint32_t numVertices = WeldVertices(streams, stats.numVerticesBefore, remap);
+
+	for (auto& index : section->indices)
+		index = remap[index];
+
+	RemapSection(section, remap, numVertices);
+
+	// Vertex Cache & Overdraw...
+	MeshOptimizer::OptimizeIndices(section->indices, section->positions);
+
+	// Vertex Fetch, order vertices by their first use and drop unused ones.
+	remap.assign(numVertices, UINT32_MAX);
+	numVertices = 0;
+
+	for (auto& index : section->indices)
+	{
+		if (remap[index] == UINT32_MAX)
+			remap[index] = numVertices++;
+
+		index = remap[index];
+	}
+
+	RemapSection(section, remap, numVertices);
+
+	stats.numVerticesAfter = numVertices;
+	stats.acmrAfter = MeshOptimizer::ComputeACMR(section->indices, numVertices);
+
+	return stats;
+}
+
+
+
+
+
+// --- -- --- -- --- -- --- -- --- -- --- -- --- -- --- -- --- -- --- -- --- -- --- --
+
+
+
+MeshOptimizerStats MeshOptimizer::Optimize(MeshSection* section)
+{
+	return OptimizeSection(section);
+}
+
+
+MeshOptimizerStats MeshOptimizer::Optimize(SkinnedMeshSection* section)
+{
+	return OptimizeSection(section);
+}
+
+
+void MeshOptimizer::OptimizeIndices(std::vector<uint32_t>& indices, const std::vector<glm::vec3>& positions)
+{
+	OptimizeVertexCache(indices, (uint32_t)positions.size());
+	OptimizeOverdraw(indices, positions);
+}
+
+
+float MeshOptimizer::ComputeACMR(const std::vector<uint32_t>& indices, uint32_t numVertices, uint32_t cacheSize)
+{
+	const uint32_t numTris = (uint32_t)indices.size() / 3;
+
+	if (numTris == 0)
+		return 0.0f;
+
+	// FIFO cache, a vertex is in the cache if less than cacheSize misses happened since it was added.
+	std::vector<uint32_t> cacheTime(numVertices, 0);
+	uint32_t time = cacheSize + 1;
+	uint32_t numMisses = 0;
+
+	for (uint32_t i = 0; i < numTris * 3; ++i)
+	{
+		uint32_t v = indices[i];
+
+		if (time - cacheTime[v] > cacheSize)
+		{
+			cacheTime[v] = time++;
+			++numMisses;
+		}
+	}
+
+	return (float)numMisses / (float)numTris;
+}
+
+
+
+} // End of namespace Raven.
@@ -0,0 +1,73 @@
+/*
+ * Developed by Raven Group at the University  of Leeds
+ * Copyright (C) 2021 Ammar Herzallah, Ben Husle, Thomas Moreno Cooper, Sulagna Sinha & Tian Zeng
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3 of the License.
+ *
+ * THIS PROGRAM IS DISTRIBUTED IN THE HOPE THAT IT WILL BE USEFUL,
+ * BUT WITHOUT ANY WARRANTY; WITHOUT EVEN THE IMPLIED WARRANTY OF
+ * MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE.  SEE THE
+ * GNU GENERAL PUBLIC LICENSE FOR MORE DETAILS.
+ */
+#pragma once
+
+#include "Utilities/Core.h"
+
+#include <glm/vec3.hpp>
+#include <vector>
+
+
+
+// The size of the FIFO cache used to compute the ACMR.
+#define MESH_OPTIMIZER_ACMR_CACHE_SIZE 16
+
+
+
+
+namespace Raven
+{
+	class MeshSection;
+	class SkinnedMeshSection;
+
+
+
+	// The results of optimizing a mesh section.
+	struct MeshOptimizerStats
+	{
+		// The number of vertices before & after welding.
+		uint32_t numVerticesBefore;
+		uint32_t numVerticesAfter;
+
+		// The average cache miss ratio before & after optimizing.
+		float acmrBefore;
+		float acmrAfter;
+	};
+
+
+
+	// MeshOptimizer:
+	//    - optimize imported mesh sections for rendering.
+	//    - weld vertices with identical attributes, order triangles for the post-transform vertex
+	//      cache (Forsyth) then order clusters of triangles for overdraw, and finally order
+	//      vertices by first use for vertex fetch.
+	//
+	class MeshOptimizer
+	{
+	public:
+		// Optimize a mesh section, must be called before computing tangents as tangents are not welded.
+		static MeshOptimizerStats Optimize(MeshSection* section);
+
+		// Optimize a skinned mesh section, vertices are only welded if their blend weights & indices match.
+		static MeshOptimizerStats Optimize(SkinnedMeshSection* section);
+
+		// Reorder triangles for the post-transform vertex cache then for overdraw.
+		static void OptimizeIndices(std::vector<uint32_t>& indices, const std::vector<glm::vec3>& positions);
+
+		// Return the average cache miss ratio, the number of transformed vertices per triangle using a FIFO cache.
+		static float ComputeACMR(const std::vector<uint32_t>& indices, uint32_t numVertices,
+			uint32_t cacheSize = MESH_OPTIMIZER_ACMR_CACHE_SIZE);
+	};
+
+}
@@ -0,0 +1,682 @@
+/*
+ * Developed by Raven Group at the University  of Leeds
+ * Copyright (C) 2021 Ammar Herzallah, Ben Husle, Thomas Moreno Cooper, Sulagna Sinha & Tian Zeng
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3 of the License.
+ *
+ * THIS PROGRAM IS DISTRIBUTED IN THE HOPE THAT IT WILL BE USEFUL,
+ * BUT WITHOUT ANY WARRANTY; WITHOUT EVEN THE IMPLIED WARRANTY OF
+ * MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE.  SEE THE
+ * GNU GENERAL PUBLIC LICENSE FOR MORE DETAILS.
+ */
+#include "MeshSimplifier.h"
+
+#include "ResourceManager/Resources/Mesh.h"
+#include "Utilities/Hash.h"
+
+
+#include <glm/glm.hpp>
+#include <unordered_map>
+#include <queue>
+#include <algorithm>
+#include <functional>
+#include <cstring>
+
+
+
+
+
+
+namespace Raven {
+
+
+
+// Raw float values used as a key to weld vertices with the exact same data.
+template<uint32_t N>
+struct WeldKey
+{
+	float values[N];
+
+	bool operator==(const WeldKey& other) const
+	{
+		return memcmp(values, other.values, sizeof(values)) == 0;
+	}
+};
+
+
+// FNV-1a hash of the weld key bytes.
+template<uint32_t N>
+struct WeldKeyHash
+{
+	size_t operator()(const WeldKey<N>& key) const
+	{
+		return (size_t)HashBytes(HASH_OFFSET_BASIS, key.values, sizeof(key.values));
+	}
+};
+
+
+
+
+// Symmetric 4x4 quadric, the sum of squared distances to a set of planes.
+struct Quadric
+{
+	double a00, a01, a02, a11, a12, a22;
+	double b0, b1, b2;
+	double c;
+
+	// Construct.
+	Quadric()
+		: a00(0.0), a01(0.0), a02(0.0), a11(0.0), a12(0.0), a22(0.0)
+		, b0(0.0), b1(0.0), b2(0.0)
+		, c(0.0)
+	{
+
+	}
+
+	// Construct the quadric of the plane (n, d) scaled by a weight.
+	static Quadric FromPlane(const glm::dvec3& n, double d, double w)
+	{
+		Quadric q;
+		q.a00 = w * n.x * n.x; q.a01 = w * n.x * n.y; q.a02 = w * n.x * n.z;
+		q.a11 = w * n.y * n.y; q.a12 = w * n.y * n.z;
+		q.a22 = w * n.z * n.z;
+		q.b0 = w * n.x * d; q.b1 = w * n.y * d; q.b2 = w * n.z * d;
+		q.c = w * d * d;
+		return q;
+	}
+
+	// Add another quadric.
+	void operator+=(const Quadric& q)
+	{
+		a00 += q.a00; a01 += q.a01; a02 += q.a02;
+		a11 += q.a11; a12 += q.a12;
+		a22 += q.a22;
+		b0 += q.b0; b1 += q.b1; b2 += q.b2;
+		c += q.c;
+	}
+
+	// Return the error of a point.
+	double Error(const glm::dvec3& v) const
+	{
+		double xx = a00 * v.x * v.x + a11 * v.y * v.y + a22 * v.z * v.z;
+		double xy = a01 * v.x * v.y + a02 * v.x * v.z + a12 * v.y * v.z;
+		double bx = b0 * v.x + b1 * v.y + b2 * v.z;
+		return xx + 2.0 * xy + 2.0 * bx + c;
+	}
+};
+
+
+
+
+// A candidate collapse of the vertex "from" onto the vertex "to".
+struct EdgeCollapse
+{
+	// The error of the collapse.
+	double cost;
+
+	// The collapsed vertices.
+	uint32_t from;
+	uint32_t to;
+
+	// The vertices versions when the cost was computed, outdated collapses are skipped.
+	uint32_t fromVersion;
+	uint32_t toVersion;
+
+	// Order by cost, ties are broken by the vertices so the result is deterministic.
+	bool operator>(const EdgeCollapse& other) const
+	{
+		if (cost != other.cost)
+			return cost > other.cost;
+
+		if (from != other.from)
+			return from > other.from;
+
+		return to > other.to;
+	}
+};
+
+
+
+
+// QuadricSimplifier:
+//    - the state of simplifying a single mesh section.
+//    - the section vertices are welded into wedges (same position & attributes), and wedges
+//      into positions. the simplification collapse positions and keep the attributes of the target.
+//
+class QuadricSimplifier
+{
+public:
+	// Construct.
+	QuadricSimplifier(const MeshSection* inSection)
+		: section(inSection)
+		, numAliveTris(0)
+	{
+
+	}
+
+	// Weld the section vertices, build the adjacency & the initial collapses.
+	void Build();
+
+	// Collapse edges until reaching the target number of triangles.
+	void Run(uint32_t targetTriangles);
+
+	// Create a new section from the remaining triangles.
+	Ptr<MeshSection> Output() const;
+
+private:
+	// Return the position of a triangle corner.
+	inline uint32_t GetTriPos(uint32_t tri, uint32_t i) const { return wedgePos[triWedges[tri * 3 + i]]; }
+
+	// Return true if the triangle has this position.
+	inline bool HasPos(uint32_t tri, uint32_t pos) const
+	{
+		return GetTriPos(tri, 0) == pos || GetTriPos(tri, 1) == pos || GetTriPos(tri, 2) == pos;
+	}
+
+	// Compute the cost of a collapse and add it to the heap, if the collapse is allowed.
+	void PushCollapse(uint32_t from, uint32_t to);
+
+	// Return true if the collapse keeps the mesh topology and doesn't flip any triangle.
+	bool IsCollapseValid(uint32_t from, uint32_t to);
+
+	// Collapse and update the adjacency & the collapses around the target.
+	void ApplyCollapse(uint32_t from, uint32_t to);
+
+	// Gather the positions connected to a position in outNeighbors sorted.
+	void GatherNeighbors(uint32_t pos, std::vector<uint32_t>& outNeighbors) const;
+
+private:
+	// The source section.
+	const MeshSection* section;
+
+	// The source vertex of each wedge.
+	std::vector<uint32_t> wedgeVertex;
+
+	// The position of each wedge.
+	std::vector<uint32_t> wedgePos;
+
+	// The welded positions.
+	std::vector<glm::dvec3> positions;
+
+	// The single wedge of each position, -1 if the position is on a seam.
+	std::vector<int32_t> posWedge;
+
+	// Locked positions are never collapsed.
+	std::vector<bool> isLocked;
+
+	// Collapsed positions.
+	std::vector<bool> isRemoved;
+
+	// The version of each position, increased when its quadric change.
+	std::vector<uint32_t> versions;
+
+	// The quadric of each position.
+	std::vector<Quadric> quadrics;
+
+	// The triangles of each position, may contain removed triangles.
+	std::vector< std::vector<uint32_t> > posTris;
+
+	// The wedges of each triangle.
+	std::vector<uint32_t> triWedges;
+
+	// The triangles that are not removed.
+	std::vector<bool> isTriAlive;
+
+	// The number of triangles that are not removed.
+	uint32_t numAliveTris;
+
+	// Collapse candidates ordered by cost.
+	std::priority_queue<EdgeCollapse, std::vector<EdgeCollapse>, std::greater<EdgeCollapse>> heap;
+
+	// Scratch lists used while validating collapses.
+	std::vector<uint32_t> fromNeighbors;
+	std::vector<uint32_t> toNeighbors;
+};
+
+
+
+void QuadricSimplifier::Build()
+{
+	const uint32_t numVerts = (uint32_t)section->positions.size();
+	const bool hasNormals = section->normals.size() == numVerts;
+	const bool hasTexCoords = section->texCoords.size() == numVerts;
+
+	// Weld vertices into wedges & positions, ids are assigned in vertex order.
+	std::unordered_map<WeldKey<8>, uint32_t, WeldKeyHash<8>> wedgeMap;
+	std::unordered_map<WeldKey<3>, uint32_t, WeldKeyHash<3>> posMap;
+	std::vector<uint32_t> vertexWedge(numVerts);
+	wedgeMap.reserve(numVerts);
+	posMap.reserve(numVerts);
+
+	for (uint32_t v = 0; v < numVerts; ++v)
+	{
+		const glm::vec3& p = section->positions[v];
+		glm::vec3 n = hasNormals ? section->normals[v] : glm::vec3(0.0f);
+		glm::vec2 uv = hasTexCoords ? section->texCoords[v] : glm::vec2(0.0f);
+
+		WeldKey<8> wedgeKey = { p.x, p.y, p.z, n.x, n.y, n.z, uv.x, uv.y };
+		auto wedgeIter = wedgeMap.emplace(wedgeKey, (uint32_t)wedgeVertex.size());
+
+		// New Wedge?
+		if (wedgeIter.second)
+		{
+			WeldKey<3> posKey = { p.x, p.y, p.z };
+			auto posIter = posMap.emplace(posKey, (uint32_t)positions.size());
+
+			if (posIter.second)
+			{
+				positions.push_back(glm::dvec3(p));
+				posWedge.push_back((int32_t)wedgeVertex.size());
+			}
+			else
+			{
+				// Another wedge on the same position, a seam.
+				posWedge[posIter.first->second] = -1;
+			}
+
+			wedgeVertex.push_back(v);
+			wedgePos.push_back(posIter.first->second);
+		}
+
+		vertexWedge[v] = wedgeIter.first->second;
+	}
+
+
+	const uint32_t numPos = (uint32_t)positions.size();
+	isLocked.resize(numPos, false);
+	isRemoved.resize(numPos, false);
+	versions.resize(numPos, 0);
+	quadrics.resize(numPos);
+	posTris.resize(numPos);
+
+
+	// Build triangles, edge counts & quadrics.
+	std::unordered_map<uint64_t, uint32_t> edgeCount;
+	edgeCount.reserve(section->indices.size());
+
+	for (uint32_t i = 0; i + 2 < (uint32_t)section->indices.size(); i += 3)
+	{
+		uint32_t w[3], p[3];
+
+		for (uint32_t k = 0; k < 3; ++k)
+		{
+			w[k] = vertexWedge[section->indices[i + k]];
+			p[k] = wedgePos[w[k]];
+		}
+
+		// Degenerate triangles are dropped.
+		if (p[0] == p[1] || p[1] == p[2] || p[0] == p[2])
+			continue;
+
+		uint32_t tri = (uint32_t)isTriAlive.size();
+		isTriAlive.push_back(true);
+
+		for (uint32_t k = 0; k < 3; ++k)
+		{
+			triWedges.push_back(w[k]);
+			posTris[p[k]].push_back(tri);
+
+			uint64_t a = glm::min(p[k], p[(k + 1) % 3]);
+			uint64_t b = glm::max(p[k], p[(k + 1) % 3]);
+			edgeCount[(a << 32) | b]++;
+		}
+
+		// Plane quadric weighted by the triangle area.
+		glm::dvec3 n = glm::cross(positions[p[1]] - positions[p[0]], positions[p[2]] - positions[p[0]]);
+		double len = glm::length(n);
+
+		if (len > 0.0)
+		{
+			n /= len;
+			Quadric q = Quadric::FromPlane(n, -glm::dot(n, positions[p[0]]), len * 0.5);
+
+			for (uint32_t k = 0; k < 3; ++k)
+				quadrics[p[k]] += q;
+		}
+	}
+
+	numAliveTris = (uint32_t)isTriAlive.size();
+
+
+	// Lock boundary & non-manifold edges.
+	for (const auto& edge : edgeCount)
+	{
+		if (edge.second == 2)
+			continue;
+
+		isLocked[(uint32_t)(edge.first >> 32)] = true;
+		isLocked[(uint32_t)(edge.first & 0xffffffffull)] = true;
+	}
+
+	// Lock seams.
+	for (uint32_t i = 0; i < numPos; ++i)
+	{
+		if (posWedge[i] == -1)
+			isLocked[i] = true;
+	}
+
+
+	// Initial collapses.
+	for (uint32_t tri = 0; tri < (uint32_t)isTriAlive.size(); ++tri)
+	{
+		for (uint32_t k = 0; k < 3; ++k)
+		{
+			uint32_t a = GetTriPos(tri, k);
+			uint32_t b = GetTriPos(tri, (k + 1) % 3);
+			PushCollapse(a, b);
+			PushCollapse(b, a);
+		}
+	}
+}
+
+
+void QuadricSimplifier::PushCollapse(uint32_t from, uint32_t to)
+{
+	// Only collapse unlocked vertices onto vertices with a single wedge, so the attributes of the target are used as is.
+	if (isLocked[from] || posWedge[to] == -1)
+		return;
+
+	Quadric q = quadrics[from];
+	q += quadrics[to];
+
+	EdgeCollapse collapse;
+	collapse.cost = q.Error(positions[to]);
+	collapse.from = from;
+	collapse.to = to;
+	collapse.fromVersion = versions[from];
+	collapse.toVersion = versions[to];
+	heap.push(collapse);
+}
+
+
+void QuadricSimplifier::GatherNeighbors(uint32_t pos, std::vector<uint32_t>& outNeighbors) const
+{
+	outNeighbors.clear();
+
+	for (uint32_t tri : posTris[pos])
+	{
+		if (!isTriAlive[tri])
+			continue;
+
+		for (uint32_t k = 0; k < 3; ++k)
+		{
+			uint32_t p = GetTriPos(tri, k);
+
+			if (p != pos)
+				outNeighbors.push_back(p);
+		}
+	}
+
+	std::sort(outNeighbors.begin(), outNeighbors.end());
+	outNeighbors.erase(std::unique(outNeighbors.begin(), outNeighbors.end()), outNeighbors.end());
+}
+
+
+bool QuadricSimplifier::IsCollapseValid(uint32_t from, uint32_t to)
+{
+	// The triangles of the edge, removed by the collapse.
+	uint32_t numEdgeTris = 0;
+
+	for (uint32_t tri : posTris[from])
+	{
+		if (isTriAlive[tri] && HasPos(tri, to))
+			++numEdgeTris;
+	}
+
+	// The edge no longer exist?
+	if (numEdgeTris == 0)
+		return false;
+
+	// Link condition, the only vertices connected to both are the ones of the edge triangles.
+	GatherNeighbors(from, fromNeighbors);
+	GatherNeighbors(to, toNeighbors);
+
+	uint32_t numShared = 0;
+
+	for (uint32_t i = 0, j = 0; i < fromNeighbors.size() && j < toNeighbors.size();)
+	{
+		if (fromNeighbors[i] < toNeighbors[j])
+		{
+			++i;
+		}
+		else if (fromNeighbors[i] > toNeighbors[j])
+		{
+			++j;
+		}
+		else
+		{
+			++numShared;
+			++i;
+			++j;
+		}
+	}
+
+	if (numShared != numEdgeTris)
+		return false;
+
+
+	// Flipped or degenerate triangles?
+	for (uint32_t tri : posTris[from])
+	{
+		if (!isTriAlive[tri] || HasPos(tri, to))
+			continue;
+
+		glm::dvec3 oldPos[3], newPos[3];
+
+		for (uint32_t k = 0; k < 3; ++k)
+		{
+			uint32_t p = GetTriPos(tri, k);
+			oldPos[k] = positions[p];
+			newPos[k] = p == from ? positions[to] : positions[p];
+		}
+
+		glm::dvec3 oldNormal = glm::cross(oldPos[1] - oldPos[0], oldPos[2] - oldPos[0]);
+		glm::dvec3 newNormal = glm::cross(newPos[1] - newPos[0], newPos[2] - newPos[0]);
+
+		if (glm::dot(oldNormal, newNormal) <= 0.0)
+			return false;
+	}
+
+	return true;
+}
+
+
+void QuadricSimplifier::ApplyCollapse(uint32_t from, uint32_t to)
+{
+	const uint32_t toWedge = (uint32_t)posWedge[to];
+
+	for (uint32_t tri : posTris[from])
+	{
+		if (!isTriAlive[tri])
+			continue;
+
+		// Edge triangle?
+		if (HasPos(tri, to))
+		{
+			isTriAlive[tri] = false;
+			--numAliveTris;
+			continue;
+		}
+
+		for (uint32_t k = 0; k < 3; ++k)
+		{
+			if (GetTriPos(tri, k) == from)
+				triWedges[tri * 3 + k] = toWedge;
+		}
+
+		posTris[to].push_back(tri);
+	}
+
+	posTris[from].clear();
+	isRemoved[from] = true;
+	quadrics[to] += quadrics[from];
+	versions[to]++;
+
+	// Remove dead triangles from the target list.
+	auto& toTris = posTris[to];
+	toTris.erase(std::remove_if(toTris.begin(), toTris.end(), [&](uint32_t tri) { return !isTriAlive[tri]; }), toTris.end());
+
+	// Update the collapses around the target.
+	for (uint32_t tri : toTris)
+	{
+		for (uint32_t k = 0; k < 3; ++k)
+		{
+			uint32_t p = GetTriPos(tri, k);
+
+			if (p == to)
+				continue;
+
+			PushCollapse(to, p);
+			PushCollapse(p, to);
+		}
+	}
+}
+
+
+void QuadricSimplifier::Run(uint32_t targetTriangles)
+{
+	while (numAliveTris > targetTriangles && !heap.empty())
+	{
+		EdgeCollapse collapse = heap.top();
+		heap.pop();
+
+		// Outdated?
+		if (isRemoved[collapse.from] || isRemoved[collapse.to]
+			|| versions[collapse.from] != collapse.fromVersion
+			|| versions[collapse.to] != collapse.toVersion)
+		{
+			continue;
+		}
+
+		if (!IsCollapseValid(collapse.from, collapse.to))
+			continue;
+
+		ApplyCollapse(collapse.from, collapse.to);
+	}
+}
+
+
+Ptr<MeshSection> QuadricSimplifier::Output() const
+{
+	Ptr<MeshSection> newSection(new MeshSection());
+	newSection->defaultMaterial = section->defaultMaterial;
+
+	const uint32_t numVerts = (uint32_t)section->positions.size();
+	const bool hasNormals = section->normals.size() == numVerts;
+	const bool hasTangents = section->tangents.size() == numVerts;
+	const bool hasTexCoords = section->texCoords.size() == numVerts;
+
+	// Wedges are added in the order they are first used.
+	std::vector<int32_t> wedgeRemap(wedgeVertex.size(), -1);
+
+	for (uint32_t tri = 0; tri < (uint32_t)isTriAlive.size(); ++tri)
+	{
+		if (!isTriAlive[tri])
+			continue;
+
+		for (uint32_t k = 0; k < 3; ++k)
+		{
+			uint32_t w = triWedges[tri * 3 + k];
+
+			if (wedgeRemap[w] == -1)
+			{
+				uint32_t v = wedgeVertex[w];
+				wedgeRemap[w] = (int32_t)newSection->positions.size();
+
+				newSection->positions.push_back(section->positions[v]);
+				newSection->bounds.Add(section->positions[v]);
+
+				if (hasNormals)
+					newSection->normals.push_back(section->normals[v]);
+
+				if (hasTangents)
+					newSection->tangents.push_back(section->tangents[v]);
+
+				if (hasTexCoords)
+					newSection->texCoords.push_back(section->texCoords[v]);
+			}
+
+			newSection->indices.push_back((uint32_t)wedgeRemap[w]);
+		}
+	}
+
+	return newSection;
+}
+
+
+
+
+
+// --- -- --- -- --- -- --- -- --- -- --- -- --- -- --- -- --- -- --- -- --- -- --- --
+
+
+
+Ptr<MeshSection> MeshSimplifier::Simplify(const MeshSection* section, uint32_t targetTriangles)
+{
+	QuadricSimplifier simplifier(section);
+	simplifier.Build();
+	simplifier.Run(targetTriangles);
+
+	return simplifier.Output();
+}
+
+
+void MeshSimplifier::GenerateLODs(Mesh* mesh, const MeshLODSettings& settings)
+{
+	if (settings.numLODs == 0)
+		return;
+
+	// Copy, adding LODs may reallocate the LOD list.
+	std::vector< Ptr<MeshSection> > lod0 = mesh->GetMeshLOD(0).sections;
+
+	uint32_t prevTriangles = 0;
+
+	for (const auto& section : lod0)
+	{
+		if (section)
+			prevTriangles += (uint32_t)section->indices.size() / 3;
+	}
+
+	float ratio = 1.0f;
+	float distance = settings.distance;
+
+	for (uint32_t level = 1; level <= settings.numLODs; ++level)
+	{
+		ratio *= settings.triangleRatio;
+
+		std::vector< Ptr<MeshSection> > lodSections;
+		uint32_t lodTriangles = 0;
+
+		// Each LOD keep the same sections as LOD_0 to match its materials.
+		for (const auto& section : lod0)
+		{
+			if (!section)
+			{
+				lodSections.push_back(nullptr);
+				continue;
+			}
+
+			uint32_t target = (uint32_t)((float)(section->indices.size() / 3) * ratio);
+			Ptr<MeshSection> lodSection = Simplify(section.get(), target);
+
+			lodTriangles += (uint32_t)lodSection->indices.size() / 3;
+			lodSections.push_back(lodSection);
+		}
+
+		// Less than 10% reduction? the mesh is mostly locked, more levels only waste memory.
+		if ((uint64_t)lodTriangles * 10 > (uint64_t)prevTriangles * 9)
+			break;
+
+		mesh->AddNewLOD(lodSections, distance);
+		LOGI("MeshSimplifier - Generated LOD_{0} with {1} triangles at distance {2}.", level, lodTriangles, distance);
+
+		prevTriangles = lodTriangles;
+		distance *= settings.distanceScale;
+	}
+}
+
+
+
+} // End of namespace Raven.
@@ -0,0 +1,75 @@
+/*
+ * Developed by Raven Group at the University  of Leeds
+ * Copyright (C) 2021 Ammar Herzallah, Ben Husle, Thomas Moreno Cooper, Sulagna Sinha & Tian Zeng
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3 of the License.
+ *
+ * THIS PROGRAM IS DISTRIBUTED IN THE HOPE THAT IT WILL BE USEFUL,
+ * BUT WITHOUT ANY WARRANTY; WITHOUT EVEN THE IMPLIED WARRANTY OF
+ * MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE.  SEE THE
+ * GNU GENERAL PUBLIC LICENSE FOR MORE DETAILS.
+ */
+#pragma once
+
+#include "Utilities/Core.h"
+
+#include <vector>
+
+
+
+namespace Raven
+{
+	class Mesh;
+	class MeshSection;
+
+
+
+	// Settings used to generate the LOD levels of a mesh on import.
+	struct MeshLODSettings
+	{
+		// The number of LOD levels to generate after LOD_0, zero to disable.
+		uint32_t numLODs;
+
+		// The triangle ratio of each level relative to the previous level.
+		float triangleRatio;
+
+		// The view distance of the first generated level.
+		float distance;
+
+		// The view distance of each level is the distance of the previous level scaled by this.
+		float distanceScale;
+
+		// Construct.
+		MeshLODSettings()
+			: numLODs(3)
+			, triangleRatio(0.5f)
+			, distance(20.0f)
+			, distanceScale(2.0f)
+		{
+
+		}
+	};
+
+
+
+	// MeshSimplifier:
+	//    - reduce the triangles of a mesh section using quadric error edge collapse.
+	//    - vertices on boundaries and on attribute seams (normals or uvs) are locked, so the
+	//      silhouette of open meshes and the uv layout are preserved.
+	//    - deterministic, the same input always produce the same output.
+	//
+	class MeshSimplifier
+	{
+	public:
+		// Simplify a mesh section, the simplification stops when reaching the target or no valid collapse is left.
+		// @param targetTriangles: the number of triangles to reach.
+		// @return new section that uses the vertices data of the source section.
+		static Ptr<MeshSection> Simplify(const MeshSection* section, uint32_t targetTriangles);
+
+		// Generate the LOD levels of a mesh from its LOD_0 sections.
+		static void GenerateLODs(Mesh* mesh, const MeshLODSettings& settings);
+	};
+
+}
@@ -17,7 +17,7 @@
 
 
 // The Current Raven Files Version.
-#define RAVEN_VERSION 10002
+#define RAVEN_VERSION 10003
 
 
 
@@ -48,4 +48,5 @@ struct RavenVersionGlobals
 // 10000 - 28/04/2021 - Initial Version.
 // 10001 - 06/05/2021 - Start saving referenced material in Primitve Components.
 // 10002 - 16/05/2021 - Cast Shadow boolean in in Primitve Components and Scene Global Settings.
+// 10003 - 17/10/2026 - Compression codec in the resource header.
 
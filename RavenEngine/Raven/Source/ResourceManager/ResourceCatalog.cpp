@@ -0,0 +1,344 @@
+/*
+ * Developed by Raven Group at the University  of Leeds
+ * Copyright (C) 2021 Ammar Herzallah, Ben Husle, Thomas Moreno Cooper, Sulagna Sinha & Tian Zeng
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3 of the License.
+ *
+ * THIS PROGRAM IS DISTRIBUTED IN THE HOPE THAT IT WILL BE USEFUL,
+ * BUT WITHOUT ANY WARRANTY; WITHOUT EVEN THE IMPLIED WARRANTY OF
+ * MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE.  SEE THE
+ * GNU GENERAL PUBLIC LICENSE FOR MORE DETAILS.
+ */
+#include "ResourceCatalog.h"
+#include "Utilities/Hash.h"
+
+
+#include <fstream>
+#include <filesystem>
+#include <algorithm>
+#include <cstring>
+
+
+
+
+namespace Raven {
+
+
+
+
+// The first bytes of the catalog file.
+static constexpr uint32_t RESOURCE_CATALOG_MAGIC = 0x43525652; // "RVRC"
+
+
+// The header of the catalog file.
+struct ResourceCatalogHeader
+{
+	uint32_t magic;
+	uint32_t version;
+	uint32_t numEntries;
+	uint32_t size;
+	uint64_t checksum;
+};
+
+
+// The fixed size part of a catalog entry, followed by the path characters.
+struct ResourceCatalogRecord
+{
+	int32_t type;
+	uint32_t version;
+	uint64_t size;
+	int64_t mtime;
+	uint64_t hash;
+	uint32_t pathSize;
+};
+
+
+
+
+ResourceCatalog::ResourceCatalog()
+	: isDirty(false)
+	, numProbed(0)
+{
+
+}
+
+
+bool ResourceCatalog::Load(const std::string& file)
+{
+	entries.clear();
+	entryMap.clear();
+	isDirty = true;
+
+	std::ifstream fs(file.c_str(), std::ios::in | std::ios::binary | std::ios::ate);
+
+	if (!fs.is_open())
+		return false;
+
+	// Read the whole catalog at once.
+	std::vector<uint8_t> data((size_t)fs.tellg());
+	fs.seekg(0, std::ios::beg);
+
+	if (!fs.read((char*)data.data(), data.size()) || data.size() < sizeof(ResourceCatalogHeader))
+		return false;
+
+	ResourceCatalogHeader header;
+	memcpy(&header, data.data(), sizeof(ResourceCatalogHeader));
+
+	// Outdated or Corrupted?
+	if (header.magic != RESOURCE_CATALOG_MAGIC
+		|| header.version != RESOURCE_CATALOG_VERSION
+		|| header.size != data.size() - sizeof(ResourceCatalogHeader)
+		|| header.checksum != HashBytes(HASH_OFFSET_BASIS, data.data() + sizeof(ResourceCatalogHeader), header.size))
+	{
+		return false;
+	}
+
+	size_t offset = sizeof(ResourceCatalogHeader);
+	entries.reserve(header.numEntries);
+
+	for (uint32_t i = 0; i < header.numEntries; ++i)
+	{
+		if (offset + sizeof(ResourceCatalogRecord) > data.size())
+			break;
+
+		ResourceCatalogRecord record;
+		memcpy(&record, data.data() + offset, sizeof(ResourceCatalogRecord));
+		offset += sizeof(ResourceCatalogRecord);
+
+		if (offset + record.pathSize > data.size())
+			break;
+
+		ResourceCatalogEntry entry;
+		entry.path.assign((const char*)data.data() + offset, record.pathSize);
+		entry.type = record.type;
+		entry.version = record.version;
+		entry.size = record.size;
+		entry.mtime = record.mtime;
+		entry.hash = record.hash;
+		entry.isFound = false;
+		offset += record.pathSize;
+
+		entries.push_back(entry);
+	}
+
+	// Truncated?
+	if (entries.size() != header.numEntries)
+	{
+		entries.clear();
+		return false;
+	}
+
+	RebuildMap();
+	isDirty = false;
+
+	return true;
+}
+
+
+bool ResourceCatalog::Save(const std::string& file) const
+{
+	std::vector<uint8_t> data(sizeof(ResourceCatalogHeader));
+
+	for (const auto& entry : entries)
+	{
+		ResourceCatalogRecord record;
+		memset(&record, 0, sizeof(ResourceCatalogRecord));
+		record.type = entry.type;
+		record.version = entry.version;
+		record.size = entry.size;
+		record.mtime = entry.mtime;
+		record.hash = entry.hash;
+		record.pathSize = (uint32_t)entry.path.size();
+
+		size_t offset = data.size();
+		data.resize(offset + sizeof(ResourceCatalogRecord) + entry.path.size());
+		memcpy(data.data() + offset, &record, sizeof(ResourceCatalogRecord));
+		memcpy(data.data() + offset + sizeof(ResourceCatalogRecord), entry.path.data(), entry.path.size());
+	}
+
+	ResourceCatalogHeader header;
+	header.magic = RESOURCE_CATALOG_MAGIC;
+	header.version = RESOURCE_CATALOG_VERSION;
+	header.numEntries = (uint32_t)entries.size();
+	header.size = (uint32_t)(data.size() - sizeof(ResourceCatalogHeader));
+	header.checksum = HashBytes(HASH_OFFSET_BASIS, data.data() + sizeof(ResourceCatalogHeader), header.size);
+	memcpy(data.data(), &header, sizeof(ResourceCatalogHeader));
+
+	std::error_code ec;
+	std::filesystem::path filePath(file);
+
+	if (filePath.has_parent_path())
+		std::filesystem::create_directories(filePath.parent_path(), ec);
+
+	// Write to a temporary file first, so a failed write never leaves a truncated catalog behind.
+	std::string tmpFile = file + ".tmp";
+
+	{
+		std::ofstream fs(tmpFile.c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+
+		if (!fs.is_open())
+			return false;
+
+		fs.write((const char*)data.data(), data.size());
+
+		if (!fs.good())
+			return false;
+	}
+
+	std::filesystem::rename(tmpFile, file, ec);
+
+	if (ec)
+		return false;
+
+	isDirty = false;
+	return true;
+}
+
+
+void ResourceCatalog::Scan(const std::string& path)
+{
+	numProbed = 0;
+
+	for (auto& entry : entries)
+		entry.isFound = false;
+
+	ScanDirectory(path);
+
+	// Remove the entries of deleted files.
+	size_t numEntries = entries.size();
+	entries.erase(std::remove_if(entries.begin(), entries.end(),
+		[](const ResourceCatalogEntry& entry) { return !entry.isFound; }), entries.end());
+
+	if (entries.size() != numEntries)
+	{
+		isDirty = true;
+		RebuildMap();
+	}
+}
+
+
+void ResourceCatalog::ScanDirectory(const std::string& path)
+{
+	std::error_code ec;
+
+	for (const auto& dirEntry : std::filesystem::directory_iterator(path, ec))
+	{
+		if (dirEntry.is_directory())
+		{
+			// recursivivly check for subdirectories
+			ScanDirectory(dirEntry.path().string());
+			continue;
+		}
+
+		// Not a raven resource?
+		if (dirEntry.path().extension().string() != ".raven")
+			continue;
+
+		std::string filePath = dirEntry.path().string();
+		uint64_t size = (uint64_t)dirEntry.file_size(ec);
+		int64_t mtime = (int64_t)dirEntry.last_write_time(ec).time_since_epoch().count();
+
+		auto iter = entryMap.find(filePath);
+
+		// Unchanged?
+		if (iter != entryMap.end())
+		{
+			ResourceCatalogEntry& entry = entries[iter->second];
+			entry.isFound = true;
+
+			if (entry.size == size && entry.mtime == mtime)
+				continue;
+
+			isDirty = true;
+
+			// Only the write time changed, skip the probe if the content is the same.
+			if (entry.size == size)
+			{
+				uint64_t hash = HashFile(filePath);
+				entry.mtime = mtime;
+
+				if (hash != 0 && hash == entry.hash)
+					continue;
+
+				Probe(entry);
+				entry.hash = hash;
+			}
+			else
+			{
+				entry.size = size;
+				entry.mtime = mtime;
+				Probe(entry);
+			}
+		}
+		else
+		{
+			ResourceCatalogEntry entry;
+			entry.path = filePath;
+			entry.size = size;
+			entry.mtime = mtime;
+			entry.isFound = true;
+			Probe(entry);
+
+			entryMap[filePath] = (uint32_t)entries.size();
+			entries.push_back(entry);
+		}
+
+		++numProbed;
+		isDirty = true;
+	}
+}
+
+
+void ResourceCatalog::Probe(ResourceCatalogEntry& entry)
+{
+	entry.type = -1;
+	entry.version = 0;
+	entry.hash = 0;
+
+	// Only the header is read.
+	RavenInputArchive archive(entry.path);
+
+	if (!archive.IsValid())
+		return;
+
+	ResourceHeaderInfo info = ILoader::LoadHeader(archive);
+
+	entry.type = info.GetRawType();
+	entry.version = info.GetVersion();
+}
+
+
+uint64_t ResourceCatalog::HashFile(const std::string& path)
+{
+	std::ifstream fs(path.c_str(), std::ios::in | std::ios::binary);
+
+	if (!fs.is_open())
+		return 0;
+
+	uint64_t hash = HASH_OFFSET_BASIS;
+	std::vector<char> buffer(64 * 1024);
+
+	while (fs)
+	{
+		fs.read(buffer.data(), buffer.size());
+		hash = HashBytes(hash, buffer.data(), (size_t)fs.gcount());
+	}
+
+	return fs.eof() ? hash : 0;
+}
+
+
+void ResourceCatalog::RebuildMap()
+{
+	entryMap.clear();
+
+	for (uint32_t i = 0; i < (uint32_t)entries.size(); ++i)
+	{
+		entryMap[entries[i].path] = i;
+	}
+}
+
+
+} // End of namespace Raven.
@@ -0,0 +1,127 @@
+/*
+ * Developed by Raven Group at the University  of Leeds
+ * Copyright (C) 2021 Ammar Herzallah, Ben Husle, Thomas Moreno Cooper, Sulagna Sinha & Tian Zeng
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3 of the License.
+ *
+ * THIS PROGRAM IS DISTRIBUTED IN THE HOPE THAT IT WILL BE USEFUL,
+ * BUT WITHOUT ANY WARRANTY; WITHOUT EVEN THE IMPLIED WARRANTY OF
+ * MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE.  SEE THE
+ * GNU GENERAL PUBLIC LICENSE FOR MORE DETAILS.
+ */
+#pragma once
+
+#include "Utilities/Core.h"
+#include "Resources/IResource.h"
+#include "Loaders/ILoader.h"
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+
+
+
+// The file of the resource catalog.
+#define RESOURCE_CATALOG_FILE "cache/ResourceCatalog.bin"
+
+// Increment when the catalog file layout changes, old catalogs are rebuilt.
+#define RESOURCE_CATALOG_VERSION 1
+
+
+
+
+namespace Raven
+{
+
+	// A single resource file in the catalog.
+	struct ResourceCatalogEntry
+	{
+		// The relative path of the resource file.
+		std::string path;
+
+		// The header type of the resource, -1 if not a valid raven resource.
+		int32_t type;
+
+		// The header version of the resource.
+		uint32_t version;
+
+		// The size of the file in bytes.
+		uint64_t size;
+
+		// The last write time of the file.
+		int64_t mtime;
+
+		// 64-bit FNV-1a hash of the file content, 0 if not computed yet.
+		uint64_t hash;
+
+		// True if the file was found by the last scan.
+		bool isFound;
+
+		// Return the header info of the resource.
+		inline ResourceHeaderInfo GetHeader() const { return ResourceHeaderInfo(type, version); }
+	};
+
+
+
+	// ResourceCatalog:
+	//    - a persistent index of all the resource files in the project, loaded in one read at startup.
+	//    - scanning only walks the directories, the files are only opened & probed for their header
+	//      if they are new or their size or write time changed since the last scan.
+	//    - files that only had their write time changed are hashed, and are not probed again if their
+	//      content is the same as the last time they were hashed.
+	//
+	class ResourceCatalog
+	{
+	public:
+		// Construct.
+		ResourceCatalog();
+
+		// Load the catalog from file, return false if missing, outdated or corrupted.
+		bool Load(const std::string& file);
+
+		// Save the catalog to file.
+		bool Save(const std::string& file) const;
+
+		// Scan a directory for resource files and update the catalog, removes the entries of deleted files.
+		void Scan(const std::string& path);
+
+		// Return all the entries in the catalog.
+		inline const std::vector<ResourceCatalogEntry>& GetEntries() const { return entries; }
+
+		// Return true if the catalog changed since it was loaded or saved.
+		inline bool IsDirty() const { return isDirty; }
+
+		// Return the number of files probed by the last scan.
+		inline uint32_t GetNumProbed() const { return numProbed; }
+
+	private:
+		// Recursively scan a directory.
+		void ScanDirectory(const std::string& path);
+
+		// Read a resource file header.
+		static void Probe(ResourceCatalogEntry& entry);
+
+		// Return the hash of a file content, 0 if failed to read.
+		static uint64_t HashFile(const std::string& path);
+
+		// Rebuild the path to entry mapping.
+		void RebuildMap();
+
+	private:
+		// All the resource files.
+		std::vector<ResourceCatalogEntry> entries;
+
+		// Map the path of a resource file to its entry.
+		std::unordered_map<std::string, uint32_t> entryMap;
+
+		// True if the catalog changed since it was loaded or saved.
+		mutable bool isDirty;
+
+		// The number of files probed by the last scan.
+		uint32_t numProbed;
+	};
+
+}
+
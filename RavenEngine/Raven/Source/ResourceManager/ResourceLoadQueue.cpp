@@ -0,0 +1,177 @@
+/*
+ * Developed by Raven Group at the University  of Leeds
+ * Copyright (C) 2021 Ammar Herzallah, Ben Husle, Thomas Moreno Cooper, Sulagna Sinha & Tian Zeng
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3 of the License.
+ *
+ * THIS PROGRAM IS DISTRIBUTED IN THE HOPE THAT IT WILL BE USEFUL,
+ * BUT WITHOUT ANY WARRANTY; WITHOUT EVEN THE IMPLIED WARRANTY OF
+ * MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE.  SEE THE
+ * GNU GENERAL PUBLIC LICENSE FOR MORE DETAILS.
+ */
+#include "ResourceLoadQueue.h"
+
+
+#include <fstream>
+#include <algorithm>
+
+
+
+
+namespace Raven {
+
+
+
+ResourceLoadQueue::ResourceLoadQueue()
+	: numCompressionThreads(1)
+	, isStopping(false)
+{
+
+}
+
+
+ResourceLoadQueue::~ResourceLoadQueue()
+{
+	Stop();
+}
+
+
+void ResourceLoadQueue::Start(uint32_t numWorkers)
+{
+	RAVEN_ASSERT(workers.empty(), "ResourceLoadQueue - Already started.");
+	isStopping = false;
+	numCompressionThreads = std::max(1u, std::thread::hardware_concurrency() / std::max(1u, numWorkers));
+
+	for (uint32_t i = 0; i < numWorkers; ++i)
+	{
+		workers.emplace_back(&ResourceLoadQueue::WorkerMain, this);
+	}
+}
+
+
+void ResourceLoadQueue::Stop()
+{
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		isStopping = true;
+	}
+
+	condition.notify_all();
+
+	for (auto& worker : workers)
+	{
+		worker.join();
+	}
+
+	workers.clear();
+
+	// Delete requests that are not finished.
+	for (auto request : pending)
+	{
+		delete request;
+	}
+
+	for (auto request : finished)
+	{
+		delete request->rsc;
+		delete request;
+	}
+
+	pending.clear();
+	finished.clear();
+}
+
+
+void ResourceLoadQueue::Push(ResourceLoadRequest* request)
+{
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		pending.push_back(request);
+	}
+
+	condition.notify_one();
+}
+
+
+void ResourceLoadQueue::PopFinished(std::deque<ResourceLoadRequest*>& outRequests)
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	outRequests.insert(outRequests.end(), finished.begin(), finished.end());
+	finished.clear();
+}
+
+
+void ResourceLoadQueue::WorkerMain()
+{
+	MaxCompressionThreads() = numCompressionThreads;
+
+	while (true)
+	{
+		ResourceLoadRequest* request = nullptr;
+
+		// Wait for a request...
+		{
+			std::unique_lock<std::mutex> lock(mutex);
+			condition.wait(lock, [this]() { return isStopping || !pending.empty(); });
+
+			if (isStopping)
+				return;
+
+			request = pending.front();
+			pending.pop_front();
+		}
+
+		Process(request);
+
+		// Done...
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			finished.push_back(request);
+		}
+	}
+}
+
+
+void ResourceLoadQueue::Process(ResourceLoadRequest* request)
+{
+	// Thread safe, deserialize straight from the mapped file without reading it into memory first.
+	if (request->isDeserialize && RESOURCE_LOAD_MAPPED)
+	{
+		RavenInputArchive archive(request->handle->GetPath(), true);
+		request->isReadSuccess = archive.IsValid();
+
+		if (request->isReadSuccess)
+		{
+			request->rsc = request->loader->LoadArchive(archive, request->info);
+		}
+
+		return;
+	}
+
+	// Read the whole file, so the main thread never waits for the disk.
+	std::ifstream file(request->handle->GetPath(), std::ios::in | std::ios::binary | std::ios::ate);
+
+	if (!file.is_open())
+		return;
+
+	std::streamsize size = file.tellg();
+	file.seekg(0, std::ios::beg);
+
+	request->fileData.resize((size_t)size);
+	request->isReadSuccess = (bool)file.read((char*)request->fileData.data(), size);
+
+	if (!request->isReadSuccess || !request->isDeserialize)
+		return;
+
+	// Deserialize...
+	RavenInputArchive archive(request->fileData.data(), request->fileData.size());
+	request->rsc = request->loader->LoadArchive(archive, request->info);
+
+	// The file data is not needed anymore.
+	std::vector<uint8_t>().swap(request->fileData);
+}
+
+
+} // End of namespace Raven.
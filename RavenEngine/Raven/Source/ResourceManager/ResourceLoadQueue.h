@@ -0,0 +1,190 @@
+/*
+ * Developed by Raven Group at the University  of Leeds
+ * Copyright (C) 2021 Ammar Herzallah, Ben Husle, Thomas Moreno Cooper, Sulagna Sinha & Tian Zeng
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3 of the License.
+ *
+ * THIS PROGRAM IS DISTRIBUTED IN THE HOPE THAT IT WILL BE USEFUL,
+ * BUT WITHOUT ANY WARRANTY; WITHOUT EVEN THE IMPLIED WARRANTY OF
+ * MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE.  SEE THE
+ * GNU GENERAL PUBLIC LICENSE FOR MORE DETAILS.
+ */
+#pragma once
+
+#include "Utilities/Core.h"
+#include "Resources/IResource.h"
+#include "Loaders/ILoader.h"
+
+#include <string>
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+
+
+// The maximum number of worker threads used to load resources in the background.
+#define RESOURCE_LOAD_MAX_WORKERS 4
+
+// The time in milliseconds the main thread can spend each frame finishing loaded resources.
+#define RESOURCE_LOAD_FRAME_BUDGET 4.0
+
+// If true resources deserialized while loading are read from a memory mapped file.
+#define RESOURCE_LOAD_MAPPED true
+
+
+
+
+namespace Raven
+{
+	// ResourceLoadHandle:
+	//    - the state of a resource loaded in the background, @see ResourceManager::LoadAsync().
+	//    - the handle is only updated on the main thread, it is done once the resource is loaded,
+	//      uploaded to the GPU and added to the registry.
+	//
+	class ResourceLoadHandle
+	{
+		// Friend...
+		friend class ResourceManager;
+
+	public:
+		// Construct.
+		ResourceLoadHandle(const std::string& inPath)
+			: path(inPath)
+			, isDone(false)
+		{
+
+		}
+
+		// Return true if the load finished, successfully or not.
+		inline bool IsDone() const { return isDone; }
+
+		// Return true if the load finished and failed.
+		inline bool IsFailed() const { return isDone && !rsc; }
+
+		// Return the relative path of the resource.
+		inline const std::string& GetPath() const { return path; }
+
+		// Return the loaded resource, null if not done or failed.
+		inline Ptr<IResource> GetResource() const { return rsc; }
+
+		// Return the loaded resource casted to its type, null if not done or failed.
+		template<class TResource>
+		inline Ptr<TResource> GetResource() const { return std::static_pointer_cast<TResource, IResource>(rsc); }
+
+	private:
+		// The relative path of the resource.
+		std::string path;
+
+		// The loaded resource.
+		Ptr<IResource> rsc;
+
+		// True if the load finished.
+		bool isDone;
+	};
+
+
+
+	// A single resource to load in the background.
+	struct ResourceLoadRequest
+	{
+		// The handle to update when the load is finished.
+		Ptr<ResourceLoadHandle> handle;
+
+		// The loader of the resource type.
+		ILoader* loader;
+
+		// If true the resource is also deserialized by the worker thread, @see ILoader::IsThreadSafe().
+		bool isDeserialize;
+
+		// The content of the file, read by the worker thread.
+		std::vector<uint8_t> fileData;
+
+		// True if the worker thread read the file.
+		bool isReadSuccess;
+
+		// The resource deserialized by the worker thread.
+		IResource* rsc;
+
+		// The header of the resource deserialized by the worker thread.
+		ResourceHeaderInfo info;
+
+		// Construct.
+		ResourceLoadRequest()
+			: loader(nullptr)
+			, isDeserialize(false)
+			, isReadSuccess(false)
+			, rsc(nullptr)
+		{
+
+		}
+	};
+
+
+
+	// ResourceLoadQueue:
+	//    - a pool of worker threads that read resource files from disk, the resources that are thread
+	//      safe are also deserialized & decompressed by the worker threads.
+	//    - the finished requests are collected by the resource manager on the main thread, @see ResourceManager::Update().
+	//
+	class ResourceLoadQueue
+	{
+		NOCOPYABLE(ResourceLoadQueue);
+
+	public:
+		// Construct.
+		ResourceLoadQueue();
+
+		// Destruct.
+		~ResourceLoadQueue();
+
+		// Start the worker threads.
+		void Start(uint32_t numWorkers);
+
+		// Stop & join the worker threads, requests that are not finished are deleted.
+		void Stop();
+
+		// Add a request to be processed by the worker threads, the queue owns the request until it is finished.
+		void Push(ResourceLoadRequest* request);
+
+		// Move all the finished requests to outRequests, the caller owns them.
+		void PopFinished(std::deque<ResourceLoadRequest*>& outRequests);
+
+		// Return the number of worker threads.
+		inline uint32_t GetNumWorkers() const { return (uint32_t)workers.size(); }
+
+	private:
+		// The worker thread main loop.
+		void WorkerMain();
+
+		// Read & deserialize a single request.
+		static void Process(ResourceLoadRequest* request);
+
+	private:
+		// The worker threads.
+		std::vector<std::thread> workers;
+
+		// Protect pending & finished requests.
+		std::mutex mutex;
+
+		// Notify workers of new requests.
+		std::condition_variable condition;
+
+		// Requests waiting for a worker thread.
+		std::deque<ResourceLoadRequest*> pending;
+
+		// Requests finished by the worker threads.
+		std::vector<ResourceLoadRequest*> finished;
+
+		// The maximum number of threads each worker uses to uncompress chunks, so the workers together don't use more than the cores.
+		uint32_t numCompressionThreads;
+
+		// True if the worker threads are stopping.
+		bool isStopping;
+	};
+
+}
+
@@ -40,6 +40,8 @@
 #include <fstream>
 #include <iostream>
 #include <filesystem>
+#include <chrono>
+#include <thread>
 
 
 // -- - --- -- - --- -- - --- -- - --- -- - --- -- - --- -- - --- -- - --- -- - --- -- - --- -- - --- -- - --
@@ -106,6 +108,207 @@ bool Raven::Uncompress(uint32_t compSize, const uint8_t* comp, uint8_t* data, ui
 }
 
 
+// Return the number of threads used to compress or uncompress chunks on this thread.
+static int32_t GetNumCompressionThreads(int32_t numChunks)
+{
+	uint32_t numThreads = Raven::MaxCompressionThreads();
+
+	if (numThreads == 0)
+		numThreads = std::thread::hardware_concurrency();
+
+	return glm::clamp((int32_t)numThreads, 1, glm::max(numChunks, 1));
+}
+
+
+bool Raven::CompressChunks(uint32_t size, const uint8_t* data, std::vector<uint32_t>& outChunkSizes, std::vector<uint8_t>& outComp)
+{
+	RAVEN_ASSERT(data, "Invalid Input.");
+
+	const int32_t numChunks = (int32_t)((size + COMPRESSION_CHUNK_SIZE - 1) / COMPRESSION_CHUNK_SIZE);
+	std::vector< std::vector<uint8_t> > chunks(numChunks);
+	int32_t numFailed = 0;
+	const int32_t numThreads = GetNumCompressionThreads(numChunks);
+
+	// Each chunk is compressed by a single job into its own buffer.
+#pragma omp parallel for schedule(dynamic, 1) num_threads(numThreads) if(numThreads > 1)
+	for (int32_t ic = 0; ic < numChunks; ++ic)
+	{
+		const uint32_t offset = (uint32_t)ic * COMPRESSION_CHUNK_SIZE;
+		const uint32_t chunkSize = glm::min((uint32_t)COMPRESSION_CHUNK_SIZE, size - offset);
+
+		mz_ulong comp_size = compressBound(chunkSize);
+		chunks[ic].resize((size_t)comp_size);
+
+		if (compress(chunks[ic].data(), &comp_size, data + offset, chunkSize) != Z_OK)
+		{
+#pragma omp atomic
+			++numFailed;
+		}
+
+		chunks[ic].resize((size_t)comp_size);
+	}
+
+	if (numFailed != 0)
+	{
+		LOGE("compress() failed!.");
+		return false;
+	}
+
+	// Pack the chunks one after the other.
+	outChunkSizes.resize(numChunks);
+	outComp.clear();
+
+	for (int32_t ic = 0; ic < numChunks; ++ic)
+	{
+		outChunkSizes[ic] = (uint32_t)chunks[ic].size();
+		outComp.insert(outComp.end(), chunks[ic].begin(), chunks[ic].end());
+	}
+
+	return true;
+}
+
+
+bool Raven::UncompressChunks(uint32_t chunkSize, const std::vector<uint32_t>& chunkSizes, const uint8_t* comp, uint8_t* data, uint32_t size)
+{
+	RAVEN_ASSERT(data && comp, "Invalid Input.");
+
+	const int32_t numChunks = (int32_t)chunkSizes.size();
+
+	// Chunks doesn't match the uncompressed size?
+	if (chunkSize == 0 || (uint64_t)numChunks != ((uint64_t)size + chunkSize - 1) / chunkSize)
+	{
+		LOGE("uncompress() failed, invalid chunks!.");
+		return false;
+	}
+
+	// The offset of each chunk in the compressed data.
+	std::vector<size_t> offsets(numChunks);
+
+	for (int32_t ic = 1; ic < numChunks; ++ic)
+		offsets[ic] = offsets[ic - 1] + chunkSizes[ic - 1];
+
+	int32_t numFailed = 0;
+	const int32_t numThreads = GetNumCompressionThreads(numChunks);
+
+	// Each chunk is uncompressed by a single job straight into its range of the output.
+#pragma omp parallel for schedule(dynamic, 1) num_threads(numThreads) if(numThreads > 1)
+	for (int32_t ic = 0; ic < numChunks; ++ic)
+	{
+		const uint32_t offset = (uint32_t)ic * chunkSize;
+		const mz_ulong expected_size = (mz_ulong)glm::min(chunkSize, size - offset);
+		mz_ulong uncomp_size = expected_size;
+
+		int cmp_status = uncompress(data + offset, &uncomp_size, comp + offsets[ic], (mz_ulong)chunkSizes[ic]);
+
+		if (cmp_status != Z_OK || uncomp_size != expected_size)
+		{
+#pragma omp atomic
+			++numFailed;
+		}
+	}
+
+	if (numFailed != 0)
+	{
+		LOGE("uncompress() failed!.");
+		return false;
+	}
+
+	return true;
+}
+
+
+bool Raven::UncompressStream(uint32_t compSize, const CompressedReadFunc& read, uint8_t* data, uint32_t size)
+{
+	RAVEN_ASSERT(data, "Invalid Input.");
+
+	z_stream stream;
+	memset(&stream, 0, sizeof(stream));
+	stream.next_out = data;
+	stream.avail_out = size;
+
+	int cmp_status = inflateInit(&stream);
+
+	// Read & uncompress one block at a time straight into the output.
+	std::vector<uint8_t> buffer(COMPRESSION_STREAM_BUFFER_SIZE);
+	uint32_t remaining = compSize;
+
+	while (remaining != 0)
+	{
+		uint32_t blockSize = glm::min(remaining, (uint32_t)COMPRESSION_STREAM_BUFFER_SIZE);
+		read(buffer.data(), blockSize);
+		remaining -= blockSize;
+
+		// Failed before? keep reading to skip the rest of the compressed data.
+		if (cmp_status != Z_OK)
+			continue;
+
+		stream.next_in = buffer.data();
+		stream.avail_in = blockSize;
+		cmp_status = inflate(&stream, Z_NO_FLUSH);
+
+		// The end of data must be the end of the compressed data.
+		if (cmp_status == Z_STREAM_END && remaining != 0)
+			cmp_status = Z_DATA_ERROR;
+	}
+
+	const mz_ulong uncomp_size = stream.total_out;
+	inflateEnd(&stream);
+
+	if (cmp_status != Z_STREAM_END)
+	{
+		LOGE("uncompress() failed!.");
+		return false;
+	}
+
+	RAVEN_ASSERT(size == uncomp_size, "Uncompress Size Mismatch.");
+	return true;
+}
+
+
+bool Raven::UncompressChunksStream(uint32_t chunkSize, const std::vector<uint32_t>& chunkSizes, const CompressedReadFunc& read, uint8_t* data, uint32_t size)
+{
+	RAVEN_ASSERT(data, "Invalid Input.");
+
+	const uint32_t numChunks = (uint32_t)chunkSizes.size();
+	bool status = chunkSize != 0 && (uint64_t)numChunks == ((uint64_t)size + chunkSize - 1) / chunkSize;
+
+	if (!status)
+	{
+		LOGE("uncompress() failed, invalid chunks!.");
+	}
+
+	// Read a few chunks at a time into the same buffer, then uncompress them in parallel.
+	std::vector<uint8_t> buffer;
+	std::vector<uint32_t> batchSizes;
+
+	for (uint32_t first = 0; first < numChunks; first += COMPRESSION_STREAM_CHUNKS)
+	{
+		const uint32_t last = glm::min(first + COMPRESSION_STREAM_CHUNKS, numChunks);
+		batchSizes.assign(chunkSizes.begin() + first, chunkSizes.begin() + last);
+
+		size_t batchCompSize = 0;
+
+		for (uint32_t compSize : batchSizes)
+			batchCompSize += compSize;
+
+		if (buffer.size() < batchCompSize)
+			buffer.resize(batchCompSize);
+
+		read(buffer.data(), (uint32_t)batchCompSize);
+
+		// Failed before? keep reading to skip the rest of the compressed data.
+		if (!status)
+			continue;
+
+		const uint32_t offset = first * chunkSize;
+		const uint32_t batchSize = (uint32_t)glm::min((uint64_t)(last - first) * chunkSize, (uint64_t)(size - offset));
+		status = UncompressChunks(chunkSize, batchSizes, buffer.data(), data + offset, batchSize);
+	}
+
+	return status;
+}
+
+
 
 
 
@@ -147,13 +350,43 @@ ResourceHeaderInfo ILoader::LoadHeader(RavenInputArchive& archive)
 }
 
 
-ResourceHeaderInfo ILoader::SaveHeader(RavenOutputArchive& archive, IResource* rsc)
+IResource* ILoader::LoadArchive(RavenInputArchive& archive, ResourceHeaderInfo& outInfo)
+{
+	// Load Header.
+	outInfo = LoadHeader(archive);
+
+	// Invalid Raven Resource?
+	if (!outInfo.IsValid())
+	{
+		return nullptr;
+	}
+
+	// Set current load version & codec.
+	archive.version = outInfo.GetVersion();
+	archive.codec = outInfo.GetCodec();
+
+	// Load the resource, corrupted or truncated data throw while reading.
+	try
+	{
+		return LoadResource(outInfo, archive);
+	}
+	catch (const cereal::Exception& e)
+	{
+		LOGE("Failed to load resource, {0}", e.what());
+		return nullptr;
+	}
+}
+
+
+ResourceHeaderInfo ILoader::SaveHeader(RavenOutputArchive& archive, IResource* rsc, ECompressionCodec codec)
 {
 	ResourceHeaderInfo header;
 	header.type = rsc->GetType();
 	header.version = RAVEN_VERSION;
+	header.codec = codec;
 
 	archive.ArchiveSave(header);
+	archive.codec = codec;
 
 	return header;
 }
@@ -327,18 +560,70 @@ void ResourceManager::Initialize()
 	RegisterLoader<SceneLoader>();
 	RegisterLoader<MaterialLoader>();
 
-	// scan the directory and populate the 
-	ScanDirectory("./");
+	// Populate the registry from the catalog, only new or changed files are probed.
+	catalog.Load(RESOURCE_CATALOG_FILE);
+	catalog.Scan("./");
 
+	if (catalog.IsDirty())
+	{
+		LOGI("Resource catalog updated, {0} files probed.", catalog.GetNumProbed());
+		catalog.Save(RESOURCE_CATALOG_FILE);
+	}
+
+	for (const auto& entry : catalog.GetEntries())
+	{
+		registry.AddResource(entry.path, entry.GetHeader(), nullptr);
+	}
+
+	// Background loading, leave a core for the main thread.
+	uint32_t numWorkers = std::thread::hardware_concurrency();
+	numWorkers = std::max(1u, std::min(numWorkers > 1 ? numWorkers - 1 : 1u, (uint32_t)RESOURCE_LOAD_MAX_WORKERS));
+	loadQueue.Start(numWorkers);
 }
 
 
 void ResourceManager::Destroy()
 {
+	// Stop background loading.
+	loadQueue.Stop();
+
+	for (auto request : loadFinished)
+	{
+		delete request->rsc;
+		delete request;
+	}
+
+	loadFinished.clear();
+	loadingAsync.clear();
+
 	registry.Reset();
 }
 
 
+void ResourceManager::Update()
+{
+	loadQueue.PopFinished(loadFinished);
+
+	if (loadFinished.empty())
+		return;
+
+	auto startTime = std::chrono::steady_clock::now();
+
+	// Finish loads until we are out of time, at least one per frame.
+	while (!loadFinished.empty())
+	{
+		ResourceLoadRequest* request = loadFinished.front();
+		loadFinished.pop_front();
+		FinishLoadAsync(request);
+
+		std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - startTime;
+
+		if (elapsed.count() > RESOURCE_LOAD_FRAME_BUDGET)
+			break;
+	}
+}
+
+
 void ResourceManager::ScanDirectory(const std::string& path)
 {
 	// construct a path from the input string
@@ -512,11 +797,13 @@ bool ResourceManager::SaveNewResource(Ptr<IResource> newResource, const std::str
 		newResource->name = StringUtils::GetFileNameWithoutExtension(saveFile);
 	}
 
+	ILoader* loader = GetLoader(newResource->GetType());
+
 	// Save Header
-	ResourceHeaderInfo info = ILoader::SaveHeader(archive, newResource.get());
+	ResourceHeaderInfo info = ILoader::SaveHeader(archive, newResource.get(), loader->GetCodec(newResource->GetType()));
 
 	// Save...
-	GetLoader(info.GetType())->SaveResource(archive, newResource.get());
+	loader->SaveResource(archive, newResource.get());
 	newResource->path = saveFile;
 
 	// Add the new resource to the registry.
@@ -543,7 +830,7 @@ bool ResourceManager::LoadResource(ILoader* loader, const std::string& path)
 {
 	std::string absPath = StringUtils::GetCurrentWorkingDirectory() + "/" + path;
 
-	RavenInputArchive archive(path);
+	RavenInputArchive archive(path, RESOURCE_LOAD_MAPPED);
 
 	// Failed to open archive?
 	if (!archive.IsValid())
@@ -552,20 +839,16 @@ bool ResourceManager::LoadResource(ILoader* loader, const std::string& path)
 		return false;
 	}
 
-	// Load Header.
-	ResourceHeaderInfo info = ILoader::LoadHeader(archive);
+	// Load the resource.
+	ResourceHeaderInfo info;
+	IResource* loadedRsc = loader->LoadArchive(archive, info);
 
 	// Invalid Raven Resource?
-	if (!info.IsValid())
+	if (!loadedRsc)
 	{
 		return false;
 	}
 
-	// Set current load version.
-	archive.version = info.GetVersion();
-
-	// Load the resource.
-	IResource* loadedRsc = loader->LoadResource(info, archive);
 	loadedRsc->path = path;
 
 	// Load Render Resources...
@@ -581,6 +864,110 @@ bool ResourceManager::LoadResource(ILoader* loader, const std::string& path)
 }
 
 
+Ptr<ResourceLoadHandle> ResourceManager::LoadAsync(const ResourceData* rscData)
+{
+	// Already Loaded?
+	if (rscData->rsc)
+	{
+		Ptr<ResourceLoadHandle> handle(new ResourceLoadHandle(rscData->path));
+		handle->rsc = rscData->rsc;
+		handle->isDone = true;
+		return handle;
+	}
+
+	// Already Loading?
+	auto iter = loadingAsync.find(rscData->cleanPath);
+
+	if (iter != loadingAsync.end())
+		return iter->second;
+
+	ILoader* loader = GetLoader(rscData->type);
+
+	ResourceLoadRequest* request = new ResourceLoadRequest();
+	request->handle = Ptr<ResourceLoadHandle>(new ResourceLoadHandle(rscData->path));
+	request->loader = loader;
+	request->isDeserialize = loader->IsThreadSafe(rscData->type);
+
+	loadingAsync[rscData->cleanPath] = request->handle;
+	loadQueue.Push(request);
+
+	return request->handle;
+}
+
+
+Ptr<ResourceLoadHandle> ResourceManager::LoadAsync(const ResourceRef& ref)
+{
+	const ResourceData* rscData = registry.FindResource(ref.path);
+
+	// Doesn't Exist?
+	if (!rscData)
+	{
+		LOGW("Error in LoadAsync, Resource Does not exit {0}", ref.path.c_str());
+		return nullptr;
+	}
+
+	// Type Mismatch?
+	if (rscData->type != ref.type)
+	{
+		RAVEN_ASSERT(0, "Type Mismatch");
+		return nullptr;
+	}
+
+	return LoadAsync(rscData);
+}
+
+
+void ResourceManager::FinishLoadAsync(ResourceLoadRequest* request)
+{
+	Ptr<ResourceLoadHandle> handle = request->handle;
+	const std::string& path = handle->path;
+	loadingAsync.erase(registry.CleanRscPath(path));
+
+	const ResourceData* rscData = registry.FindResource(path);
+
+	// Loaded with GetResource() while loading in the background?
+	if (rscData && rscData->rsc)
+	{
+		delete request->rsc;
+		handle->rsc = rscData->rsc;
+	}
+	else
+	{
+		IResource* loadedRsc = request->rsc;
+		ResourceHeaderInfo info = request->info;
+
+		// Not thread safe, deserialize from the file data in memory.
+		if (!loadedRsc && request->isReadSuccess)
+		{
+			RavenInputArchive archive(request->fileData.data(), request->fileData.size());
+			loadedRsc = request->loader->LoadArchive(archive, info);
+		}
+
+		if (loadedRsc)
+		{
+			loadedRsc->path = path;
+
+			// Load Render Resources...
+			if (loadedRsc->HasRenderResources() && !loadedRsc->IsOnGPU())
+			{
+				loadedRsc->LoadRenderResource();
+			}
+
+			// Add the loaded resource to the registry.
+			handle->rsc = Ptr<IResource>(loadedRsc);
+			registry.AddResource(path, info, handle->rsc);
+		}
+		else
+		{
+			LOGE("Failed to load resource in the background {0}.", path.c_str());
+		}
+	}
+
+	handle->isDone = true;
+	delete request;
+}
+
+
 bool ResourceManager::AddResource(const std::string& path)
 {
 	std::string absPath = StringUtils::GetCurrentWorkingDirectory() + "/" + path;
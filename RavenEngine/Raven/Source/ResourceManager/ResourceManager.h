@@ -25,6 +25,8 @@
 #include "Resources/IResource.h"
 #include "Importers/Importer.h"
 #include "Loaders/ILoader.h"
+#include "ResourceLoadQueue.h"
+#include "ResourceCatalog.h"
 
 
 
@@ -36,6 +38,7 @@
 #include <memory>	
 #include <array>
 #include <vector>
+#include <deque>
 
 
 
@@ -136,6 +139,10 @@ namespace Raven
 		// Return Module Type.
 		static EModuleType GetModuleType() { return EModuleType::MT_ResourceManager; }
 
+		// Finish the resources loaded in the background, called every frame on the main thread.
+		// Stops after RESOURCE_LOAD_FRAME_BUDGET milliseconds, the rest are finished next frames.
+		void Update();
+
 
 		// --- -- - --- -- - --- -- - --- -- - --- -- - --- 
 		//               Pending Save Resources
@@ -167,6 +174,19 @@ namespace Raven
 			std::enable_if_t< std::is_base_of<IResource, TResource>::value, bool > = true >
 		Ptr<TResource> GetResource(const std::string& path);
 
+		// Load a Resource in the background, disk reads & decompression are done by worker threads
+		// and only the GPU upload is done on the main thread in Update().
+		// @return handle to check the load, null if the Resource does not exist.
+		template<class TResource,
+			std::enable_if_t< std::is_base_of<IResource, TResource>::value, bool > = true >
+		Ptr<ResourceLoadHandle> LoadAsync(const std::string& path);
+
+		// Load the Resource referenced by a ResourceRef in the background, @see LoadAsync<TResource>().
+		Ptr<ResourceLoadHandle> LoadAsync(const ResourceRef& ref);
+
+		// Return the number of Resources being loaded in the background.
+		inline uint32_t GetNumLoadingAsync() const { return (uint32_t)loadingAsync.size(); }
+
 		// Return true if the Resource exist in the Resource registry whether loaded or not.
 		bool HasResource(const std::string& path);
 		bool HasResource(Ptr<IResource> rsc);
@@ -221,6 +241,9 @@ namespace Raven
 
 		void ScanDirectory(const std::string& path);
 
+		// Return the catalog of all the resource files in the project.
+		inline const ResourceCatalog& GetCatalog() const { return catalog; }
+
 	private:
 		// --- -- - --- -- - --- -- - --- -- - --- -- - --- 
 		//             Importers & Loaders 
@@ -242,13 +265,20 @@ namespace Raven
 		// Load a resrouce using specific loader.
 		bool LoadResource(ILoader* loader, const std::string& path);
 
+		// Start loading a registered Resource in the background.
+		Ptr<ResourceLoadHandle> LoadAsync(const ResourceData* rscData);
 
-	private:
-		// Create & Register a new loader to the Resource manager.
+		// Finish a background load on the main thread, upload & register its Resource.
+		void FinishLoadAsync(ResourceLoadRequest* request);
+
+
+	public:
+		// Create & Register a new loader to the Resource manager, the types already loaded by another loader are ignored.
 		template<class TLoader,
 			std::enable_if_t< std::is_base_of<ILoader, TLoader>::value, bool > = true >
 		void RegisterLoader();
 
+	private:
 		// Create & Register a new importer to the Resource manager.
 		template<class TImporter,
 			std::enable_if_t< std::is_base_of<IImporter, TImporter>::value, bool > = true >
@@ -274,6 +304,18 @@ namespace Raven
 
 		// Resources that are waiting to be saved.
 		std::set< Ptr<IResource> > pendingSaveRsc;
+
+		// The catalog of all the resource files in the project, used instead of probing every file at startup.
+		ResourceCatalog catalog;
+
+		// The worker threads loading resources in the background.
+		ResourceLoadQueue loadQueue;
+
+		// The handles of the resources being loaded in the background, mapped by their clean path.
+		std::unordered_map< std::string, Ptr<ResourceLoadHandle> > loadingAsync;
+
+		// Background loads finished by the workers and waiting for the main thread.
+		std::deque<ResourceLoadRequest*> loadFinished;
 	};
 
 
@@ -339,6 +381,30 @@ namespace Raven
 	}
 
 
+	template<class TResource,
+		std::enable_if_t< std::is_base_of<IResource, TResource>::value, bool > >
+	Ptr<ResourceLoadHandle> ResourceManager::LoadAsync(const std::string& path)
+	{
+		const ResourceData* rscData = registry.FindResource(path);
+
+		// Doesn't Exist?
+		if (!rscData)
+		{
+			LOGW("Error in LoadAsync, Resource Does not exit {0}", path.c_str());
+			return nullptr;
+		}
+
+		// Type Mismatch?
+		if (rscData->type != TResource::StaticGetType())
+		{
+			RAVEN_ASSERT(0, "Invalid Resrouce Type.");
+			return nullptr;
+		}
+
+		return LoadAsync(rscData);
+	}
+
+
 	template<class TLoader,
 		std::enable_if_t< std::is_base_of<ILoader, TLoader>::value, bool > >
 		void ResourceManager::RegisterLoader()
@@ -254,6 +254,14 @@ namespace Raven
 
 		}
 
+		// Construct from the path & type of a Resource that may not be loaded.
+		ResourceRef(const std::string& inPath, EResourceType inType)
+			: path(inPath)
+			, type(inType)
+		{
+
+		}
+
 		// Construct.
 		ResourceRef(IResource* resource)
 			: path(resource->path)
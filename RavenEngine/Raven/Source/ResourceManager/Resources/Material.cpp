@@ -15,6 +15,8 @@
 #include "ResourceManager/Resources/Texture2D.h"
 #include "ResourceManager/Resources/MaterialShader.h"
 #include "Render/RenderResource/Shader/RenderRscMaterial.h"
+#include "ResourceManager/ResourceManager.h"
+#include "Engine.h"
 
 
 
@@ -52,6 +54,7 @@ int32_t Material::SetTexture(const std::string& name, Ptr<ITexture> texture)
 	}
 	else
 	{
+		RemovePendingTexture(idx);
 		textures[idx].second = texture;
 		DirtyUpdate();
 	}
@@ -111,6 +114,7 @@ int32_t Material::SetColor(const std::string& name, const glm::vec4& color)
 void Material::SetTexture(int32_t idx, Ptr<ITexture> texture)
 {
 	DirtyUpdate();
+	RemovePendingTexture(idx);
 	textures[idx].second = texture;
 }
 
@@ -248,7 +252,6 @@ void Material::LoadRenderResource()
 	renderRsc = new RenderRscMaterial(shader->GetRenderRsc());
 	renderRsc->SetShadowShader(shader->GetShadowRenderRsc());
 	renderRsc->LoadInputBlock(shader->GetBlockInput().name, shader->GetSamplersStartIndex());
-	renderRsc->SetUniformBuffer(shader->GetUnifromBuffer());
 
 	isOnGPU = true;
 	dirtyFlag = EMaterialDirtyFlag::Remap;
@@ -258,7 +261,11 @@ void Material::LoadRenderResource()
 
 void Material::UpdateRenderResource()
 {
-	if (!IsOnGPU())
+	if (!pendingTextures.empty())
+		UpdatePendingTextures();
+
+	// Only textures finished loading? the render material reads them when binding.
+	if (!IsOnGPU() || dirtyFlag == EMaterialDirtyFlag::None)
 		return;
 
 	// Remapping...
@@ -318,7 +325,6 @@ void Material::SetMaterialShader(Ptr<MaterialShader> inShader)
 			renderRsc->ReloadShader(shader->GetRenderRsc());
 			renderRsc->SetShadowShader(shader->GetShadowRenderRsc());
 			renderRsc->LoadInputBlock(shader->GetBlockInput().name, shader->GetSamplersStartIndex());
-			renderRsc->SetUniformBuffer(shader->GetUnifromBuffer());
 
 			DirtyRemap();
 		}
@@ -348,11 +354,90 @@ void Material::ClearAllParamters()
 	textures.clear();
 	scalars.clear();
 	colors.clear();
+	pendingTextures.clear();
 
 	DirtyRemap();
 }
 
 
+void Material::LoadTextureRef(int32_t idx, const ResourceRef& ref)
+{
+	textures[idx].second = nullptr;
+
+	// No Texture?
+	if (!ref.IsValid())
+		return;
+
+	Ptr<ResourceLoadHandle> handle = Engine::GetModule<ResourceManager>()->LoadAsync(ref);
+
+	// Doesn't Exist?
+	if (!handle)
+		return;
+
+	// Already Loaded?
+	if (handle->IsDone())
+	{
+		textures[idx].second = handle->GetResource<ITexture>();
+		return;
+	}
+
+	PendingTexture pending;
+	pending.idx = idx;
+	pending.ref = ref;
+	pending.handle = handle;
+	pendingTextures.push_back(pending);
+}
+
+
+void Material::UpdatePendingTextures()
+{
+	for (size_t i = 0; i < pendingTextures.size();)
+	{
+		const PendingTexture& pending = pendingTextures[i];
+
+		// Still Loading?
+		if (!pending.handle->IsDone())
+		{
+			++i;
+			continue;
+		}
+
+		if (pending.handle->IsFailed())
+		{
+			LOGW("Material {0} - Failed to load texture {1}.", GetName().c_str(), pending.ref.GetPath().c_str());
+		}
+
+		textures[pending.idx].second = pending.handle->GetResource<ITexture>();
+		pendingTextures.erase(pendingTextures.begin() + i);
+	}
+}
+
+
+void Material::RemovePendingTexture(int32_t idx)
+{
+	for (size_t i = 0; i < pendingTextures.size(); ++i)
+	{
+		if (pendingTextures[i].idx == idx)
+		{
+			pendingTextures.erase(pendingTextures.begin() + i);
+			return;
+		}
+	}
+}
+
+
+const ResourceRef* Material::GetPendingTextureRef(int32_t idx) const
+{
+	for (const auto& pending : pendingTextures)
+	{
+		if (pending.idx == idx)
+			return &pending.ref;
+	}
+
+	return nullptr;
+}
+
+
 void Material::LoadDefaulFromShader(const std::string& name)
 {
 	if (!shader)
@@ -35,6 +35,7 @@ namespace Raven
 {
 	class MaterialShader;
 	class RenderRscMaterial;
+	class ResourceLoadHandle;
 
 
 	// Dirty flag used to update the materail.
@@ -98,8 +99,8 @@ namespace Raven
 		inline const std::vector< std::pair<std::string, float> >& GetScalars() const { return scalars; }
 		inline const std::vector< std::pair<std::string, glm::vec4> >& GetColors() const { return colors; }
 
-		// Return true if the materail is dirty and need update.
-		inline bool IsDirty() { return dirtyFlag != EMaterialDirtyFlag::None; }
+		// Return true if the materail is dirty and need update, or some of its textures are still loading.
+		inline bool IsDirty() { return dirtyFlag != EMaterialDirtyFlag::None || !pendingTextures.empty(); }
 
 		// Load the materail on GPU.
 		virtual void LoadRenderResource() override;
@@ -132,6 +133,18 @@ namespace Raven
 		// Rebuild paramters used after loading from archive..
 		void RebuildParamters();
 
+		// Set a texture paramter loaded from archive, the texture is loaded in the background if not loaded.
+		void LoadTextureRef(int32_t idx, const ResourceRef& ref);
+
+		// Set the textures that finished loading in the background.
+		void UpdatePendingTextures();
+
+		// Stop waiting for a texture loading in the background.
+		void RemovePendingTexture(int32_t idx);
+
+		// Return the reference of a texture paramter still loading in the background, null if not loading.
+		const ResourceRef* GetPendingTextureRef(int32_t idx) const;
+
 		// -- -- --- ----- ----- --- --- - -- --- - 
 		//       Load/Save Utils Fnctions.
 		// -- -- --- ----- ----- --- --- - -- --- - 
@@ -145,7 +158,14 @@ namespace Raven
 			for (uint32_t i = 0; i < count; ++i)
 			{
 				archive(textures[i].first);
-				ResourceRef::Save(archive, textures[i].second.get()); // Save Reference To Texture.
+
+				// Still loading? save the reference it was loaded with.
+				const ResourceRef* pendingRef = GetPendingTextureRef((int32_t)i);
+
+				if (pendingRef)
+					archive(*pendingRef);
+				else
+					ResourceRef::Save(archive, textures[i].second.get()); // Save Reference To Texture.
 			}
 		}
 
@@ -156,12 +176,12 @@ namespace Raven
 			uint32_t count = 0;
 			archive(count);
 			textures.resize(count);
+			pendingTextures.clear();
 
 			for (uint32_t i = 0; i < count; ++i)
 			{
-				std::string name;
 				archive(textures[i].first);
-				textures[i].second = ResourceRef::Load(archive).FindOrLoad<ITexture>(); // Load Reference To Texture.
+				LoadTextureRef((int32_t)i, ResourceRef::Load(archive)); // Load Reference To Texture.
 			}
 		}
 
@@ -281,5 +301,21 @@ namespace Raven
 		// Flags used to update material with the render.
 		EMaterialDirtyFlag dirtyFlag;
 
+		// A texture paramter loading in the background, drawn with the default texture until loaded.
+		struct PendingTexture
+		{
+			// The index of the texture paramter.
+			int32_t idx;
+
+			// The reference of the texture.
+			ResourceRef ref;
+
+			// The background load.
+			Ptr<ResourceLoadHandle> handle;
+		};
+
+		// Texture paramters loading in the background.
+		std::vector<PendingTexture> pendingTextures;
+
 	};
 }
\ No newline at end of file
@@ -20,7 +20,6 @@
 
 #include "MaterialShader.h"
 #include "Material.h"
-#include "Render/RenderResource/Shader/UniformBuffer.h"
 
 
 
@@ -39,6 +38,7 @@ MaterialShader::MaterialShader()
 	, samplersStartIndex(-1)
 	, isMakeShadowShader(false)
 	, isTwoSided(false)
+	, isBuildFailed(false)
 {
 	type = MaterialShader::StaticGetType();
 	hasRenderResources = true;
@@ -73,20 +73,15 @@ void MaterialShader::LoadRenderResource()
 	rscData.name = name;
 	rscData.type = stype;
 	rscData.AddFunction(stages, materialFunction);
-	renderRsc = RenderRscShader::Create(sdomain, rscData); // Build Shader
-
-	// Failed to build shader
-	if (!renderRsc)
-		return;
+	renderRsc = RenderRscShader::CreateAsync(sdomain, rscData); // Build Shader in the background
+	renderRsc->SetBuildFinishedCallback([this](bool isSuccess) { OnShaderBuilt(isSuccess); });
+	isBuildFailed = false;
 
 	// Shader Input...
 	if (blockInput.size != -1)
 	{
 		blockInput.binding = RenderShaderInput::MaterialBlockBinding;
 		renderRsc->GetInput().AddBlockInput(blockInput);
-
-		// Create a unifrom buffer for the block input.
-		materialUBO = Ptr<UniformBuffer>(UniformBuffer::Create(blockInput, false));
 	}
 
 
@@ -229,7 +224,8 @@ void MaterialShader::CreateShadowShader(RenderRscShaderCreateData data)
 
 	data.isShadow = true;
 	data.name.append("_Shadow");
-	renderShadowRsc = RenderRscShader::Create(sdomain, data); // Build Shader
+	renderShadowRsc = RenderRscShader::CreateAsync(sdomain, data); // Build Shader in the background
+	renderShadowRsc->SetBuildFinishedCallback([this](bool isSuccess) { OnShaderBuilt(isSuccess); });
 
 	if (blockInput.binding != -1)
 		renderRsc->GetInput().AddBlockInput(blockInput);
@@ -240,5 +236,16 @@ void MaterialShader::CreateShadowShader(RenderRscShaderCreateData data)
 }
 
 
+void MaterialShader::OnShaderBuilt(bool isSuccess)
+{
+	if (isSuccess)
+		return;
+
+	// The render falls back to the default material while the materials of this shader are not ready.
+	isBuildFailed = true;
+	LOGE("MaterialShader - Failed to build {0}, its materials are drawn with the default material.", name);
+}
+
+
 
 } // End of namespace Raven.
@@ -29,7 +29,6 @@
 namespace Raven
 {
 	class RenderRscShader;
-	class UniformBuffer;
 
 
 
@@ -99,9 +98,6 @@ namespace Raven
 		// Return the shader type.
 		inline ERenderShaderType GetShaderType() const { return stype; }
 
-		// Return the shader unifrom buffer.
-		inline UniformBuffer* GetUnifromBuffer() const { return materialUBO.get(); }
-
 		// Load the shader on GPU.
 		virtual void LoadRenderResource() override;
 
@@ -111,6 +107,9 @@ namespace Raven
 		// Does this shader contain the valid data to be loaded to GPU.
 		bool HasValidData();
 
+		// Return true if the shader or its shadow shader failed to build, its materials are drawn with the default material.
+		inline bool IsBuildFailed() const { return isBuildFailed; }
+
 		// Force shadow shader making even if the material doesn't need to.
 		void SetShadowShader(bool value);
 		
@@ -164,6 +163,9 @@ namespace Raven
 		// Create a shadow shader that represent this material.
 		void CreateShadowShader(RenderRscShaderCreateData data);
 
+		// Called when one of the shaders built in the background is finished.
+		void OnShaderBuilt(bool isSuccess);
+
 	private:
 		// The Shader Render Resrouce.
 		RenderRscShader* renderRsc;
@@ -189,9 +191,6 @@ namespace Raven
 		// The Shader Type.
 		ERenderShaderType stype;
 
-		// The uniform buffer for the material data.
-		Ptr<UniformBuffer> materialUBO;
-
 		// The materials that reference this shader.
 		std::vector<Material*> materials;
 
@@ -206,6 +205,9 @@ namespace Raven
 
 		// if true the shader will be used to draw object without face culling.
 		bool isTwoSided;
+
+		// True if the shader or its shadow shader failed to build.
+		bool isBuildFailed;
 	};
 
 }
@@ -228,6 +228,18 @@ namespace Raven
 
 				section->LoadRenderResource();
 			}
+
+			for (auto& lod : LODs)
+			{
+				for (auto& section : lod.sections)
+				{
+					// Invalid Section?
+					if (!section)
+						continue;
+
+					section->LoadRenderResource();
+				}
+			}
 		}
 
 		// Update Render Resrouces.
@@ -258,23 +270,25 @@ namespace Raven
 		inline const MathUtils::BoundingBox& GetBounds() const { return bounds; }
 
 		// Add new mesh LOD level.
-		inline void AddNewLOD(const std::vector< Ptr<MeshSection> >& lodSections)
+		// @param distance: the view distance the LOD is displayed at, must be greater than the previous LOD distance.
+		inline void AddNewLOD(const std::vector< Ptr<MeshSection> >& lodSections, float distance)
 		{
 			RAVEN_ASSERT(!meshLOD0.sections.empty(), "Should have at least LOD_0");
 
 			MeshLOD& lod = LODs.emplace_back( MeshLOD() );
 			lod.sections = lodSections;
+			lod.distance = distance;
 		}
 
 		// Remove LOD level.
 		inline void RemoveLOD(uint32_t level)
 		{
-			RAVEN_ASSERT(level == 0, "To remove level 0 you need to remove one section at a time.");
-			LODs.erase(LODs.begin() + level);
+			RAVEN_ASSERT(level != 0, "To remove level 0 you need to remove one section at a time.");
+			LODs.erase(LODs.begin() + (level - 1));
 		}
 
 		// Return the number of lods
-		inline uint32_t GetNumLODs() { return (uint32_t)LODs.size() + 1; }
+		inline uint32_t GetNumLODs() const { return (uint32_t)LODs.size() + 1; }
 
 		// Return mesh lod at level.
 		inline MeshLOD& GetMeshLOD(uint32_t level) 
@@ -282,11 +296,28 @@ namespace Raven
 			if (level == 0)
 				return meshLOD0;
 
-			return LODs[level];
+			return LODs[level - 1];
 		}
 
 		// Return mesh lod at level.
-		inline const MeshLOD& GetMeshLOD(uint32_t level) const { return const_cast<const Mesh*>(this)->GetMeshLOD(level); }
+		inline const MeshLOD& GetMeshLOD(uint32_t level) const { return const_cast<Mesh*>(this)->GetMeshLOD(level); }
+
+		// Return the size of the loaded render resources of all the LODs on the GPU in bytes.
+		inline uint32_t GetGPUSize() const
+		{
+			uint32_t size = 0;
+
+			for (uint32_t level = 0; level < GetNumLODs(); ++level)
+			{
+				for (const auto& section : GetMeshLOD(level).sections)
+				{
+					if (section && section->renderRscMesh)
+						size += section->renderRscMesh->GetGPUSize();
+				}
+			}
+
+			return size;
+		}
 
 		// Serialization Save.
 		template<typename Archive>
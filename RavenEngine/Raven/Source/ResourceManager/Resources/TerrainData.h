@@ -67,6 +67,7 @@ namespace Raven
 		// Construct.
 		TerrainFoliageLayer()
 			: isCastShadow(true)
+			, isInstanceBufferDirty(true)
 		{
 			SetClipDistance(-1.0f);
 		}
@@ -108,10 +109,65 @@ namespace Raven
 			newInstance.center = bounds.GetCenter();
 			newInstance.radius = glm::length(bounds.GetExtent());
 			instances.push_back(newInstance);
+			isInstanceBufferDirty = true;
 
 			return instances.size() - 1;
 		}
 
+		// Upload the transforms of all instances sorted by bin to the instance buffer, only if
+		// instances were added since the last upload, so static layers are uploaded once.
+		// @param numBins: the number of bins in the terrain.
+		inline void UpdateInstanceBuffer(size_t numBins)
+		{
+			if (!isInstanceBufferDirty)
+				return;
+
+			isInstanceBufferDirty = false;
+
+			// Count the instances of each bin then compute the first instance of each bin.
+			binRanges.clear();
+			binRanges.resize(numBins, glm::uvec2(0));
+
+			for (const auto& instance : instances)
+				binRanges[instance.binIndex].y++;
+
+			uint32_t first = 0;
+
+			for (auto& range : binRanges)
+			{
+				range.x = first;
+				first += range.y;
+			}
+
+			// Place each instance in its bin range, the culling data is padded for batched tests.
+			size_t paddedSize = (instances.size() + 3) & ~(size_t)3;
+			std::vector<glm::mat4> transforms(instances.size());
+			std::vector<uint32_t> binFill(numBins, 0);
+			cullCenters.assign(paddedSize, glm::vec3(0.0f));
+			cullRadii.assign(paddedSize, 0.0f);
+
+			for (const auto& instance : instances)
+			{
+				uint32_t slot = binRanges[instance.binIndex].x + binFill[instance.binIndex]++;
+				transforms[slot] = instance.transform;
+				cullCenters[slot] = instance.center;
+				cullRadii[slot] = instance.radius;
+			}
+
+			// All mesh instances share the instance buffer of the first one.
+			if (!meshInstances.empty() && !transforms.empty())
+			{
+				meshInstances[0]->UpdateTransforms(transforms);
+			}
+		}
+
+		// Return the range (first, count) of a bin instances in the instance buffer.
+		inline const glm::uvec2& GetBinRange(size_t bin) const { return binRanges[bin]; }
+
+		// Return the bounding spheres of the instances in the instance buffer order.
+		inline const glm::vec3* GetCullCenters() const { return cullCenters.data(); }
+		inline const float* GetCullRadii() const { return cullRadii.data(); }
+
 		// Return all mesh instances.
 		inline const std::vector< Ptr<RenderRscMeshInstance> >& GetMeshInstances() const { return meshInstances; }
 
@@ -156,6 +212,16 @@ namespace Raven
 
 		// Does the mesh cast shadows.
 		bool isCastShadow;
+
+		// True if instances were added since the instance buffer was uploaded.
+		bool isInstanceBufferDirty;
+
+		// The range (first, count) of each bin instances in the instance buffer.
+		std::vector<glm::uvec2> binRanges;
+
+		// The bounding spheres of the instances in the instance buffer order, padded to a multiple of 4.
+		std::vector<glm::vec3> cullCenters;
+		std::vector<float> cullRadii;
 	};
 
 
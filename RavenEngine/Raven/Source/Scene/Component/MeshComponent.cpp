@@ -33,6 +33,7 @@ namespace Raven {
 
 
 MeshComponent::MeshComponent()
+	: currentLOD(0)
 {
 	
 }
@@ -48,6 +49,8 @@ void MeshComponent::SetMesh(Ptr<Mesh> newMesh)
 {
 	mesh = newMesh;
 	localBounds = mesh != nullptr ? mesh->GetBounds() : MathUtils::BoundingBox();
+	currentLOD = 0;
+	MarkBoundsDirty();
 }
 
 
@@ -59,30 +62,9 @@ void MeshComponent::CollectRenderPrimitives(RenderPrimitiveCollector& rcollector
 		return;
 	}
 
-	MeshLOD* meshLOD;
-
-	// Has LODs?
-	uint32_t numLODs = mesh->GetNumLODs();
-
-	if (numLODs > 1)
-	{
-		uint32_t level;
-
-		for (level = 1; level < numLODs; ++level)
-		{
-			if (rcollector.GetViewDistance() < mesh->GetMeshLOD(level).distance)
-			{
-				level -= 1;
-				break;
-			}
-		}
-
-		meshLOD = &mesh->GetMeshLOD(level);
-	}
-	else
-	{
-		meshLOD = &mesh->GetMeshLOD(0);
-	}
+	// Select LOD based on the view distance.
+	currentLOD = rcollector.SelectLOD(mesh.get(), currentLOD);
+	MeshLOD* meshLOD = &mesh->GetMeshLOD(currentLOD);
 
 
 	for (uint32_t i = 0; i < meshLOD->sections.size(); ++i)
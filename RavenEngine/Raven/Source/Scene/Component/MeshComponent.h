@@ -85,6 +85,9 @@ namespace Raven
 		// The model mesh, each mesh section is mapped to a material.
 		Ptr<Mesh> mesh;
 
+		// The mesh LOD selected in the last collection, not serialized.
+		uint32_t currentLOD;
+
 	};
 
 };
\ No newline at end of file
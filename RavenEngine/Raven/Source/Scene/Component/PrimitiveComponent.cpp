@@ -24,6 +24,7 @@
 
 #include "Scene/SceneManager.h"
 #include "Scene/Scene.h"
+#include "Scene/SceneBoundsTree.h"
 #include "Scene/Entity/EntityManager.h"
 #include "Utilities/StringUtils.h"
 
@@ -57,6 +58,21 @@ void PrimitiveComponent::SetMaterial(uint32_t index, Ptr<Material> mat)
 }
 
 
+void PrimitiveComponent::MarkBoundsDirty()
+{
+	// Not in a scene yet?
+	if (GetEntityHandle() == entt::null)
+		return;
+
+	Scene* scene = GetEntity().GetScene();
+
+	if (scene)
+	{
+		scene->GetBoundsTree()->MarkDirty(GetEntityHandle());
+	}
+}
+
+
 Material* PrimitiveComponent::GetMaterial(uint32_t index)
 {
 	// Invalid Index?
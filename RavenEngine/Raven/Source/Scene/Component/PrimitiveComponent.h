@@ -134,6 +134,10 @@ namespace Raven
 		}
 
 
+	protected:
+		// Notify the scene that the world bounds of this entity need to be updated.
+		void MarkBoundsDirty();
+
 	private:
 		// The Model Materials, used by mesh mapped to the same index.
 		std::vector< Ptr<Material> > materials;
@@ -55,6 +55,7 @@ void SkinnedMeshComponent::SetMesh(Ptr<SkinnedMesh> newMesh)
 	if (!mesh)
 	{
 		localBounds = MathUtils::BoundingBox();
+		MarkBoundsDirty();
 		return;
 	}
 
@@ -75,6 +76,7 @@ void SkinnedMeshComponent::SetMesh(Ptr<SkinnedMesh> newMesh)
 	}
 
 	localBounds = mesh->GetBounds();
+	MarkBoundsDirty();
 }
 
 
@@ -20,6 +20,7 @@
 #include "Scene/Entity/Entity.h"
 #include "Scene/SceneManager.h"
 #include "Scene/Scene.h"
+#include "Scene/SceneBoundsTree.h"
 
 
 #include <glm/gtx/matrix_decompose.hpp>
@@ -142,11 +143,27 @@ void Transform::UpdateChildrenWorld() const
 			continue;
 
 		childTransform->worldMatrix = GetWorldMatrix() * childTransform->GetLocalMatrix();
+		childTransform->MarkBoundsDirty();
 		childTransform->UpdateChildrenWorld();
 	}
 }
 
 
+void Transform::MarkBoundsDirty() const
+{
+	// Not in a scene yet?
+	if (GetEntityHandle() == entt::null)
+		return;
+
+	Scene* scene = GetEntity().GetScene();
+
+	if (scene)
+	{
+		scene->GetBoundsTree()->MarkDirty(GetEntityHandle());
+	}
+}
+
+
 bool Transform::GetParentWorldMatrix(glm::mat4& outMtx) const
 {
 	Entity ent = GetEntity();
@@ -179,6 +196,7 @@ void Transform::ResetTransform()
 	rotation = glm::quat(1.0f, 0.0f, 0.0f, 0.0f);
 	isWorldMatrixDiry = true;
 	isLocalMatrixCacheDiry = true;
+	MarkBoundsDirty();
 }
 
 
@@ -215,6 +233,7 @@ void Transform::Dirty()
 {
 	isWorldMatrixDiry = true;
 	isLocalMatrixCacheDiry = true;
+	MarkBoundsDirty();
 }
 
 
@@ -379,6 +398,7 @@ void Transform::SetTransform(Transform& other)
 
 	isLocalMatrixCacheDiry = false;
 	isWorldMatrixDiry = false;
+	MarkBoundsDirty();
 	UpdateChildrenWorld();
 }
 
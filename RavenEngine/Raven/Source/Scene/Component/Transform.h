@@ -198,6 +198,9 @@ namespace Raven
 		// Return parent world matrix.
 		bool GetParentWorldMatrix(glm::mat4& outMtx) const;
 
+		// Notify the scene that the world bounds of this entity need to be updated.
+		void MarkBoundsDirty() const;
+
 	private:
 		// The Local Translation.
 		glm::vec3 position;
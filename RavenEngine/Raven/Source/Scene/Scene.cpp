@@ -21,6 +21,7 @@
 #include "Entity/Entity.h"
 #include "Entity/EntityManager.h"
 #include "SceneGraph.h"
+#include "SceneBoundsTree.h"
 #include "Scene/Component/Transform.h"
 #include "Scene/Component/Light.h"
 #include "Scene/Component/CameraControllerComponent.h"
@@ -122,6 +123,9 @@ namespace Raven {
 		sceneGraph = std::make_shared<SceneGraph>();
 		sceneGraph->Init(entityManager->GetRegistry());
 
+		boundsTree = std::make_shared<SceneBoundsTree>();
+		boundsTree->Init(entityManager->GetRegistry());
+
 		// Register Enttity Components Getter...
 		if (entt_comp_getters.empty())
 		{
@@ -37,6 +37,7 @@ namespace Raven
 	class EntityManager;
 	class Entity;
 	class SceneGraph;
+	class SceneBoundsTree;
 	class Camera;
 	class Transform;
 
@@ -171,6 +172,9 @@ namespace Raven
 		SceneGlobalSettings& GetGlobalSettings() { return globalSettings; }
 		const SceneGlobalSettings& GetGlobalSettings() const { return globalSettings; }
 
+		// Get the tree of the scene primitives world bounds.
+		inline SceneBoundsTree* GetBoundsTree() { return boundsTree.get(); }
+
 
 		template<typename Archive>
 		void save(Archive& archive) const
@@ -207,6 +211,7 @@ namespace Raven
 
 		bool forceShow = false;
 		std::shared_ptr<SceneGraph> sceneGraph;
+		std::shared_ptr<SceneBoundsTree> boundsTree;
 		std::shared_ptr<EntityManager> entityManager;
 		std::string name;
 		std::string loadName;
@@ -0,0 +1,168 @@
+/*
+ * Developed by Raven Group at the University  of Leeds
+ * Copyright (C) 2021 Ammar Herzallah, Ben Husle, Thomas Moreno Cooper, Sulagna Sinha & Tian Zeng
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3 of the License.
+ *
+ * THIS PROGRAM IS DISTRIBUTED IN THE HOPE THAT IT WILL BE USEFUL,
+ * BUT WITHOUT ANY WARRANTY; WITHOUT EVEN THE IMPLIED WARRANTY OF
+ * MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE.  SEE THE
+ * GNU GENERAL PUBLIC LICENSE FOR MORE DETAILS.
+ */
+
+//////////////////////////////////////////////////////////////////////////////
+// This file is part of the Raven Game Engine			                    //
+//////////////////////////////////////////////////////////////////////////////
+
+#include "SceneBoundsTree.h"
+#include "Scene.h"
+#include "Component/Transform.h"
+#include "Component/MeshComponent.h"
+#include "Component/SkinnedMeshComponent.h"
+
+#include <entt/entt.hpp>
+
+
+namespace Raven
+{
+	// Return the index part of the entity handle.
+	static inline uint32_t GetEntityIndex(entt::entity entity)
+	{
+		return entt::to_integral(entity) & entt::entt_traits<entt::entity>::entity_mask;
+	}
+
+
+	void SceneBoundsTree::Init(entt::registry& registry)
+	{
+		registry.on_construct<MeshComponent>().connect<&SceneBoundsTree::OnPrimitiveChanged>(*this);
+		registry.on_destroy<MeshComponent>().connect<&SceneBoundsTree::OnPrimitiveChanged>(*this);
+		registry.on_construct<SkinnedMeshComponent>().connect<&SceneBoundsTree::OnPrimitiveChanged>(*this);
+		registry.on_destroy<SkinnedMeshComponent>().connect<&SceneBoundsTree::OnPrimitiveChanged>(*this);
+	}
+
+
+	void SceneBoundsTree::OnPrimitiveChanged(entt::registry& registry, entt::entity entity)
+	{
+		MarkDirty(entity);
+	}
+
+
+	void SceneBoundsTree::MarkDirty(entt::entity entity)
+	{
+		if (entity == entt::null)
+			return;
+
+		uint32_t index = GetEntityIndex(entity);
+
+		if (index >= dirtyHandles.size())
+			dirtyHandles.resize(index + 1, entt::null);
+
+		// Not in the list? the index may be recycled so always keep the latest handle.
+		if (dirtyHandles[index] == entt::null)
+			dirtyIndices.push_back(index);
+
+		dirtyHandles[index] = entity;
+	}
+
+
+	void SceneBoundsTree::Update(entt::registry& registry)
+	{
+		changedBounds.clear();
+
+		for (auto index : dirtyIndices)
+		{
+			entt::entity entity = dirtyHandles[index];
+			dirtyHandles[index] = entt::null;
+
+			if (index >= proxies.size())
+				proxies.resize(index + 1, -1);
+
+			// Compute the world bounds of all the entity primitives.
+			MathUtils::BoundingBox bounds;
+
+			if (registry.valid(entity))
+			{
+				Transform* trans = registry.try_get<Transform>(entity);
+				PrimitiveComponent* prims[2] = {
+					registry.try_get<MeshComponent>(entity),
+					registry.try_get<SkinnedMeshComponent>(entity)
+				};
+
+				for (uint32_t i = 0; trans && i < 2; ++i)
+				{
+					if (!prims[i])
+						continue;
+
+					MathUtils::BoundingBox localBounds = prims[i]->GetLocalBounds();
+
+					if (!localBounds.IsValid())
+						continue;
+
+					// The sphere of the world box, same bounds used by the render for culling.
+					glm::vec3 center;
+					float radius;
+					localBounds.Transform(trans->GetWorldMatrix()).GetSphere(center, radius);
+
+					bounds.Add(center - glm::vec3(radius));
+					bounds.Add(center + glm::vec3(radius));
+				}
+			}
+
+			int32_t& proxy = proxies[index];
+
+			// The old fat bounds & the new bounds are both changed.
+			if (proxy != -1)
+			{
+				glm::vec3 oldMin, oldMax;
+				tree.GetFatBounds(proxy, oldMin, oldMax);
+				changedBounds.emplace_back(oldMin, oldMax);
+			}
+
+			if (bounds.IsValid())
+				changedBounds.push_back(bounds);
+
+			// No longer have bounds?
+			if (!bounds.IsValid())
+			{
+				if (proxy != -1)
+				{
+					tree.DestroyProxy(proxy);
+					proxy = -1;
+				}
+
+				continue;
+			}
+
+			if (proxy == -1)
+			{
+				proxy = tree.CreateProxy(bounds.GetMin(), bounds.GetMax(), entt::to_integral(entity));
+			}
+			else if (tree.GetUserData(proxy) != entt::to_integral(entity))
+			{
+				// The entity index was recycled, recreate with the new handle.
+				tree.DestroyProxy(proxy);
+				proxy = tree.CreateProxy(bounds.GetMin(), bounds.GetMax(), entt::to_integral(entity));
+			}
+			else
+			{
+				tree.MoveProxy(proxy, bounds.GetMin(), bounds.GetMax());
+			}
+		}
+
+		dirtyIndices.clear();
+	}
+
+
+	void SceneBoundsTree::Clear()
+	{
+		tree.Clear();
+		proxies.clear();
+		dirtyIndices.clear();
+		dirtyHandles.clear();
+		changedBounds.clear();
+	}
+
+
+};
@@ -0,0 +1,97 @@
+/*
+ * Developed by Raven Group at the University  of Leeds
+ * Copyright (C) 2021 Ammar Herzallah, Ben Husle, Thomas Moreno Cooper, Sulagna Sinha & Tian Zeng
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3 of the License.
+ *
+ * THIS PROGRAM IS DISTRIBUTED IN THE HOPE THAT IT WILL BE USEFUL,
+ * BUT WITHOUT ANY WARRANTY; WITHOUT EVEN THE IMPLIED WARRANTY OF
+ * MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE.  SEE THE
+ * GNU GENERAL PUBLIC LICENSE FOR MORE DETAILS.
+ */
+
+//////////////////////////////////////////////////////////////////////////////
+// This file is part of the Raven Game Engine			                    //
+//////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+#include "Utilities/Core.h"
+#include "Math/DynamicAABBTree.h"
+#include "Math/BoundingBox.h"
+
+#include <vector>
+#include <entt/entity/fwd.hpp>
+
+
+namespace Raven
+{
+	// SceneBoundsTree:
+	//		- Keep the world bounds of every entity with a primitive component in a dynamic AABB tree.
+	//		- Entities are marked dirty when their transform or mesh change, and only dirty entities
+	//		  are refitted in Update(), static entities cost nothing per frame.
+	//		- Used by the render to cull the scene and by the editor for ray picking.
+	//
+	class SceneBoundsTree final
+	{
+	public:
+		SceneBoundsTree() = default;
+		~SceneBoundsTree() = default;
+
+		// Connect to the registry to track primitive components.
+		void Init(entt::registry& registry);
+
+		// Mark the entity bounds as dirty to be updated in the next Update().
+		void MarkDirty(entt::entity entity);
+
+		// Refit the bounds of all the dirty entities.
+		void Update(entt::registry& registry);
+
+		// Remove all the entities from the tree.
+		void Clear();
+
+		// Call the callback with each entity whose bounds intersect the frustum.
+		// @param is2D: test only the left, right, near and far planes, same as Frustum::IsInFrustum2D().
+		template<class Callback>
+		void QueryFrustum(const MathUtils::Frustum& frustum, bool is2D, Callback&& callback) const
+		{
+			tree.QueryFrustum(frustum, is2D, [&](uint32_t data) { callback( (entt::entity)data ); });
+		}
+
+		// Call the callback with each entity whose bounds the ray hit.
+		// @param callback: called as float(entt::entity), return the new max alpha to clip the ray with.
+		template<class Callback>
+		void QueryRay(const glm::vec3& org, const glm::vec3& dir, float maxAlpha, Callback&& callback) const
+		{
+			tree.QueryRay(org, dir, maxAlpha, [&](uint32_t data) { return callback( (entt::entity)data ); });
+		}
+
+		// Return the number of entities in the tree.
+		inline uint32_t GetNumEntities() const { return tree.GetNumProxies(); }
+
+		// Return the old & new bounds of the entities refitted by the last Update().
+		inline const std::vector<MathUtils::BoundingBox>& GetChangedBounds() const { return changedBounds; }
+
+	private:
+		// Called by the registry when a primitive component is added or removed.
+		void OnPrimitiveChanged(entt::registry& registry, entt::entity entity);
+
+	private:
+		// The tree of the entities world bounds, the proxy user data is the entity.
+		MathUtils::DynamicAABBTree tree;
+
+		// The tree proxy of each entity, indexed by the entity index.
+		std::vector<int32_t> proxies;
+
+		// The indices of the entities that need their bounds updated.
+		std::vector<uint32_t> dirtyIndices;
+
+		// The last handle marked dirty for each entity index, null if not in the dirty list.
+		std::vector<entt::entity> dirtyHandles;
+
+		// The old & new bounds of the entities refitted by the last Update().
+		std::vector<MathUtils::BoundingBox> changedBounds;
+	};
+
+};
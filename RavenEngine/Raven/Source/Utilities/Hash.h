@@ -0,0 +1,42 @@
+/*
+ * Developed by Raven Group at the University  of Leeds
+ * Copyright (C) 2021 Ammar Herzallah, Ben Husle, Thomas Moreno Cooper, Sulagna Sinha & Tian Zeng
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3 of the License.
+ *
+ * THIS PROGRAM IS DISTRIBUTED IN THE HOPE THAT IT WILL BE USEFUL,
+ * BUT WITHOUT ANY WARRANTY; WITHOUT EVEN THE IMPLIED WARRANTY OF
+ * MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE.  SEE THE
+ * GNU GENERAL PUBLIC LICENSE FOR MORE DETAILS.
+ */
+#pragma once
+
+
+#include <cstdint>
+#include <cstddef>
+
+
+
+
+namespace Raven
+{
+	// The starting value of a 64-bit FNV-1a hash.
+	static constexpr uint64_t HASH_OFFSET_BASIS = 0xCBF29CE484222325ull;
+
+
+	// 64-bit FNV-1a hash, pass HASH_OFFSET_BASIS to start a new hash or a previous hash to continue it.
+	inline uint64_t HashBytes(uint64_t hash, const void* data, size_t size)
+	{
+		const uint8_t* bytes = (const uint8_t*)data;
+
+		for (size_t i = 0; i < size; ++i)
+		{
+			hash ^= bytes[i];
+			hash *= 0x100000001B3ull;
+		}
+
+		return hash;
+	}
+}
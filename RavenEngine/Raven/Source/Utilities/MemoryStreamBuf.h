@@ -0,0 +1,116 @@
+/*
+ * Developed by Raven Group at the University  of Leeds
+ * Copyright (C) 2021 Ammar Herzallah, Ben Husle, Thomas Moreno Cooper, Sulagna Sinha & Tian Zeng
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3 of the License.
+ *
+ * THIS PROGRAM IS DISTRIBUTED IN THE HOPE THAT IT WILL BE USEFUL,
+ * BUT WITHOUT ANY WARRANTY; WITHOUT EVEN THE IMPLIED WARRANTY OF
+ * MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE.  SEE THE
+ * GNU GENERAL PUBLIC LICENSE FOR MORE DETAILS.
+ */
+#pragma once
+
+
+#include <streambuf>
+#include <cstdint>
+#include <cstring>
+#include <mutex>
+#include <unordered_map>
+
+
+
+
+namespace Raven
+{
+
+	// RavenMemoryStreamBuf:
+	//		- Read only stream buffer over memory, the memory is not copied and must outlive the buffer.
+	//		- Bulk reads are a single memcpy, and Consume() gives direct access to the memory so
+	//		  compressed data can be decompressed in place, @see LoadCompressed().
+	//		- The archive reading from the buffer is attached to it, so the buffer can be found
+	//		  from the archive alone, @see Find().
+	//
+	class RavenMemoryStreamBuf : public std::streambuf
+	{
+	public:
+		// Construct.
+		RavenMemoryStreamBuf(const uint8_t* data, size_t size)
+		{
+			Reset(data, size);
+		}
+
+		// Set the memory to read.
+		inline void Reset(const uint8_t* data, size_t size)
+		{
+			char* begin = const_cast<char*>(reinterpret_cast<const char*>(data));
+			setg(begin, begin, begin + size);
+		}
+
+		// Return the memory of the next size bytes and skip them, null if there is not enough data left.
+		inline const uint8_t* Consume(size_t size)
+		{
+			if ((size_t)(egptr() - gptr()) < size)
+				return nullptr;
+
+			char* current = gptr();
+			setg(eback(), current + size, egptr());
+
+			return reinterpret_cast<const uint8_t*>(current);
+		}
+
+		// Attach an archive to the buffer it reads from, until Detach() is called.
+		static void Attach(const void* archive, RavenMemoryStreamBuf* buf)
+		{
+			std::lock_guard<std::mutex> lock(GetArchivesMutex());
+			GetArchives()[archive] = buf;
+		}
+
+		// Detach an archive attached by Attach().
+		static void Detach(const void* archive)
+		{
+			std::lock_guard<std::mutex> lock(GetArchivesMutex());
+			GetArchives().erase(archive);
+		}
+
+		// Return the buffer an archive reads from, null if the archive is not attached to a memory buffer.
+		static RavenMemoryStreamBuf* Find(const void* archive)
+		{
+			std::lock_guard<std::mutex> lock(GetArchivesMutex());
+			auto iter = GetArchives().find(archive);
+			return iter != GetArchives().end() ? iter->second : nullptr;
+		}
+
+	protected:
+		// Read count bytes with a single copy.
+		virtual std::streamsize xsgetn(char* s, std::streamsize count) override
+		{
+			std::streamsize available = egptr() - gptr();
+			std::streamsize size = count < available ? count : available;
+
+			memcpy(s, gptr(), (size_t)size);
+			setg(eback(), gptr() + size, egptr());
+
+			return size;
+		}
+
+	private:
+		// The archives attached to their buffers.
+		static std::unordered_map<const void*, RavenMemoryStreamBuf*>& GetArchives()
+		{
+			static std::unordered_map<const void*, RavenMemoryStreamBuf*> archives;
+			return archives;
+		}
+
+		// Guard the attached archives, archives are used by the load worker threads.
+		static std::mutex& GetArchivesMutex()
+		{
+			static std::mutex archivesMutex;
+			return archivesMutex;
+		}
+	};
+
+}
+
@@ -15,10 +15,29 @@
 
 
 #include "Core.h"
+#include "MemoryStreamBuf.h"
 
 
 #include <glm/glm.hpp>
 #include "imgui/imgui.h"
+#include "cereal/details/helpers.hpp"
+
+
+#include <vector>
+#include <functional>
+#include <cstring>
+
+
+
+
+// The uncompressed size of each chunk compressed by ECompressionCodec::ZlibChunked.
+#define COMPRESSION_CHUNK_SIZE (256 * 1024)
+
+// The size of the buffer used to read compressed data from a stream.
+#define COMPRESSION_STREAM_BUFFER_SIZE (64 * 1024)
+
+// The number of chunks read from a stream then uncompressed in parallel at a time.
+#define COMPRESSION_STREAM_CHUNKS 8
 
 
 namespace glm
@@ -71,47 +90,207 @@ namespace reactphysics3d
 
 namespace Raven
 {
+	// The codecs used to compress binary data, the codec of a resource is saved in its header.
+	enum class ECompressionCodec : uint8_t
+	{
+		// zlib over the whole data, resources saved before codecs were added use it.
+		Zlib = 0,
+
+		// zlib over fixed size chunks, chunks are compressed and uncompressed in parallel.
+		ZlibChunked = 1,
+
+		// Not compressed, the fastest to load for data that does not compress well.
+		Raw = 2
+	};
+
+
+	// Return the codec used by SaveCompressed/LoadCompressed on this thread, set by the resource archive.
+	inline ECompressionCodec& ActiveCompressionCodec()
+	{
+		thread_local ECompressionCodec codec = ECompressionCodec::Zlib;
+		return codec;
+	}
+
+
+	// Return the maximum number of threads used to compress or uncompress chunks on this thread, 0 to use all the cores.
+	// The resource load worker threads lower it as they already load resources in parallel, @see ResourceLoadQueue.
+	inline uint32_t& MaxCompressionThreads()
+	{
+		thread_local uint32_t numThreads = 0;
+		return numThreads;
+	}
+
+
+	// CompressionCodecScope:
+	//		- set the active compression codec of this thread for the lifetime of the scope.
+	//
+	class CompressionCodecScope
+	{
+	public:
+		// Construct.
+		CompressionCodecScope(ECompressionCodec codec)
+			: prevCodec(ActiveCompressionCodec())
+		{
+			ActiveCompressionCodec() = codec;
+		}
+
+		// Destruct.
+		~CompressionCodecScope()
+		{
+			ActiveCompressionCodec() = prevCodec;
+		}
+
+	private:
+		// The codec to restore.
+		ECompressionCodec prevCodec;
+	};
+
+
+
 	// Compress data.
 	extern bool Compress(uint32_t size, const uint8_t* data, uint8_t*& comp, uint32_t& outCompSize);
 
 	// Uncompress data.
 	extern bool Uncompress(uint32_t compSize, const uint8_t* comp, uint8_t* data, uint32_t size);
 
-	// Compress data then save it.
+	// Compress data in chunks of COMPRESSION_CHUNK_SIZE in parallel.
+	// @param outChunkSizes: the compressed size of each chunk.
+	// @param outComp: the compressed chunks one after the other.
+	extern bool CompressChunks(uint32_t size, const uint8_t* data, std::vector<uint32_t>& outChunkSizes, std::vector<uint8_t>& outComp);
+
+	// Uncompress chunks compressed by CompressChunks() in parallel.
+	extern bool UncompressChunks(uint32_t chunkSize, const std::vector<uint32_t>& chunkSizes, const uint8_t* comp, uint8_t* data, uint32_t size);
+
+	// Function that read the next size bytes of compressed data into buffer.
+	typedef std::function<void(uint8_t* buffer, uint32_t size)> CompressedReadFunc;
+
+	// Uncompress data compressed by Compress() while reading it in blocks of COMPRESSION_STREAM_BUFFER_SIZE,
+	// the compressed data is read to the end even if it fails.
+	extern bool UncompressStream(uint32_t compSize, const CompressedReadFunc& read, uint8_t* data, uint32_t size);
+
+	// Uncompress chunks compressed by CompressChunks() while reading COMPRESSION_STREAM_CHUNKS chunks at a time,
+	// the compressed data is read to the end even if it fails.
+	extern bool UncompressChunksStream(uint32_t chunkSize, const std::vector<uint32_t>& chunkSizes, const CompressedReadFunc& read, uint8_t* data, uint32_t size);
+
+
+	// Compress data then save it using the active codec.
 	template<class Archive>
 	void SaveCompressed(Archive& archive, uint32_t size, const uint8_t* data)
 	{
 		RAVEN_ASSERT(size != 0 && data != nullptr, "Invalid Input.");
 
-		uint32_t compressedSize = 0;
-		uint8_t* compressedData = nullptr;
-		bool status = Compress(size, data, compressedData, compressedSize);
-		RAVEN_ASSERT(status, "Failed to compress");
+		switch (ActiveCompressionCodec())
+		{
+		case ECompressionCodec::Zlib:
+		{
+			uint32_t compressedSize = 0;
+			uint8_t* compressedData = nullptr;
+			bool status = Compress(size, data, compressedData, compressedSize);
+			RAVEN_ASSERT(status, "Failed to compress");
+
+			archive(compressedSize);
+			archive.saveBinary(compressedData, compressedSize);
 
-		archive(compressedSize);
-		archive.saveBinary(compressedData, compressedSize);
+			free(compressedData);
+		}
+			break;
 
-		free(compressedData);
+		case ECompressionCodec::ZlibChunked:
+		{
+			std::vector<uint32_t> chunkSizes;
+			std::vector<uint8_t> compressedData;
+			bool status = CompressChunks(size, data, chunkSizes, compressedData);
+			RAVEN_ASSERT(status, "Failed to compress");
+
+			uint32_t chunkSize = COMPRESSION_CHUNK_SIZE;
+			uint32_t numChunks = (uint32_t)chunkSizes.size();
+			archive(chunkSize, numChunks);
+			archive.saveBinary(chunkSizes.data(), chunkSizes.size() * sizeof(uint32_t));
+			archive.saveBinary(compressedData.data(), compressedData.size());
+		}
+			break;
+
+		case ECompressionCodec::Raw:
+			archive.saveBinary(data, size);
+			break;
+		}
 	}
 
-	// Loaed Compressed data then uncompress it.
+	// Loaed Compressed data then uncompress it using the active codec.
+	// @throw cereal::Exception if the data is corrupted, data is cleared and the load fails like any other failed archive read, @see ILoader::LoadArchive().
 	template<class Archive>
 	void LoadCompressed(Archive& archive, uint32_t size, uint8_t* data)
 	{
 		RAVEN_ASSERT(size != 0 && data != nullptr, "Invalid Input.");
 
+		const ECompressionCodec codec = ActiveCompressionCodec();
+
+		// Not Compressed?
+		if (codec == ECompressionCodec::Raw)
+		{
+			archive.loadBinary(data, size);
+			return;
+		}
+
 		// Load Size.
 		uint32_t compressedSize = 0;
-		archive(compressedSize);
+		uint32_t chunkSize = 0;
+		std::vector<uint32_t> chunkSizes;
 
-		// Allocate and load.
-		uint8_t* compressedData = (uint8_t*)malloc((size_t)compressedSize);
-		archive.loadBinary(compressedData, compressedSize);
+		if (codec == ECompressionCodec::ZlibChunked)
+		{
+			uint32_t numChunks = 0;
+			archive(chunkSize, numChunks);
+
+			// Corrupted? the chunks must cover the uncompressed size, checked before allocating anything.
+			// The size of the compressed data is unknown, so the rest of the archive can't be read.
+			if (chunkSize == 0 || (uint64_t)numChunks != ((uint64_t)size + chunkSize - 1) / chunkSize)
+			{
+				memset(data, 0, size);
+				throw cereal::Exception("LoadCompressed - Invalid chunks, the data is corrupted.");
+			}
+
+			chunkSizes.resize(numChunks);
+			archive.loadBinary(chunkSizes.data(), chunkSizes.size() * sizeof(uint32_t));
+
+			for (uint32_t i = 0; i < numChunks; ++i)
+				compressedSize += chunkSizes[i];
+		}
+		else
+		{
+			archive(compressedSize);
+		}
 
-		bool status = Uncompress(compressedSize, compressedData, data, size);
-		RAVEN_ASSERT(status, "Failed to compress");
+		// Reading from memory? uncompress in place without copying the compressed data.
+		RavenMemoryStreamBuf* memoryBuf = RavenMemoryStreamBuf::Find(&archive);
+		const uint8_t* compressedData = memoryBuf ? memoryBuf->Consume(compressedSize) : nullptr;
+		bool status = false;
 
-		free(compressedData);
+		if (compressedData)
+		{
+			status = codec == ECompressionCodec::ZlibChunked
+				? UncompressChunks(chunkSize, chunkSizes, compressedData, data, size)
+				: Uncompress(compressedSize, compressedData, data, size);
+		}
+		else
+		{
+			// Reading from a stream, uncompress while reading so the compressed data is never fully in memory.
+			CompressedReadFunc read = [&archive](uint8_t* buffer, uint32_t readSize)
+			{
+				archive.loadBinary(buffer, readSize);
+			};
+
+			status = codec == ECompressionCodec::ZlibChunked
+				? UncompressChunksStream(chunkSize, chunkSizes, read, data, size)
+				: UncompressStream(compressedSize, read, data, size);
+		}
+
+		// Failed, the compressed data was read to the end but the output is not valid.
+		if (!status)
+		{
+			memset(data, 0, size);
+			throw cereal::Exception("LoadCompressed - Failed to uncompress, the data is corrupted.");
+		}
 	}
 
 	// Archve save a vector.
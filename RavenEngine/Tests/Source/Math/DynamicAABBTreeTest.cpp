@@ -0,0 +1,81 @@
+/*
+ * Developed by Raven Group at the University  of Leeds
+ * Copyright (C) 2021 Ammar Herzallah, Ben Husle, Thomas Moreno Cooper, Sulagna Sinha & Tian Zeng
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3 of the License.
+ *
+ * THIS PROGRAM IS DISTRIBUTED IN THE HOPE THAT IT WILL BE USEFUL,
+ * BUT WITHOUT ANY WARRANTY; WITHOUT EVEN THE IMPLIED WARRANTY OF
+ * MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE.  SEE THE
+ * GNU GENERAL PUBLIC LICENSE FOR MORE DETAILS.
+ */
+#include "RavenTest.h"
+
+#include "Math/DynamicAABBTree.h"
+
+
+#include "glm/gtc/matrix_transform.hpp"
+
+#include <vector>
+#include <algorithm>
+
+
+
+using namespace Raven;
+
+
+
+
+RAVEN_TEST(DynamicAABBTree_StackGrowsPastFixedSize)
+{
+	MathUtils::DynamicAABBTreeStack stack;
+	const int32_t count = DYNAMIC_AABB_TREE_STACK_SIZE * 5 + 3;
+
+	for (int32_t i = 0; i < count; ++i)
+		stack.Push(i);
+
+	for (int32_t i = count - 1; i >= 0; --i)
+	{
+		TEST_CHECK(!stack.IsEmpty());
+		TEST_CHECK(stack.Pop() == i);
+	}
+
+	TEST_CHECK(stack.IsEmpty());
+}
+
+
+RAVEN_TEST(DynamicAABBTree_QueryFrustumMatchesBruteForce)
+{
+	MathUtils::DynamicAABBTree tree;
+	std::vector<glm::vec3> mins, maxs;
+
+	for (uint32_t i = 0; i < 4000; ++i)
+	{
+		glm::vec3 pos((float)(i % 64) * 6.0f - 192.0f, (float)(i % 5), (float)(i / 64) * 6.0f - 192.0f);
+		mins.push_back(pos - glm::vec3(1.0f));
+		maxs.push_back(pos + glm::vec3(1.0f));
+		tree.CreateProxy(mins.back(), maxs.back(), i);
+	}
+
+	glm::mat4 proj = glm::perspective(glm::radians(60.0f), 1.0f, 0.1f, 150.0f);
+	glm::mat4 view = glm::lookAt(glm::vec3(0.0f, 2.0f, 0.0f), glm::vec3(1.0f, 2.0f, 1.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+	MathUtils::Frustum frustum(proj * view);
+
+	std::vector<uint32_t> found;
+	tree.QueryFrustum(frustum, false, [&](uint32_t userData) { found.push_back(userData); });
+	std::sort(found.begin(), found.end());
+
+	std::vector<uint32_t> expected;
+
+	for (uint32_t i = 0; i < (uint32_t)mins.size(); ++i)
+	{
+		if (frustum.IsBoxInFrustum(mins[i], maxs[i]))
+			expected.push_back(i);
+	}
+
+	// The tree stores fat boxes, so it may report a few more proxies but never miss one.
+	TEST_CHECK(!expected.empty());
+	TEST_CHECK(std::includes(found.begin(), found.end(), expected.begin(), expected.end()));
+}
@@ -0,0 +1,172 @@
+/*
+ * Developed by Raven Group at the University  of Leeds
+ * Copyright (C) 2021 Ammar Herzallah, Ben Husle, Thomas Moreno Cooper, Sulagna Sinha & Tian Zeng
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3 of the License.
+ *
+ * THIS PROGRAM IS DISTRIBUTED IN THE HOPE THAT IT WILL BE USEFUL,
+ * BUT WITHOUT ANY WARRANTY; WITHOUT EVEN THE IMPLIED WARRANTY OF
+ * MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE.  SEE THE
+ * GNU GENERAL PUBLIC LICENSE FOR MORE DETAILS.
+ */
+#include "RavenTest.h"
+
+#include "Math/Frustum.h"
+
+
+#include "glm/gtc/matrix_transform.hpp"
+
+#include <vector>
+#include <cstdio>
+
+
+
+using namespace Raven;
+
+
+
+
+// Small deterministic random generator, so failures can be reproduced.
+struct TestRandom
+{
+	uint32_t state = 0x12345678u;
+
+	// Return a random float in [min, max].
+	float Range(float min, float max)
+	{
+		state = state * 1664525u + 1013904223u;
+		return min + (max - min) * (float)(state >> 8) / (float)(1u << 24);
+	}
+};
+
+
+// A frustum looking down the diagonal, so none of its planes are axis aligned.
+static MathUtils::Frustum MakeTestFrustum()
+{
+	glm::mat4 proj = glm::perspective(glm::radians(60.0f), 16.0f / 9.0f, 0.1f, 100.0f);
+	glm::mat4 view = glm::lookAt(glm::vec3(3.0f, 5.0f, -2.0f), glm::vec3(20.0f, 1.0f, 30.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+	return MathUtils::Frustum(proj * view);
+}
+
+
+// Random spheres & boxes around the frustum, most of them close to its planes.
+struct TestVolumes
+{
+	std::vector<glm::vec3> centers;
+	std::vector<float> radii;
+	std::vector<glm::vec3> mins;
+	std::vector<glm::vec3> maxs;
+
+	TestVolumes(uint32_t count)
+	{
+		TestRandom rnd;
+
+		for (uint32_t i = 0; i < count; ++i)
+		{
+			glm::vec3 c(rnd.Range(-120.0f, 140.0f), rnd.Range(-60.0f, 60.0f), rnd.Range(-120.0f, 140.0f));
+			glm::vec3 e(rnd.Range(0.0f, 4.0f), rnd.Range(0.0f, 4.0f), rnd.Range(0.0f, 4.0f));
+
+			centers.push_back(c);
+			radii.push_back(i % 16 == 0 ? 0.0f : e.x);
+			mins.push_back(c - e);
+			maxs.push_back(c + e);
+		}
+	}
+};
+
+
+
+
+RAVEN_TEST(Frustum_SpheresX4MatchScalar)
+{
+	MathUtils::Frustum frustum = MakeTestFrustum();
+	TestVolumes volumes(100000);
+	uint32_t numInside = 0;
+
+	for (uint32_t i = 0; i < (uint32_t)volumes.centers.size(); i += 4)
+	{
+		uint32_t mask3D = frustum.IsInFrustumX4(&volumes.centers[i], &volumes.radii[i]);
+		uint32_t mask2D = frustum.IsInFrustum2DX4(&volumes.centers[i], &volumes.radii[i]);
+
+		for (uint32_t l = 0; l < 4; ++l)
+		{
+			bool isInside3D = frustum.IsInFrustum(volumes.centers[i + l], volumes.radii[i + l]);
+			bool isInside2D = frustum.IsInFrustum2D(volumes.centers[i + l], volumes.radii[i + l]);
+			TEST_CHECK(((mask3D >> l) & 1u) == (uint32_t)isInside3D);
+			TEST_CHECK(((mask2D >> l) & 1u) == (uint32_t)isInside2D);
+			numInside += isInside3D;
+		}
+	}
+
+	// Make sure both results are tested.
+	TEST_CHECK(numInside > 0 && numInside < volumes.centers.size());
+}
+
+
+RAVEN_TEST(Frustum_BoxesX4MatchScalar)
+{
+	MathUtils::Frustum frustum = MakeTestFrustum();
+	TestVolumes volumes(100000);
+	uint32_t numInside = 0;
+
+	for (uint32_t i = 0; i < (uint32_t)volumes.mins.size(); i += 4)
+	{
+		uint32_t mask3D = frustum.IsBoxInFrustumX4(&volumes.mins[i], &volumes.maxs[i]);
+		uint32_t mask2D = frustum.IsBoxInFrustum2DX4(&volumes.mins[i], &volumes.maxs[i]);
+
+		for (uint32_t l = 0; l < 4; ++l)
+		{
+			bool isInside3D = frustum.IsBoxInFrustum(volumes.mins[i + l], volumes.maxs[i + l]);
+			bool isInside2D = frustum.IsBoxInFrustum2D(volumes.mins[i + l], volumes.maxs[i + l]);
+			TEST_CHECK(((mask3D >> l) & 1u) == (uint32_t)isInside3D);
+			TEST_CHECK(((mask2D >> l) & 1u) == (uint32_t)isInside2D);
+			numInside += isInside3D;
+		}
+	}
+
+	TEST_CHECK(numInside > 0 && numInside < volumes.mins.size());
+}
+
+
+RAVEN_BENCHMARK(Frustum_BoxesPerSecond)
+{
+	MathUtils::Frustum frustum = MakeTestFrustum();
+	TestVolumes volumes(1 << 16);
+	const uint32_t numBoxes = (uint32_t)volumes.mins.size();
+	const uint32_t numRepeats = 200;
+
+	// Scalar.
+	uint32_t numInside = 0;
+	double start = Test::GetTimeMs();
+
+	for (uint32_t r = 0; r < numRepeats; ++r)
+	{
+		for (uint32_t i = 0; i < numBoxes; ++i)
+			numInside += frustum.IsBoxInFrustum(volumes.mins[i], volumes.maxs[i]);
+	}
+
+	double scalarMs = Test::GetTimeMs() - start;
+	Test::DoNotOptimize(&numInside);
+
+	// 4 at a time.
+	uint32_t numInsideX4 = 0;
+	start = Test::GetTimeMs();
+
+	for (uint32_t r = 0; r < numRepeats; ++r)
+	{
+		for (uint32_t i = 0; i < numBoxes; i += 4)
+		{
+			uint32_t mask = frustum.IsBoxInFrustumX4(&volumes.mins[i], &volumes.maxs[i]);
+			numInsideX4 += (mask & 1u) + ((mask >> 1) & 1u) + ((mask >> 2) & 1u) + ((mask >> 3) & 1u);
+		}
+	}
+
+	double x4Ms = Test::GetTimeMs() - start;
+	Test::DoNotOptimize(&numInsideX4);
+
+	const double numTested = (double)numBoxes * numRepeats;
+	printf("  scalar: %.1f M boxes/sec\n", numTested / (scalarMs * 1000.0));
+	printf("  X4:     %.1f M boxes/sec, %.2fx\n", numTested / (x4Ms * 1000.0), scalarMs / x4Ms);
+}
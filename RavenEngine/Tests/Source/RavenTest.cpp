@@ -0,0 +1,261 @@
+/*
+ * Developed by Raven Group at the University  of Leeds
+ * Copyright (C) 2021 Ammar Herzallah, Ben Husle, Thomas Moreno Cooper, Sulagna Sinha & Tian Zeng
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3 of the License.
+ *
+ * THIS PROGRAM IS DISTRIBUTED IN THE HOPE THAT IT WILL BE USEFUL,
+ * BUT WITHOUT ANY WARRANTY; WITHOUT EVEN THE IMPLIED WARRANTY OF
+ * MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE.  SEE THE
+ * GNU GENERAL PUBLIC LICENSE FOR MORE DETAILS.
+ */
+#include "RavenTest.h"
+#include "Logger/Console.h"
+#include "Engine.h"
+
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+
+
+
+
+// Count every global heap allocation, used by tests that check for non-allocating code.
+static std::atomic<uint64_t> heapAllocations(0);
+
+
+void* operator new(size_t size)
+{
+	++heapAllocations;
+	void* ptr = malloc(size != 0 ? size : 1);
+
+	if (!ptr)
+		throw std::bad_alloc();
+
+	return ptr;
+}
+
+
+void* operator new[](size_t size)
+{
+	return operator new(size);
+}
+
+
+void operator delete(void* ptr) noexcept
+{
+	free(ptr);
+}
+
+
+void operator delete[](void* ptr) noexcept
+{
+	free(ptr);
+}
+
+
+void operator delete(void* ptr, size_t) noexcept
+{
+	free(ptr);
+}
+
+
+void operator delete[](void* ptr, size_t) noexcept
+{
+	free(ptr);
+}
+
+
+void* operator new(size_t size, std::align_val_t alignment)
+{
+	++heapAllocations;
+	size = size != 0 ? size : 1;
+
+#ifdef _WIN32
+	void* ptr = _aligned_malloc(size, (size_t)alignment);
+#else
+	// aligned_alloc requires the size to be a multiple of the alignment.
+	size_t align = (size_t)alignment;
+	void* ptr = aligned_alloc(align, (size + align - 1) / align * align);
+#endif
+
+	if (!ptr)
+		throw std::bad_alloc();
+
+	return ptr;
+}
+
+
+void* operator new[](size_t size, std::align_val_t alignment)
+{
+	return operator new(size, alignment);
+}
+
+
+void operator delete(void* ptr, std::align_val_t) noexcept
+{
+#ifdef _WIN32
+	_aligned_free(ptr);
+#else
+	free(ptr);
+#endif
+}
+
+
+void operator delete[](void* ptr, std::align_val_t alignment) noexcept
+{
+	operator delete(ptr, alignment);
+}
+
+
+void operator delete(void* ptr, size_t, std::align_val_t alignment) noexcept
+{
+	operator delete(ptr, alignment);
+}
+
+
+void operator delete[](void* ptr, size_t, std::align_val_t alignment) noexcept
+{
+	operator delete(ptr, alignment);
+}
+
+
+
+
+// The engine of the tests, its modules are only loaded by the tests that need them, @see Test::InitializeEngine().
+Raven::Engine* CreateEngine()
+{
+	return new Raven::Engine();
+}
+
+
+
+
+namespace Raven {
+namespace Test {
+
+
+// The number of failed checks in the running test.
+static uint32_t numTestFailures = 0;
+
+// A value written by DoNotOptimize().
+static const void* volatile sinkValue = nullptr;
+
+
+
+TestRegistrar::TestRegistrar(const char* name, TestFunc func, bool isBenchmark)
+{
+	GetTestCases().push_back(TestCase{ name, func, isBenchmark });
+}
+
+
+std::vector<TestCase>& GetTestCases()
+{
+	static std::vector<TestCase> testCases;
+	return testCases;
+}
+
+
+void ReportFailure(const char* file, int line, const char* condition)
+{
+	printf("    %s(%d): check failed: %s\n", file, line, condition);
+	++numTestFailures;
+}
+
+
+uint64_t GetHeapAllocations()
+{
+	return heapAllocations.load();
+}
+
+
+double GetTimeMs()
+{
+	using namespace std::chrono;
+	return duration<double, std::milli>(steady_clock::now().time_since_epoch()).count();
+}
+
+
+void DoNotOptimize(const void* value)
+{
+	sinkValue = value;
+}
+
+
+void InitializeEngine()
+{
+	static bool isInitialized = false;
+
+	if (isInitialized)
+		return;
+
+	isInitialized = true;
+	Engine::Get().Initialize();
+}
+
+
+} // End of namespace Test.
+} // End of namespace Raven.
+
+
+
+
+// Run all the tests, or all the benchmarks with --bench, optionally only those whose name contains a filter.
+// @return the number of failed tests.
+int main(int argc, char** argv)
+{
+	using namespace Raven::Test;
+
+	bool isBenchmark = false;
+	const char* filter = nullptr;
+
+	for (int i = 1; i < argc; ++i)
+	{
+		if (strcmp(argv[i], "--bench") == 0)
+			isBenchmark = true;
+		else
+			filter = argv[i];
+	}
+
+	// The engine code logs through the console, only warnings & errors are shown.
+	Raven::Console::Init();
+	Raven::Console::GetLogger()->set_level(spdlog::level::warn);
+
+	int numFailed = 0;
+	int numRun = 0;
+
+	for (const TestCase& testCase : GetTestCases())
+	{
+		if (testCase.isBenchmark != isBenchmark)
+			continue;
+
+		if (filter && !strstr(testCase.name, filter))
+			continue;
+
+		printf("[ RUN  ] %s\n", testCase.name);
+		fflush(stdout);
+
+		numTestFailures = 0;
+		testCase.func();
+		++numRun;
+
+		if (numTestFailures == 0)
+		{
+			printf("[ PASS ] %s\n", testCase.name);
+		}
+		else
+		{
+			printf("[ FAIL ] %s\n", testCase.name);
+			++numFailed;
+		}
+	}
+
+	printf("\n%d %s, %d failed.\n", numRun, isBenchmark ? "benchmarks" : "tests", numFailed);
+	return numFailed;
+}
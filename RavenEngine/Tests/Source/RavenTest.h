@@ -0,0 +1,101 @@
+/*
+ * Developed by Raven Group at the University  of Leeds
+ * Copyright (C) 2021 Ammar Herzallah, Ben Husle, Thomas Moreno Cooper, Sulagna Sinha & Tian Zeng
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3 of the License.
+ *
+ * THIS PROGRAM IS DISTRIBUTED IN THE HOPE THAT IT WILL BE USEFUL,
+ * BUT WITHOUT ANY WARRANTY; WITHOUT EVEN THE IMPLIED WARRANTY OF
+ * MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE.  SEE THE
+ * GNU GENERAL PUBLIC LICENSE FOR MORE DETAILS.
+ */
+#pragma once
+
+
+#include <cstdint>
+#include <vector>
+
+
+
+
+// Define a test, registered and run by the RavenTests executable.
+#define RAVEN_TEST(Name) \
+	static void Name(); \
+	static Raven::Test::TestRegistrar Name##_Registrar(#Name, &Name, false); \
+	static void Name()
+
+
+// Define a benchmark, only run by the RavenTests executable with --bench.
+#define RAVEN_BENCHMARK(Name) \
+	static void Name(); \
+	static Raven::Test::TestRegistrar Name##_Registrar(#Name, &Name, true); \
+	static void Name()
+
+
+// Check a condition, if false the running test fails and returns.
+#define TEST_CHECK(condition) \
+	do \
+	{ \
+		if (!(condition)) \
+		{ \
+			Raven::Test::ReportFailure(__FILE__, __LINE__, #condition); \
+			return; \
+		} \
+	} while (0)
+
+
+
+
+namespace Raven
+{
+namespace Test
+{
+	// The function of a test or a benchmark.
+	typedef void(*TestFunc)();
+
+
+	// A registered test or benchmark.
+	struct TestCase
+	{
+		// The name of the test.
+		const char* name;
+
+		// The test function.
+		TestFunc func;
+
+		// True if this is a benchmark.
+		bool isBenchmark;
+	};
+
+
+	// TestRegistrar:
+	//		- register a test case when constructed, @see RAVEN_TEST & RAVEN_BENCHMARK.
+	//
+	struct TestRegistrar
+	{
+		// Construct.
+		TestRegistrar(const char* name, TestFunc func, bool isBenchmark);
+	};
+
+
+	// Return all the registered tests & benchmarks.
+	std::vector<TestCase>& GetTestCases();
+
+	// Report a failed check in the running test.
+	void ReportFailure(const char* file, int line, const char* condition);
+
+	// Return the number of global heap allocations made by the process so far.
+	uint64_t GetHeapAllocations();
+
+	// Return the time in milliseconds since an arbitrary point, used to time benchmarks.
+	double GetTimeMs();
+
+	// Prevent the compiler from optimizing away a value computed by a benchmark.
+	void DoNotOptimize(const void* value);
+
+	// Load the engine modules once, for tests that need the window, the renderer or the project resources.
+	void InitializeEngine();
+}
+}
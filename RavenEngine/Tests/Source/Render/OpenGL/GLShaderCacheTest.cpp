@@ -0,0 +1,148 @@
+/*
+ * Developed by Raven Group at the University  of Leeds
+ * Copyright (C) 2021 Ammar Herzallah, Ben Husle, Thomas Moreno Cooper, Sulagna Sinha & Tian Zeng
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3 of the License.
+ *
+ * THIS PROGRAM IS DISTRIBUTED IN THE HOPE THAT IT WILL BE USEFUL,
+ * BUT WITHOUT ANY WARRANTY; WITHOUT EVEN THE IMPLIED WARRANTY OF
+ * MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE.  SEE THE
+ * GNU GENERAL PUBLIC LICENSE FOR MORE DETAILS.
+ */
+#include "RavenTest.h"
+
+#include "Render/OpenGL/GLShaderCache.h"
+
+
+#include <vector>
+#include <string>
+#include <fstream>
+#include <filesystem>
+
+
+
+using namespace Raven;
+
+
+
+
+// A clean directory for the test files.
+static std::string MakeTestDirectory(const char* name)
+{
+	std::filesystem::path dir = std::filesystem::temp_directory_path() / "RavenTests" / name;
+	std::filesystem::remove_all(dir);
+	std::filesystem::create_directories(dir);
+	return dir.string();
+}
+
+
+// Read all the bytes of a file.
+static std::vector<char> ReadTestFile(const std::string& path)
+{
+	std::ifstream fs(path.c_str(), std::ios::in | std::ios::binary);
+	return std::vector<char>((std::istreambuf_iterator<char>(fs)), std::istreambuf_iterator<char>());
+}
+
+
+// Write all the bytes of a file.
+static void WriteTestFile(const std::string& path, const std::vector<char>& data)
+{
+	std::ofstream fs(path.c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+	fs.write(data.data(), data.size());
+}
+
+
+
+
+RAVEN_TEST(GLShaderCache_KeyChangesWithSourcesAndDriver)
+{
+	const std::vector<std::string> sources = { "#version 450\nvoid main() {}", "#define SHADOW\nvoid main() {}" };
+	const uint64_t key = GLShaderCache::ComputeKey(sources, "Vendor Renderer 4.5");
+
+	// Stable for the same input.
+	TEST_CHECK(key == GLShaderCache::ComputeKey(sources, "Vendor Renderer 4.5"));
+
+	// Any change to a source, the stages or the driver is a new key.
+	TEST_CHECK(key != GLShaderCache::ComputeKey(sources, "Vendor Renderer 4.6"));
+	TEST_CHECK(key != GLShaderCache::ComputeKey({ sources[0], sources[1] + " " }, "Vendor Renderer 4.5"));
+	TEST_CHECK(key != GLShaderCache::ComputeKey({ sources[1], sources[0] }, "Vendor Renderer 4.5"));
+	TEST_CHECK(key != GLShaderCache::ComputeKey({ sources[0] }, "Vendor Renderer 4.5"));
+
+	// Moving text between stages is a new key.
+	TEST_CHECK(GLShaderCache::ComputeKey({ "ab", "c" }, "") != GLShaderCache::ComputeKey({ "a", "bc" }, ""));
+	TEST_CHECK(GLShaderCache::ComputeKey({ "abc" }, "") != GLShaderCache::ComputeKey({ "ab", "c" }, ""));
+}
+
+
+RAVEN_TEST(GLShaderCache_FileRoundTripAndValidation)
+{
+	const std::string dir = MakeTestDirectory("GLShaderCache");
+	const uint64_t key = 0x0123456789ABCDEFull;
+	const std::string path = GLShaderCache::GetFilePath(dir, key);
+	TEST_CHECK(path == dir + "/0123456789abcdef.bin");
+
+	std::vector<uint8_t> binary(1000);
+
+	for (size_t i = 0; i < binary.size(); ++i)
+		binary[i] = (uint8_t)(i * 31);
+
+	TEST_CHECK(GLShaderCache::WriteFile(path, key, 0x8741, binary));
+	TEST_CHECK(!std::filesystem::exists(path + ".tmp"));
+
+	uint32_t format = 0;
+	std::vector<uint8_t> loaded;
+	TEST_CHECK(GLShaderCache::ReadFile(path, key, format, loaded));
+	TEST_CHECK(format == 0x8741 && loaded == binary);
+
+	// Another key.
+	TEST_CHECK(!GLShaderCache::ReadFile(path, key + 1, format, loaded));
+
+	// Missing file.
+	TEST_CHECK(!GLShaderCache::ReadFile(dir + "/missing.bin", key, format, loaded));
+
+	const std::vector<char> file = ReadTestFile(path);
+
+	// Another version, stored after the magic.
+	std::vector<char> badFile = file;
+	badFile[4] ^= 0x7F;
+	WriteTestFile(path, badFile);
+	TEST_CHECK(!GLShaderCache::ReadFile(path, key, format, loaded));
+
+	// Corrupted binary.
+	badFile = file;
+	badFile[badFile.size() - 10] ^= 0x01;
+	WriteTestFile(path, badFile);
+	TEST_CHECK(!GLShaderCache::ReadFile(path, key, format, loaded));
+	TEST_CHECK(loaded.empty());
+
+	// Truncated binary.
+	badFile = file;
+	badFile.resize(badFile.size() - 1);
+	WriteTestFile(path, badFile);
+	TEST_CHECK(!GLShaderCache::ReadFile(path, key, format, loaded));
+
+	std::filesystem::remove_all(dir);
+}
+
+
+RAVEN_TEST(GLShaderCache_FailedWriteLeavesNoTemporaryFile)
+{
+	const std::string dir = MakeTestDirectory("GLShaderCacheFail");
+	const uint64_t key = 42;
+	const std::string path = GLShaderCache::GetFilePath(dir, key);
+
+	// A non-empty directory in place of the file, renaming the temporary file over it fails.
+	std::filesystem::create_directories(path + "/blocker");
+
+	std::vector<uint8_t> binary(64, 7);
+	TEST_CHECK(!GLShaderCache::WriteFile(path, key, 1, binary));
+	TEST_CHECK(!std::filesystem::exists(path + ".tmp"));
+
+	// A missing directory fails without creating anything.
+	TEST_CHECK(!GLShaderCache::WriteFile(dir + "/missing/file.bin", key, 1, binary));
+	TEST_CHECK(!std::filesystem::exists(dir + "/missing"));
+
+	std::filesystem::remove_all(dir);
+}
@@ -0,0 +1,149 @@
+/*
+ * Developed by Raven Group at the University  of Leeds
+ * Copyright (C) 2021 Ammar Herzallah, Ben Husle, Thomas Moreno Cooper, Sulagna Sinha & Tian Zeng
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3 of the License.
+ *
+ * THIS PROGRAM IS DISTRIBUTED IN THE HOPE THAT IT WILL BE USEFUL,
+ * BUT WITHOUT ANY WARRANTY; WITHOUT EVEN THE IMPLIED WARRANTY OF
+ * MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE.  SEE THE
+ * GNU GENERAL PUBLIC LICENSE FOR MORE DETAILS.
+ */
+#include "RavenTest.h"
+
+#include "Render/RenderObjects/RenderFrameArena.h"
+#include "Render/RenderObjects/RenderScene.h"
+#include "Scene/Scene.h"
+#include "Scene/Entity/Entity.h"
+#include "Scene/Component/Transform.h"
+#include "Scene/Component/MeshComponent.h"
+#include "Scene/Component/Light.h"
+#include "ResourceManager/MeshFactory.h"
+#include "ResourceManager/Resources/Mesh.h"
+
+#include <glm/gtc/matrix_transform.hpp>
+
+
+#include <memory>
+
+
+
+using namespace Raven;
+
+
+
+
+// An over-aligned type, allocated with the aligned operator new.
+struct alignas(64) AlignedTestData
+{
+	float values[16];
+};
+
+
+// A small scene: a grid of cubes lit by the sun & point lights, some of them outside the view.
+static Scene* CreateTestScene()
+{
+	Scene* scene = new Scene("RenderFrameArenaTest");
+	scene->GetGlobalSettings().isSun = true;
+
+	Ptr<Mesh> cube = MeshFactory::GetBasicShape(EBasicShape::Cube);
+
+	for (int32_t x = -8; x < 8; ++x)
+	{
+		for (int32_t z = -8; z < 8; ++z)
+		{
+			auto entity = scene->CreateEntity("Cube");
+			auto& tr = entity.GetOrAddComponent<Transform>();
+			tr.SetPosition(glm::vec3(x * 4.0f, 0.0f, z * 4.0f - 40.0f));
+
+			auto& model = entity.GetOrAddComponent<MeshComponent>();
+			model.SetMesh(cube);
+		}
+	}
+
+	for (int32_t i = 0; i < 16; ++i)
+	{
+		auto entity = scene->CreateEntity("Light");
+		auto& tr = entity.GetOrAddComponent<Transform>();
+		tr.SetPosition(glm::vec3((i % 4) * 8.0f - 16.0f, 2.0f, (i / 4) * 8.0f - 56.0f));
+
+		auto& light = entity.GetOrAddComponent<Light>();
+		light.type = (int32_t)LightType::PointLight;
+		light.radius = 10.0f;
+	}
+
+	return scene;
+}
+
+
+// Build & clear a frame of the scene the way the render module does.
+static void BuildTestFrame(RenderScene& rscene, Scene* scene)
+{
+	rscene.SetView(glm::lookAt(glm::vec3(0.0f, 10.0f, 0.0f), glm::vec3(0.0f, 0.0f, -40.0f), glm::vec3(0.0f, 1.0f, 0.0f)));
+	rscene.SetProjection(glm::perspective(glm::radians(45.0f), 16.0f / 9.0f, 1.0f, 1000.0f), glm::radians(45.0f), 16.0f / 9.0f, 1.0f, 1000.0f);
+	rscene.Build(scene);
+}
+
+
+
+
+RAVEN_TEST(RenderFrameArena_NoHeapAllocationsInSteadyState)
+{
+	Test::InitializeEngine();
+
+	// The heap counter sees aligned allocations too.
+	uint64_t heapAllocations = Test::GetHeapAllocations();
+	std::unique_ptr<AlignedTestData> aligned(new AlignedTestData());
+	TEST_CHECK(Test::GetHeapAllocations() == heapAllocations + 1);
+
+	std::unique_ptr<Scene> scene(CreateTestScene());
+	std::unique_ptr<RenderScene> rscene(new RenderScene());
+	rscene->Setup();
+
+	// Warm up, the arena & containers grow to fit the frame.
+	for (uint32_t frame = 0; frame < 3; ++frame)
+	{
+		BuildTestFrame(*rscene, scene.get());
+		rscene->Clear();
+	}
+
+	TEST_CHECK(rscene->GetFrameArena().GetTotalHeapAllocations() > 0);
+
+	// Steady state, no allocation from the heap nor by the arena.
+	for (uint32_t frame = 3; frame < 30; ++frame)
+	{
+		heapAllocations = Test::GetHeapAllocations();
+		BuildTestFrame(*rscene, scene.get());
+
+		TEST_CHECK(rscene->GetFrameArena().GetFrameHeapAllocations() == 0);
+		TEST_CHECK(!rscene->GetLights().empty());
+		TEST_CHECK(rscene->GetStats().lodPrimitives[0] > 0);
+
+		rscene->Clear();
+		TEST_CHECK(Test::GetHeapAllocations() == heapAllocations);
+	}
+}
+
+
+RAVEN_TEST(RenderFrameArena_AlignedAllocations)
+{
+	RenderFrameArena arena(256);
+
+	for (uint32_t i = 0; i < 100; ++i)
+	{
+		size_t alignment = (size_t)1 << (i % 7);
+		uint8_t* mem = (uint8_t*)arena.Allocate(1 + i % 13, alignment);
+		TEST_CHECK(((uintptr_t)mem & (alignment - 1)) == 0);
+	}
+
+	// Allocation bigger than a block.
+	void* big = arena.Allocate(4096, 16);
+	TEST_CHECK(big != nullptr);
+	TEST_CHECK(arena.GetCapacity() >= 4096);
+
+	arena.Reset();
+	TEST_CHECK(arena.GetUsedSize() == 0);
+	TEST_CHECK(arena.GetFrameHeapAllocations() == 0);
+}
@@ -0,0 +1,161 @@
+/*
+ * Developed by Raven Group at the University  of Leeds
+ * Copyright (C) 2021 Ammar Herzallah, Ben Husle, Thomas Moreno Cooper, Sulagna Sinha & Tian Zeng
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3 of the License.
+ *
+ * THIS PROGRAM IS DISTRIBUTED IN THE HOPE THAT IT WILL BE USEFUL,
+ * BUT WITHOUT ANY WARRANTY; WITHOUT EVEN THE IMPLIED WARRANTY OF
+ * MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE.  SEE THE
+ * GNU GENERAL PUBLIC LICENSE FOR MORE DETAILS.
+ */
+#include "RavenTest.h"
+
+#include "Render/RenderObjects/RenderLightClusters.h"
+#include "Render/RenderObjects/RenderLight.h"
+
+
+#include "glm/gtc/matrix_transform.hpp"
+
+#include <vector>
+#include <algorithm>
+
+
+
+using namespace Raven;
+
+
+
+
+// The view & projection the tests build the clusters with, the view is the identity so world space is view space.
+static const float TEST_NEAR = 0.1f;
+static const float TEST_FAR = 500.0f;
+static const float TEST_FOV = glm::radians(60.0f);
+static const float TEST_ASPECT = 16.0f / 9.0f;
+
+
+// Lights scattered in front of the view, some partially outside the frustum.
+static void MakeTestLights(std::vector<RenderLight>& lights, uint32_t count)
+{
+	lights.resize(count);
+	uint32_t state = 0x2545F491u;
+
+	auto random = [&](float min, float max)
+	{
+		state = state * 1664525u + 1013904223u;
+		return min + (max - min) * (float)(state >> 8) / (float)(1u << 24);
+	};
+
+	for (uint32_t i = 0; i < count; ++i)
+	{
+		RenderLight& light = lights[i];
+		float depth = random(0.5f, 120.0f);
+		light.SetType(i % 3 == 0 ? ERenderLightType::Spot : ERenderLightType::Point);
+		light.postion = glm::vec3(random(-1.2f, 1.2f) * depth, random(-0.8f, 0.8f) * depth, -depth);
+		light.dir = glm::vec3(0.0f, 0.0f, -1.0f);
+		light.radius = random(0.5f, 10.0f);
+		light.innerAngle = 0.0f;
+		light.outerAngle = 0.0f;
+		light.colorAndPower = glm::vec4(1.0f);
+	}
+}
+
+
+// Return true if the cluster cell has the light.
+static bool IsInCell(const RenderLightClusters& clusters, uint32_t cluster, uint32_t light)
+{
+	const glm::uvec2& cell = clusters.GetCells()[cluster];
+	const uint32_t* begin = clusters.GetIndices().data() + cell.x;
+	return std::find(begin, begin + cell.y, light) != begin + cell.y;
+}
+
+
+
+
+RAVEN_TEST(RenderLightClusters_PointsGetAllTheirLights)
+{
+	std::vector<RenderLight> lightsData;
+	MakeTestLights(lightsData, 300);
+
+	std::vector<RenderLight*> lights;
+
+	for (auto& light : lightsData)
+		lights.push_back(&light);
+
+	glm::mat4 projection = glm::perspective(TEST_FOV, TEST_ASPECT, TEST_NEAR, TEST_FAR);
+	RenderLightClusters clusters;
+	clusters.Build(lights, glm::mat4(1.0f), projection, TEST_NEAR, TEST_FAR);
+
+	TEST_CHECK(clusters.GetLights().size() == lights.size());
+	TEST_CHECK(clusters.GetCells().size() == RenderLightClusters::GetNumClusters());
+
+	// Every light of a cluster is listed once in increasing order, the same order as the lights.
+	for (const auto& cell : clusters.GetCells())
+	{
+		TEST_CHECK(cell.x + cell.y <= clusters.GetIndices().size());
+
+		for (uint32_t i = 1; i < cell.y; ++i)
+			TEST_CHECK(clusters.GetIndices()[cell.x + i - 1] < clusters.GetIndices()[cell.x + i]);
+	}
+
+	// Points on a grid of the view, the cluster of each point must have all the lights that reach it.
+	const glm::vec2 tanHalfFov(glm::tan(TEST_FOV * 0.5f) * TEST_ASPECT, glm::tan(TEST_FOV * 0.5f));
+	uint32_t numTested = 0;
+
+	for (float depth = 0.2f; depth < 140.0f; depth *= 1.07f)
+	{
+		for (float ny = -0.99f; ny < 1.0f; ny += 0.0625f)
+		{
+			for (float nx = -0.99f; nx < 1.0f; nx += 0.0625f)
+			{
+				glm::vec3 pos(nx * depth * tanHalfFov.x, ny * depth * tanHalfFov.y, -depth);
+				uint32_t cluster = clusters.GetClusterIndex(glm::vec2(nx, ny), depth);
+
+				for (uint32_t i = 0; i < (uint32_t)lightsData.size(); ++i)
+				{
+					if (glm::length(pos - lightsData[i].postion) > lightsData[i].radius * 0.999f)
+						continue;
+
+					TEST_CHECK(IsInCell(clusters, cluster, i));
+					++numTested;
+				}
+			}
+		}
+	}
+
+	TEST_CHECK(numTested > 1000);
+}
+
+
+RAVEN_TEST(RenderLightClusters_DirectionalAndHiddenLights)
+{
+	RenderLight lightsData[3];
+
+	// Directional light, in all the clusters.
+	lightsData[0].SetType(ERenderLightType::Directional);
+	lightsData[0].dir = glm::vec3(0.0f, -1.0f, 0.0f);
+
+	// Point lights behind the view & past the far plane, in none of the clusters.
+	lightsData[1].SetType(ERenderLightType::Point);
+	lightsData[1].postion = glm::vec3(0.0f, 0.0f, 20.0f);
+	lightsData[1].radius = 5.0f;
+	lightsData[2].SetType(ERenderLightType::Point);
+	lightsData[2].postion = glm::vec3(0.0f, 0.0f, -TEST_FAR - 20.0f);
+	lightsData[2].radius = 5.0f;
+
+	std::vector<RenderLight*> lights = { &lightsData[0], &lightsData[1], &lightsData[2] };
+
+	glm::mat4 projection = glm::perspective(TEST_FOV, TEST_ASPECT, TEST_NEAR, TEST_FAR);
+	RenderLightClusters clusters;
+	clusters.Build(lights, glm::mat4(1.0f), projection, TEST_NEAR, TEST_FAR);
+
+	TEST_CHECK(clusters.GetIndices().size() == RenderLightClusters::GetNumClusters());
+
+	for (uint32_t c = 0; c < RenderLightClusters::GetNumClusters(); ++c)
+	{
+		TEST_CHECK(clusters.GetCells()[c].y == 1);
+		TEST_CHECK(IsInCell(clusters, c, 0));
+	}
+}
@@ -0,0 +1,58 @@
+/*
+ * Developed by Raven Group at the University  of Leeds
+ * Copyright (C) 2021 Ammar Herzallah, Ben Husle, Thomas Moreno Cooper, Sulagna Sinha & Tian Zeng
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3 of the License.
+ *
+ * THIS PROGRAM IS DISTRIBUTED IN THE HOPE THAT IT WILL BE USEFUL,
+ * BUT WITHOUT ANY WARRANTY; WITHOUT EVEN THE IMPLIED WARRANTY OF
+ * MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE.  SEE THE
+ * GNU GENERAL PUBLIC LICENSE FOR MORE DETAILS.
+ */
+#include "RavenTest.h"
+
+#include "Render/RenderObjects/RenderLightGrid.h"
+#include "Render/RenderObjects/RenderLight.h"
+
+
+#include <vector>
+
+
+
+using namespace Raven;
+
+
+
+
+RAVEN_TEST(RenderLightGrid_HugeLightsAndQueries)
+{
+	RenderLight lightsData[3];
+
+	// A small light, a huge light & a light far away, their cell counts overflow an int32.
+	const glm::vec3 positions[3] = { glm::vec3(5.0f), glm::vec3(0.0f), glm::vec3(3.0e9f, 0.0f, 0.0f) };
+	const float radii[3] = { 2.0f, 1.0e8f, 10.0f };
+
+	for (uint32_t i = 0; i < 3; ++i)
+	{
+		lightsData[i].SetType(ERenderLightType::Point);
+		lightsData[i].postion = positions[i];
+		lightsData[i].radius = radii[i];
+		lightsData[i].colorAndPower = glm::vec4(1.0f);
+	}
+
+	std::vector<RenderLight*> lights = { &lightsData[0], &lightsData[1], &lightsData[2] };
+
+	RenderLightGrid grid;
+	grid.Build(lights);
+
+	// Small query, the small & the huge light.
+	uint32_t found[8];
+	uint32_t count = grid.Gather(glm::vec3(5.0f), 1.0f, found, 8);
+	TEST_CHECK(count == 2);
+
+	// Huge query, all the lights are tested.
+	count = grid.Gather(glm::vec3(0.0f), 1.0e10f, found, 8);
+	TEST_CHECK(count == 3);
+}
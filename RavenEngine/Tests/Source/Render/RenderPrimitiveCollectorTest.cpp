@@ -0,0 +1,119 @@
+/*
+ * Developed by Raven Group at the University  of Leeds
+ * Copyright (C) 2021 Ammar Herzallah, Ben Husle, Thomas Moreno Cooper, Sulagna Sinha & Tian Zeng
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3 of the License.
+ *
+ * THIS PROGRAM IS DISTRIBUTED IN THE HOPE THAT IT WILL BE USEFUL,
+ * BUT WITHOUT ANY WARRANTY; WITHOUT EVEN THE IMPLIED WARRANTY OF
+ * MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE.  SEE THE
+ * GNU GENERAL PUBLIC LICENSE FOR MORE DETAILS.
+ */
+#include "RavenTest.h"
+
+#include "Render/RenderObjects/RenderPrimitiveCollector.h"
+#include "ResourceManager/Resources/Mesh.h"
+
+
+#include <vector>
+
+
+
+using namespace Raven;
+
+
+
+
+// A mesh with LOD_1 displayed at 10 & LOD_2 displayed at 20, the sections are never drawn.
+static Ptr<Mesh> CreateTestLODMesh()
+{
+	Ptr<Mesh> mesh(new Mesh());
+	mesh->AddMeshSection(Ptr<MeshSection>(new MeshSection()));
+	mesh->AddNewLOD({ Ptr<MeshSection>(new MeshSection()) }, 10.0f);
+	mesh->AddNewLOD({ Ptr<MeshSection>(new MeshSection()) }, 20.0f);
+
+	return mesh;
+}
+
+
+
+
+RAVEN_TEST(RenderPrimitiveCollector_LODDoesNotFlipAroundAThreshold)
+{
+	Ptr<Mesh> mesh = CreateTestLODMesh();
+	RenderPrimitiveCollector collector(nullptr);
+
+	// The view distance moves back & forth across the LOD_1 distance every frame.
+	const float kDistances[2] = { 9.5f, 10.5f };
+
+	// Coming from LOD_0, stays at LOD_0 until the distance leaves the hysteresis band.
+	uint32_t level = 0;
+	uint32_t numChanges = 0;
+
+	for (uint32_t frame = 0; frame < 100; ++frame)
+	{
+		collector.SetViewDistance(kDistances[frame % 2]);
+		uint32_t newLevel = collector.SelectLOD(mesh.get(), level);
+		numChanges += newLevel != level ? 1 : 0;
+		level = newLevel;
+	}
+
+	TEST_CHECK(level == 0);
+	TEST_CHECK(numChanges == 0);
+
+	// Moving away switches to LOD_1, then it stays at LOD_1 while moving back & forth.
+	collector.SetViewDistance(12.0f);
+	level = collector.SelectLOD(mesh.get(), level);
+	TEST_CHECK(level == 1);
+
+	for (uint32_t frame = 0; frame < 100; ++frame)
+	{
+		collector.SetViewDistance(kDistances[frame % 2]);
+		uint32_t newLevel = collector.SelectLOD(mesh.get(), level);
+		numChanges += newLevel != level ? 1 : 0;
+		level = newLevel;
+	}
+
+	TEST_CHECK(level == 1);
+	TEST_CHECK(numChanges == 0);
+
+	// Getting closer than the band switches back to LOD_0.
+	collector.SetViewDistance(8.0f);
+	TEST_CHECK(collector.SelectLOD(mesh.get(), level) == 0);
+
+	// Far away goes straight to the last LOD, and unknown distances use LOD_0.
+	collector.SetViewDistance(1000.0f);
+	TEST_CHECK(collector.SelectLOD(mesh.get(), 0) == 2);
+
+	collector.SetViewDistance(-1.0f);
+	TEST_CHECK(collector.SelectLOD(mesh.get(), 2) == 0);
+}
+
+
+RAVEN_TEST(RenderPrimitiveCollector_LODBiasShiftsTheSelectedLOD)
+{
+	Ptr<Mesh> mesh = CreateTestLODMesh();
+	RenderPrimitiveCollector collector(nullptr);
+	collector.SetViewDistance(8.0f);
+
+	// No bias.
+	collector.SetLODBias(1.0f);
+	TEST_CHECK(collector.SelectLOD(mesh.get(), 0) == 0);
+
+	// Higher bias selects lower details at the same distance.
+	collector.SetLODBias(2.0f);
+	TEST_CHECK(collector.SelectLOD(mesh.get(), 0) == 1);
+
+	collector.SetLODBias(3.0f);
+	TEST_CHECK(collector.SelectLOD(mesh.get(), 0) == 2);
+
+	// Lower bias keeps higher details farther away.
+	collector.SetViewDistance(15.0f);
+	collector.SetLODBias(1.0f);
+	TEST_CHECK(collector.SelectLOD(mesh.get(), 0) == 1);
+
+	collector.SetLODBias(0.5f);
+	TEST_CHECK(collector.SelectLOD(mesh.get(), 1) == 0);
+}
@@ -0,0 +1,163 @@
+/*
+ * Developed by Raven Group at the University  of Leeds
+ * Copyright (C) 2021 Ammar Herzallah, Ben Husle, Thomas Moreno Cooper, Sulagna Sinha & Tian Zeng
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3 of the License.
+ *
+ * THIS PROGRAM IS DISTRIBUTED IN THE HOPE THAT IT WILL BE USEFUL,
+ * BUT WITHOUT ANY WARRANTY; WITHOUT EVEN THE IMPLIED WARRANTY OF
+ * MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE.  SEE THE
+ * GNU GENERAL PUBLIC LICENSE FOR MORE DETAILS.
+ */
+#include "RavenTest.h"
+
+#include "Render/RenderObjects/RenderRadixSort.h"
+
+
+#include <vector>
+#include <algorithm>
+#include <cstdlib>
+#include <cstdio>
+
+
+
+using namespace Raven;
+
+
+
+
+// An element sorted by a 64-bit key like the batch draws, the value checks the sort is stable.
+struct TestSortElem
+{
+	uint64_t key;
+	uint32_t value;
+};
+
+
+// Fill elements with keys made like the draw keys, few shaders & materials with random depths.
+static void MakeTestElems(std::vector<TestSortElem>& elems, uint32_t count, uint32_t seed)
+{
+	elems.resize(count);
+	uint32_t state = seed;
+
+	for (uint32_t i = 0; i < count; ++i)
+	{
+		state = state * 1664525u + 1013904223u;
+		uint64_t shader = (state >> 8) % 16;
+		uint64_t material = (state >> 12) % 256;
+		uint64_t depth = (state >> 16) % 1024;
+
+		elems[i].key = (shader << 48) | (material << 32) | depth;
+		elems[i].value = i;
+	}
+}
+
+
+// Return true if both lists have the same keys & values in the same order.
+static bool IsSameOrder(const std::vector<TestSortElem>& a, const std::vector<TestSortElem>& b)
+{
+	if (a.size() != b.size())
+		return false;
+
+	for (size_t i = 0; i < a.size(); ++i)
+	{
+		if (a[i].key != b[i].key || a[i].value != b[i].value)
+			return false;
+	}
+
+	return true;
+}
+
+
+// qsort comparison of two elements.
+static int CompareTestElems(const void* a, const void* b)
+{
+	uint64_t ka = ((const TestSortElem*)a)->key;
+	uint64_t kb = ((const TestSortElem*)b)->key;
+	return ka < kb ? -1 : (ka > kb ? 1 : 0);
+}
+
+
+
+
+RAVEN_TEST(RenderRadixSort_StableForAllSizes)
+{
+	std::vector<TestSortElem> elems, expected, scratch;
+	const uint32_t sizes[] = { 0, 1, 2, 3, 17, RENDER_RADIX_SORT_MIN_ELEMENTS - 1, RENDER_RADIX_SORT_MIN_ELEMENTS, 1000, 20000 };
+
+	for (uint32_t size : sizes)
+	{
+		MakeTestElems(elems, size, size + 1);
+		expected = elems;
+		std::stable_sort(expected.begin(), expected.end(), [](const TestSortElem& a, const TestSortElem& b) { return a.key < b.key; });
+
+		RenderRadixSort(elems, scratch);
+		TEST_CHECK(IsSameOrder(elems, expected));
+	}
+}
+
+
+RAVEN_TEST(RenderRadixSort_SmallListsDontAllocate)
+{
+	std::vector<TestSortElem> elems, scratch;
+	MakeTestElems(elems, RENDER_RADIX_SORT_MIN_ELEMENTS - 1, 7);
+
+	uint64_t allocations = Test::GetHeapAllocations();
+	RenderRadixSort(elems, scratch);
+	TEST_CHECK(Test::GetHeapAllocations() == allocations);
+	TEST_CHECK(scratch.capacity() == 0);
+}
+
+
+RAVEN_BENCHMARK(RenderRadixSort_VsQsort)
+{
+	const uint32_t sizes[] = { 1000, 10000, 100000 };
+	std::vector<TestSortElem> source, elems, scratch;
+
+	for (uint32_t size : sizes)
+	{
+		MakeTestElems(source, size, 13);
+		const uint32_t numRepeats = 10000000 / size;
+
+		// qsort.
+		double start = Test::GetTimeMs();
+
+		for (uint32_t r = 0; r < numRepeats; ++r)
+		{
+			elems = source;
+			qsort(elems.data(), elems.size(), sizeof(TestSortElem), &CompareTestElems);
+			Test::DoNotOptimize(elems.data());
+		}
+
+		double qsortMs = (Test::GetTimeMs() - start) / numRepeats;
+
+		// std::sort.
+		start = Test::GetTimeMs();
+
+		for (uint32_t r = 0; r < numRepeats; ++r)
+		{
+			elems = source;
+			std::sort(elems.begin(), elems.end(), [](const TestSortElem& a, const TestSortElem& b) { return a.key < b.key; });
+			Test::DoNotOptimize(elems.data());
+		}
+
+		double stdSortMs = (Test::GetTimeMs() - start) / numRepeats;
+
+		// Radix, the scratch is reused like the batches do.
+		start = Test::GetTimeMs();
+
+		for (uint32_t r = 0; r < numRepeats; ++r)
+		{
+			elems = source;
+			RenderRadixSort(elems, scratch);
+			Test::DoNotOptimize(elems.data());
+		}
+
+		double radixMs = (Test::GetTimeMs() - start) / numRepeats;
+
+		printf("  %6u elements: qsort %.3f ms, std::sort %.3f ms, radix %.3f ms, %.2fx vs qsort\n",
+			size, qsortMs, stdSortMs, radixMs, qsortMs / radixMs);
+	}
+}
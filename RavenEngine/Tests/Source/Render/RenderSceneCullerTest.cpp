@@ -0,0 +1,202 @@
+/*
+ * Developed by Raven Group at the University  of Leeds
+ * Copyright (C) 2021 Ammar Herzallah, Ben Husle, Thomas Moreno Cooper, Sulagna Sinha & Tian Zeng
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3 of the License.
+ *
+ * THIS PROGRAM IS DISTRIBUTED IN THE HOPE THAT IT WILL BE USEFUL,
+ * BUT WITHOUT ANY WARRANTY; WITHOUT EVEN THE IMPLIED WARRANTY OF
+ * MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE.  SEE THE
+ * GNU GENERAL PUBLIC LICENSE FOR MORE DETAILS.
+ */
+#include "RavenTest.h"
+
+#include "Render/RenderObjects/RenderSceneCuller.h"
+#include "Render/RenderObjects/RenderShadow.h"
+
+
+#include "glm/gtc/matrix_transform.hpp"
+
+#include <omp.h>
+#include <vector>
+#include <cstdio>
+
+
+
+using namespace Raven;
+
+
+
+
+// Synthetic scene of primitives scattered on a square grid around the view, each with its own matrix.
+struct TestCullScene
+{
+	std::vector<glm::mat4> matrices;
+	MathUtils::BoundingBox localBounds;
+	std::vector<ScenePrimitiveData> primitives;
+	MathUtils::Frustum frustum;
+	glm::vec3 viewPos;
+
+	TestCullScene(uint32_t count)
+		: localBounds(glm::vec3(-1.0f), glm::vec3(1.0f))
+		, viewPos(0.0f, 2.0f, 0.0f)
+	{
+		const uint32_t side = (uint32_t)glm::ceil(glm::sqrt((float)count));
+		matrices.resize(count);
+		primitives.resize(count);
+
+		for (uint32_t i = 0; i < count; ++i)
+		{
+			glm::vec3 pos((float)(i % side) - side * 0.5f, 0.0f, (float)(i / side) - side * 0.5f);
+			matrices[i] = glm::translate(glm::mat4(1.0f), pos * 4.0f);
+
+			ScenePrimitiveData& prim = primitives[i];
+			prim.tr = nullptr;
+			prim.comp = nullptr;
+			prim.worldMatrix = &matrices[i];
+			prim.localBounds = &localBounds;
+			prim.clipDistance = (i % 7) == 0 ? 300.0f : 0.0f;
+			prim.isCastShadow = true;
+		}
+
+		glm::mat4 proj = glm::perspective(glm::radians(60.0f), 16.0f / 9.0f, 0.1f, 2000.0f);
+		glm::mat4 view = glm::lookAt(viewPos, viewPos + glm::vec3(1.0f, 0.0f, 1.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+		frustum = MathUtils::Frustum(proj * view);
+	}
+};
+
+
+
+
+RAVEN_TEST(RenderSceneCuller_SameResultForAnyThreadCount)
+{
+	TestCullScene scene(20000);
+	const int32_t maxThreads = omp_get_max_threads();
+
+	RenderSceneCuller reference;
+	omp_set_num_threads(1);
+	reference.Cull(scene.primitives, scene.viewPos, scene.frustum, nullptr);
+
+	RenderSceneCuller culler;
+	omp_set_num_threads(glm::max(maxThreads, 4));
+	culler.Cull(scene.primitives, scene.viewPos, scene.frustum, nullptr);
+	omp_set_num_threads(maxThreads);
+
+	const std::vector<ScenePrimitiveCullData>& a = reference.GetVisible();
+	const std::vector<ScenePrimitiveCullData>& b = culler.GetVisible();
+	TEST_CHECK(!a.empty() && a.size() < scene.primitives.size());
+	TEST_CHECK(a.size() == b.size());
+
+	for (size_t i = 0; i < a.size(); ++i)
+	{
+		TEST_CHECK(a[i].index == b[i].index);
+		TEST_CHECK(a[i].viewDist2 == b[i].viewDist2);
+		TEST_CHECK(!a[i].isViewCulled && a[i].shadowMask == 0);
+	}
+}
+
+
+RAVEN_TEST(RenderSceneCuller_OffscreenShadowCasterIsKept)
+{
+	// The shadow maps need a render context.
+	Test::InitializeEngine();
+
+	const glm::vec3 viewPos(0.0f, 2.0f, 0.0f);
+	const glm::mat4 view = glm::lookAt(viewPos, viewPos + glm::vec3(1.0f, 0.0f, 1.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+	const glm::mat4 proj = glm::perspective(glm::radians(60.0f), 16.0f / 9.0f, 0.1f, 2000.0f);
+	const MathUtils::Frustum frustum(proj * view);
+
+	// The sun is behind the view, a caster behind the view shadows the ground in front of it.
+	const glm::vec3 sunDir = glm::normalize(glm::vec3(1.0f, -1.0f, 1.0f));
+	const glm::vec3 groundPos(8.0f, 0.0f, 8.0f);
+	const glm::vec3 casterPos = groundPos - sunDir * 20.0f;
+
+	RenderShadowCascade shadow;
+	shadow.SetupCascade({ glm::ivec2(256, 256), glm::ivec2(256, 256), glm::ivec2(256, 256), glm::ivec2(256, 256) });
+	shadow.ComputeCascade(sunDir, 60.0f, 16.0f / 9.0f, 0.1f, 2000.0f, glm::inverse(view));
+
+	// A shadow caster & a non-caster at the same position outside the view, and a caster on the visible ground.
+	const glm::vec3 positions[3] = { casterPos, casterPos, groundPos };
+	const bool isCastShadow[3] = { true, false, true };
+
+	MathUtils::BoundingBox localBounds(glm::vec3(-1.0f), glm::vec3(1.0f));
+	std::vector<glm::mat4> matrices(3);
+	std::vector<ScenePrimitiveData> primitives(3);
+
+	for (uint32_t i = 0; i < 3; ++i)
+	{
+		matrices[i] = glm::translate(glm::mat4(1.0f), positions[i]);
+
+		ScenePrimitiveData& prim = primitives[i];
+		prim.tr = nullptr;
+		prim.comp = nullptr;
+		prim.worldMatrix = &matrices[i];
+		prim.localBounds = &localBounds;
+		prim.clipDistance = 0.0f;
+		prim.isCastShadow = isCastShadow[i];
+	}
+
+	float radius;
+	glm::vec3 center;
+	localBounds.Transform(matrices[0]).GetSphere(center, radius);
+	TEST_CHECK(!frustum.IsInFrustum2D(center, radius));
+	TEST_CHECK(shadow.IsInShadow(center, radius) != 0);
+
+	RenderSceneCuller culler;
+	culler.Cull(primitives, viewPos, frustum, &shadow);
+
+	// The off-screen caster is only kept for the shadow, the off-screen non-caster is culled.
+	const std::vector<ScenePrimitiveCullData>& visible = culler.GetVisible();
+	TEST_CHECK(visible.size() == 2);
+
+	if (visible.size() == 2)
+	{
+		TEST_CHECK(visible[0].index == 0);
+		TEST_CHECK(visible[0].isViewCulled);
+		TEST_CHECK(visible[0].shadowMask == shadow.IsInShadow(center, radius));
+
+		TEST_CHECK(visible[1].index == 2);
+		TEST_CHECK(!visible[1].isViewCulled && visible[1].shadowMask != 0);
+	}
+
+	// Without a sun, the off-screen caster is culled too.
+	culler.Cull(primitives, viewPos, frustum, nullptr);
+	TEST_CHECK(culler.GetVisible().size() == 1 && culler.GetVisible()[0].index == 2);
+}
+
+
+RAVEN_BENCHMARK(RenderSceneCuller_Scaling100k)
+{
+	TestCullScene scene(100000);
+	const int32_t maxThreads = omp_get_max_threads();
+	const int32_t numFrames = 50;
+	double singleMs = 0.0;
+
+	RenderSceneCuller culler;
+
+	for (int32_t threads = 1; threads <= maxThreads; threads *= 2)
+	{
+		omp_set_num_threads(threads);
+
+		// Warm up, grows the chunk lists to their steady state.
+		culler.Cull(scene.primitives, scene.viewPos, scene.frustum, nullptr);
+
+		double start = Test::GetTimeMs();
+
+		for (int32_t f = 0; f < numFrames; ++f)
+		{
+			culler.Cull(scene.primitives, scene.viewPos, scene.frustum, nullptr);
+			Test::DoNotOptimize(culler.GetVisible().data());
+		}
+
+		double frameMs = (Test::GetTimeMs() - start) / numFrames;
+		singleMs = threads == 1 ? frameMs : singleMs;
+
+		printf("  100k primitives, %2d threads: %.3f ms/frame, %.2fx, %zu visible\n",
+			threads, frameMs, singleMs / frameMs, culler.GetVisible().size());
+	}
+
+	omp_set_num_threads(maxThreads);
+}
@@ -0,0 +1,55 @@
+/*
+ * Developed by Raven Group at the University  of Leeds
+ * Copyright (C) 2021 Ammar Herzallah, Ben Husle, Thomas Moreno Cooper, Sulagna Sinha & Tian Zeng
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3 of the License.
+ *
+ * THIS PROGRAM IS DISTRIBUTED IN THE HOPE THAT IT WILL BE USEFUL,
+ * BUT WITHOUT ANY WARRANTY; WITHOUT EVEN THE IMPLIED WARRANTY OF
+ * MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE.  SEE THE
+ * GNU GENERAL PUBLIC LICENSE FOR MORE DETAILS.
+ */
+#include "RavenTest.h"
+
+#include "Render/RenderResource/RenderSortIdAllocator.h"
+
+
+#include <vector>
+#include <algorithm>
+
+
+
+using namespace Raven;
+
+
+
+
+RAVEN_TEST(RenderSortIdAllocator_RecycledIdsStayCompact)
+{
+	RenderSortIdAllocator allocator(RENDER_SORT_ID_SHADER_BITS);
+	std::vector<uint32_t> ids;
+
+	// Create & destroy many more resources than the key field can hold, with at most 1000 alive.
+	for (uint32_t i = 0; i < 50000; ++i)
+	{
+		ids.push_back(allocator.Allocate());
+
+		if (ids.size() == 1000)
+		{
+			// Destroy the oldest half.
+			for (uint32_t j = 0; j < 500; ++j)
+				allocator.Free(ids[j]);
+
+			ids.erase(ids.begin(), ids.begin() + 500);
+		}
+	}
+
+	TEST_CHECK(allocator.GetNumUsed() == (uint32_t)ids.size());
+
+	// All the ids fit the key field & the alive ones are unique.
+	std::sort(ids.begin(), ids.end());
+	TEST_CHECK(std::adjacent_find(ids.begin(), ids.end()) == ids.end());
+	TEST_CHECK(ids.back() < (1u << RENDER_SORT_ID_SHADER_BITS));
+}
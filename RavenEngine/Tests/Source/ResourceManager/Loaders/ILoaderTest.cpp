@@ -0,0 +1,370 @@
+/*
+ * Developed by Raven Group at the University  of Leeds
+ * Copyright (C) 2021 Ammar Herzallah, Ben Husle, Thomas Moreno Cooper, Sulagna Sinha & Tian Zeng
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3 of the License.
+ *
+ * THIS PROGRAM IS DISTRIBUTED IN THE HOPE THAT IT WILL BE USEFUL,
+ * BUT WITHOUT ANY WARRANTY; WITHOUT EVEN THE IMPLIED WARRANTY OF
+ * MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE.  SEE THE
+ * GNU GENERAL PUBLIC LICENSE FOR MORE DETAILS.
+ */
+#include "RavenTest.h"
+
+#include "ResourceManager/Loaders/ILoader.h"
+
+
+#include <vector>
+#include <algorithm>
+#include <string>
+#include <fstream>
+#include <filesystem>
+#include <memory>
+
+
+
+using namespace Raven;
+
+
+
+
+// Bulk data saved with SaveCompressed(), like the pixels of a texture.
+struct TestBlob
+{
+	std::vector<uint8_t> data;
+
+	template<typename Archive>
+	void save(Archive& archive) const
+	{
+		uint32_t size = (uint32_t)data.size();
+		archive(size);
+		SaveCompressed(archive, size, data.data());
+	}
+
+	template<typename Archive>
+	void load(Archive& archive)
+	{
+		uint32_t size = 0;
+		archive(size);
+		data.resize(size);
+		LoadCompressed(archive, size, data.data());
+	}
+};
+
+
+// A resource that only has a blob.
+class TestBlobResource : public IResource
+{
+public:
+	TestBlobResource()
+	{
+		type = EResourceType::RT_AnimationClip;
+	}
+
+	TestBlob blob;
+};
+
+
+// Load TestBlobResource.
+class TestBlobLoader : public ILoader
+{
+public:
+	virtual IResource* LoadResource(const ResourceHeaderInfo& info, RavenInputArchive& archive) override
+	{
+		std::unique_ptr<TestBlobResource> rsc(new TestBlobResource());
+		archive.ArchiveLoad(rsc->blob);
+		return rsc.release();
+	}
+
+	virtual void SaveResource(RavenOutputArchive& archive, IResource* Resource) override { }
+	virtual void ListResourceTypes(std::vector<EResourceType>& outRscTypes) override { }
+};
+
+
+// Read all the bytes of a file.
+static std::vector<char> ReadTestFile(const std::string& path)
+{
+	std::ifstream fs(path.c_str(), std::ios::in | std::ios::binary);
+	return std::vector<char>((std::istreambuf_iterator<char>(fs)), std::istreambuf_iterator<char>());
+}
+
+
+// Write all the bytes of a file.
+static void WriteTestFile(const std::string& path, const std::vector<char>& data)
+{
+	std::ofstream fs(path.c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+	fs.write(data.data(), data.size());
+}
+
+
+// Make data that compress about as well as texture pixels.
+static std::vector<uint8_t> MakeTestData(uint32_t size)
+{
+	std::vector<uint8_t> data(size);
+	uint32_t seed = 7;
+
+	for (uint32_t i = 0; i < size; ++i)
+	{
+		seed = seed * 1664525u + 1013904223u;
+		data[i] = (uint8_t)((i / 64) * 3 + ((seed >> 24) & 0x7));
+	}
+
+	return data;
+}
+
+
+// A clean directory for the test files.
+static std::string MakeTestDirectory(const char* name)
+{
+	std::filesystem::path dir = std::filesystem::temp_directory_path() / "RavenTests" / name;
+	std::filesystem::remove_all(dir);
+	std::filesystem::create_directories(dir);
+	return dir.string();
+}
+
+
+// Save a blob to a file with a codec.
+static void SaveTestBlob(const std::string& path, ECompressionCodec codec, const TestBlob& blob)
+{
+	RavenOutputArchive archive(path);
+	archive.codec = codec;
+	archive.ArchiveSave(blob);
+}
+
+
+// The ways a resource file is read.
+enum class ETestReadMode
+{
+	Stream,
+	Mapped,
+	Memory
+};
+
+
+// Load a blob from a file with a codec.
+static TestBlob LoadTestBlob(const std::string& path, ECompressionCodec codec, ETestReadMode mode, std::vector<uint8_t>& fileData)
+{
+	TestBlob blob;
+
+	if (mode == ETestReadMode::Memory)
+	{
+		// Read the whole file like the load worker threads do.
+		std::ifstream fs(path.c_str(), std::ios::in | std::ios::binary | std::ios::ate);
+		fileData.resize((size_t)fs.tellg());
+		fs.seekg(0, std::ios::beg);
+		fs.read((char*)fileData.data(), fileData.size());
+
+		RavenInputArchive archive(fileData.data(), fileData.size());
+		archive.codec = codec;
+		archive.ArchiveLoad(blob);
+	}
+	else
+	{
+		RavenInputArchive archive(path, mode == ETestReadMode::Mapped);
+		archive.codec = codec;
+		archive.ArchiveLoad(blob);
+	}
+
+	return blob;
+}
+
+
+static const ECompressionCodec kTestCodecs[] = { ECompressionCodec::Zlib, ECompressionCodec::ZlibChunked, ECompressionCodec::Raw };
+static const char* kTestCodecNames[] = { "Zlib", "ZlibChunked", "Raw" };
+static const ETestReadMode kTestModes[] = { ETestReadMode::Stream, ETestReadMode::Mapped, ETestReadMode::Memory };
+static const char* kTestModeNames[] = { "stream", "mapped", "memory" };
+
+
+
+
+RAVEN_TEST(ILoader_ArchivesFindTheirOwnMemoryBuffer)
+{
+	const std::vector<uint8_t> dataA(64, 1), dataB(64, 2);
+	RavenMemoryStreamBuf bufA(dataA.data(), dataA.size()), bufB(dataB.data(), dataB.size());
+	int archiveA = 0, archiveB = 0, archiveC = 0;
+
+	RavenMemoryStreamBuf::Attach(&archiveA, &bufA);
+	RavenMemoryStreamBuf::Attach(&archiveB, &bufB);
+
+	// Each archive finds its own buffer whatever the order they were attached in.
+	TEST_CHECK(RavenMemoryStreamBuf::Find(&archiveA) == &bufA);
+	TEST_CHECK(RavenMemoryStreamBuf::Find(&archiveB) == &bufB);
+	TEST_CHECK(RavenMemoryStreamBuf::Find(&archiveC) == nullptr);
+
+	RavenMemoryStreamBuf::Detach(&archiveA);
+	TEST_CHECK(RavenMemoryStreamBuf::Find(&archiveA) == nullptr);
+	TEST_CHECK(RavenMemoryStreamBuf::Find(&archiveB) == &bufB);
+
+	RavenMemoryStreamBuf::Detach(&archiveB);
+	TEST_CHECK(RavenMemoryStreamBuf::Find(&archiveB) == nullptr);
+}
+
+
+RAVEN_TEST(ILoader_CompressedDataMatchForAllCodecsAndReads)
+{
+	const std::string dir = MakeTestDirectory("ILoader");
+
+	// Several chunks & more than one streamed batch of chunks.
+	TestBlob source;
+	source.data = MakeTestData(COMPRESSION_CHUNK_SIZE * (COMPRESSION_STREAM_CHUNKS + 3) + 123);
+
+	for (uint32_t ic = 0; ic < 3; ++ic)
+	{
+		const std::string path = dir + "/" + kTestCodecNames[ic] + ".raven";
+		SaveTestBlob(path, kTestCodecs[ic], source);
+
+		for (ETestReadMode mode : kTestModes)
+		{
+			std::vector<uint8_t> fileData;
+			TestBlob blob = LoadTestBlob(path, kTestCodecs[ic], mode, fileData);
+			TEST_CHECK(blob.data == source.data);
+		}
+	}
+
+	// A file stream archive opened while a mapped archive is reading doesn't change how the mapped one reads.
+	const std::string path = dir + "/ZlibChunked.raven";
+	RavenInputArchive mapped(path, true);
+	mapped.codec = ECompressionCodec::ZlibChunked;
+	TEST_CHECK(mapped.IsMapped());
+
+	TestBlob blobStream;
+	{
+		RavenInputArchive stream(path, false);
+		stream.codec = ECompressionCodec::ZlibChunked;
+
+		TestBlob blobMapped;
+		mapped.ArchiveLoad(blobMapped);
+		stream.ArchiveLoad(blobStream);
+		TEST_CHECK(blobMapped.data == source.data);
+	}
+
+	TEST_CHECK(blobStream.data == source.data);
+}
+
+
+RAVEN_TEST(ILoader_CorruptedDataFailsTheLoad)
+{
+	const std::string dir = MakeTestDirectory("ILoaderCorrupted");
+	const uint32_t kSize = COMPRESSION_CHUNK_SIZE * 3 + 5;
+
+	TestBlobResource source;
+	source.blob.data = MakeTestData(kSize);
+
+	// A chunk count that doesn't match the size, loading it must not allocate the chunk sizes.
+	const std::string countPath = dir + "/Count.raven";
+	{
+		RavenOutputArchive archive(countPath);
+		ILoader::SaveHeader(archive, &source, ECompressionCodec::ZlibChunked);
+		uint32_t size = kSize, chunkSize = COMPRESSION_CHUNK_SIZE, numChunks = 0x7FFFFFFF;
+		archive.ArchiveSave(size);
+		archive.ArchiveSave(chunkSize);
+		archive.ArchiveSave(numChunks);
+	}
+
+	// Valid chunks with broken compressed data.
+	const std::string dataPath = dir + "/Data.raven";
+	{
+		RavenOutputArchive archive(dataPath);
+		ILoader::SaveHeader(archive, &source, ECompressionCodec::ZlibChunked);
+		archive.ArchiveSave(source.blob);
+	}
+
+	std::vector<char> bytes = ReadTestFile(dataPath);
+	bytes[bytes.size() - 100] ^= 0x5A;
+	bytes[bytes.size() / 2] ^= 0x5A;
+	WriteTestFile(dataPath, bytes);
+
+	TestBlobLoader loader;
+
+	for (const std::string& path : { countPath, dataPath })
+	{
+		for (ETestReadMode mode : kTestModes)
+		{
+			std::vector<uint8_t> fileData;
+			ResourceHeaderInfo info;
+			IResource* rsc = nullptr;
+
+			if (mode == ETestReadMode::Memory)
+			{
+				std::vector<char> pathBytes = ReadTestFile(path);
+				fileData.assign(pathBytes.begin(), pathBytes.end());
+
+				RavenInputArchive archive(fileData.data(), fileData.size());
+				rsc = loader.LoadArchive(archive, info);
+			}
+			else
+			{
+				RavenInputArchive archive(path, mode == ETestReadMode::Mapped);
+				rsc = loader.LoadArchive(archive, info);
+			}
+
+			// The header is fine, the resource is not.
+			TEST_CHECK(info.IsValid());
+			TEST_CHECK(rsc == nullptr);
+		}
+	}
+
+	// The output is cleared, never left half uncompressed.
+	std::vector<uint8_t> fileData(bytes.begin(), bytes.end());
+	RavenInputArchive archive(fileData.data(), fileData.size());
+	ResourceHeaderInfo info = ILoader::LoadHeader(archive);
+	archive.codec = info.GetCodec();
+
+	TestBlob blob;
+	bool isThrown = false;
+
+	try
+	{
+		archive.ArchiveLoad(blob);
+	}
+	catch (const cereal::Exception&)
+	{
+		isThrown = true;
+	}
+
+	TEST_CHECK(isThrown);
+	TEST_CHECK(blob.data == std::vector<uint8_t>(kSize, 0));
+}
+
+
+RAVEN_BENCHMARK(ILoader_FileRead)
+{
+	const std::string dir = MakeTestDirectory("ILoaderBench");
+	const uint32_t kSize = 64 * 1024 * 1024;
+	const uint32_t kNumRepeats = 5;
+
+	TestBlob source;
+	source.data = MakeTestData(kSize);
+
+	for (uint32_t ic = 0; ic < 3; ++ic)
+	{
+		const std::string path = dir + "/" + kTestCodecNames[ic] + ".raven";
+		SaveTestBlob(path, kTestCodecs[ic], source);
+		const double fileMB = (double)std::filesystem::file_size(path) / (1024.0 * 1024.0);
+
+		printf("  %-11s %6.1f MB file:", kTestCodecNames[ic], fileMB);
+
+		for (uint32_t im = 0; im < 3; ++im)
+		{
+			std::vector<uint8_t> fileData;
+			double bestMs = 1e9;
+
+			// Best of, the file is in the OS cache after the first read.
+			for (uint32_t r = 0; r < kNumRepeats; ++r)
+			{
+				double start = Test::GetTimeMs();
+				TestBlob blob = LoadTestBlob(path, kTestCodecs[ic], kTestModes[im], fileData);
+				Test::DoNotOptimize(blob.data.data());
+				bestMs = std::min(bestMs, Test::GetTimeMs() - start);
+			}
+
+			printf(" %s %.1f ms (%.0f MB/s)", kTestModeNames[im], bestMs, (kSize / (1024.0 * 1024.0)) / (bestMs / 1000.0));
+		}
+
+		printf("\n");
+	}
+
+	std::filesystem::remove_all(dir);
+}
@@ -0,0 +1,201 @@
+/*
+ * Developed by Raven Group at the University  of Leeds
+ * Copyright (C) 2021 Ammar Herzallah, Ben Husle, Thomas Moreno Cooper, Sulagna Sinha & Tian Zeng
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3 of the License.
+ *
+ * THIS PROGRAM IS DISTRIBUTED IN THE HOPE THAT IT WILL BE USEFUL,
+ * BUT WITHOUT ANY WARRANTY; WITHOUT EVEN THE IMPLIED WARRANTY OF
+ * MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE.  SEE THE
+ * GNU GENERAL PUBLIC LICENSE FOR MORE DETAILS.
+ */
+#include "RavenTest.h"
+
+#include "ResourceManager/Importers/OBJImporter.h"
+#include "ResourceManager/Resources/Mesh.h"
+#include "ResourceManager/MeshOptimizer.h"
+
+
+#include <vector>
+#include <string>
+#include <array>
+#include <algorithm>
+
+
+
+using namespace Raven;
+
+
+
+
+// A grid of quads where every triangle has its own three vertices, like an unindexed import.
+static Ptr<MeshSection> CreateUnweldedGrid(uint32_t size)
+{
+	Ptr<MeshSection> section(new MeshSection());
+
+	auto addVertex = [&](uint32_t x, uint32_t z)
+	{
+		section->indices.push_back((uint32_t)section->positions.size());
+		section->positions.push_back(glm::vec3((float)x, 0.0f, (float)z));
+		section->normals.push_back(glm::vec3(0.0f, 1.0f, 0.0f));
+		section->texCoords.push_back(glm::vec2((float)x / size, (float)z / size));
+	};
+
+	for (uint32_t z = 0; z < size; ++z)
+	{
+		for (uint32_t x = 0; x < size; ++x)
+		{
+			addVertex(x, z); addVertex(x, z + 1); addVertex(x + 1, z + 1);
+			addVertex(x, z); addVertex(x + 1, z + 1); addVertex(x + 1, z);
+		}
+	}
+
+	return section;
+}
+
+
+// Return the triangles as sorted lists of their vertex indices, each rotated to start at its smallest
+// index so the winding is kept.
+static std::vector< std::array<uint32_t, 3> > GetSortedTriangles(const std::vector<uint32_t>& indices)
+{
+	std::vector< std::array<uint32_t, 3> > triangles;
+
+	for (size_t i = 0; i + 2 < indices.size(); i += 3)
+	{
+		std::array<uint32_t, 3> tri = { indices[i], indices[i + 1], indices[i + 2] };
+		std::rotate(tri.begin(), std::min_element(tri.begin(), tri.end()), tri.end());
+		triangles.push_back(tri);
+	}
+
+	std::sort(triangles.begin(), triangles.end());
+	return triangles;
+}
+
+
+// Return the triangles of a section by the positions of their vertices, independent of the vertex order.
+static std::vector< std::array<float, 9> > GetSortedTrianglePositions(const MeshSection* section)
+{
+	std::vector< std::array<float, 9> > triangles;
+
+	for (size_t i = 0; i + 2 < section->indices.size(); i += 3)
+	{
+		std::array<glm::vec3, 3> v = {
+			section->positions[section->indices[i]],
+			section->positions[section->indices[i + 1]],
+			section->positions[section->indices[i + 2]]
+		};
+
+		auto isLess = [](const glm::vec3& a, const glm::vec3& b)
+		{
+			return a.x != b.x ? a.x < b.x : (a.y != b.y ? a.y < b.y : a.z < b.z);
+		};
+
+		std::rotate(v.begin(), std::min_element(v.begin(), v.end(), isLess), v.end());
+		triangles.push_back({ v[0].x, v[0].y, v[0].z, v[1].x, v[1].y, v[1].z, v[2].x, v[2].y, v[2].z });
+	}
+
+	std::sort(triangles.begin(), triangles.end());
+	return triangles;
+}
+
+
+// Shuffle the triangles of an index list with a fixed seed.
+static void ShuffleTriangles(std::vector<uint32_t>& indices)
+{
+	uint32_t seed = 12345;
+	uint32_t numTris = (uint32_t)indices.size() / 3;
+
+	for (uint32_t i = numTris - 1; i > 0; --i)
+	{
+		seed = seed * 1664525u + 1013904223u;
+		uint32_t j = seed % (i + 1);
+
+		for (uint32_t k = 0; k < 3; ++k)
+			std::swap(indices[i * 3 + k], indices[j * 3 + k]);
+	}
+}
+
+
+
+
+RAVEN_TEST(MeshOptimizer_WeldsDuplicateVertices)
+{
+	const uint32_t kSize = 8;
+	Ptr<MeshSection> section = CreateUnweldedGrid(kSize);
+	auto trianglesBefore = GetSortedTrianglePositions(section.get());
+
+	MeshOptimizerStats stats = MeshOptimizer::Optimize(section.get());
+
+	// Every grid point is shared by the triangles around it.
+	const uint32_t kNumGridVertices = (kSize + 1) * (kSize + 1);
+	TEST_CHECK(stats.numVerticesBefore == kSize * kSize * 6);
+	TEST_CHECK(stats.numVerticesAfter == kNumGridVertices);
+	TEST_CHECK(section->positions.size() == kNumGridVertices);
+	TEST_CHECK(section->normals.size() == kNumGridVertices);
+	TEST_CHECK(section->texCoords.size() == kNumGridVertices);
+
+	// Same triangles with the same winding.
+	TEST_CHECK(section->indices.size() == kSize * kSize * 6);
+	TEST_CHECK(GetSortedTrianglePositions(section.get()) == trianglesBefore);
+
+	// Vertices with a different attribute are not welded.
+	Ptr<MeshSection> seam = CreateUnweldedGrid(kSize);
+
+	for (size_t i = 0; i < seam->texCoords.size(); i += 6)
+		seam->texCoords[i].x += 0.5f;
+
+	stats = MeshOptimizer::Optimize(seam.get());
+	TEST_CHECK(stats.numVerticesAfter > kNumGridVertices);
+}
+
+
+RAVEN_TEST(MeshOptimizer_ReorderingKeepsTheTriangles)
+{
+	Ptr<MeshSection> section = CreateUnweldedGrid(16);
+	MeshOptimizer::Optimize(section.get());
+
+	std::vector<uint32_t> indices = section->indices;
+	ShuffleTriangles(indices);
+	auto trianglesBefore = GetSortedTriangles(indices);
+
+	MeshOptimizer::OptimizeIndices(indices, section->positions);
+
+	TEST_CHECK(indices.size() == section->indices.size());
+	TEST_CHECK(GetSortedTriangles(indices) == trianglesBefore);
+}
+
+
+RAVEN_TEST(MeshOptimizer_ACMRIsNotWorseOnSampleMesh)
+{
+	OBJImporter importer;
+	std::vector< Ptr<IResource> > resources;
+	TEST_CHECK(importer.Import("assets/models/Lantern/lantern.obj", resources) && resources.size() == 1);
+
+	Ptr<Mesh> mesh = std::static_pointer_cast<Mesh>(resources[0]);
+	TEST_CHECK(!mesh->GetMeshLOD(0).sections.empty());
+
+	for (const auto& section : mesh->GetMeshLOD(0).sections)
+	{
+		const uint32_t numVertices = (uint32_t)section->positions.size();
+
+		// A random triangle order gets better.
+		std::vector<uint32_t> indices = section->indices;
+		ShuffleTriangles(indices);
+		float acmrShuffled = MeshOptimizer::ComputeACMR(indices, numVertices);
+		auto trianglesBefore = GetSortedTriangles(indices);
+
+		MeshOptimizer::OptimizeIndices(indices, section->positions);
+		TEST_CHECK(MeshOptimizer::ComputeACMR(indices, numVertices) < acmrShuffled);
+		TEST_CHECK(GetSortedTriangles(indices) == trianglesBefore);
+
+		// Optimizing a whole shuffled section reports the same.
+		MeshSection shuffled = *section;
+		ShuffleTriangles(shuffled.indices);
+
+		MeshOptimizerStats stats = MeshOptimizer::Optimize(&shuffled);
+		TEST_CHECK(stats.acmrAfter <= stats.acmrBefore);
+		TEST_CHECK(stats.numVerticesAfter <= stats.numVerticesBefore);
+	}
+}
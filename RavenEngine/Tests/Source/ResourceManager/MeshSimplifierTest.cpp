@@ -0,0 +1,282 @@
+/*
+ * Developed by Raven Group at the University  of Leeds
+ * Copyright (C) 2021 Ammar Herzallah, Ben Husle, Thomas Moreno Cooper, Sulagna Sinha & Tian Zeng
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3 of the License.
+ *
+ * THIS PROGRAM IS DISTRIBUTED IN THE HOPE THAT IT WILL BE USEFUL,
+ * BUT WITHOUT ANY WARRANTY; WITHOUT EVEN THE IMPLIED WARRANTY OF
+ * MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE.  SEE THE
+ * GNU GENERAL PUBLIC LICENSE FOR MORE DETAILS.
+ */
+#include "RavenTest.h"
+
+#include "ResourceManager/Importers/OBJImporter.h"
+#include "ResourceManager/Resources/Mesh.h"
+#include "ResourceManager/MeshSimplifier.h"
+
+
+#include <vector>
+#include <string>
+#include <cstring>
+#include <map>
+#include <tuple>
+#include <algorithm>
+
+
+
+using namespace Raven;
+
+
+
+
+// The sample meshes bundled with the game project, relative to the gameProject folder.
+static const char* TEST_SAMPLE_MESHES[] = {
+	"assets/models/Lantern/lantern.obj",
+	"assets/models/mallard.obj",
+	"assets/models/deer.obj"
+};
+
+
+// Import an obj mesh with its generated LODs.
+static Ptr<Mesh> ImportTestMesh(const std::string& path)
+{
+	OBJImporter importer;
+	std::vector< Ptr<IResource> > resources;
+
+	if (!importer.Import(path, resources) || resources.size() != 1)
+		return nullptr;
+
+	return std::static_pointer_cast<Mesh>(resources[0]);
+}
+
+
+// Return true if both vectors have the exact same bytes.
+template<class T>
+static bool IsSameData(const std::vector<T>& a, const std::vector<T>& b)
+{
+	return a.size() == b.size() && (a.empty() || memcmp(a.data(), b.data(), a.size() * sizeof(T)) == 0);
+}
+
+
+// Return true if both sections have the exact same vertices & indices.
+static bool IsSameSection(const MeshSection* a, const MeshSection* b)
+{
+	if (!a || !b)
+		return a == b;
+
+	return IsSameData(a->positions, b->positions)
+		&& IsSameData(a->normals, b->normals)
+		&& IsSameData(a->tangents, b->tangents)
+		&& IsSameData(a->texCoords, b->texCoords)
+		&& IsSameData(a->indices, b->indices);
+}
+
+
+// Return the number of triangles in a mesh LOD.
+static uint32_t GetNumTriangles(const MeshLOD& lod)
+{
+	uint32_t count = 0;
+
+	for (const auto& section : lod.sections)
+	{
+		if (section)
+			count += (uint32_t)section->indices.size() / 3;
+	}
+
+	return count;
+}
+
+
+// A flat grid with an open boundary, the vertices right of the middle column have their uvs shifted by one,
+// so the middle column is a uv seam with two vertices at each position.
+static Ptr<MeshSection> CreateSeamGrid(uint32_t size)
+{
+	Ptr<MeshSection> section(new MeshSection());
+	const uint32_t seamX = size / 2;
+
+	auto addVertex = [&](uint32_t x, uint32_t z, float uOffset)
+	{
+		section->positions.push_back(glm::vec3((float)x, 0.0f, (float)z));
+		section->normals.push_back(glm::vec3(0.0f, 1.0f, 0.0f));
+		section->texCoords.push_back(glm::vec2((float)x / size + uOffset, (float)z / size));
+		return (uint32_t)section->positions.size() - 1;
+	};
+
+	// The vertex of each grid point used by the quads left & right of the seam.
+	std::vector<uint32_t> leftVerts((size + 1) * (size + 1));
+	std::vector<uint32_t> rightVerts((size + 1) * (size + 1));
+
+	for (uint32_t z = 0; z <= size; ++z)
+	{
+		for (uint32_t x = 0; x <= size; ++x)
+		{
+			uint32_t i = z * (size + 1) + x;
+
+			if (x <= seamX)
+				leftVerts[i] = addVertex(x, z, 0.0f);
+
+			if (x >= seamX)
+				rightVerts[i] = addVertex(x, z, 1.0f);
+		}
+	}
+
+	for (uint32_t z = 0; z < size; ++z)
+	{
+		for (uint32_t x = 0; x < size; ++x)
+		{
+			const std::vector<uint32_t>& verts = x < seamX ? leftVerts : rightVerts;
+			uint32_t v00 = verts[z * (size + 1) + x];
+			uint32_t v10 = verts[z * (size + 1) + x + 1];
+			uint32_t v01 = verts[(z + 1) * (size + 1) + x];
+			uint32_t v11 = verts[(z + 1) * (size + 1) + x + 1];
+
+			section->indices.insert(section->indices.end(), { v00, v01, v11, v00, v11, v10 });
+		}
+	}
+
+	return section;
+}
+
+
+
+
+RAVEN_TEST(MeshSimplifier_SampleMeshLODsAreDeterministic)
+{
+	uint32_t numMeshesWithLODs = 0;
+
+	for (const char* path : TEST_SAMPLE_MESHES)
+	{
+		Ptr<Mesh> meshA = ImportTestMesh(path);
+		Ptr<Mesh> meshB = ImportTestMesh(path);
+		TEST_CHECK(meshA && meshB);
+		TEST_CHECK(meshA->GetNumLODs() == meshB->GetNumLODs());
+
+		for (uint32_t level = 0; level < meshA->GetNumLODs(); ++level)
+		{
+			MeshLOD& lodA = meshA->GetMeshLOD(level);
+			MeshLOD& lodB = meshB->GetMeshLOD(level);
+			TEST_CHECK(lodA.distance == lodB.distance);
+			TEST_CHECK(lodA.sections.size() == lodB.sections.size());
+
+			for (size_t i = 0; i < lodA.sections.size(); ++i)
+				TEST_CHECK(IsSameSection(lodA.sections[i].get(), lodB.sections[i].get()));
+
+			// Each level reduces the triangles of the previous one.
+			if (level > 0)
+			{
+				uint32_t numTriangles = GetNumTriangles(lodA);
+				TEST_CHECK(numTriangles > 0 && numTriangles < GetNumTriangles(meshA->GetMeshLOD(level - 1)));
+			}
+		}
+
+		// Simplifying the same section again gives the same result, and the same as the import if it kept the LOD.
+		const MeshLOD& lod0 = meshA->GetMeshLOD(0);
+		const bool hasLODs = meshA->GetNumLODs() > 1;
+		MeshLODSettings settings;
+
+		for (size_t i = 0; i < lod0.sections.size(); ++i)
+		{
+			const MeshSection* section = lod0.sections[i].get();
+			uint32_t target = (uint32_t)((float)(section->indices.size() / 3) * settings.triangleRatio);
+			Ptr<MeshSection> simplifiedA = MeshSimplifier::Simplify(section, target);
+			Ptr<MeshSection> simplifiedB = MeshSimplifier::Simplify(section, target);
+			TEST_CHECK(IsSameSection(simplifiedA.get(), simplifiedB.get()));
+
+			if (hasLODs)
+				TEST_CHECK(IsSameSection(simplifiedA.get(), meshA->GetMeshLOD(1).sections[i].get()));
+		}
+
+		numMeshesWithLODs += hasLODs;
+	}
+
+	// The lantern & the mallard get LODs, the low poly deer may not reduce enough to keep any.
+	TEST_CHECK(numMeshesWithLODs >= 2);
+}
+
+
+RAVEN_TEST(MeshSimplifier_BoundaryAndSeamArePreserved)
+{
+	const uint32_t kSize = 16;
+	const uint32_t seamX = kSize / 2;
+
+	Ptr<MeshSection> section = CreateSeamGrid(kSize);
+	const uint32_t numTriangles = (uint32_t)section->indices.size() / 3;
+
+	Ptr<MeshSection> simplified = MeshSimplifier::Simplify(section.get(), numTriangles / 4);
+	TEST_CHECK(simplified->indices.size() / 3 < numTriangles);
+
+	// The grid point & the side of the seam of a vertex, checking its uv wasn't taken from the other side.
+	auto getGridPoint = [&](uint32_t v, bool& outIsRight)
+	{
+		const glm::vec3& pos = simplified->positions[v];
+		const glm::vec2& uv = simplified->texCoords[v];
+		outIsRight = uv.x > 1.0f;
+
+		uint32_t x = (uint32_t)pos.x;
+		uint32_t z = (uint32_t)pos.z;
+		float expectedU = (float)x / kSize + (outIsRight ? 1.0f : 0.0f);
+
+		return (uv.x == expectedU && uv.y == (float)z / kSize && pos.y == 0.0f) ? z * (kSize + 1) + x : UINT32_MAX;
+	};
+
+	// Count the triangles of each edge, by grid points & side of the seam.
+	std::map<std::tuple<uint32_t, uint32_t, bool>, uint32_t> edgeTriangles;
+
+	for (size_t i = 0; i < simplified->indices.size(); i += 3)
+	{
+		uint32_t points[3];
+		bool isRight[3];
+
+		for (uint32_t k = 0; k < 3; ++k)
+		{
+			points[k] = getGridPoint(simplified->indices[i + k], isRight[k]);
+			TEST_CHECK(points[k] != UINT32_MAX);
+		}
+
+		// The triangles don't cross the seam.
+		TEST_CHECK(isRight[0] == isRight[1] && isRight[1] == isRight[2]);
+
+		for (uint32_t k = 0; k < 3; ++k)
+		{
+			uint32_t a = points[k];
+			uint32_t b = points[(k + 1) % 3];
+			++edgeTriangles[std::make_tuple(std::min(a, b), std::max(a, b), isRight[0])];
+		}
+	}
+
+	// Return true if the segment between two adjacent grid points is still an edge with a single triangle.
+	auto isOpenEdge = [&](uint32_t x0, uint32_t z0, uint32_t x1, uint32_t z1, bool isRight)
+	{
+		uint32_t a = z0 * (kSize + 1) + x0;
+		uint32_t b = z1 * (kSize + 1) + x1;
+		auto iter = edgeTriangles.find(std::make_tuple(std::min(a, b), std::max(a, b), isRight));
+		return iter != edgeTriangles.end() && iter->second == 1;
+	};
+
+	for (uint32_t i = 0; i < kSize; ++i)
+	{
+		// Open boundary, every segment of the grid outline is kept.
+		TEST_CHECK(isOpenEdge(i, 0, i + 1, 0, i >= seamX));
+		TEST_CHECK(isOpenEdge(i, kSize, i + 1, kSize, i >= seamX));
+		TEST_CHECK(isOpenEdge(0, i, 0, i + 1, false));
+		TEST_CHECK(isOpenEdge(kSize, i, kSize, i + 1, true));
+
+		// Seam, every segment is kept on both sides.
+		TEST_CHECK(isOpenEdge(seamX, i, seamX, i + 1, false));
+		TEST_CHECK(isOpenEdge(seamX, i, seamX, i + 1, true));
+	}
+
+	// No other open edge, the simplified grid has no holes.
+	uint32_t numOpenEdges = 0;
+
+	for (const auto& edge : edgeTriangles)
+	{
+		TEST_CHECK(edge.second <= 2);
+		numOpenEdges += edge.second == 1 ? 1 : 0;
+	}
+
+	TEST_CHECK(numOpenEdges == kSize * 6);
+}
@@ -0,0 +1,169 @@
+/*
+ * Developed by Raven Group at the University  of Leeds
+ * Copyright (C) 2021 Ammar Herzallah, Ben Husle, Thomas Moreno Cooper, Sulagna Sinha & Tian Zeng
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3 of the License.
+ *
+ * THIS PROGRAM IS DISTRIBUTED IN THE HOPE THAT IT WILL BE USEFUL,
+ * BUT WITHOUT ANY WARRANTY; WITHOUT EVEN THE IMPLIED WARRANTY OF
+ * MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE.  SEE THE
+ * GNU GENERAL PUBLIC LICENSE FOR MORE DETAILS.
+ */
+#include "RavenTest.h"
+
+#include "ResourceManager/ResourceCatalog.h"
+
+
+#include <string>
+#include <filesystem>
+#include <chrono>
+
+
+
+using namespace Raven;
+
+
+
+
+// Write a resource file with a header and some content.
+static void WriteCatalogTestFile(const std::string& path, EResourceType type, const std::string& content)
+{
+	RavenOutputArchive archive(path);
+	ResourceHeaderInfo header((int32_t)type, RAVEN_VERSION);
+	archive.ArchiveSave(header);
+	archive.ArchiveSave(content);
+}
+
+
+// Move the last write time of a file forward without changing its content.
+static void TouchCatalogTestFile(const std::string& path)
+{
+	auto mtime = std::filesystem::last_write_time(path);
+	std::filesystem::last_write_time(path, mtime + std::chrono::hours(1));
+}
+
+
+// Return the entry of a file in the catalog.
+static const ResourceCatalogEntry* FindCatalogEntry(const ResourceCatalog& catalog, const std::string& path)
+{
+	for (const auto& entry : catalog.GetEntries())
+	{
+		if (std::filesystem::path(entry.path) == std::filesystem::path(path))
+			return &entry;
+	}
+
+	return nullptr;
+}
+
+
+
+
+RAVEN_TEST(ResourceCatalog_OnlyProbesChangedFiles)
+{
+	std::filesystem::path dir = std::filesystem::temp_directory_path() / "RavenTests" / "ResourceCatalog";
+	std::filesystem::remove_all(dir);
+	std::filesystem::create_directories(dir);
+
+	const std::string catalogFile = (dir / "Catalog.bin").string();
+	const std::string rscDir = (dir / "Resources").string();
+	const std::string pathA = (dir / "Resources" / "A.raven").string();
+	const std::string pathB = (dir / "Resources" / "B.raven").string();
+	std::filesystem::create_directories(rscDir);
+
+	WriteCatalogTestFile(pathA, EResourceType::RT_Texture2D, "AAAA");
+	WriteCatalogTestFile(pathB, EResourceType::RT_Mesh, "BBBB");
+
+	// First scan, all the files are new.
+	{
+		ResourceCatalog catalog;
+		TEST_CHECK(!catalog.Load(catalogFile));
+		catalog.Scan(rscDir);
+
+		TEST_CHECK(catalog.GetNumProbed() == 2);
+		TEST_CHECK(catalog.GetEntries().size() == 2);
+		TEST_CHECK(catalog.IsDirty());
+		TEST_CHECK(catalog.Save(catalogFile));
+	}
+
+	// Unchanged files are not probed, and the catalog is not saved again.
+	{
+		ResourceCatalog catalog;
+		TEST_CHECK(catalog.Load(catalogFile));
+		catalog.Scan(rscDir);
+
+		TEST_CHECK(catalog.GetNumProbed() == 0);
+		TEST_CHECK(!catalog.IsDirty());
+
+		const ResourceCatalogEntry* entryA = FindCatalogEntry(catalog, pathA);
+		TEST_CHECK(entryA && entryA->type == (int32_t)EResourceType::RT_Texture2D);
+	}
+
+	// Size change, the file is probed and its new header is read.
+	WriteCatalogTestFile(pathA, EResourceType::RT_Material, "AAAAAAAA");
+
+	{
+		ResourceCatalog catalog;
+		TEST_CHECK(catalog.Load(catalogFile));
+		catalog.Scan(rscDir);
+
+		TEST_CHECK(catalog.GetNumProbed() == 1);
+		TEST_CHECK(catalog.IsDirty());
+
+		const ResourceCatalogEntry* entryA = FindCatalogEntry(catalog, pathA);
+		TEST_CHECK(entryA && entryA->type == (int32_t)EResourceType::RT_Material);
+		TEST_CHECK(entryA && entryA->size == (uint64_t)std::filesystem::file_size(pathA));
+		TEST_CHECK(catalog.Save(catalogFile));
+	}
+
+	// Write time only, the first time the file is probed and hashed.
+	TouchCatalogTestFile(pathB);
+
+	{
+		ResourceCatalog catalog;
+		TEST_CHECK(catalog.Load(catalogFile));
+		catalog.Scan(rscDir);
+
+		TEST_CHECK(catalog.GetNumProbed() == 1);
+
+		const ResourceCatalogEntry* entryB = FindCatalogEntry(catalog, pathB);
+		TEST_CHECK(entryB && entryB->hash != 0);
+		TEST_CHECK(catalog.Save(catalogFile));
+	}
+
+	// Write time only with the same hash, the file is not probed but its new write time is kept.
+	TouchCatalogTestFile(pathB);
+	int64_t mtimeB = (int64_t)std::filesystem::last_write_time(pathB).time_since_epoch().count();
+
+	{
+		ResourceCatalog catalog;
+		TEST_CHECK(catalog.Load(catalogFile));
+		catalog.Scan(rscDir);
+
+		TEST_CHECK(catalog.GetNumProbed() == 0);
+		TEST_CHECK(catalog.IsDirty());
+
+		const ResourceCatalogEntry* entryB = FindCatalogEntry(catalog, pathB);
+		TEST_CHECK(entryB && entryB->mtime == mtimeB);
+		TEST_CHECK(entryB && entryB->type == (int32_t)EResourceType::RT_Mesh);
+		TEST_CHECK(catalog.Save(catalogFile));
+	}
+
+	// Same size & a different content, the file is probed.
+	WriteCatalogTestFile(pathB, EResourceType::RT_Scene, "CCCC");
+	TouchCatalogTestFile(pathB);
+
+	{
+		ResourceCatalog catalog;
+		TEST_CHECK(catalog.Load(catalogFile));
+		catalog.Scan(rscDir);
+
+		TEST_CHECK(catalog.GetNumProbed() == 1);
+
+		const ResourceCatalogEntry* entryB = FindCatalogEntry(catalog, pathB);
+		TEST_CHECK(entryB && entryB->type == (int32_t)EResourceType::RT_Scene);
+	}
+
+	std::filesystem::remove_all(dir);
+}
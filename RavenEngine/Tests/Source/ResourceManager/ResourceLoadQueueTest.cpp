@@ -0,0 +1,190 @@
+/*
+ * Developed by Raven Group at the University  of Leeds
+ * Copyright (C) 2021 Ammar Herzallah, Ben Husle, Thomas Moreno Cooper, Sulagna Sinha & Tian Zeng
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3 of the License.
+ *
+ * THIS PROGRAM IS DISTRIBUTED IN THE HOPE THAT IT WILL BE USEFUL,
+ * BUT WITHOUT ANY WARRANTY; WITHOUT EVEN THE IMPLIED WARRANTY OF
+ * MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE.  SEE THE
+ * GNU GENERAL PUBLIC LICENSE FOR MORE DETAILS.
+ */
+#include "RavenTest.h"
+
+#include "ResourceManager/ResourceLoadQueue.h"
+
+
+#include <vector>
+#include <algorithm>
+#include <deque>
+#include <string>
+#include <thread>
+#include <chrono>
+#include <atomic>
+#include <filesystem>
+
+
+
+using namespace Raven;
+
+
+
+
+// A loader that takes a long time to load a resource, like a very slow disk read.
+class SlowLoader : public ILoader
+{
+public:
+	// Construct.
+	SlowLoader(uint32_t inDelayMs)
+		: delayMs(inDelayMs)
+		, numLoaded(0)
+		, maxCompressionThreads(0)
+	{
+
+	}
+
+	virtual IResource* LoadResource(const ResourceHeaderInfo& info, RavenInputArchive& archive) override
+	{
+		std::this_thread::sleep_for(std::chrono::milliseconds(delayMs));
+		maxCompressionThreads = MaxCompressionThreads();
+		++numLoaded;
+		return nullptr;
+	}
+
+	virtual bool IsThreadSafe(EResourceType rscType) const override { return true; }
+	virtual void SaveResource(RavenOutputArchive& archive, IResource* Resource) override { }
+	virtual void ListResourceTypes(std::vector<EResourceType>& outRscTypes) override { }
+
+	// The time each load takes.
+	uint32_t delayMs;
+
+	// The number of resources loaded.
+	std::atomic<uint32_t> numLoaded;
+
+	// The compression threads limit of the thread that loaded the last resource.
+	std::atomic<uint32_t> maxCompressionThreads;
+};
+
+
+// Write a resource file that only has a valid header.
+static std::string MakeTestResource()
+{
+	std::filesystem::path dir = std::filesystem::temp_directory_path() / "RavenTests" / "ResourceLoadQueue";
+	std::filesystem::remove_all(dir);
+	std::filesystem::create_directories(dir);
+
+	std::string path = (dir / "Slow.raven").string();
+	RavenOutputArchive archive(path);
+	ResourceHeaderInfo header((int32_t)EResourceType::RT_AnimationClip, RAVEN_VERSION);
+	archive.ArchiveSave(header);
+
+	return path;
+}
+
+
+
+
+RAVEN_TEST(ResourceLoadQueue_MainThreadNeverWaitsForLoads)
+{
+	const uint32_t kDelayMs = 100;
+	const uint32_t kNumRequests = 4;
+
+	const std::string path = MakeTestResource();
+	SlowLoader loader(kDelayMs);
+
+	ResourceLoadQueue queue;
+	queue.Start(2);
+
+	// LoadAsync() on the main thread only pushes the requests.
+	double maxFrameMs = 0.0;
+	double startMs = Test::GetTimeMs();
+
+	for (uint32_t i = 0; i < kNumRequests; ++i)
+	{
+		ResourceLoadRequest* request = new ResourceLoadRequest();
+		request->handle = Ptr<ResourceLoadHandle>(new ResourceLoadHandle(path));
+		request->loader = &loader;
+		request->isDeserialize = true;
+		queue.Push(request);
+	}
+
+	maxFrameMs = Test::GetTimeMs() - startMs;
+
+	// Update() on the main thread only collects the finished requests, the frames must keep
+	// going within the budget while the workers are stuck loading.
+	std::deque<ResourceLoadRequest*> finished;
+	uint32_t numFrames = 0;
+
+	while (finished.size() < kNumRequests && Test::GetTimeMs() - startMs < 10000.0)
+	{
+		double frameMs = Test::GetTimeMs();
+		queue.PopFinished(finished);
+		frameMs = Test::GetTimeMs() - frameMs;
+
+		maxFrameMs = std::max(maxFrameMs, frameMs);
+		++numFrames;
+
+		std::this_thread::sleep_for(std::chrono::milliseconds(1));
+	}
+
+	double totalMs = Test::GetTimeMs() - startMs;
+
+	TEST_CHECK(finished.size() == kNumRequests);
+	TEST_CHECK(loader.numLoaded == kNumRequests);
+	TEST_CHECK(maxFrameMs < RESOURCE_LOAD_FRAME_BUDGET);
+
+	// The loads took many frames, so the main thread really ran while they were loading.
+	TEST_CHECK(totalMs >= kDelayMs * 2);
+	TEST_CHECK(numFrames > kNumRequests);
+
+	for (auto request : finished)
+	{
+		TEST_CHECK(request->isReadSuccess);
+		delete request;
+	}
+
+	queue.Stop();
+}
+
+
+RAVEN_TEST(ResourceLoadQueue_WorkersShareTheCoresForCompression)
+{
+	const std::string path = MakeTestResource();
+	SlowLoader loader(0);
+
+	const uint32_t kNumWorkers = 4;
+	ResourceLoadQueue queue;
+	queue.Start(kNumWorkers);
+
+	ResourceLoadRequest* request = new ResourceLoadRequest();
+	request->handle = Ptr<ResourceLoadHandle>(new ResourceLoadHandle(path));
+	request->loader = &loader;
+	request->isDeserialize = true;
+	queue.Push(request);
+
+	std::deque<ResourceLoadRequest*> finished;
+	double startMs = Test::GetTimeMs();
+
+	while (finished.empty() && Test::GetTimeMs() - startMs < 10000.0)
+	{
+		queue.PopFinished(finished);
+		std::this_thread::sleep_for(std::chrono::milliseconds(1));
+	}
+
+	// The workers uncompressing in parallel never use more threads than the cores.
+	const uint32_t expectedThreads = std::max(1u, std::thread::hardware_concurrency() / kNumWorkers);
+	TEST_CHECK(finished.size() == 1);
+	TEST_CHECK(loader.maxCompressionThreads == expectedThreads);
+
+	// The main thread is not limited.
+	TEST_CHECK(MaxCompressionThreads() == 0);
+
+	for (auto request : finished)
+	{
+		delete request;
+	}
+
+	queue.Stop();
+}
@@ -0,0 +1,151 @@
+/*
+ * Developed by Raven Group at the University  of Leeds
+ * Copyright (C) 2021 Ammar Herzallah, Ben Husle, Thomas Moreno Cooper, Sulagna Sinha & Tian Zeng
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3 of the License.
+ *
+ * THIS PROGRAM IS DISTRIBUTED IN THE HOPE THAT IT WILL BE USEFUL,
+ * BUT WITHOUT ANY WARRANTY; WITHOUT EVEN THE IMPLIED WARRANTY OF
+ * MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE.  SEE THE
+ * GNU GENERAL PUBLIC LICENSE FOR MORE DETAILS.
+ */
+#include "RavenTest.h"
+
+#include "ResourceManager/ResourceManager.h"
+
+
+#include <vector>
+#include <algorithm>
+#include <string>
+#include <thread>
+#include <chrono>
+#include <filesystem>
+
+
+
+using namespace Raven;
+
+
+
+
+// A resource with no render resources.
+class FinishTestResource : public IResource
+{
+public:
+	FinishTestResource()
+	{
+		type = EResourceType::RT_Terrain;
+	}
+};
+
+
+// A loader that is not thread safe and takes a few milliseconds to load on the main thread.
+class FinishTestLoader : public ILoader
+{
+public:
+	inline static ELoaderType Type() { return ELoaderType::LT_Audio; }
+
+	virtual IResource* LoadResource(const ResourceHeaderInfo& info, RavenInputArchive& archive) override
+	{
+		double loadMs = Test::GetTimeMs();
+		std::this_thread::sleep_for(std::chrono::milliseconds(3));
+		maxLoadMs = std::max(maxLoadMs, Test::GetTimeMs() - loadMs);
+
+		return new FinishTestResource();
+	}
+
+	virtual void SaveResource(RavenOutputArchive& archive, IResource* Resource) override { }
+	virtual void ListResourceTypes(std::vector<EResourceType>& outRscTypes) override { outRscTypes.push_back(EResourceType::RT_Terrain); }
+
+	// The longest time a load took, sleeps may take longer than asked.
+	inline static double maxLoadMs = 0.0;
+};
+
+
+
+
+RAVEN_TEST(ResourceManager_UpdateFinishesLoadsWithinTheFrameBudget)
+{
+	const uint32_t kNumResources = 6;
+
+	ResourceManager manager;
+	manager.Initialize();
+	manager.RegisterLoader<FinishTestLoader>();
+
+	// Resource files relative to the working directory, like the project resources.
+	const std::string dir = "cache/ResourceManagerTest/";
+	std::filesystem::remove_all(dir);
+	std::filesystem::create_directories(dir);
+
+	std::vector< Ptr<ResourceLoadHandle> > handles;
+
+	for (uint32_t i = 0; i < kNumResources; ++i)
+	{
+		std::string path = dir + "Finish" + std::to_string(i) + ".raven";
+
+		{
+			RavenOutputArchive archive(path);
+			ResourceHeaderInfo header((int32_t)EResourceType::RT_Terrain, RAVEN_VERSION);
+			archive.ArchiveSave(header);
+		}
+
+		TEST_CHECK(manager.AddResource(path));
+		handles.push_back(manager.LoadAsync(ResourceRef(path, EResourceType::RT_Terrain)));
+		TEST_CHECK(handles.back() && !handles.back()->IsDone());
+	}
+
+	TEST_CHECK(manager.GetNumLoadingAsync() == kNumResources);
+
+	// Let the workers read all the files, the loads are only finished by Update().
+	std::this_thread::sleep_for(std::chrono::milliseconds(500));
+
+	auto countDone = [&handles]()
+	{
+		uint32_t numDone = 0;
+
+		for (const auto& handle : handles)
+			numDone += handle->IsDone() ? 1 : 0;
+
+		return numDone;
+	};
+
+	TEST_CHECK(countDone() == 0);
+
+	// The first frame stops once it is over the budget, with at most one load over it.
+	double frameMs = Test::GetTimeMs();
+	manager.Update();
+	frameMs = Test::GetTimeMs() - frameMs;
+
+	uint32_t numDone = countDone();
+	TEST_CHECK(numDone >= 1);
+	TEST_CHECK(numDone < kNumResources);
+	TEST_CHECK(frameMs < RESOURCE_LOAD_FRAME_BUDGET + FinishTestLoader::maxLoadMs + 1.0);
+
+	// The next frames pick up the rest.
+	uint32_t numFrames = 1;
+
+	while (countDone() < kNumResources && numFrames < 100)
+	{
+		uint32_t prevDone = countDone();
+		manager.Update();
+		++numFrames;
+
+		// Every frame finishes at least one load.
+		TEST_CHECK(countDone() > prevDone);
+	}
+
+	TEST_CHECK(countDone() == kNumResources);
+	TEST_CHECK(numFrames > 1);
+	TEST_CHECK(manager.GetNumLoadingAsync() == 0);
+
+	for (const auto& handle : handles)
+	{
+		TEST_CHECK(!handle->IsFailed());
+		TEST_CHECK(manager.IsResourceLoaded(handle->GetPath()));
+	}
+
+	manager.Destroy();
+	std::filesystem::remove_all(dir);
+}
@@ -10,8 +10,8 @@
 
 
 
-// Make sure to define MAX_LIGHTS
-#ifndef MAX_LIGHTS
+// Make sure to define MAX_LIGHTS, clustered lighting reads its lights from storage buffers instead.
+#if !defined(MAX_LIGHTS) && !defined(LIGHT_CLUSTERS)
 #error MAX_LIGHTS should be defined.
 #endif
 
@@ -28,6 +28,52 @@
 
 
 
+#if defined(LIGHT_CLUSTERS)
+
+// The data of a single light.
+struct LightData
+{
+	// Direction (XYZ).
+	vec4 dir;
+	
+	// Position (XYZ).
+	vec4 pos;
+	
+	// Light Color(RGB), Power(A).
+	vec4 power;
+	
+	// Type(X), Inner Angle(Y), Outter Angle(Z), Radius(W).
+	vec4 data;
+};
+
+
+// All the lights in the view.
+layout(std430, binding = LIGHT_CLUSTER_LIGHTS_BINDING) readonly buffer LightClusterLights
+{
+	LightData lights[];
+} inClusterLights;
+
+
+// The offset(X) & count(Y) of the light indices of each cluster.
+layout(std430, binding = LIGHT_CLUSTER_CELLS_BINDING) readonly buffer LightClusterCells
+{
+	uvec2 cells[];
+} inClusterCells;
+
+
+// The light indices of all clusters.
+layout(std430, binding = LIGHT_CLUSTER_INDICES_BINDING) readonly buffer LightClusterIndices
+{
+	uint indices[];
+} inClusterIndices;
+
+
+#define LIGHT_DIR(idx) inClusterLights.lights[idx].dir
+#define LIGHT_POS(idx) inClusterLights.lights[idx].pos
+#define LIGHT_POWER(idx) inClusterLights.lights[idx].power
+#define LIGHT_DATA(idx) inClusterLights.lights[idx].data
+
+#else
  
 // Lighting Input...
 layout(std140) uniform LightingBlock
@@ -47,6 +93,14 @@ layout(std140) uniform LightingBlock
 } inLighting;
 
 
+#define LIGHT_DIR(idx) inLighting.lightDir[idx]
+#define LIGHT_POS(idx) inLighting.lightPos[idx]
+#define LIGHT_POWER(idx) inLighting.lightPower[idx]
+#define LIGHT_DATA(idx) inLighting.lightData[idx]
+
+#endif
+
+
 
 // Sky Environment Map.
 uniform samplerCube inSkyEnvironment;
@@ -237,8 +291,8 @@ vec3 ComputeSunLight(in LightSurfaceData surface)
 vec3 ComputeLight(in LightSurfaceData surface, int lightIdx)
 {
 	// General Light Data...
-	vec4 lightPower = inLighting.lightPower[lightIdx];
-	vec4 lightData = inLighting.lightData[lightIdx];
+	vec4 lightPower = LIGHT_POWER(lightIdx);
+	vec4 lightData = LIGHT_DATA(lightIdx);
 	int lightType = int(lightData.x);
 	
 	
@@ -258,7 +312,7 @@ vec3 ComputeLight(in LightSurfaceData surface, int lightIdx)
 	
 	//
 	case TYPE_DIR_LIGHT:
-		l = -inLighting.lightDir[lightIdx].xyz;
+		l = -LIGHT_DIR(lightIdx).xyz;
 		dist = 0.0; // Infinity.
 		attenuation = 1.0; // No Attenuation.
 		break;
@@ -267,7 +321,7 @@ vec3 ComputeLight(in LightSurfaceData surface, int lightIdx)
 	case TYPE_SPOT_LIGHT:
 	case TYPE_POINT_LIGHT:
 	{
-		l = inLighting.lightPos[lightIdx].xyz - surface.p; 
+		l = LIGHT_POS(lightIdx).xyz - surface.p; 
 		dist = length(l);
 		
 		float attenBase = pow(max(1.0 - pow(dist / lightData.w, 4), 0.0), 2);
@@ -284,7 +338,7 @@ vec3 ComputeLight(in LightSurfaceData surface, int lightIdx)
 	if (lightType == TYPE_SPOT_LIGHT)
 	{
 		vec2 angles = lightData.yz;
-		vec3 dir = -inLighting.lightDir[lightIdx].xyz;
+		vec3 dir = -LIGHT_DIR(lightIdx).xyz;
 		
 		float a = dot(l, dir);
 		lightPower.a *= clamp((a - angles.y) / (angles.x - angles.y), 0.0, 1.0); 
@@ -321,6 +375,26 @@ vec3 ComputeLight(in LightSurfaceData surface, int lightIdx)
 
 
 
+#if defined(LIGHT_CLUSTERS)
+// Compute the index of the light cluster that contains a point in world space, must match RenderLightClusters.
+uint ComputeLightCluster(vec3 p)
+{
+	vec4 clip = inCommon.viewProjMatrix * vec4(p, 1.0);
+	vec2 uv = clamp(clip.xy / clip.w * 0.5 + 0.5, 0.0, 0.9999);
+	
+	// Exponential depth slices between the near & far planes.
+	float depth = max(clip.w, NEAR_VALUE);
+	float sliceScale = float(LIGHT_CLUSTER_Z) / log(FAR_VALUE / NEAR_VALUE);
+	uint slice = min(uint(log(depth / NEAR_VALUE) * sliceScale), LIGHT_CLUSTER_Z - 1u);
+	
+	uvec2 tile = uvec2(uv * vec2(LIGHT_CLUSTER_X, LIGHT_CLUSTER_Y));
+	return tile.x + (tile.y + slice * LIGHT_CLUSTER_Y) * LIGHT_CLUSTER_X;
+}
+#endif
+
+
+
+
 //	Compute Scene Lighting form sun and light data.
 vec3 ComputeLighting(in LightSurfaceData surface)
 {
@@ -331,12 +405,21 @@ vec3 ComputeLighting(in LightSurfaceData surface)
 	finalLighting += ComputeIBL(surface);
 	
 
-	// TODO: This should only be done for forward pass, deferred pass we need to implement light proxies
 	// Many Lights.
+#if defined(LIGHT_CLUSTERS)
+	// Only the lights of the surface cluster.
+	uvec2 cell = inClusterCells.cells[ComputeLightCluster(surface.p)];
+	
+	for (uint i = 0; i < cell.y; ++i)
+	{
+		finalLighting += ComputeLight(surface, int(inClusterIndices.indices[cell.x + i]));
+	}
+#else
 	for (int lightIndex = 0; lightIndex < MAX_LIGHTS; ++lightIndex)
 	{
 		finalLighting += ComputeLight(surface, lightIndex);
 	}
+#endif
 
 
 	return finalLighting;
@@ -3,8 +3,13 @@
 
 // Input Attributes...
 layout(location=0) in vec3 inPosition;
+#if RENDER_MESH_COMPACT_VERTEX
+layout(location=1) in vec2 inNormalOct;
+layout(location=2) in vec2 inTangentOct;
+#else
 layout(location=1) in vec3 inNormal;
 layout(location=2) in vec3 inTangent;
+#endif
 layout(location=3) in vec2 inTexCoord;
 
 #if RENDER_SHADER_MESH_INSTANCE
@@ -38,8 +43,28 @@ out VertexOutput
 
 
 
+#if RENDER_MESH_COMPACT_VERTEX
+// Decode an octahedral encoded unit vector.
+vec3 DecodeOctahedral(vec2 e)
+{
+	vec3 v = vec3(e.xy, 1.0 - abs(e.x) - abs(e.y));
+	float t = max(-v.z, 0.0);
+	v.x += v.x >= 0.0 ? -t : t;
+	v.y += v.y >= 0.0 ? -t : t;
+	return normalize(v);
+}
+#endif
+
+
+
+
 void main()
 {
+#if RENDER_MESH_COMPACT_VERTEX
+	vec3 inNormal = DecodeOctahedral(inNormalOct);
+	vec3 inTangent = DecodeOctahedral(inTangentOct);
+#endif
+
 #if RENDER_SHADER_MESH_INSTANCE
 	// Transform to world space.
 	vec4 worldPos = inInstanceTransform * vec4(inPosition, 1.0);
@@ -75,6 +75,7 @@ workspace( settings.workspace_name )
 	include "RavenEngine/Raven/premake5"
 	include "RavenEngine/Game/premake5"
 	include "RavenEngine/Editor/premake5"
+	include "RavenEngine/Tests/premake5"
 
 workspace( settings.workspace_name )
 